@@ -79,8 +79,12 @@
  * embb_atomic_store_unsigned_int( &my_var, 5 );
  * \endcode
  *
- * The current implementation guarantees sequential consistency (full fences)
- * for all atomic operations. Relaxed memory models may be added in the future.
+ * All operations without a memory order parameter are sequentially consistent
+ * (full fences). The \c _explicit variants of load, store, swap,
+ * fetch-and-add, and compare-and-swap take an ::embb_memory_order and only
+ * enforce the ordering constraints requested, which avoids unnecessary fences
+ * in lock-free algorithms. Where no cheaper instruction sequence is available,
+ * they behave like their sequentially consistent counterparts.
  */
 
 #ifdef DOXYGEN
@@ -163,6 +167,118 @@ EMBB_PLATFORM_INLINE TYPE embb_atomic_load_TYPE(
   /**< [IN] Pointer to atomic variable */
   );
 
+/**
+ * Compares \p variable with \p expected and, if equivalent, swaps its value
+ * with \p desired, using the memory order \p order.
+ *
+ * Same as embb_atomic_compare_and_swap_TYPE(), but a failed comparison only
+ * orders the load of \p variable (with acquire semantics at most).
+ *
+ * \return != 0 if the values of \p variable and \p expected were equivalent \n
+ *          0 otherwise
+ *
+ * \see \ref general_desc_atomic_base "Detailed description" for general
+ * information and the meaning of \b TYPE.
+ *
+ * \ingroup C_BASE_ATOMIC
+ * \waitfree
+ */
+EMBB_PLATFORM_INLINE int embb_atomic_compare_and_swap_explicit_TYPE(
+  embb_atomic_TYPE* variable,
+  /**< [IN,OUT] Pointer to atomic variable */
+  TYPE* expected,
+  /**< [IN,OUT] Pointer to expected value */
+  TYPE desired,
+  /**< [IN] Value to be stored in \p variable */
+  embb_memory_order order
+  /**< [IN] Memory order of the operation */
+  );
+
+/**
+ * Adds \p value to \p variable and returns its old value, using the memory
+ * order \p order.
+ *
+ * \return The value before the operation
+ *
+ * \see \ref general_desc_atomic_base "Detailed description" for general
+ * information and the meaning of \b TYPE.
+ *
+ * \ingroup C_BASE_ATOMIC
+ * \waitfree
+ */
+EMBB_PLATFORM_INLINE TYPE embb_atomic_fetch_and_add_explicit_TYPE(
+  embb_atomic_TYPE* variable,
+  /**< [IN,OUT] Pointer to atomic variable*/
+  TYPE value,
+  /**< [IN] The value to be added to \p variable (can be negative) */
+  embb_memory_order order
+  /**< [IN] Memory order of the operation */
+  );
+
+/**
+ * Loads the value of \p variable and returns it, using the memory order
+ * \p order.
+ *
+ * A load cannot release: EMBB_MEMORY_ORDER_RELEASE and
+ * EMBB_MEMORY_ORDER_ACQ_REL are treated as EMBB_MEMORY_ORDER_ACQUIRE.
+ *
+ * \return The value of the atomic variable.
+ *
+ * \see \ref general_desc_atomic_base "Detailed description" for general
+ * information and the meaning of \b TYPE.
+ *
+ * \ingroup C_BASE_ATOMIC
+ * \waitfree
+ */
+EMBB_PLATFORM_INLINE TYPE embb_atomic_load_explicit_TYPE(
+  const embb_atomic_TYPE* variable,
+  /**< [IN] Pointer to atomic variable */
+  embb_memory_order order
+  /**< [IN] Memory order of the operation */
+  );
+
+/**
+ * Stores \p value in \p variable, using the memory order \p order.
+ *
+ * A store cannot acquire: EMBB_MEMORY_ORDER_ACQUIRE and
+ * EMBB_MEMORY_ORDER_ACQ_REL are treated as EMBB_MEMORY_ORDER_RELEASE.
+ *
+ * \see \ref general_desc_atomic_base "Detailed description" for general
+ * information and the meaning of \b TYPE.
+ *
+ * \ingroup C_BASE_ATOMIC
+ * \waitfree
+ */
+EMBB_PLATFORM_INLINE void embb_atomic_store_explicit_TYPE(
+  embb_atomic_TYPE* variable,
+  /**< [IN,OUT] Pointer to atomic variable */
+  TYPE value,
+  /**< [IN] Value to be stored */
+  embb_memory_order order
+  /**< [IN] Memory order of the operation */
+  );
+
+/**
+ * Swaps the current value of \p variable with \p value, using the memory
+ * order \p order.
+ *
+ * \return The old value of \p variable
+ *
+ * \see \ref general_desc_atomic_base "Detailed description" for general
+ * information and the meaning of \b TYPE.
+ *
+ * \ingroup C_BASE_ATOMIC
+ * \waitfree
+ */
+EMBB_PLATFORM_INLINE TYPE embb_atomic_swap_explicit_TYPE(
+  embb_atomic_TYPE* variable,
+  /**< [IN,OUT] Pointer to atomic variable whose value is swapped */
+  TYPE value,
+  /**< [IN] Value which will be stored in the atomic variable */
+  embb_memory_order order
+  /**< [IN] Memory order of the operation */
+  );
+
 /**
  * Enforces a memory barrier (full fence).
  *
@@ -248,6 +364,26 @@ EMBB_PLATFORM_INLINE void embb_atomic_xor_assign_TYPE(
 extern "C" {
 #endif
 
+/**
+ * Memory orders of the \c _explicit atomic operations.
+ *
+ * The orders correspond to those of C11 and C++11 (without consume).
+ *
+ * \ingroup C_BASE_ATOMIC
+ */
+typedef enum {
+  /** No ordering constraints, only atomicity is guaranteed */
+  EMBB_MEMORY_ORDER_RELAXED = 0,
+  /** Later accesses are not reordered before the operation */
+  EMBB_MEMORY_ORDER_ACQUIRE,
+  /** Earlier accesses are not reordered after the operation */
+  EMBB_MEMORY_ORDER_RELEASE,
+  /** Both acquire and release */
+  EMBB_MEMORY_ORDER_ACQ_REL,
+  /** Acquire and release, plus a single total order of all such operations */
+  EMBB_MEMORY_ORDER_SEQ_CST
+} embb_memory_order;
+
 #include <embb/base/c/internal/platform.h>
 #include <embb/base/c/internal/atomic/atomic_sizes.h>
 #include <embb/base/c/internal/atomic/atomic_variables.h>
@@ -261,6 +397,7 @@ extern "C" {
 #include <embb/base/c/internal/atomic/fetch_and_add.h>
 #include <embb/base/c/internal/atomic/compare_and_swap.h>
 #include <embb/base/c/internal/atomic/memory_barrier.h>
+#include <embb/base/c/internal/atomic/memory_order.h>
 
 #ifdef __cplusplus
 }
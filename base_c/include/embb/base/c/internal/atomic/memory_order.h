@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_BASE_C_INTERNAL_ATOMIC_MEMORY_ORDER_H_
+#define EMBB_BASE_C_INTERNAL_ATOMIC_MEMORY_ORDER_H_
+
+#ifndef DOXYGEN
+
+#include <embb/base/c/internal/config.h>
+#include <embb/base/c/internal/atomic/atomic_sizes.h>
+#include <embb/base/c/internal/macro_helper.h>
+#include <embb/base/c/internal/atomic/atomic_variables.h>
+#include <embb/base/c/internal/atomic/load.h>
+#include <embb/base/c/internal/atomic/store.h>
+#include <embb/base/c/internal/atomic/swap.h>
+#include <embb/base/c/internal/atomic/fetch_and_add.h>
+#include <embb/base/c/internal/atomic/compare_and_swap.h>
+#include <string.h>
+
+/*
+ * Operations with an explicit memory order. With GCC and Clang, they map to
+ * the __atomic builtins, which emit only the fences required by the order on
+ * the target (e.g., a release store is a plain mov on x86 and does not need
+ * the dmb after the str on ARM). Otherwise, they fall back to the sequentially
+ * consistent implementations, which are correct for every order.
+ *
+ * Orders that are meaningless for an operation are strengthened to the
+ * nearest valid one: loads never release and stores never acquire.
+ */
+#if defined(EMBB_PLATFORM_COMPILER_GNUC) && defined(__ATOMIC_RELAXED)
+
+#define EMBB_ATOMIC_INTERNAL_HAS_BUILTINS
+
+EMBB_PLATFORM_INLINE int embb_internal__atomic_rmw_order(
+  embb_memory_order order) {
+  switch (order) {
+  case EMBB_MEMORY_ORDER_RELAXED: return __ATOMIC_RELAXED;
+  case EMBB_MEMORY_ORDER_ACQUIRE: return __ATOMIC_ACQUIRE;
+  case EMBB_MEMORY_ORDER_RELEASE: return __ATOMIC_RELEASE;
+  case EMBB_MEMORY_ORDER_ACQ_REL: return __ATOMIC_ACQ_REL;
+  default: return __ATOMIC_SEQ_CST;
+  }
+}
+
+EMBB_PLATFORM_INLINE int embb_internal__atomic_load_order(
+  embb_memory_order order) {
+  switch (order) {
+  case EMBB_MEMORY_ORDER_RELAXED: return __ATOMIC_RELAXED;
+  case EMBB_MEMORY_ORDER_ACQUIRE:
+  case EMBB_MEMORY_ORDER_RELEASE:
+  case EMBB_MEMORY_ORDER_ACQ_REL: return __ATOMIC_ACQUIRE;
+  default: return __ATOMIC_SEQ_CST;
+  }
+}
+
+EMBB_PLATFORM_INLINE int embb_internal__atomic_store_order(
+  embb_memory_order order) {
+  switch (order) {
+  case EMBB_MEMORY_ORDER_RELAXED: return __ATOMIC_RELAXED;
+  case EMBB_MEMORY_ORDER_ACQUIRE:
+  case EMBB_MEMORY_ORDER_RELEASE:
+  case EMBB_MEMORY_ORDER_ACQ_REL: return __ATOMIC_RELEASE;
+  default: return __ATOMIC_SEQ_CST;
+  }
+}
+
+/* The failure order of a CAS must not be stronger than its success order. */
+EMBB_PLATFORM_INLINE int embb_internal__atomic_failure_order(
+  embb_memory_order order) {
+  switch (order) {
+  case EMBB_MEMORY_ORDER_RELAXED:
+  case EMBB_MEMORY_ORDER_RELEASE: return __ATOMIC_RELAXED;
+  case EMBB_MEMORY_ORDER_ACQUIRE:
+  case EMBB_MEMORY_ORDER_ACQ_REL: return __ATOMIC_ACQUIRE;
+  default: return __ATOMIC_SEQ_CST;
+  }
+}
+
+#define EMBB_DEFINE_EXPLICIT(EMBB_PARAMETER_SIZE_BYTE) \
+  EMBB_PLATFORM_INLINE EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_PARAMETER_SIZE_BYTE) \
+  EMBB_CAT2(embb_internal__atomic_load_explicit_, EMBB_PARAMETER_SIZE_BYTE)(\
+  EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_PARAMETER_SIZE_BYTE) volatile* pointer_to_value, \
+  embb_memory_order order) { \
+  return __atomic_load_n(pointer_to_value, \
+    embb_internal__atomic_load_order(order)); \
+  } \
+  EMBB_PLATFORM_INLINE void \
+  EMBB_CAT2(embb_internal__atomic_store_explicit_, EMBB_PARAMETER_SIZE_BYTE)(\
+  EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_PARAMETER_SIZE_BYTE) volatile* pointer_to_value, \
+  EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_PARAMETER_SIZE_BYTE) new_value, \
+  embb_memory_order order) { \
+  __atomic_store_n(pointer_to_value, new_value, \
+    embb_internal__atomic_store_order(order)); \
+  } \
+  EMBB_PLATFORM_INLINE EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_PARAMETER_SIZE_BYTE) \
+  EMBB_CAT2(embb_internal__atomic_swap_explicit_, EMBB_PARAMETER_SIZE_BYTE)(\
+  EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_PARAMETER_SIZE_BYTE) volatile* pointer_to_value, \
+  EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_PARAMETER_SIZE_BYTE) new_value, \
+  embb_memory_order order) { \
+  return __atomic_exchange_n(pointer_to_value, new_value, \
+    embb_internal__atomic_rmw_order(order)); \
+  } \
+  EMBB_PLATFORM_INLINE EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_PARAMETER_SIZE_BYTE) \
+  EMBB_CAT2(embb_internal__atomic_fetch_and_add_explicit_, EMBB_PARAMETER_SIZE_BYTE)(\
+  EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_PARAMETER_SIZE_BYTE) volatile* pointer_to_value, \
+  EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_PARAMETER_SIZE_BYTE) new_value, \
+  embb_memory_order order) { \
+  return __atomic_fetch_add(pointer_to_value, new_value, \
+    embb_internal__atomic_rmw_order(order)); \
+  } \
+  EMBB_PLATFORM_INLINE int \
+  EMBB_CAT2(embb_internal__atomic_compare_and_swap_explicit_, EMBB_PARAMETER_SIZE_BYTE)(\
+  EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_PARAMETER_SIZE_BYTE) volatile* pointer_to_value, \
+  EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_PARAMETER_SIZE_BYTE)* expected, \
+  EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_PARAMETER_SIZE_BYTE) desired, \
+  embb_memory_order order) { \
+  return __atomic_compare_exchange_n(pointer_to_value, expected, desired, 0, \
+    embb_internal__atomic_rmw_order(order), \
+    embb_internal__atomic_failure_order(order)) ? 1 : 0; \
+  }
+
+#else
+
+#define EMBB_DEFINE_EXPLICIT(EMBB_PARAMETER_SIZE_BYTE) \
+  EMBB_PLATFORM_INLINE EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_PARAMETER_SIZE_BYTE) \
+  EMBB_CAT2(embb_internal__atomic_load_explicit_, EMBB_PARAMETER_SIZE_BYTE)(\
+  EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_PARAMETER_SIZE_BYTE) volatile* pointer_to_value, \
+  embb_memory_order order) { \
+  (void)order; \
+  return EMBB_CAT2(embb_internal__atomic_load_, EMBB_PARAMETER_SIZE_BYTE)(\
+    pointer_to_value); \
+  } \
+  EMBB_PLATFORM_INLINE void \
+  EMBB_CAT2(embb_internal__atomic_store_explicit_, EMBB_PARAMETER_SIZE_BYTE)(\
+  EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_PARAMETER_SIZE_BYTE) volatile* pointer_to_value, \
+  EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_PARAMETER_SIZE_BYTE) new_value, \
+  embb_memory_order order) { \
+  (void)order; \
+  EMBB_CAT2(embb_internal__atomic_store_, EMBB_PARAMETER_SIZE_BYTE)(\
+    pointer_to_value, new_value); \
+  } \
+  EMBB_PLATFORM_INLINE EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_PARAMETER_SIZE_BYTE) \
+  EMBB_CAT2(embb_internal__atomic_swap_explicit_, EMBB_PARAMETER_SIZE_BYTE)(\
+  EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_PARAMETER_SIZE_BYTE) volatile* pointer_to_value, \
+  EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_PARAMETER_SIZE_BYTE) new_value, \
+  embb_memory_order order) { \
+  (void)order; \
+  return EMBB_CAT2(embb_internal__atomic_swap_, EMBB_PARAMETER_SIZE_BYTE)(\
+    pointer_to_value, new_value); \
+  } \
+  EMBB_PLATFORM_INLINE EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_PARAMETER_SIZE_BYTE) \
+  EMBB_CAT2(embb_internal__atomic_fetch_and_add_explicit_, EMBB_PARAMETER_SIZE_BYTE)(\
+  EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_PARAMETER_SIZE_BYTE) volatile* pointer_to_value, \
+  EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_PARAMETER_SIZE_BYTE) new_value, \
+  embb_memory_order order) { \
+  (void)order; \
+  return EMBB_CAT2(embb_internal__atomic_fetch_and_add_, EMBB_PARAMETER_SIZE_BYTE)(\
+    pointer_to_value, new_value); \
+  } \
+  EMBB_PLATFORM_INLINE int \
+  EMBB_CAT2(embb_internal__atomic_compare_and_swap_explicit_, EMBB_PARAMETER_SIZE_BYTE)(\
+  EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_PARAMETER_SIZE_BYTE) volatile* pointer_to_value, \
+  EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_PARAMETER_SIZE_BYTE)* expected, \
+  EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_PARAMETER_SIZE_BYTE) desired, \
+  embb_memory_order order) { \
+  (void)order; \
+  return EMBB_CAT2(embb_internal__atomic_compare_and_swap_, EMBB_PARAMETER_SIZE_BYTE)(\
+    pointer_to_value, expected, desired); \
+  }
+
+#endif
+
+/*
+* The three or four macro calls below generate the methods for 1, 2, 4, and
+* bytes, as stated in the macro definition.
+*/
+EMBB_DEFINE_EXPLICIT(1)
+EMBB_DEFINE_EXPLICIT(2)
+EMBB_DEFINE_EXPLICIT(4)
+#ifdef EMBB_64_BIT_ATOMIC_AVAILABLE
+EMBB_DEFINE_EXPLICIT(8)
+#endif
+
+/*
+* See file and_assign.h for a detailed (and operation independent) description
+* of the following macros.
+*/
+#define EMBB_ATOMIC_INTERNAL_DEFINE_LOAD_EXPLICIT_METHOD(EMBB_ATOMIC_PARAMETER_TYPE_NATIVE, EMBB_ATOMIC_PARAMETER_ATOMIC_TYPE_SUFFIX, EMBB_ATOMIC_PARAMETER_TYPE_SIZE) \
+  EMBB_PLATFORM_INLINE EMBB_ATOMIC_PARAMETER_TYPE_NATIVE EMBB_CAT2(embb_atomic_load_explicit_, EMBB_ATOMIC_PARAMETER_ATOMIC_TYPE_SUFFIX)(\
+  const EMBB_CAT2(embb_atomic_, EMBB_ATOMIC_PARAMETER_ATOMIC_TYPE_SUFFIX)* variable, embb_memory_order order) { \
+  EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_ATOMIC_PARAMETER_TYPE_SIZE) \
+  return_val = (EMBB_CAT2(embb_internal__atomic_load_explicit_, EMBB_ATOMIC_PARAMETER_TYPE_SIZE)(\
+  (EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_ATOMIC_PARAMETER_TYPE_SIZE) volatile *)(&(variable->internal_variable)), order)); \
+  EMBB_ATOMIC_PARAMETER_TYPE_NATIVE return_val_pun; \
+  memcpy(&return_val_pun, &return_val, sizeof(EMBB_ATOMIC_PARAMETER_TYPE_NATIVE)); \
+  return return_val_pun; \
+  }
+
+#define EMBB_ATOMIC_INTERNAL_DEFINE_STORE_EXPLICIT_METHOD(EMBB_ATOMIC_PARAMETER_TYPE_NATIVE, EMBB_ATOMIC_PARAMETER_ATOMIC_TYPE_SUFFIX, EMBB_ATOMIC_PARAMETER_TYPE_SIZE) \
+  EMBB_PLATFORM_INLINE void EMBB_CAT2(embb_atomic_store_explicit_, EMBB_ATOMIC_PARAMETER_ATOMIC_TYPE_SUFFIX)(\
+  EMBB_CAT2(embb_atomic_, EMBB_ATOMIC_PARAMETER_ATOMIC_TYPE_SUFFIX)* variable, EMBB_ATOMIC_PARAMETER_TYPE_NATIVE value, embb_memory_order order) { \
+  EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_ATOMIC_PARAMETER_TYPE_SIZE) value_pun; \
+  memcpy(&value_pun, &value, sizeof(EMBB_ATOMIC_PARAMETER_TYPE_NATIVE)); \
+  EMBB_CAT2(embb_internal__atomic_store_explicit_, EMBB_ATOMIC_PARAMETER_TYPE_SIZE)((EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_ATOMIC_PARAMETER_TYPE_SIZE) volatile *)\
+  (&(variable->internal_variable)), value_pun, order); \
+  }
+
+#define EMBB_ATOMIC_INTERNAL_DEFINE_SWAP_EXPLICIT_METHOD(EMBB_ATOMIC_PARAMETER_TYPE_NATIVE, EMBB_ATOMIC_PARAMETER_ATOMIC_TYPE_SUFFIX, EMBB_ATOMIC_PARAMETER_TYPE_SIZE) \
+  EMBB_PLATFORM_INLINE EMBB_ATOMIC_PARAMETER_TYPE_NATIVE EMBB_CAT2(embb_atomic_swap_explicit_, EMBB_ATOMIC_PARAMETER_ATOMIC_TYPE_SUFFIX)(\
+  EMBB_CAT2(embb_atomic_, EMBB_ATOMIC_PARAMETER_ATOMIC_TYPE_SUFFIX)* variable, EMBB_ATOMIC_PARAMETER_TYPE_NATIVE value, embb_memory_order order) { \
+  EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_ATOMIC_PARAMETER_TYPE_SIZE) value_pun; \
+  EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_ATOMIC_PARAMETER_TYPE_SIZE) return_val; \
+  EMBB_ATOMIC_PARAMETER_TYPE_NATIVE return_val_pun; \
+  memcpy(&value_pun, &value, sizeof(EMBB_ATOMIC_PARAMETER_TYPE_NATIVE)); \
+  return_val = EMBB_CAT2(embb_internal__atomic_swap_explicit_, EMBB_ATOMIC_PARAMETER_TYPE_SIZE)((EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_ATOMIC_PARAMETER_TYPE_SIZE) volatile *)\
+  (&(variable->internal_variable)), value_pun, order); \
+  memcpy(&return_val_pun, &return_val, sizeof(EMBB_ATOMIC_PARAMETER_TYPE_NATIVE)); \
+  return return_val_pun; \
+  }
+
+#define EMBB_ATOMIC_INTERNAL_DEFINE_FETCH_AND_ADD_EXPLICIT_METHOD(EMBB_ATOMIC_PARAMETER_TYPE_NATIVE, EMBB_ATOMIC_PARAMETER_ATOMIC_TYPE_SUFFIX, EMBB_ATOMIC_PARAMETER_TYPE_SIZE) \
+  EMBB_PLATFORM_INLINE EMBB_ATOMIC_PARAMETER_TYPE_NATIVE EMBB_CAT2(embb_atomic_fetch_and_add_explicit_, EMBB_ATOMIC_PARAMETER_ATOMIC_TYPE_SUFFIX)(\
+  EMBB_CAT2(embb_atomic_, EMBB_ATOMIC_PARAMETER_ATOMIC_TYPE_SUFFIX)* variable, EMBB_ATOMIC_PARAMETER_TYPE_NATIVE value, embb_memory_order order) { \
+  EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_ATOMIC_PARAMETER_TYPE_SIZE) value_pun; \
+  EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_ATOMIC_PARAMETER_TYPE_SIZE) return_val; \
+  EMBB_ATOMIC_PARAMETER_TYPE_NATIVE return_val_pun; \
+  memcpy(&value_pun, &value, sizeof(EMBB_ATOMIC_PARAMETER_TYPE_NATIVE)); \
+  return_val = EMBB_CAT2(embb_internal__atomic_fetch_and_add_explicit_, EMBB_ATOMIC_PARAMETER_TYPE_SIZE)((EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_ATOMIC_PARAMETER_TYPE_SIZE) volatile *)\
+  (&(variable->internal_variable)), value_pun, order); \
+  memcpy(&return_val_pun, &return_val, sizeof(EMBB_ATOMIC_PARAMETER_TYPE_NATIVE)); \
+  return return_val_pun; \
+  }
+
+#define EMBB_ATOMIC_INTERNAL_DEFINE_COMPARE_AND_SWAP_EXPLICIT_METHOD(EMBB_ATOMIC_PARAMETER_TYPE_NATIVE, EMBB_ATOMIC_PARAMETER_ATOMIC_TYPE_SUFFIX, EMBB_ATOMIC_PARAMETER_TYPE_SIZE) \
+  EMBB_PLATFORM_INLINE int EMBB_CAT2(embb_atomic_compare_and_swap_explicit_, EMBB_ATOMIC_PARAMETER_ATOMIC_TYPE_SUFFIX)(\
+  EMBB_CAT2(embb_atomic_, EMBB_ATOMIC_PARAMETER_ATOMIC_TYPE_SUFFIX)* variable, EMBB_ATOMIC_PARAMETER_TYPE_NATIVE* expected, EMBB_ATOMIC_PARAMETER_TYPE_NATIVE desired, embb_memory_order order) { \
+  EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_ATOMIC_PARAMETER_TYPE_SIZE) desired_pun; \
+  EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_ATOMIC_PARAMETER_TYPE_SIZE) expected_pun; \
+  int result; \
+  memcpy(&desired_pun, &desired, sizeof(EMBB_ATOMIC_PARAMETER_TYPE_NATIVE)); \
+  memcpy(&expected_pun, expected, sizeof(EMBB_ATOMIC_PARAMETER_TYPE_NATIVE)); \
+  result = EMBB_CAT2(embb_internal__atomic_compare_and_swap_explicit_, EMBB_ATOMIC_PARAMETER_TYPE_SIZE)((EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, EMBB_ATOMIC_PARAMETER_TYPE_SIZE) volatile *)\
+  (&(variable->internal_variable)), &expected_pun, desired_pun, order); \
+  memcpy(expected, &expected_pun, sizeof(EMBB_ATOMIC_PARAMETER_TYPE_NATIVE)); \
+  return result; \
+  }
+
+#undef EMBB_ATOMIC_METHOD_TO_GENERATE
+#define EMBB_ATOMIC_METHOD_TO_GENERATE LOAD_EXPLICIT_METHOD
+#include <embb/base/c/internal/atomic/generate_atomic_implementation_template.h>
+#undef EMBB_ATOMIC_METHOD_TO_GENERATE
+#define EMBB_ATOMIC_METHOD_TO_GENERATE STORE_EXPLICIT_METHOD
+#include <embb/base/c/internal/atomic/generate_atomic_implementation_template.h>
+#undef EMBB_ATOMIC_METHOD_TO_GENERATE
+#define EMBB_ATOMIC_METHOD_TO_GENERATE SWAP_EXPLICIT_METHOD
+#include <embb/base/c/internal/atomic/generate_atomic_implementation_template.h>
+#undef EMBB_ATOMIC_METHOD_TO_GENERATE
+#define EMBB_ATOMIC_METHOD_TO_GENERATE FETCH_AND_ADD_EXPLICIT_METHOD
+#include <embb/base/c/internal/atomic/generate_atomic_implementation_template.h>
+#undef EMBB_ATOMIC_METHOD_TO_GENERATE
+#define EMBB_ATOMIC_METHOD_TO_GENERATE COMPARE_AND_SWAP_EXPLICIT_METHOD
+#include <embb/base/c/internal/atomic/generate_atomic_implementation_template.h>
+#undef EMBB_ATOMIC_METHOD_TO_GENERATE
+
+#endif //DOXYGEN
+
+#endif //EMBB_BASE_C_INTERNAL_ATOMIC_MEMORY_ORDER_H_
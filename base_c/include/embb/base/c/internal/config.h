@@ -90,6 +90,19 @@
 #define EMBB_PLATFORM_ARCH_UNKNOWN
 #endif
 
+/* Hint to load the cache line at the given address before it is read.
+ * Never faults, so the address may be invalid or NULL.
+ */
+#if defined(EMBB_PLATFORM_COMPILER_GNUC)
+#define EMBB_PLATFORM_PREFETCH(address) __builtin_prefetch(address)
+#elif defined(EMBB_PLATFORM_COMPILER_MSVC) && defined(EMBB_PLATFORM_ARCH_X86)
+#include <xmmintrin.h>
+#define EMBB_PLATFORM_PREFETCH(address) \
+  _mm_prefetch((const char*)(address), _MM_HINT_T0)
+#else
+#define EMBB_PLATFORM_PREFETCH(address)
+#endif
+
 #if defined(EMBB_PLATFORM_COMPILER_MSVC)
 #define EMBB_PLATFORM_THREADING_WINTHREADS
 #elif defined(EMBB_PLATFORM_COMPILER_GNUC)
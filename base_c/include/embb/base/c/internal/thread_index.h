@@ -36,7 +36,8 @@ extern "C" {
  *
  * A new index has to be obtained only on first call of the function. Later
  * calls always succeed, since they just return the index obtained in the
- * first call.
+ * first call. The index is released when the thread exits and may then be
+ * handed out to another thread.
  *
  * \pre embb_internal_thread_index_create() has been called.
  * \return EMBB_SUCCESS, if an index could be obtained.
@@ -48,6 +49,42 @@ int embb_internal_thread_index(
   /**< [OUT] Pointer to memory location to write thread index to. */
   );
 
+/**
+ * Tries to return the current thread's (internal) index and the generation of
+ * the index.
+ *
+ * Indices are recycled when threads exit, so a thread may obtain an index
+ * that was used by another thread before. The generation is unique among all
+ * threads that obtained an index and is never 0. It allows per-thread slots
+ * to detect that they were written by a previous holder of the index.
+ *
+ * \return EMBB_SUCCESS, if an index could be obtained.
+ *         EMBB_ERROR, if no more indices were available.
+ * \lockfree
+ * \see embb_internal_thread_index()
+ */
+int embb_internal_thread_index_and_generation(
+  unsigned int* index,
+  /**< [OUT] Pointer to memory location to write thread index to. */
+  unsigned int* generation
+  /**< [OUT] Pointer to memory location to write the generation to, which is
+             0 if no index could be obtained. */
+  );
+
+/**
+ * Releases the current thread's (internal) index, so that it can be reused
+ * by other threads.
+ *
+ * This is done automatically when a thread that obtained an index exits. A
+ * thread that calls embb_internal_thread_index() after releasing its index
+ * obtains a new one.
+ *
+ * \notthreadsafe The calling thread must not use its index any more, i.e.,
+ *                it must not be inside an operation of a data structure that
+ *                relies on thread indices.
+ */
+void embb_internal_thread_index_release();
+
 /**
  * Returns the maximum number of available thread indices.
  *
@@ -34,7 +34,9 @@
  *
  * Provides an abstraction from platform-specific mutex implementations.
  * Plain and recursive mutexes are available, where the plain version can
- * only be locked once by the same thread.
+ * only be locked once by the same thread. Additionally, an adaptive mutex is
+ * provided for short critical sections that spins for a bounded time before
+ * putting the calling thread to sleep.
  *
  * \ingroup C_BASE
  * \{
@@ -46,6 +48,7 @@ extern "C" {
 
 #include <embb/base/c/internal/platform.h>
 #include <embb/base/c/errors.h>
+#include <embb/base/c/atomic.h>
 
 #ifdef DOXYGEN
 /**
@@ -147,6 +150,104 @@ void embb_mutex_destroy(
   /**< [IN/OUT] Pointer to mutex */
   );
 
+/**
+ * Opaque type representing an adaptive mutex.
+ */
+#ifdef DOXYGEN
+typedef opaque_type embb_adaptive_mutex_t;
+#else
+typedef struct embb_adaptive_mutex_t {
+  /* 0: unlocked, 1: locked, 2: locked and possibly contended */
+  embb_atomic_int state;
+  /* Number of spin rounds before a thread is parked */
+  unsigned int spin_limit;
+  /* Used for parking if the platform does not provide futexes */
+  embb_mutex_t park_mutex;
+  embb_condition_t park_condition;
+} embb_adaptive_mutex_t;
+#endif /* else defined(DOXYGEN) */
+
+/**
+ * Initializes an adaptive mutex.
+ *
+ * An adaptive mutex is non-recursive. A thread trying to lock an adaptive
+ * mutex that is held by another thread first spins with exponential backoff
+ * for a bounded number of rounds and is only put to sleep if the mutex is
+ * still locked afterwards. Spinning is skipped if only a single core is
+ * available. Uncontended locking and unlocking does not enter the operating
+ * system. An adaptive mutex does not guarantee fairness.
+ *
+ * \post \c mutex is initialized and unlocked
+ * \return EMBB_SUCCESS if mutex could be initialized \n
+ *         EMBB_ERROR otherwise
+ * \memory (Potentially) allocates dynamic memory
+ * \notthreadsafe
+ * \see embb_adaptive_mutex_destroy()
+ */
+int embb_adaptive_mutex_init(
+  embb_adaptive_mutex_t* mutex
+  /**< [OUT] Pointer to adaptive mutex */
+  );
+
+/**
+ * Waits until the adaptive mutex can be locked and locks it.
+ *
+ * \pre \c mutex is initialized and not locked by the current thread
+ * \post If successful, \c mutex is locked.
+ * \return EMBB_SUCCESS if mutex could be locked \n
+ *         EMBB_ERROR otherwise
+ * \threadsafe
+ * \see embb_adaptive_mutex_try_lock(), embb_adaptive_mutex_unlock()
+ */
+int embb_adaptive_mutex_lock(
+  embb_adaptive_mutex_t* mutex
+  /**< [IN/OUT] Pointer to adaptive mutex */
+  );
+
+/**
+ * Tries to lock the adaptive mutex and returns immediately.
+ *
+ * \pre \c mutex is initialized
+ * \post If successful, \c mutex is locked
+ * \return EMBB_SUCCESS if mutex could be locked \n
+ *         EMBB_BUSY if mutex could not be locked
+ * \threadsafe
+ * \lockfree
+ * \see embb_adaptive_mutex_lock(), embb_adaptive_mutex_unlock()
+ */
+int embb_adaptive_mutex_try_lock(
+  embb_adaptive_mutex_t* mutex
+  /**< [IN/OUT] Pointer to adaptive mutex */
+  );
+
+/**
+ * Unlocks a locked adaptive mutex and wakes up one sleeping thread, if any.
+ *
+ * \pre \c mutex has been locked by the current thread.
+ * \post If successful, \c mutex is unlocked.
+ * \return EMBB_SUCCESS if the operation was successful \n
+ *         EMBB_ERROR otherwise
+ * \threadsafe
+ * \see embb_adaptive_mutex_lock(), embb_adaptive_mutex_try_lock()
+ */
+int embb_adaptive_mutex_unlock(
+  embb_adaptive_mutex_t* mutex
+  /**< [IN/OUT] Pointer to adaptive mutex */
+  );
+
+/**
+ * Destroys an adaptive mutex and frees its resources.
+ *
+ * \pre \c mutex has been initialized and is unlocked
+ * \post \c mutex is uninitialized
+ * \notthreadsafe
+ * \see embb_adaptive_mutex_init()
+ */
+void embb_adaptive_mutex_destroy(
+  embb_adaptive_mutex_t* mutex
+  /**< [IN/OUT] Pointer to adaptive mutex */
+  );
+
 #ifdef __cplusplus
 } /* Close extern "C" { */
 #endif
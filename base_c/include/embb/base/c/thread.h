@@ -71,10 +71,11 @@ typedef int(*embb_thread_start_t)(void*);
  * EMB<sup>2</sup> functionalities or data structures, regardless of whether
  * a thread is started by EMB<sup>2</sup> or other threading libraries.
  * Each thread that makes use of EMB<sup>2</sup> at least once consumes one
- * entry in the internal tables. The entry is permanently consumed during a
- * program run, even if the thread does not exist any longer. If more threads
- * than the maximum thread count access EMB<sup>2</sup>, undefined behavior or
- * abortion of program execution can occur.
+ * entry in the internal tables. The entry is released when the thread exits
+ * and can then be used by another thread, so the maximum thread count only
+ * has to cover the threads that use EMB<sup>2</sup> at the same time. If more
+ * threads than the maximum thread count access EMB<sup>2</sup> at the same
+ * time, undefined behavior or abortion of program execution can occur.
  *
  * \return Maximum number of threads
  *
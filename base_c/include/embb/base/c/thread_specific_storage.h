@@ -54,6 +54,9 @@ typedef opaque_type embb_tss_t;
 #else
 typedef struct embb_tss_t {
   void** values;
+  /* Generation of the thread index that set the value, see
+     embb_internal_thread_index_and_generation() */
+  unsigned int* generations;
   unsigned int size;
 } embb_tss_t;
 #endif /* else defined(DOXYGEN) */
@@ -64,7 +67,7 @@ typedef struct embb_tss_t {
  * \pre The given TSS has not yet been created or has already been deleted.
  * \return EMBB_SUCCESS if storage could be created \n
  *         EMBB_NOMEM if not enough memory was available
- * \memory embb_thread_get_max_count() pointers
+ * \memory embb_thread_get_max_count() pointers and unsigned integers
  * \notthreadsafe
  * \see embb_tss_delete(), embb_thread_get_max_count()
  */
@@ -98,7 +101,8 @@ int embb_tss_set(
  * \pre The given TSS has been created
  * \return Thread-specific value if embb_tss_set() has previously been called
  *         with a valid address. NULL, if no value was set or the calling thread
- *         could not obtain a thread-specific index.
+ *         could not obtain a thread-specific index. Values set by exited
+ *         threads are not returned to a thread reusing their index.
  * \lockfree
  * \see embb_tss_set()
  */
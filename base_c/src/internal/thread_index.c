@@ -76,10 +76,60 @@ embb_counter_t* embb_thread_index_counter() {
   return &embb_thread_index_counter_index;
 }
 
+/**
+ * Indices released by exited threads, handed out again once the counter is
+ * exhausted.
+ *
+ * The list is protected by a spinlock, since it is only accessed when a
+ * thread obtains its first index or exits. It is allocated with malloc
+ * instead of embb_alloc, as it lives until the end of the program and must
+ * not show up as a leak of the user's allocations.
+ *
+ * These variables have local scope.
+ */
+static embb_atomic_int embb_thread_index_free_lock = { 0 };
+static unsigned int* embb_thread_index_free_list = NULL;
+static unsigned int embb_thread_index_free_count = 0;
+static unsigned int embb_thread_index_free_capacity = 0;
+
+static void embb_thread_index_free_list_lock() {
+  int expected = 0;
+  while (!embb_atomic_compare_and_swap_explicit_int(
+      &embb_thread_index_free_lock, &expected, 1,
+      EMBB_MEMORY_ORDER_ACQUIRE)) {
+    expected = 0;
+  }
+}
+
+static void embb_thread_index_free_list_unlock() {
+  embb_atomic_store_explicit_int(&embb_thread_index_free_lock, 0,
+    EMBB_MEMORY_ORDER_RELEASE);
+}
+
+/**
+ * Generation of the last index handed out, see
+ * embb_internal_thread_index_and_generation().
+ *
+ * This variable has local scope.
+ */
+static embb_atomic_unsigned_int embb_thread_index_generation_counter = { 0 };
+
+/**
+ * Generation at the last call of embb_internal_thread_index_reset(). Indices
+ * of older generations were handed out before the reset and are not put back
+ * on release, since the counter may have handed them out again.
+ *
+ * This variable has local scope.
+ */
+static embb_atomic_unsigned_int embb_thread_index_reset_generation = { 0 };
+
 /**
  * Tries to return the next free (internal) thread index.
  *
- * An index is only set, if there was still one available.
+ * An index is only set, if there was still one available. New indices are
+ * taken from the counter first, so running threads keep distinct indices as
+ * long as possible. Released indices are reused once the counter reached
+ * the maximum.
  *
  * This function has local scope.
  *
@@ -87,13 +137,55 @@ embb_counter_t* embb_thread_index_counter() {
  */
 int embb_try_get_next_thread_index(unsigned int* free_index) {
   assert(free_index != NULL);
+  unsigned int max = *embb_max_number_thread_indices();
   unsigned int index = embb_counter_increment(embb_thread_index_counter());
-  if (index >= *embb_max_number_thread_indices()) {
-    embb_counter_decrement(embb_thread_index_counter());
-    return EMBB_ERROR;
+  if (index < max) {
+    *free_index = index;
+    return EMBB_SUCCESS;
   }
-  *free_index = index;
-  return EMBB_SUCCESS;
+  embb_counter_decrement(embb_thread_index_counter());
+
+  embb_thread_index_free_list_lock();
+  while (embb_thread_index_free_count > 0) {
+    index = embb_thread_index_free_list[--embb_thread_index_free_count];
+    /* Skip indices that became invalid by lowering the maximum */
+    if (index < max) {
+      embb_thread_index_free_list_unlock();
+      *free_index = index;
+      return EMBB_SUCCESS;
+    }
+  }
+  embb_thread_index_free_list_unlock();
+  return EMBB_ERROR;
+}
+
+/**
+ * Puts \p index back for reuse by other threads.
+ *
+ * If the free list cannot grow, the index is dropped, i.e., it is consumed
+ * as without recycling.
+ *
+ * This function has local scope.
+ */
+static void embb_put_thread_index(unsigned int index) {
+  embb_thread_index_free_list_lock();
+  if (embb_thread_index_free_count == embb_thread_index_free_capacity) {
+    unsigned int capacity = embb_thread_index_free_capacity * 2;
+    if (capacity < *embb_max_number_thread_indices()) {
+      capacity = *embb_max_number_thread_indices();
+    }
+    unsigned int* list =
+      (unsigned int*)realloc(embb_thread_index_free_list,
+        capacity * sizeof(unsigned int));
+    if (list == NULL) {
+      embb_thread_index_free_list_unlock();
+      return;
+    }
+    embb_thread_index_free_list = list;
+    embb_thread_index_free_capacity = capacity;
+  }
+  embb_thread_index_free_list[embb_thread_index_free_count++] = index;
+  embb_thread_index_free_list_unlock();
 }
 
 /**
@@ -107,6 +199,76 @@ int embb_try_get_next_thread_index(unsigned int* free_index) {
  */
 EMBB_THREAD_SPECIFIC unsigned int embb_internal_thread_index_var = UINT_MAX;
 
+/**
+ * Generation of the thread specific thread index.
+ *
+ * This variable has local scope.
+ */
+EMBB_THREAD_SPECIFIC unsigned int embb_internal_thread_generation_var = 0;
+
+/**
+ * Releases the index of the calling thread at thread exit. The value passed
+ * by the platform is ignored, the index is taken from the thread specific
+ * variable.
+ *
+ * This function has local scope.
+ */
+#ifdef EMBB_PLATFORM_THREADING_WINTHREADS
+static VOID WINAPI embb_thread_index_destructor(PVOID value) {
+  (void)value;
+  embb_internal_thread_index_release();
+}
+#else
+static void embb_thread_index_destructor(void* value) {
+  (void)value;
+  embb_internal_thread_index_release();
+}
+#endif
+
+/**
+ * Registers the destructor that releases the thread index at thread exit,
+ * using thread local storage of the platform (the compiler's thread specific
+ * variables do not support destructors in C).
+ *
+ * Returns 0 if no destructor could be registered, in which case indices are
+ * not recycled.
+ *
+ * This function has local scope.
+ */
+static embb_atomic_int embb_thread_index_key_flag = { 0 };
+#ifdef EMBB_PLATFORM_THREADING_WINTHREADS
+static DWORD embb_thread_index_key;
+#else
+static pthread_key_t embb_thread_index_key;
+#endif
+
+static int embb_thread_index_register_destructor() {
+  int compare_to = 0;
+  if (embb_atomic_load_int(&embb_thread_index_key_flag) < 2) {
+    if (embb_atomic_compare_and_swap_int(
+        &embb_thread_index_key_flag, &compare_to, 1)) {
+#ifdef EMBB_PLATFORM_THREADING_WINTHREADS
+      embb_thread_index_key = FlsAlloc(embb_thread_index_destructor);
+      int created = (embb_thread_index_key != FLS_OUT_OF_INDEXES);
+#else
+      int created = (pthread_key_create(&embb_thread_index_key,
+        embb_thread_index_destructor) == 0);
+#endif
+      embb_atomic_store_int(&embb_thread_index_key_flag, created ? 2 : 3);
+    }
+    while (embb_atomic_load_int(&embb_thread_index_key_flag) < 2) {}
+  }
+  if (embb_atomic_load_int(&embb_thread_index_key_flag) != 2) {
+    return 0;
+  }
+  /* Any non-null value makes the platform call the destructor */
+#ifdef EMBB_PLATFORM_THREADING_WINTHREADS
+  return FlsSetValue(embb_thread_index_key, (PVOID)1) ? 1 : 0;
+#else
+  return pthread_setspecific(embb_thread_index_key, (void*)1) == 0 ? 1 : 0;
+#endif
+}
+
 int embb_internal_thread_index(unsigned int* index) {
   assert(index != NULL);
   if (embb_internal_thread_index_var == UINT_MAX) {
@@ -115,11 +277,38 @@ int embb_internal_thread_index(unsigned int* index) {
     if (status == EMBB_ERROR) {
       return EMBB_ERROR;
     }
+    unsigned int generation;
+    do {
+      generation = embb_atomic_fetch_and_add_explicit_unsigned_int(
+        &embb_thread_index_generation_counter, 1,
+        EMBB_MEMORY_ORDER_RELAXED) + 1;
+    } while (generation == 0);
+    embb_internal_thread_generation_var = generation;
+    embb_thread_index_register_destructor();
   }
   *index = embb_internal_thread_index_var;
   return EMBB_SUCCESS;
 }
 
+int embb_internal_thread_index_and_generation(unsigned int* index,
+  unsigned int* generation) {
+  assert(generation != NULL);
+  int status = embb_internal_thread_index(index);
+  *generation = embb_internal_thread_generation_var;
+  return status;
+}
+
+void embb_internal_thread_index_release() {
+  if (embb_internal_thread_index_var != UINT_MAX) {
+    if (embb_internal_thread_generation_var >
+        embb_atomic_load_unsigned_int(&embb_thread_index_reset_generation)) {
+      embb_put_thread_index(embb_internal_thread_index_var);
+    }
+    embb_internal_thread_index_var = UINT_MAX;
+    embb_internal_thread_generation_var = 0;
+  }
+}
+
 int embb_internal_thread_index_max() {
   return (int)(*embb_max_number_thread_indices());
 }
@@ -129,5 +318,10 @@ void embb_internal_thread_index_set_max(unsigned int max) {
 }
 
 void embb_internal_thread_index_reset() {
+  embb_thread_index_free_list_lock();
+  embb_thread_index_free_count = 0;
+  embb_atomic_store_unsigned_int(&embb_thread_index_reset_generation,
+    embb_atomic_load_unsigned_int(&embb_thread_index_generation_counter));
+  embb_thread_index_free_list_unlock();
   embb_counter_init(embb_thread_index_counter());
 }
@@ -25,9 +25,18 @@
  */
 
 #include <embb/base/c/mutex.h>
+#include <embb/base/c/condition_variable.h>
+#include <embb/base/c/core_set.h>
 #include <assert.h>
 
 #include <embb/base/c/internal/unused.h>
+#include <embb/base/c/internal/cmake_config.h>
+
+#ifdef EMBB_PLATFORM_HAS_HEADER_FUTEX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
 
 #ifdef EMBB_PLATFORM_THREADING_WINTHREADS
 
@@ -115,3 +124,149 @@ void embb_mutex_destroy(embb_mutex_t* mutex) {
 }
 
 #endif /* EMBB_PLATFORM_THREADING_POSIXTHREADS */
+
+/**
+ * Number of spin rounds of an adaptive mutex before parking the thread.
+ */
+#define EMBB_ADAPTIVE_MUTEX_SPIN_LIMIT 100
+
+/**
+ * Upper bound for the number of pause instructions per spin round.
+ */
+#define EMBB_ADAPTIVE_MUTEX_BACKOFF_LIMIT 64
+
+static void embb_adaptive_mutex_pause() {
+#if defined(EMBB_PLATFORM_COMPILER_MSVC)
+  YieldProcessor();
+#elif defined(EMBB_PLATFORM_COMPILER_GNUC) && \
+  (defined(__i386__) || defined(__x86_64__))
+  __asm__ __volatile__("pause");
+#endif
+}
+
+/**
+ * Sleeps as long as the state of the mutex is 2. May return spuriously.
+ */
+static void embb_adaptive_mutex_park(embb_adaptive_mutex_t* mutex) {
+#ifdef EMBB_PLATFORM_HAS_HEADER_FUTEX
+  syscall(SYS_futex, &mutex->state.internal_variable, FUTEX_WAIT_PRIVATE,
+    2, NULL, NULL, 0);
+#else
+  embb_mutex_lock(&mutex->park_mutex);
+  /* The waker takes park_mutex after releasing the state, so checking the
+     state under park_mutex cannot miss the notification. */
+  if (embb_atomic_load_int(&mutex->state) == 2) {
+    embb_condition_wait(&mutex->park_condition, &mutex->park_mutex);
+  }
+  embb_mutex_unlock(&mutex->park_mutex);
+#endif
+}
+
+/**
+ * Wakes up at most one thread sleeping in embb_adaptive_mutex_park().
+ */
+static void embb_adaptive_mutex_unpark(embb_adaptive_mutex_t* mutex) {
+#ifdef EMBB_PLATFORM_HAS_HEADER_FUTEX
+  syscall(SYS_futex, &mutex->state.internal_variable, FUTEX_WAKE_PRIVATE,
+    1, NULL, NULL, 0);
+#else
+  embb_mutex_lock(&mutex->park_mutex);
+  embb_condition_notify_one(&mutex->park_condition);
+  embb_mutex_unlock(&mutex->park_mutex);
+#endif
+}
+
+int embb_adaptive_mutex_init(embb_adaptive_mutex_t* mutex) {
+  assert(mutex != NULL);
+  embb_atomic_store_int(&mutex->state, 0);
+  /* Spinning only pays off if the owner can make progress meanwhile */
+  mutex->spin_limit = embb_core_count_available() > 1 ?
+    EMBB_ADAPTIVE_MUTEX_SPIN_LIMIT : 0;
+#ifndef EMBB_PLATFORM_HAS_HEADER_FUTEX
+  if (embb_mutex_init(&mutex->park_mutex, EMBB_MUTEX_PLAIN) != EMBB_SUCCESS) {
+    return EMBB_ERROR;
+  }
+  if (embb_condition_init(&mutex->park_condition) != EMBB_SUCCESS) {
+    embb_mutex_destroy(&mutex->park_mutex);
+    return EMBB_ERROR;
+  }
+#endif
+  return EMBB_SUCCESS;
+}
+
+int embb_adaptive_mutex_lock(embb_adaptive_mutex_t* mutex) {
+  unsigned int spin;
+  unsigned int backoff = 1;
+  unsigned int pause;
+  int state = 0;
+  assert(mutex != NULL);
+  if (embb_atomic_compare_and_swap_explicit_int(&mutex->state, &state, 1,
+      EMBB_MEMORY_ORDER_ACQUIRE)) {
+    return EMBB_SUCCESS;
+  }
+  for (spin = 0; spin < mutex->spin_limit; spin++) {
+    state = embb_atomic_load_explicit_int(&mutex->state,
+      EMBB_MEMORY_ORDER_RELAXED);
+    if (state == 0 &&
+        embb_atomic_compare_and_swap_explicit_int(&mutex->state, &state, 1,
+          EMBB_MEMORY_ORDER_ACQUIRE)) {
+      return EMBB_SUCCESS;
+    }
+    if (state == 2) {
+      /* Others are already sleeping, do not compete with them */
+      break;
+    }
+    for (pause = 0; pause < backoff; pause++) {
+      embb_adaptive_mutex_pause();
+    }
+    if (backoff < EMBB_ADAPTIVE_MUTEX_BACKOFF_LIMIT) {
+      backoff <<= 1;
+    }
+  }
+  /* Mark the mutex as contended, so that the owner wakes us up on unlock.
+     Acquiring it this way leaves the state at 2, which may cause a spurious
+     wake up later but never a lost one. */
+  state = embb_atomic_swap_explicit_int(&mutex->state, 2,
+    EMBB_MEMORY_ORDER_ACQUIRE);
+  while (state != 0) {
+    embb_adaptive_mutex_park(mutex);
+    state = embb_atomic_swap_explicit_int(&mutex->state, 2,
+      EMBB_MEMORY_ORDER_ACQUIRE);
+  }
+  return EMBB_SUCCESS;
+}
+
+int embb_adaptive_mutex_try_lock(embb_adaptive_mutex_t* mutex) {
+  int state = 0;
+  assert(mutex != NULL);
+  if (embb_atomic_compare_and_swap_explicit_int(&mutex->state, &state, 1,
+      EMBB_MEMORY_ORDER_ACQUIRE)) {
+    return EMBB_SUCCESS;
+  }
+  return EMBB_BUSY;
+}
+
+int embb_adaptive_mutex_unlock(embb_adaptive_mutex_t* mutex) {
+  int state;
+  assert(mutex != NULL);
+  state = embb_atomic_swap_explicit_int(&mutex->state, 0,
+    EMBB_MEMORY_ORDER_RELEASE);
+  if (state == 0) {
+    return EMBB_ERROR;
+  }
+  if (state == 2) {
+    embb_adaptive_mutex_unpark(mutex);
+  }
+  return EMBB_SUCCESS;
+}
+
+void embb_adaptive_mutex_destroy(embb_adaptive_mutex_t* mutex) {
+  assert(mutex != NULL);
+  assert(embb_atomic_load_int(&mutex->state) == 0);
+#ifdef EMBB_PLATFORM_HAS_HEADER_FUTEX
+  EMBB_UNUSED_IN_RELEASE(mutex);
+#else
+  embb_condition_destroy(&mutex->park_condition);
+  embb_mutex_destroy(&mutex->park_mutex);
+#endif
+}
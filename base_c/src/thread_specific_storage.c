@@ -38,8 +38,15 @@ int embb_tss_create(embb_tss_t* tss) {
   if (tss->values == NULL) {
     return EMBB_NOMEM;
   }
+  tss->generations = (unsigned int*) embb_alloc_cache_aligned(
+    tss->size * sizeof(unsigned int));
+  if (tss->generations == NULL) {
+    embb_free_aligned(tss->values);
+    return EMBB_NOMEM;
+  }
   for (unsigned int i = 0; i < tss->size; i++) {
     tss->values[i] = NULL;
+    tss->generations[i] = 0;
   }
   return EMBB_SUCCESS;
 }
@@ -47,11 +54,13 @@ int embb_tss_create(embb_tss_t* tss) {
 int embb_tss_set(embb_tss_t* tss, void* value) {
   assert(tss != NULL);
   unsigned int index = 0;
-  int status = embb_internal_thread_index(&index);
+  unsigned int generation = 0;
+  int status = embb_internal_thread_index_and_generation(&index, &generation);
   if ((status != EMBB_SUCCESS) || (index >= tss->size)) {
     return EMBB_ERROR;
   }
   tss->values[index] = value;
+  tss->generations[index] = generation;
   return EMBB_SUCCESS;
 }
 
@@ -59,14 +68,20 @@ void* embb_tss_get(const embb_tss_t* tss) {
   assert(tss != NULL);
   assert(tss->values != NULL);
   unsigned int index = 0;
-  int status = embb_internal_thread_index(&index);
+  unsigned int generation = 0;
+  int status = embb_internal_thread_index_and_generation(&index, &generation);
   if ((status != EMBB_SUCCESS) || (index >= tss->size)) {
     return NULL;
   }
+  /* The slot may have been set by a thread that held the index before */
+  if (tss->generations[index] != generation) {
+    return NULL;
+  }
   return tss->values[index];
 }
 
 void embb_tss_delete(embb_tss_t* tss) {
   assert(tss != NULL);
   embb_free_aligned(tss->values);
+  embb_free_aligned(tss->generations);
 }
@@ -43,6 +43,13 @@ MutexTest::MutexTest() : counter_(0),
       .Post(&MutexTest::PostMutexInc, this);
   CreateUnit("Recursive mutex")
       .Add(&MutexTest::TestRecursiveMutex, this);
+  CreateUnit("Adaptive mutex protected counter")
+      .Pre(&MutexTest::PreAdaptiveMutexInc, this)
+      .Add(&MutexTest::TestAdaptiveMutexInc, this, number_threads_,
+          number_iterations_)
+      .Post(&MutexTest::PostAdaptiveMutexInc, this);
+  CreateUnit("Adaptive mutex try lock")
+      .Add(&MutexTest::TestAdaptiveMutexTryLock, this);
 }
 
 void MutexTest::PreMutexInc() {
@@ -76,6 +83,45 @@ void MutexTest::TestRecursiveMutex() {
   embb_mutex_destroy(&mutex);
 }
 
+void MutexTest::PreAdaptiveMutexInc() {
+  counter_ = 0;
+  int status = embb_adaptive_mutex_init(&adaptive_mutex_);
+  PT_ASSERT_EQ(status, EMBB_SUCCESS);
+}
+
+void MutexTest::TestAdaptiveMutexInc() {
+  int status = embb_adaptive_mutex_lock(&adaptive_mutex_);
+  PT_EXPECT_EQ(status, EMBB_SUCCESS);
+  ++counter_;
+  status = embb_adaptive_mutex_unlock(&adaptive_mutex_);
+  PT_EXPECT_EQ(status, EMBB_SUCCESS);
+}
+
+void MutexTest::PostAdaptiveMutexInc() {
+  PT_EXPECT_EQ(counter_, number_iterations_ * number_threads_);
+  embb_adaptive_mutex_destroy(&adaptive_mutex_);
+}
+
+void MutexTest::TestAdaptiveMutexTryLock() {
+  embb_adaptive_mutex_t mutex;
+  int status = embb_adaptive_mutex_init(&mutex);
+  PT_ASSERT_EQ(status, EMBB_SUCCESS);
+  status = embb_adaptive_mutex_try_lock(&mutex);
+  PT_EXPECT_EQ(status, EMBB_SUCCESS);
+  // Adaptive mutexes are not recursive
+  status = embb_adaptive_mutex_try_lock(&mutex);
+  PT_EXPECT_EQ(status, EMBB_BUSY);
+  status = embb_adaptive_mutex_unlock(&mutex);
+  PT_EXPECT_EQ(status, EMBB_SUCCESS);
+  status = embb_adaptive_mutex_lock(&mutex);
+  PT_EXPECT_EQ(status, EMBB_SUCCESS);
+  status = embb_adaptive_mutex_try_lock(&mutex);
+  PT_EXPECT_EQ(status, EMBB_BUSY);
+  status = embb_adaptive_mutex_unlock(&mutex);
+  PT_EXPECT_EQ(status, EMBB_SUCCESS);
+  embb_adaptive_mutex_destroy(&mutex);
+}
+
 } // namespace test
 } // namespace base
 } // namespace embb
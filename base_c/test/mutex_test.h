@@ -64,11 +64,34 @@ class MutexTest : public partest::TestCase {
    */
   void TestRecursiveMutex();
 
+  /**
+   * Prepares TestAdaptiveMutexInc.
+   */
+  void PreAdaptiveMutexInc();
+  /**
+   * Tests adaptive mutex locking and unlocking to protect shared counter.
+   */
+  void TestAdaptiveMutexInc();
+  /**
+   * Checks and tears down TestAdaptiveMutexInc.
+   */
+  void PostAdaptiveMutexInc();
+
+  /**
+   * Tests trying to lock an adaptive mutex.
+   */
+  void TestAdaptiveMutexTryLock();
+
   /**
    * Mutex for tests.
    */
   embb_mutex_t mutex_;
 
+  /**
+   * Adaptive mutex for tests.
+   */
+  embb_adaptive_mutex_t adaptive_mutex_;
+
   /**
    * Shared counter to check effectiveness of mutex.
    */
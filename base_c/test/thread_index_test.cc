@@ -41,6 +41,7 @@ ThreadIndexTest::ThreadIndexTest()
   CreateUnit("Test 0 indices").Add(&ThreadIndexTest::Test0, this);
   CreateUnit("Test 1 index").Add(&ThreadIndexTest::Test1, this);
   CreateUnit("Test N indices").Add(&ThreadIndexTest::TestN, this, 1);
+  CreateUnit("Test index reuse").Add(&ThreadIndexTest::TestReuse, this);
 }
 
 void ThreadIndexTest::Test0() {
@@ -68,8 +69,9 @@ void ThreadIndexTest::Test1() {
     embb_thread_join(&thread, NULL);
   }
   {
+    // The index of the first thread was released on its exit
     embb_thread_t thread;
-    bool index_available = false;
+    bool index_available = true;
     int status =
       embb_thread_create(&thread, NULL, ThreadStart, &index_available);
     PT_EXPECT_EQ(status, EMBB_SUCCESS);
@@ -99,8 +101,9 @@ void ThreadIndexTest::TestN() {
     int status = embb_thread_join(threads + i, NULL);
     PT_EXPECT_EQ(status, EMBB_SUCCESS);
   }
+  // The indices of the joined threads can be reused
   embb_thread_t thread;
-  bool index_available = false;
+  bool index_available = true;
   int status = embb_thread_create(&thread, NULL, ThreadStart, &index_available);
   PT_EXPECT_EQ(status, EMBB_SUCCESS);
   embb_thread_join(&thread, NULL);
@@ -108,6 +111,76 @@ void ThreadIndexTest::TestN() {
   embb_internal_thread_index_set_max(old_max);
 }
 
+embb_atomic_int holding = { 0 };
+embb_atomic_int hold = { 0 };
+
+int HoldingThreadStart(void* arg) {
+  embb_tss_t* tss = static_cast<embb_tss_t*>(arg);
+  unsigned int index = UINT_MAX;
+  PT_EXPECT_EQ(embb_internal_thread_index(&index), EMBB_SUCCESS);
+  PT_EXPECT_EQ(index, 0u);
+  PT_EXPECT_EQ(embb_tss_set(tss, tss), EMBB_SUCCESS);
+  embb_atomic_store_int(&holding, 1);
+  while (embb_atomic_load_int(&hold) == 1) { embb_thread_yield(); }
+  return 0;
+}
+
+int ReusingThreadStart(void* arg) {
+  embb_tss_t* tss = static_cast<embb_tss_t*>(arg);
+  unsigned int index = UINT_MAX;
+  unsigned int generation = 0;
+  PT_EXPECT_EQ(
+    embb_internal_thread_index_and_generation(&index, &generation),
+    EMBB_SUCCESS);
+  PT_EXPECT_EQ(index, 0u);
+  PT_EXPECT_NE(generation, 0u);
+  // The value set by the previous holder of the index is not visible
+  PT_EXPECT(embb_tss_get(tss) == NULL);
+
+  // An explicitly released index is obtained again with a new generation
+  unsigned int next_generation = 0;
+  embb_internal_thread_index_release();
+  PT_EXPECT_EQ(
+    embb_internal_thread_index_and_generation(&index, &next_generation),
+    EMBB_SUCCESS);
+  PT_EXPECT_EQ(index, 0u);
+  PT_EXPECT_NE(next_generation, generation);
+  return 0;
+}
+
+void ThreadIndexTest::TestReuse() {
+  embb_internal_thread_index_reset();
+  unsigned int old_max = embb_thread_get_max_count();
+  embb_internal_thread_index_set_max(1);
+  embb_tss_t tss;
+  PT_ASSERT_EQ(embb_tss_create(&tss), EMBB_SUCCESS);
+
+  embb_atomic_store_int(&holding, 0);
+  embb_atomic_store_int(&hold, 1);
+  embb_thread_t holder;
+  int status = embb_thread_create(&holder, NULL, HoldingThreadStart, &tss);
+  PT_EXPECT_EQ(status, EMBB_SUCCESS);
+  while (embb_atomic_load_int(&holding) == 0) { embb_thread_yield(); }
+  {
+    // The only index is held by a running thread
+    embb_thread_t thread;
+    bool index_available = false;
+    status = embb_thread_create(&thread, NULL, ThreadStart, &index_available);
+    PT_EXPECT_EQ(status, EMBB_SUCCESS);
+    embb_thread_join(&thread, NULL);
+  }
+  embb_atomic_store_int(&hold, 0);
+  embb_thread_join(&holder, NULL);
+
+  embb_thread_t thread;
+  status = embb_thread_create(&thread, NULL, ReusingThreadStart, &tss);
+  PT_EXPECT_EQ(status, EMBB_SUCCESS);
+  embb_thread_join(&thread, NULL);
+
+  embb_tss_delete(&tss);
+  embb_internal_thread_index_set_max(old_max);
+}
+
 int ThreadStart(void* arg) {
   assert(arg != NULL);
   unsigned int index = UINT_MAX;
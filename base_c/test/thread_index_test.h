@@ -56,6 +56,11 @@ class ThreadIndexTest : public partest::TestCase {
    */
   void TestN();
 
+  /**
+   * Tests that indices of exited threads are reused.
+   */
+  void TestReuse();
+
  private:
   /**
    * Configurable number of threads (and indices) used in TestN().
@@ -28,12 +28,17 @@
 #include <embb/base/c/internal/thread_index.h>
 #include <embb/base/c/thread.h>
 #include <embb/base/c/errors.h>
+#include <embb/base/c/atomic.h>
 #include <iostream>
 
 namespace embb {
 namespace base {
 namespace test {
 
+// Threads wait for each other before exiting, so that they hold distinct
+// thread indices (indices of exited threads are reused).
+static embb_atomic_int arrived_threads = { 0 };
+
 ThreadSpecificStorageTest::ThreadSpecificStorageTest()
     : tss_(), number_threads_(partest::TestSuite::GetDefaultNumThreads()) {
   embb_tss_create(&tss_);
@@ -56,6 +61,11 @@ void ThreadSpecificStorageTest::Test() {
     size_t stored_rank = *static_cast<size_t*>(value);
     PT_EXPECT_EQ(rank, stored_rank);
   }
+  embb_atomic_fetch_and_add_int(&arrived_threads, 1);
+  while (embb_atomic_load_int(&arrived_threads) <
+         static_cast<int>(number_threads_)) {
+    embb_thread_yield();
+  }
 }
 
 void ThreadSpecificStorageTest::Post() {
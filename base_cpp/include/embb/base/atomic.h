@@ -32,6 +32,7 @@
 #include <cassert>
 #include <utility>
 
+#include <embb/base/memory_order.h>
 #include <embb/base/internal/atomic/atomic_base.h>
 #include <embb/base/internal/atomic/atomic_pointer.h>
 #include <embb/base/internal/atomic/atomic_integer.h>
@@ -50,8 +51,10 @@ namespace base {
 /**
  * Class representing atomic variables.
  *
- * The current implementation guarantees sequential consistency (full fences)
- * for all atomic operations. Relaxed memory models may be added in the future.
+ * Operations without a MemoryOrder parameter are sequentially consistent
+ * (full fences). The overloads of Load(), Store(), Swap(), CompareAndSwap(),
+ * FetchAndAdd(), and FetchAndSub() taking a MemoryOrder only enforce the
+ * ordering constraints requested.
  *
  * \tparam BaseType Underlying type
  * \ingroup CPP_BASE_ATOMIC
@@ -169,6 +172,22 @@ class Atomic {
    */
   void Store(BaseType val);
 
+  /**
+   * Store operation with explicit memory order.
+   *
+   * Stores the passed value in the object. Acquire semantics are ignored,
+   * i.e., kMemoryOrderAcquire and kMemoryOrderAcqRel are treated as
+   * kMemoryOrderRelease.
+   *
+   * \waitfree
+   *
+   * \param val Value to be stored
+   * \param order Memory order of the operation
+   *
+   * \see Load(MemoryOrder) const
+   */
+  void Store(BaseType val, MemoryOrder order);
+
   /**
    * Load operation.
    *
@@ -182,6 +201,23 @@ class Atomic {
    */
   BaseType Load() const;
 
+  /**
+   * Load operation with explicit memory order.
+   *
+   * Loads and returns the stored value. Release semantics are ignored, i.e.,
+   * kMemoryOrderRelease and kMemoryOrderAcqRel are treated as
+   * kMemoryOrderAcquire.
+   *
+   * \waitfree
+   *
+   * \param order Memory order of the operation
+   *
+   * \return Stored value
+   *
+   * \see Store(BaseType, MemoryOrder)
+   */
+  BaseType Load(MemoryOrder order) const;
+
   /**
    * Swap operation.
    *
@@ -197,6 +233,20 @@ class Atomic {
    */
   BaseType Swap(BaseType val);
 
+  /**
+   * Swap operation with explicit memory order.
+   *
+   * Stores the given value in the object and returns the old value.
+   *
+   * \waitfree
+   *
+   * \param val New value
+   * \param order Memory order of the operation
+   *
+   * \return Old value
+   */
+  BaseType Swap(BaseType val, MemoryOrder order);
+
   /**
    * Compare-and-Swap operation (CAS).
    *
@@ -214,6 +264,24 @@ class Atomic {
    */
   bool CompareAndSwap(BaseType& expected, BaseType desired);
 
+  /**
+   * Compare-and-Swap operation (CAS) with explicit memory order.
+   *
+   * Stores \c desired if the current value is equal to \c expected.
+   * Otherwise, stores the current value in \c expected. If the operation
+   * fails, it has at most acquire semantics.
+   *
+   * \waitfree
+   *
+   * \param expected Expected value
+   * \param desired Desired value
+   * \param order Memory order of the operation
+   *
+   * \return \c true if CAS succeeded, otherwise \c false
+   */
+  bool CompareAndSwap(BaseType& expected, BaseType desired,
+    MemoryOrder order);
+
   /** @name Arithmetic members
    *
    * The following members are only available if \c BaseType supports arithmetic
@@ -238,6 +306,20 @@ class Atomic {
    */
   BaseType FetchAndAdd(BaseType val);
 
+  /**
+   * Fetch-and-Add operation with explicit memory order.
+   *
+   * Adds the passed value and returns the old value.
+   *
+   * \waitfree
+   *
+   * \param val Addend
+   * \param order Memory order of the operation
+   *
+   * \return Old value
+   */
+  BaseType FetchAndAdd(BaseType val, MemoryOrder order);
+
   /**
    * Fetch-and-Sub operation.
    *
@@ -253,6 +335,20 @@ class Atomic {
    */
   BaseType FetchAndSub(BaseType val);
 
+  /**
+   * Fetch-and-Sub operation with explicit memory order.
+   *
+   * Subtracts the passed value and returns the old value.
+   *
+   * \waitfree
+   *
+   * \param val Subtrahend
+   * \param order Memory order of the operation
+   *
+   * \return Old value
+   */
+  BaseType FetchAndSub(BaseType val, MemoryOrder order);
+
   /**
    * Post-increment operation.
    *
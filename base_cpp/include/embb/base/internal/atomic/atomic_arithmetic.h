@@ -70,7 +70,9 @@ class AtomicArithmetic : public AtomicBase<BaseType> {
 
   // The methods below are documented in atomic.h
   BaseType FetchAndAdd(DifferenceType val);
+  BaseType FetchAndAdd(DifferenceType val, MemoryOrder order);
   BaseType FetchAndSub(DifferenceType val);
+  BaseType FetchAndSub(DifferenceType val, MemoryOrder order);
   BaseType operator++(int);
   BaseType operator--(int);
   BaseType operator++();
@@ -130,6 +132,29 @@ FetchAndSub(DifferenceType val) {
   return FetchAndAdd(-val);
 }
 
+template<typename BaseType, typename DifferenceType, size_t Stride>
+inline BaseType AtomicArithmetic<BaseType, DifferenceType, Stride>::
+FetchAndAdd(DifferenceType val, MemoryOrder order) {
+  BaseType return_value;
+  DifferenceType desired = static_cast<DifferenceType>(Stride)*val;
+
+  NativeType native_desired;
+  memcpy(&native_desired, &desired, sizeof(desired));
+
+  NativeType storage_value = fetch_and_add_explicit_implementation<NativeType>::
+    fetch_and_add(&this->AtomicValue, native_desired,
+      static_cast<embb_memory_order>(order));
+
+  memcpy(&return_value, &storage_value, sizeof(return_value));
+  return return_value;
+}
+
+template<typename BaseType, typename DifferenceType, size_t Stride>
+inline BaseType AtomicArithmetic<BaseType, DifferenceType, Stride>::
+FetchAndSub(DifferenceType val, MemoryOrder order) {
+  return FetchAndAdd(-val, order);
+}
+
 template<typename BaseType, typename DifferenceType, size_t Stride>
 inline BaseType AtomicArithmetic<BaseType, DifferenceType, Stride>::
 operator++(int) {
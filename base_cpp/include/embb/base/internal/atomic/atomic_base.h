@@ -36,6 +36,7 @@
 
 #include <embb/base/internal/atomic/atomic_utility.h>
 #include <embb/base/internal/atomic/atomic_implementation.h>
+#include <embb/base/memory_order.h>
 
 namespace embb {
 namespace base {
@@ -81,9 +82,14 @@ class AtomicBase {
   bool IsInteger() const;
   bool IsPointer() const;
   void Store(BaseType val);
+  void Store(BaseType val, MemoryOrder order);
   BaseType Load() const;
+  BaseType Load(MemoryOrder order) const;
   BaseType Swap(BaseType val);
+  BaseType Swap(BaseType val, MemoryOrder order);
   bool CompareAndSwap(BaseType& expected, BaseType desired);
+  bool CompareAndSwap(BaseType& expected, BaseType desired,
+    MemoryOrder order);
 };
 
 template<typename BaseType>
@@ -136,6 +142,16 @@ inline void AtomicBase<BaseType>::Store(BaseType val) {
     ::Store(&AtomicValue, storage_value);
 }
 
+template<typename BaseType>
+inline void AtomicBase<BaseType>::Store(BaseType val, MemoryOrder order) {
+  NativeType storage_value;
+  memcpy(&storage_value, &val, sizeof(storage_value));
+
+  store_explicit_implementation< NativeType >
+    ::Store(&AtomicValue, storage_value,
+      static_cast<embb_memory_order>(order));
+}
+
 template<typename BaseType>
 inline BaseType AtomicBase<BaseType>::Load() const {
   BaseType return_value;
@@ -148,6 +164,19 @@ inline BaseType AtomicBase<BaseType>::Load() const {
   return return_value;
 }
 
+template<typename BaseType>
+inline BaseType AtomicBase<BaseType>::Load(MemoryOrder order) const {
+  BaseType return_value;
+
+  NativeType storage_value =
+    load_explicit_implementation< NativeType >::Load(&AtomicValue,
+      static_cast<embb_memory_order>(order));
+
+  memcpy(&return_value, &storage_value, sizeof(return_value));
+
+  return return_value;
+}
+
 template<typename BaseType>
 inline BaseType AtomicBase<BaseType>::Swap(BaseType val) {
   NativeType storage_value;
@@ -163,6 +192,22 @@ inline BaseType AtomicBase<BaseType>::Swap(BaseType val) {
   return return_value;
 }
 
+template<typename BaseType>
+inline BaseType AtomicBase<BaseType>::Swap(BaseType val, MemoryOrder order) {
+  NativeType storage_value;
+  BaseType return_value;
+
+  memcpy(&storage_value, &val, sizeof(storage_value));
+
+  NativeType storage_value2 = swap_explicit_implementation< NativeType >
+    ::Swap(&AtomicValue, storage_value,
+      static_cast<embb_memory_order>(order));
+
+  memcpy(&return_value, &storage_value2, sizeof(return_value));
+
+  return return_value;
+}
+
 template<typename BaseType>
 inline bool AtomicBase<BaseType>::
 CompareAndSwap(BaseType& expected, BaseType desired) {
@@ -183,6 +228,30 @@ CompareAndSwap(BaseType& expected, BaseType desired) {
   return return_val;
 }
 
+template<typename BaseType>
+inline bool AtomicBase<BaseType>::
+CompareAndSwap(BaseType& expected, BaseType desired, MemoryOrder order) {
+  NativeType native_expected;
+  NativeType native_desired;
+
+  memcpy(&native_expected, &expected, sizeof(expected));
+  memcpy(&native_desired, &desired, sizeof(desired));
+
+  bool return_val =
+    (compare_and_swap_explicit_implementation<NativeType>::
+    compare_and_swap(&AtomicValue, &native_expected, native_desired,
+      static_cast<embb_memory_order>(order))) != 0
+    ? true : false;
+
+  // On failure, the native implementation already returned the current value
+  // in native_expected, so another (sequentially consistent) load is not
+  // needed.
+  if (!return_val)
+    memcpy(&expected, &native_expected, sizeof(expected));
+
+  return return_val;
+}
+
 }  // namespace atomic
 }  // namespace internal
 }  // namespace base
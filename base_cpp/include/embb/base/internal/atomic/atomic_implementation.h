@@ -181,6 +181,91 @@ public: \
     } \
 };
 
+/**
+ * \def EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_VAL_PAR1_POINTER_PAR2_ORDER
+ * Same as EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_VAL_PAR1_POINTER, with an
+ * additional memory order parameter.
+ */
+#define EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_VAL_PAR1_POINTER_PAR2_ORDER\
+(SIZE, IMPLEMENTATION_CLASS, IMPLEMENTATION_METHOD, NATIVE_PREFIX) \
+template<> \
+class IMPLEMENTATION_CLASS< EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, SIZE) > \
+{ \
+public: \
+    static inline EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, SIZE) \
+    IMPLEMENTATION_METHOD(\
+    EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, SIZE) * par1, \
+    embb_memory_order order) \
+    { \
+    return EMBB_CAT2(NATIVE_PREFIX, SIZE)(par1, order); \
+    } \
+};
+
+/**
+ * \def EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_VAL_PAR1_POINTER_PAR2_VALUE_PAR3_ORDER
+ * Same as EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_VAL_PAR1_POINTER_PAR2_VALUE,
+ * with an additional memory order parameter.
+ */
+#define EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_VAL_PAR1_POINTER_PAR2_VALUE_PAR3_ORDER\
+(SIZE, IMPLEMENTATION_CLASS, IMPLEMENTATION_METHOD, NATIVE_PREFIX) \
+template<> \
+class IMPLEMENTATION_CLASS< EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, SIZE) > \
+{ \
+public: \
+    static inline EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, SIZE) \
+    IMPLEMENTATION_METHOD(\
+    EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, SIZE) * par1, \
+    EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, SIZE) par2, \
+    embb_memory_order order) \
+    { \
+    return EMBB_CAT2(NATIVE_PREFIX, SIZE)(par1, par2, order); \
+    } \
+};
+
+/**
+ * \def EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_INT_PAR1_POINTER_PAR2_POINTER_PAR3_VAL_PAR4_ORDER
+ * Same as
+ * EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_INT_PAR1_POINTER_PAR2_POINTER_PAR3_VAL,
+ * with an additional memory order parameter.
+ */
+#define EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_INT_PAR1_POINTER_PAR2_POINTER_PAR3_VAL_PAR4_ORDER\
+(SIZE, IMPLEMENTATION_CLASS, IMPLEMENTATION_METHOD, NATIVE_PREFIX) \
+template<> \
+class IMPLEMENTATION_CLASS< EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, SIZE) > \
+{ \
+public: \
+    static inline int \
+    IMPLEMENTATION_METHOD(\
+    EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, SIZE) * par1, \
+    EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, SIZE) * par2, \
+    EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, SIZE) par3, \
+    embb_memory_order order) \
+    { \
+      return EMBB_CAT2(NATIVE_PREFIX, SIZE)(par1, par2, par3, order); \
+    } \
+};
+
+/**
+ * \def EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_VOID_PAR1_POINTER_PAR2_VAL_PAR3_ORDER
+ * Same as EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_VOID_PAR1_POINTER_PAR2_VAL,
+ * with an additional memory order parameter.
+ */
+#define EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_VOID_PAR1_POINTER_PAR2_VAL_PAR3_ORDER\
+(SIZE, IMPLEMENTATION_CLASS, IMPLEMENTATION_METHOD, NATIVE_PREFIX) \
+template<> \
+class IMPLEMENTATION_CLASS< EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, SIZE) > \
+{ \
+public: \
+    static inline void \
+    IMPLEMENTATION_METHOD(\
+    EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, SIZE) * par1, \
+    EMBB_CAT2(EMBB_BASE_BASIC_TYPE_SIZE_, SIZE) par2, \
+    embb_memory_order order) \
+    { \
+    EMBB_CAT2(NATIVE_PREFIX, SIZE)(par1, par2, order); \
+    } \
+};
+
 namespace embb {
 namespace base {
 namespace internal {
@@ -295,6 +380,71 @@ EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_VAL_PAR1_POINTER_PAR2_VALUE
 (8, swap_implementation, Swap, embb_internal__atomic_swap_)
 #endif
 
+// load_explicit_implementation
+EMBB_ATOMIC_GENERAL_TEMPLATE(load_explicit_implementation)
+EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_VAL_PAR1_POINTER_PAR2_ORDER
+(1, load_explicit_implementation, Load, embb_internal__atomic_load_explicit_)
+EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_VAL_PAR1_POINTER_PAR2_ORDER
+(2, load_explicit_implementation, Load, embb_internal__atomic_load_explicit_)
+EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_VAL_PAR1_POINTER_PAR2_ORDER
+(4, load_explicit_implementation, Load, embb_internal__atomic_load_explicit_)
+#ifdef EMBB_64_BIT_ATOMIC_AVAILABLE
+EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_VAL_PAR1_POINTER_PAR2_ORDER
+(8, load_explicit_implementation, Load, embb_internal__atomic_load_explicit_)
+#endif
+
+// store_explicit_implementation
+EMBB_ATOMIC_GENERAL_TEMPLATE(store_explicit_implementation)
+EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_VOID_PAR1_POINTER_PAR2_VAL_PAR3_ORDER
+(1, store_explicit_implementation, Store, embb_internal__atomic_store_explicit_)
+EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_VOID_PAR1_POINTER_PAR2_VAL_PAR3_ORDER
+(2, store_explicit_implementation, Store, embb_internal__atomic_store_explicit_)
+EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_VOID_PAR1_POINTER_PAR2_VAL_PAR3_ORDER
+(4, store_explicit_implementation, Store, embb_internal__atomic_store_explicit_)
+#ifdef EMBB_64_BIT_ATOMIC_AVAILABLE
+EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_VOID_PAR1_POINTER_PAR2_VAL_PAR3_ORDER
+(8, store_explicit_implementation, Store, embb_internal__atomic_store_explicit_)
+#endif
+
+// swap_explicit_implementation
+EMBB_ATOMIC_GENERAL_TEMPLATE(swap_explicit_implementation)
+EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_VAL_PAR1_POINTER_PAR2_VALUE_PAR3_ORDER
+(1, swap_explicit_implementation, Swap, embb_internal__atomic_swap_explicit_)
+EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_VAL_PAR1_POINTER_PAR2_VALUE_PAR3_ORDER
+(2, swap_explicit_implementation, Swap, embb_internal__atomic_swap_explicit_)
+EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_VAL_PAR1_POINTER_PAR2_VALUE_PAR3_ORDER
+(4, swap_explicit_implementation, Swap, embb_internal__atomic_swap_explicit_)
+#ifdef EMBB_64_BIT_ATOMIC_AVAILABLE
+EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_VAL_PAR1_POINTER_PAR2_VALUE_PAR3_ORDER
+(8, swap_explicit_implementation, Swap, embb_internal__atomic_swap_explicit_)
+#endif
+
+// fetch_and_add_explicit_implementation
+EMBB_ATOMIC_GENERAL_TEMPLATE(fetch_and_add_explicit_implementation)
+EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_VAL_PAR1_POINTER_PAR2_VALUE_PAR3_ORDER
+(1, fetch_and_add_explicit_implementation, fetch_and_add, embb_internal__atomic_fetch_and_add_explicit_)
+EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_VAL_PAR1_POINTER_PAR2_VALUE_PAR3_ORDER
+(2, fetch_and_add_explicit_implementation, fetch_and_add, embb_internal__atomic_fetch_and_add_explicit_)
+EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_VAL_PAR1_POINTER_PAR2_VALUE_PAR3_ORDER
+(4, fetch_and_add_explicit_implementation, fetch_and_add, embb_internal__atomic_fetch_and_add_explicit_)
+#ifdef EMBB_64_BIT_ATOMIC_AVAILABLE
+EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_VAL_PAR1_POINTER_PAR2_VALUE_PAR3_ORDER
+(8, fetch_and_add_explicit_implementation, fetch_and_add, embb_internal__atomic_fetch_and_add_explicit_)
+#endif
+
+// compare_and_swap_explicit_implementation
+EMBB_ATOMIC_GENERAL_TEMPLATE(compare_and_swap_explicit_implementation)
+EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_INT_PAR1_POINTER_PAR2_POINTER_PAR3_VAL_PAR4_ORDER
+(1, compare_and_swap_explicit_implementation, compare_and_swap, embb_internal__atomic_compare_and_swap_explicit_)
+EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_INT_PAR1_POINTER_PAR2_POINTER_PAR3_VAL_PAR4_ORDER
+(2, compare_and_swap_explicit_implementation, compare_and_swap, embb_internal__atomic_compare_and_swap_explicit_)
+EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_INT_PAR1_POINTER_PAR2_POINTER_PAR3_VAL_PAR4_ORDER
+(4, compare_and_swap_explicit_implementation, compare_and_swap, embb_internal__atomic_compare_and_swap_explicit_)
+#ifdef EMBB_64_BIT_ATOMIC_AVAILABLE
+EMBB_ATOMIC_IMPLEMENTATION_FOR_SIZE_RET_INT_PAR1_POINTER_PAR2_POINTER_PAR3_VAL_PAR4_ORDER
+(8, compare_and_swap_explicit_implementation, compare_and_swap, embb_internal__atomic_compare_and_swap_explicit_)
+#endif
+
 }  // namespace atomic
 }  // namespace internal
 }  // namespace base
@@ -28,7 +28,6 @@
 #define EMBB_BASE_INTERNAL_THREAD_SPECIFIC_STORAGE_INL_H_
 
 #include <embb/base/c/thread_specific_storage.h>
-#include <embb/base/c/internal/unused.h>
 #include <embb/base/memory_allocation.h>
 
 #include <cassert>
@@ -38,32 +37,25 @@ namespace base {
 
 template<typename Type>
 ThreadSpecificStorage<Type>::ThreadSpecificStorage()
-    : rep_(), usage_flags_(NULL) {
-  Prepare();
-  for (unsigned int i = 0; i < rep_.size; i++) {
-    rep_.values[i] = Allocation::New<Type>();
-  }
+    : rep_(), usage_flags_(NULL), factory_(NULL) {
+  Prepare(Allocation::New<internal::TssFactoryArg0<Type> >());
 }
 
 template<typename Type>
 template<typename Initializer>
 ThreadSpecificStorage<Type>::ThreadSpecificStorage(Initializer initializer)
-    : rep_(), usage_flags_(NULL) {
-  Prepare();
-  for (unsigned int i = 0; i < rep_.size; i++) {
-    rep_.values[i] = Allocation::New<Type>(initializer);
-  }
+    : rep_(), usage_flags_(NULL), factory_(NULL) {
+  Prepare(Allocation::New<internal::TssFactoryArg1<Type, Initializer> >(
+    initializer));
 }
 
 template<typename Type>
 template<typename Initializer1, typename Initializer2>
 ThreadSpecificStorage<Type>::ThreadSpecificStorage(
     Initializer1 initializer1, Initializer2 initializer2)
-    : rep_(), usage_flags_(NULL) {
-  Prepare();
-  for (unsigned int i = 0; i < rep_.size; i++) {
-    rep_.values[i] = Allocation::New<Type>(initializer1, initializer2);
-  }
+    : rep_(), usage_flags_(NULL), factory_(NULL) {
+  Prepare(Allocation::New<internal::TssFactoryArg2<Type, Initializer1,
+    Initializer2> >(initializer1, initializer2));
 }
 
 template<typename Type>
@@ -71,12 +63,9 @@ template<typename Initializer1, typename Initializer2, typename Initializer3>
 ThreadSpecificStorage<Type>::ThreadSpecificStorage(
     Initializer1 initializer1, Initializer2 initializer2,
     Initializer3 initializer3)
-    : rep_(), usage_flags_(NULL) {
-  Prepare();
-  for (unsigned int i = 0; i < rep_.size; i++) {
-    rep_.values[i] = Allocation::New<Type>(initializer1, initializer2,
-                                           initializer3);
-  }
+    : rep_(), usage_flags_(NULL), factory_(NULL) {
+  Prepare(Allocation::New<internal::TssFactoryArg3<Type, Initializer1,
+    Initializer2, Initializer3> >(initializer1, initializer2, initializer3));
 }
 
 template<typename Type>
@@ -85,12 +74,10 @@ template<typename Initializer1, typename Initializer2, typename Initializer3,
 ThreadSpecificStorage<Type>::ThreadSpecificStorage(
     Initializer1 initializer1, Initializer2 initializer2,
     Initializer3 initializer3, Initializer4 initializer4)
-    : rep_(), usage_flags_(NULL) {
-  Prepare();
-  for (unsigned int i = 0; i < rep_.size; i++) {
-    rep_.values[i] = Allocation::New<Type>(initializer1, initializer2,
-                                           initializer3, initializer4);
-  }
+    : rep_(), usage_flags_(NULL), factory_(NULL) {
+  Prepare(Allocation::New<internal::TssFactoryArg4<Type, Initializer1,
+    Initializer2, Initializer3, Initializer4> >(initializer1, initializer2,
+    initializer3, initializer4));
 }
 
 template<typename Type>
@@ -100,40 +87,52 @@ ThreadSpecificStorage<Type>::~ThreadSpecificStorage() {
     assert(value != NULL);
     Allocation::Delete(value);
   }
+  Allocation::Delete(factory_);
   embb_tss_delete(&rep_);
   Allocation::Free(usage_flags_);
 }
 
 template<typename Type>
 Type& ThreadSpecificStorage<Type>::Get() {
-  Type* value = static_cast<Type*>(embb_tss_get(&rep_));
-  if (value == NULL) {
-    EMBB_THROW(ErrorException, "No thread index could be obtained");
-  }
-  unsigned int thread_index = 0;
-  int status = embb_internal_thread_index(&thread_index);
-  assert(status == EMBB_SUCCESS);
-  EMBB_UNUSED_IN_RELEASE(status);
-  usage_flags_[thread_index] = true;
-  return *value;
+  return *GetSlot();
 }
 
 template<typename Type>
 const Type& ThreadSpecificStorage<Type>::Get() const {
-  const Type* value = static_cast<Type*>(embb_tss_get(&rep_));
-  if (value == NULL) {
+  return *GetSlot();
+}
+
+template<typename Type>
+Type* ThreadSpecificStorage<Type>::GetSlot() const {
+  unsigned int thread_index = 0;
+  unsigned int generation = 0;
+  int status = embb_internal_thread_index_and_generation(
+    &thread_index, &generation);
+  if (status != EMBB_SUCCESS || thread_index >= rep_.size) {
     EMBB_THROW(ErrorException, "No thread index could be obtained");
   }
-  unsigned int thread_index = 0;
-  int status = embb_internal_thread_index(&thread_index);
-  assert(status == EMBB_SUCCESS);
-  EMBB_UNUSED_IN_RELEASE(status);
+  Type* value = static_cast<Type*>(rep_.values[thread_index]);
+  // Like embb_tss_get(), the slot is tagged with the generation of the
+  // thread index that used it. Generation 0 marks an unused slot, which
+  // still holds its initial object.
+  if (rep_.generations[thread_index] != generation) {
+    if (rep_.generations[thread_index] != 0) {
+      // The slot was used by a thread that held the index before
+      Type* fresh_value = factory_->Create();
+      Allocation::Delete(value);
+      value = fresh_value;
+      rep_.values[thread_index] = value;
+    }
+    rep_.generations[thread_index] = generation;
+  }
   usage_flags_[thread_index] = true;
-  return *value;
+  return value;
 }
 
 template<typename Type>
-void ThreadSpecificStorage<Type>::Prepare() {
+void ThreadSpecificStorage<Type>::Prepare(
+  internal::TssFactory<Type>* factory) {
+  factory_ = factory;
   int status = embb_tss_create(&rep_);
   if (status == EMBB_NOMEM) {
     EMBB_THROW(NoMemoryException, "Not enough memory to allocate "
@@ -144,6 +143,9 @@ void ThreadSpecificStorage<Type>::Prepare() {
   for (unsigned int i = 0; i < rep_.size; i++) {
     usage_flags_[i] = false;
   }
+  for (unsigned int i = 0; i < rep_.size; i++) {
+    rep_.values[i] = factory_->Create();
+  }
 }
 
 } // namespace base
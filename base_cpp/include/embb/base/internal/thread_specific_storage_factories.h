@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+#ifndef EMBB_BASE_INTERNAL_THREAD_SPECIFIC_STORAGE_FACTORIES_H_
+#define EMBB_BASE_INTERNAL_THREAD_SPECIFIC_STORAGE_FACTORIES_H_
+
+#include <embb/base/memory_allocation.h>
+
+namespace embb {
+namespace base {
+namespace internal {
+
+/**
+ * Creates the objects of thread-specific storage slots.
+ *
+ * Keeps the constructor arguments given to the TSS, so that slots reused by
+ * another thread are constructed the same way as the initial ones.
+ */
+template<typename Type>
+struct TssFactory {
+  virtual ~TssFactory() {}
+
+  virtual Type* Create() const = 0;
+};
+
+/**
+ * TSS factory for objects constructed without arguments.
+ */
+template<typename Type>
+struct TssFactoryArg0 : public TssFactory<Type> {
+  virtual Type* Create() const {
+    return Allocation::New<Type>();
+  }
+};
+
+/**
+ * TSS factory for objects constructed with one argument.
+ */
+template<typename Type, typename Arg1>
+struct TssFactoryArg1 : public TssFactory<Type> {
+  Arg1 arg1_;
+
+  virtual Type* Create() const {
+    return Allocation::New<Type>(arg1_);
+  }
+
+  explicit TssFactoryArg1(const Arg1& arg1) : arg1_(arg1) {}
+};
+
+/**
+ * TSS factory for objects constructed with two arguments.
+ */
+template<typename Type, typename Arg1, typename Arg2>
+struct TssFactoryArg2 : public TssFactory<Type> {
+  Arg1 arg1_;
+  Arg2 arg2_;
+
+  virtual Type* Create() const {
+    return Allocation::New<Type>(arg1_, arg2_);
+  }
+
+  TssFactoryArg2(const Arg1& arg1, const Arg2& arg2)
+  : arg1_(arg1), arg2_(arg2) {}
+};
+
+/**
+ * TSS factory for objects constructed with three arguments.
+ */
+template<typename Type, typename Arg1, typename Arg2, typename Arg3>
+struct TssFactoryArg3 : public TssFactory<Type> {
+  Arg1 arg1_;
+  Arg2 arg2_;
+  Arg3 arg3_;
+
+  virtual Type* Create() const {
+    return Allocation::New<Type>(arg1_, arg2_, arg3_);
+  }
+
+  TssFactoryArg3(const Arg1& arg1, const Arg2& arg2, const Arg3& arg3)
+  : arg1_(arg1), arg2_(arg2), arg3_(arg3) {}
+};
+
+/**
+ * TSS factory for objects constructed with four arguments.
+ */
+template<typename Type, typename Arg1, typename Arg2, typename Arg3,
+         typename Arg4>
+struct TssFactoryArg4 : public TssFactory<Type> {
+  Arg1 arg1_;
+  Arg2 arg2_;
+  Arg3 arg3_;
+  Arg4 arg4_;
+
+  virtual Type* Create() const {
+    return Allocation::New<Type>(arg1_, arg2_, arg3_, arg4_);
+  }
+
+  TssFactoryArg4(const Arg1& arg1, const Arg2& arg2, const Arg3& arg3,
+                 const Arg4& arg4)
+  : arg1_(arg1), arg2_(arg2), arg3_(arg3), arg4_(arg4) {}
+};
+
+} // namespace internal
+} // namespace base
+} // namespace embb
+
+#endif  // EMBB_BASE_INTERNAL_THREAD_SPECIFIC_STORAGE_FACTORIES_H_
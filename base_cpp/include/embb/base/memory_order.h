@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_BASE_MEMORY_ORDER_H_
+#define EMBB_BASE_MEMORY_ORDER_H_
+
+#include <embb/base/c/atomic.h>
+
+namespace embb {
+namespace base {
+
+/**
+ * Memory orders that can be passed to the operations of Atomic.
+ *
+ * The orders correspond to those of C++11 (without consume). Operations
+ * without a memory order are sequentially consistent.
+ *
+ * \ingroup CPP_BASE_ATOMIC
+ */
+enum MemoryOrder {
+  /** No ordering constraints, only atomicity is guaranteed */
+  kMemoryOrderRelaxed = EMBB_MEMORY_ORDER_RELAXED,
+  /** Later accesses are not reordered before the operation */
+  kMemoryOrderAcquire = EMBB_MEMORY_ORDER_ACQUIRE,
+  /** Earlier accesses are not reordered after the operation */
+  kMemoryOrderRelease = EMBB_MEMORY_ORDER_RELEASE,
+  /** Both acquire and release */
+  kMemoryOrderAcqRel = EMBB_MEMORY_ORDER_ACQ_REL,
+  /** Acquire and release, plus a single total order of all such operations */
+  kMemoryOrderSeqCst = EMBB_MEMORY_ORDER_SEQ_CST
+};
+
+}  // namespace base
+}  // namespace embb
+
+#endif  // EMBB_BASE_MEMORY_ORDER_H_
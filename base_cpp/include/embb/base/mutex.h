@@ -30,6 +30,7 @@
 #include <embb/base/internal/platform.h>
 #include <embb/base/exceptions.h>
 #include <embb/base/c/counter.h>
+#include <embb/base/c/mutex.h>
 
 namespace embb {
 namespace base {
@@ -247,6 +248,83 @@ class RecursiveMutex : public internal::MutexBase {
   RecursiveMutex& operator=(const RecursiveMutex&);
 };
 
+/**
+ * Non-recursive, exclusive mutex for short critical sections.
+ *
+ * A thread trying to lock an adaptive mutex that is held by another thread
+ * first spins with exponential backoff for a bounded number of rounds and is
+ * only put to sleep if the mutex is still locked afterwards. Locking and
+ * unlocking an uncontended adaptive mutex does not involve the operating
+ * system. There is no guarantee of fairness. An adaptive mutex can be used
+ * wherever a Mutex is expected by LockGuard or UniqueLock, but not with
+ * ConditionVariable. It cannot be copied or assigned.
+ *
+ * \see Mutex
+ * \ingroup CPP_BASE_MUTEX
+ */
+class AdaptiveMutex {
+ public:
+  /**
+   * Creates an adaptive mutex which is in unlocked state.
+   *
+   * \throws ErrorException if the mutex could not be initialized
+   * \memory Potentially allocates dynamic memory
+   * \notthreadsafe
+   */
+  AdaptiveMutex();
+
+  /**
+   * Destroys the mutex.
+   *
+   * \pre The mutex is unlocked
+   * \notthreadsafe
+   */
+  ~AdaptiveMutex();
+
+  /**
+   * Waits until the mutex can be locked and locks it.
+   *
+   * \pre The mutex is not locked by the current thread.
+   * \post The mutex is locked
+   * \threadsafe
+   * \see TryLock(), Unlock()
+   */
+  void Lock();
+
+  /**
+   * Tries to lock the mutex and returns immediately.
+   *
+   * \post If successful, the mutex is locked.
+   * \return \c true if the mutex could be locked, otherwise \c false.
+   * \threadsafe
+   * \lockfree
+   * \see Lock(), Unlock()
+   */
+  bool TryLock();
+
+  /**
+   * Unlocks the mutex.
+   *
+   * \pre The mutex is locked by the current thread
+   * \post The mutex is unlocked
+   * \threadsafe
+   * \see Lock(), TryLock()
+   */
+  void Unlock();
+
+ private:
+  /**
+   * Disables copy construction and assignment.
+   */
+  AdaptiveMutex(const AdaptiveMutex&);
+  AdaptiveMutex& operator=(const AdaptiveMutex&);
+
+  /**
+   * Holds the actual mutex.
+   */
+  embb_adaptive_mutex_t mutex_;
+};
+
 
 /**
  * Scoped lock (according to the RAII principle) using a mutex.
@@ -0,0 +1,267 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef EMBB_BASE_SHARED_MUTEX_H_
+#define EMBB_BASE_SHARED_MUTEX_H_
+
+#include <embb/base/internal/platform.h>
+#include <embb/base/atomic.h>
+#include <embb/base/mutex.h>
+#include <embb/base/condition_variable.h>
+
+namespace embb {
+namespace base {
+
+/**
+ * Reader-writer mutex that scales with the number of readers.
+ *
+ * Any number of threads may hold the mutex in shared mode at the same time,
+ * while exclusive mode excludes all other threads. Each thread announces
+ * itself as reader in a cache line of its own, selected by its thread
+ * index, so readers neither write to a common memory location nor take a
+ * lock. A writer announces itself and then waits for the reader indicators
+ * to become empty. Arriving readers give way to announced writers, so
+ * writers do not starve. Waiting threads spin for a while and then block.
+ *
+ * In contrast to ReadWriteLock, shared locking costs two atomic operations on
+ * a cache line private to the thread, while exclusive locking visits the
+ * indicators of all threads. The mutex thus suits data that is read much more
+ * often than it is written. It is neither recursive nor upgradable and cannot
+ * be copied or assigned.
+ *
+ * \see ReadWriteLock, SharedLock
+ * \ingroup CPP_BASE_MUTEX
+ */
+class SharedMutex {
+ public:
+  /**
+   * Creates a mutex which is in unlocked state.
+   *
+   * \memory Allocates one cache line per thread as given by
+   *         embb_thread_get_max_count()
+   * \throws embb::base::NoMemoryException if not enough memory is available
+   * \notthreadsafe
+   */
+  SharedMutex();
+
+  /**
+   * Destroys the mutex.
+   *
+   * \pre The mutex is not locked
+   * \notthreadsafe
+   */
+  ~SharedMutex();
+
+  /**
+   * Waits until the mutex can be locked exclusively and locks it.
+   *
+   * \pre The mutex is not locked by the current thread.
+   * \post The mutex is locked exclusively
+   * \threadsafe
+   * \see TryLock(), Unlock()
+   */
+  void Lock();
+
+  /**
+   * Tries to lock the mutex exclusively and returns immediately.
+   *
+   * \pre The mutex is not locked by the current thread.
+   * \post If successful, the mutex is locked exclusively
+   * \return \c true if the mutex could be locked, otherwise \c false.
+   * \threadsafe
+   * \see Lock(), Unlock()
+   */
+  bool TryLock();
+
+  /**
+   * Unlocks the exclusively locked mutex.
+   *
+   * \pre The mutex is locked exclusively by the current thread
+   * \post The mutex is unlocked
+   * \threadsafe
+   * \see Lock(), TryLock()
+   */
+  void Unlock();
+
+  /**
+   * Waits until the mutex can be locked in shared mode and locks it.
+   *
+   * \pre The mutex is not locked by the current thread.
+   * \post The mutex is locked in shared mode
+   * \threadsafe
+   * \see TryLockShared(), UnlockShared()
+   */
+  void LockShared();
+
+  /**
+   * Tries to lock the mutex in shared mode and returns immediately.
+   *
+   * \pre The mutex is not locked by the current thread.
+   * \post If successful, the mutex is locked in shared mode
+   * \return \c true if the mutex could be locked, otherwise \c false.
+   * \threadsafe
+   * \see LockShared(), UnlockShared()
+   */
+  bool TryLockShared();
+
+  /**
+   * Unlocks the mutex locked in shared mode by the current thread.
+   *
+   * \pre The mutex is locked in shared mode by the current thread
+   * \post The current thread does not hold the mutex anymore
+   * \threadsafe
+   * \see LockShared(), TryLockShared()
+   */
+  void UnlockShared();
+
+ private:
+  /**
+   * Number of readers using one indicator, padded to a cache line.
+   */
+  struct ReaderIndicator {
+    Atomic<int> readers;
+    char padding[EMBB_PLATFORM_CACHE_LINE_SIZE - sizeof(Atomic<int>)];
+  };
+
+  /**
+   * Returns the reader indicator of the current thread. Threads without a
+   * thread index share the first one.
+   */
+  ReaderIndicator& GetIndicator();
+
+  /**
+   * Spins and then blocks until no writer is waiting or active.
+   */
+  void WaitForWriters();
+
+  /**
+   * Spins and then blocks until the given indicator has no readers.
+   */
+  void WaitForReaders(ReaderIndicator& indicator);
+
+  /**
+   * Wakes up blocked threads, if there are any.
+   */
+  void WakeUp();
+
+  /**
+   * Disables copy construction and assignment.
+   */
+  SharedMutex(const SharedMutex&);
+  SharedMutex& operator=(const SharedMutex&);
+
+  /**
+   * Number of loop iterations a waiting thread spins before it blocks.
+   */
+  static const int kSpinCount = 1000;
+
+  /**
+   * Reader indicators, one per thread index.
+   */
+  ReaderIndicator* indicators_;
+
+  /**
+   * Number of reader indicators.
+   */
+  unsigned int indicator_count_;
+
+  /**
+   * Number of writers waiting for or holding the mutex.
+   */
+  Atomic<int> writers_;
+
+  /**
+   * Serializes writers.
+   */
+  Mutex writer_mutex_;
+
+  /**
+   * Number of blocked threads.
+   */
+  Atomic<int> blocked_;
+
+  /**
+   * Protects blocking and waking up.
+   */
+  Mutex block_mutex_;
+
+  /**
+   * Blocked threads wait for this condition.
+   */
+  ConditionVariable block_condition_;
+};
+
+/**
+ * Scoped shared lock.
+ *
+ * Locks a mutex in shared mode on construction and unlocks it on destruction.
+ * The mutex is typically a SharedMutex.
+ *
+ * \tparam SharedMutex Type of the mutex, needs to provide LockShared() and
+ *         UnlockShared()
+ * \see SharedMutex, LockGuard
+ * \ingroup CPP_BASE_MUTEX
+ */
+template<typename SharedMutex = embb::base::SharedMutex>
+class SharedLock {
+ public:
+  /**
+   * Creates the lock and locks the mutex in shared mode.
+   *
+   * \pre The mutex is not locked by the current thread.
+   */
+  explicit SharedLock(
+    SharedMutex& mutex
+    /**< [IN] Mutex to be managed */
+    ) : mutex_(mutex) {
+    mutex_.LockShared();
+  }
+
+  /**
+   * Unlocks the mutex.
+   */
+  ~SharedLock() {
+    mutex_.UnlockShared();
+  }
+
+ private:
+  /**
+   * Holds the managed mutex.
+   */
+  SharedMutex& mutex_;
+
+  /**
+   * Disables copy construction and assignment.
+   */
+  SharedLock(const SharedLock&);
+  SharedLock& operator=(const SharedLock&);
+};
+
+} // namespace base
+} // namespace embb
+
+#endif // EMBB_BASE_SHARED_MUTEX_H_
@@ -30,6 +30,7 @@
 #include <embb/base/c/thread_specific_storage.h>
 #include <embb/base/c/internal/thread_index.h>
 #include <embb/base/exceptions.h>
+#include <embb/base/internal/thread_specific_storage_factories.h>
 
 namespace embb {
 namespace base {
@@ -53,6 +54,10 @@ class ThreadSpecificStorageTest;
  * Represents thread-specific storage (TSS).
  *
  * Provides for each thread a separate slot storing an object of the given type.
+ * The slots are bound to thread indices, which are recycled when threads
+ * exit. A thread obtaining the index of an exited thread gets a new object,
+ * constructed with the arguments given to the TSS, instead of the object left
+ * in the slot.
  *
  * \tparam Type Type of the objects
  * \ingroup CPP_BASE_TSS
@@ -66,7 +71,8 @@ class ThreadSpecificStorage {
    * \throws NoMemoryException if not enough memory is available to allocate
    *         the TSS slots
    * \memory Dynamically allocates embb::base::Thread::GetThreadsMaxCount()
-   *         pointers and slots of the TSS type
+   *         pointers and slots of the TSS type, and a copy of the
+   *         constructor arguments to initialize reused slots
    * \notthreadsafe
    */
   ThreadSpecificStorage();
@@ -82,7 +88,8 @@ class ThreadSpecificStorage {
    * \throws NoMemoryException if not enough memory is available to allocate
    *         the TSS slots
    * \memory Dynamically allocates embb::base::Thread::GetThreadsMaxCount()
-   *         pointers and slots of the TSS type
+   *         pointers and slots of the TSS type, and a copy of the
+   *         constructor arguments to initialize reused slots
    * \notthreadsafe
    */
   template<typename Initializer1, ...>
@@ -132,6 +139,8 @@ class ThreadSpecificStorage {
    *
    * \throws embb::base::ErrorException if the maximum number of threads has
    *         been exceeded
+   * \memory Allocates a new object on the first call of a thread that
+   *         obtained the index of an exited thread
    * \lockfree
    * \see Get() const
    */
@@ -144,6 +153,8 @@ class ThreadSpecificStorage {
    *
    * \throws embb::base::ErrorException if the maximum number of threads has
    *         been exceeded
+   * \memory Allocates a new object on the first call of a thread that
+   *         obtained the index of an exited thread
    * \lockfree
    * \see Get()
    */
@@ -151,19 +162,36 @@ class ThreadSpecificStorage {
 
  private:
   /**
-   * Common construction code.
+   * Common construction code, creates the objects of all slots with the
+   * given factory and takes it over.
    */
-  void Prepare();
+  void Prepare(
+    internal::TssFactory<Type>* factory
+    /**< [IN] Factory for the objects of the TSS slots */
+    );
+
+  /**
+   * Returns the slot of the current thread, reinitialized if it was used by
+   * an exited thread with the same index.
+   */
+  Type* GetSlot() const;
 
   /**
-   * Representation of TSS implemented in Base C.
+   * Representation of TSS implemented in Base C. Mutable, since also Get()
+   * const replaces the object of a reused slot.
    */
-  embb_tss_t rep_;
+  mutable embb_tss_t rep_;
 
   /**
    * Flags to indicate the usage of a TSS value. Are set on first access.
    */
-  bool* usage_flags_;
+  mutable bool* usage_flags_;
+
+  /**
+   * Creates the objects of all slots, including those that were used by an
+   * exited thread.
+   */
+  internal::TssFactory<Type>* factory_;
 
   /**
    * To allow white-box tests.
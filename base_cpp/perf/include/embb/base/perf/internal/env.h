@@ -4,7 +4,7 @@
 #include <embb/base/c/internal/config.h>
 
 // Windows
-#ifdef EMBB_THREADING_WINTHREADS
+#ifdef EMBB_PLATFORM_THREADING_WINTHREADS
 #define EMBB_BASE_CPP_PERF_TIMER_WIN32
 #endif
 // OS X
@@ -18,7 +18,7 @@
 #define EMBB_BASE_CPP_PERF_TIMER_UX
 #endif
 // POSIX
-#if defined(EMBB_THREADING_POSIXTHREADS)
+#if defined(EMBB_PLATFORM_THREADING_POSIXTHREADS)
 #define EMBB_BASE_CPP_PERF_TIMER_POSIX
 #endif
 // Linux
@@ -37,17 +37,17 @@
 // Architecture specific defines
 
 // Intel 386
-#if defined(EMBB_ARCH_X86_32)
+#if defined(EMBB_PLATFORM_ARCH_X86_32)
 #define EMBB_BASE_CPP_PERF__ARCH_I386
 #define EMBB_BASE_CPP_PERF__ARCH_X86
 
 // AMD64, Intel x64
-#elif defined(EMBB_ARCH_X86_64)
+#elif defined(EMBB_PLATFORM_ARCH_X86_64)
 #define EMBB_BASE_CPP_PERF__ARCH_X64
 #define EMBB_BASE_CPP_PERF__ARCH_X86
 
 // ARM
-#elif defined(EMBB_ARCH_ARM)
+#elif defined(EMBB_PLATFORM_ARCH_ARM)
 // ARM versions consolidated to major architecture version. 
 // See: https://wiki.edubuntu.org/ARM/Thumb2PortingHowto
 #if defined(__ARM_ARCH_7__) || \
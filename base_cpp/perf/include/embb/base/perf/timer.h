@@ -42,10 +42,10 @@
 #if defined(EMBB_BASE_CPP_PERF_TIMER_PAPI)
 #  include <embb/base/perf/internal/timestamp_papi.h>
 #endif
-#if defined(EMBB_THREADING_WINTHREADS)
+#if defined(EMBB_PLATFORM_THREADING_WINTHREADS)
 #  include <embb/base/perf/internal/timestamp_counter_win32.h>
 #  include <embb/base/perf/internal/timestamp_clock_win32.h>
-#elif defined(EMBB_THREADING_POSIXTHREADS)
+#elif defined(EMBB_PLATFORM_THREADING_POSIXTHREADS)
 #  include <embb/base/perf/internal/timestamp_counter_posix.h>
 #  include <embb/base/perf/internal/timestamp_clock_posix.h>
 #endif
@@ -60,6 +60,28 @@ Mutex::Mutex() : MutexBase(EMBB_MUTEX_PLAIN) {
 RecursiveMutex::RecursiveMutex() : MutexBase(EMBB_MUTEX_RECURSIVE) {
 }
 
+AdaptiveMutex::AdaptiveMutex() : mutex_() {
+  if (embb_adaptive_mutex_init(&mutex_) != EMBB_SUCCESS) {
+    EMBB_THROW(ErrorException, "Could not initialize adaptive mutex.");
+  }
+}
+
+AdaptiveMutex::~AdaptiveMutex() {
+  embb_adaptive_mutex_destroy(&mutex_);
+}
+
+void AdaptiveMutex::Lock() {
+  embb_adaptive_mutex_lock(&mutex_);
+}
+
+bool AdaptiveMutex::TryLock() {
+  return embb_adaptive_mutex_try_lock(&mutex_) == EMBB_SUCCESS;
+}
+
+void AdaptiveMutex::Unlock() {
+  embb_adaptive_mutex_unlock(&mutex_);
+}
+
 } // namespace base
 } // namespace embb
 
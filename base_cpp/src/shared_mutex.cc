@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <embb/base/shared_mutex.h>
+#include <embb/base/memory_allocation.h>
+#include <embb/base/c/thread.h>
+#include <embb/base/c/internal/thread_index.h>
+
+#include <cassert>
+#include <new>
+
+namespace embb {
+namespace base {
+
+SharedMutex::SharedMutex()
+    : indicators_(NULL), indicator_count_(embb_thread_get_max_count()),
+      writers_(0), writer_mutex_(), blocked_(0), block_mutex_(),
+      block_condition_() {
+  if (indicator_count_ == 0) {
+    indicator_count_ = 1;
+  }
+  indicators_ = static_cast<ReaderIndicator*>(
+    Allocation::AllocateCacheAligned(
+      sizeof(ReaderIndicator) * indicator_count_));
+  for (unsigned int index = 0; index < indicator_count_; index++) {
+    new (&indicators_[index]) ReaderIndicator();
+    indicators_[index].readers.Store(0);
+  }
+}
+
+SharedMutex::~SharedMutex() {
+  for (unsigned int index = 0; index < indicator_count_; index++) {
+    assert(indicators_[index].readers.Load() == 0);
+    indicators_[index].~ReaderIndicator();
+  }
+  Allocation::FreeAligned(indicators_);
+}
+
+void SharedMutex::Lock() {
+  ++writers_;
+  writer_mutex_.Lock();
+  // readers arriving from now on give way, wait for the others to leave
+  for (unsigned int index = 0; index < indicator_count_; index++) {
+    WaitForReaders(indicators_[index]);
+  }
+}
+
+bool SharedMutex::TryLock() {
+  if (!writer_mutex_.TryLock()) {
+    return false;
+  }
+  ++writers_;
+  for (unsigned int index = 0; index < indicator_count_; index++) {
+    if (indicators_[index].readers.Load() != 0) {
+      Unlock();
+      return false;
+    }
+  }
+  return true;
+}
+
+void SharedMutex::Unlock() {
+  int writers = --writers_;
+  writer_mutex_.Unlock();
+  if (writers == 0) {
+    WakeUp();
+  }
+}
+
+void SharedMutex::LockShared() {
+  Atomic<int>& readers = GetIndicator().readers;
+  for (;;) {
+    ++readers;
+    if (writers_.Load() == 0) {
+      return;
+    }
+    // give way to the writer, which may already wait for this indicator
+    if (--readers == 0) {
+      WakeUp();
+    }
+    WaitForWriters();
+  }
+}
+
+bool SharedMutex::TryLockShared() {
+  Atomic<int>& readers = GetIndicator().readers;
+  ++readers;
+  if (writers_.Load() == 0) {
+    return true;
+  }
+  if (--readers == 0) {
+    WakeUp();
+  }
+  return false;
+}
+
+void SharedMutex::UnlockShared() {
+  if (--GetIndicator().readers == 0 && writers_.Load() != 0) {
+    WakeUp();
+  }
+}
+
+SharedMutex::ReaderIndicator& SharedMutex::GetIndicator() {
+  unsigned int index = 0;
+  if (embb_internal_thread_index(&index) != EMBB_SUCCESS) {
+    index = 0;
+  }
+  return indicators_[index % indicator_count_];
+}
+
+void SharedMutex::WaitForWriters() {
+  for (int spin = 0; spin < kSpinCount; spin++) {
+    if (writers_.Load() == 0) {
+      return;
+    }
+  }
+  UniqueLock<Mutex> lock(block_mutex_);
+  // announce before checking, so the writer either sees us or we see it
+  ++blocked_;
+  while (writers_.Load() != 0) {
+    block_condition_.Wait(lock);
+  }
+  --blocked_;
+}
+
+void SharedMutex::WaitForReaders(ReaderIndicator& indicator) {
+  for (int spin = 0; spin < kSpinCount; spin++) {
+    if (indicator.readers.Load() == 0) {
+      return;
+    }
+  }
+  UniqueLock<Mutex> lock(block_mutex_);
+  ++blocked_;
+  while (indicator.readers.Load() != 0) {
+    block_condition_.Wait(lock);
+  }
+  --blocked_;
+}
+
+void SharedMutex::WakeUp() {
+  if (blocked_.Load() != 0) {
+    LockGuard<Mutex> lock(block_mutex_);
+    block_condition_.NotifyAll();
+  }
+}
+
+} // namespace base
+} // namespace embb
@@ -137,6 +137,32 @@ void AtomicTest::TestStressProduceConsume::Init() {
 void AtomicTest::TestStressProduceConsume::CheckAndDestroy() {
 }
 
+AtomicTest::TestStressAcquireRelease::TestStressAcquireRelease(
+  size_t number_threads, size_t number_iterations)
+  : TestUnit("Acquire/Release Stress test for Atomics"), payload(0), flag(0),
+  counter_producer(0), counter_consumer(0) {
+  PT_ASSERT(number_threads == 1);
+  Add(&TestStressAcquireRelease::produce, this,
+    number_threads, number_iterations);
+  Add(&TestStressAcquireRelease::consume, this,
+    number_threads, number_iterations);
+}
+
+void AtomicTest::TestStressAcquireRelease::produce() {
+  counter_producer++;
+  while (flag.Load(embb::base::kMemoryOrderAcquire) != 0) {}
+  // The payload is not atomic, it is published by the release store
+  payload = counter_producer;
+  flag.Store(1, embb::base::kMemoryOrderRelease);
+}
+
+void AtomicTest::TestStressAcquireRelease::consume() {
+  counter_consumer++;
+  while (flag.Load(embb::base::kMemoryOrderAcquire) == 0) {}
+  PT_EXPECT_EQ(payload, counter_consumer);
+  flag.Store(0, embb::base::kMemoryOrderRelease);
+}
+
 AtomicTest::TestStressIncrementDecrement::TestStressIncrementDecrement(
   size_t number_threads, size_t number_iterations)
   : TestUnit("Increment/Decrement Stress test for Atomics"), inc_dec_value(0) {
@@ -275,6 +301,9 @@ AtomicTest::AtomicTest() {
     .Add(&AtomicTest::BasicTests, this);
   CreateUnit<TestStressLoadStore>(static_cast<size_t>(1), numIterations_);
   CreateUnit<TestStressProduceConsume>(static_cast<size_t>(1), numIterations_);
+  CreateUnit("MemoryOrderTestsSingleThreaded")
+    .Add(&AtomicTest::MemoryOrderTests, this);
+  CreateUnit<TestStressAcquireRelease>(static_cast<size_t>(1), numIterations_);
   CreateUnit<TestStressIncrementDecrement>(static_cast<size_t>(1),
     numIterations_);
   CreateUnit<TestStressSwap>(static_cast<size_t>(1), numIterations_);
@@ -386,6 +415,49 @@ void AtomicTest::BasicTests() {
   delete k;
 }
 
+void AtomicTest::MemoryOrderTests() {
+  const embb::base::MemoryOrder orders[] = {
+    embb::base::kMemoryOrderRelaxed,
+    embb::base::kMemoryOrderAcquire,
+    embb::base::kMemoryOrderRelease,
+    embb::base::kMemoryOrderAcqRel,
+    embb::base::kMemoryOrderSeqCst
+  };
+
+  for (size_t o = 0; o != sizeof(orders) / sizeof(orders[0]); ++o) {
+    const embb::base::MemoryOrder order = orders[o];
+    embb::base::Atomic<colors_t> c(RED);
+    embb::base::Atomic<unsigned char> ch;
+    embb::base::Atomic<unsigned int> i;
+    int values[2] = { 0, 0 };
+    embb::base::Atomic<int*> n(&values[0]);
+
+    // Load and store
+    c.Store(GREEN, order);
+    PT_EXPECT(c.Load(order) == GREEN);
+    ch.Store('a', order);
+    PT_EXPECT(ch.Load(order) == 'a');
+    // Swap
+    PT_EXPECT(c.Swap(BLUE, order) == GREEN);
+    PT_EXPECT(c.Load(order) == BLUE);
+    // Compare-and-swap
+    colors_t d = RED;
+    PT_EXPECT(!c.CompareAndSwap(d, GREEN, order));
+    PT_EXPECT(d == BLUE);
+    PT_EXPECT(c.CompareAndSwap(d, GREEN, order));
+    PT_EXPECT(c.Load(order) == GREEN);
+    // Fetch-and-add and fetch-and-sub
+    PT_EXPECT(i.FetchAndAdd(10, order) == 0);
+    PT_EXPECT(i.FetchAndSub(3, order) == 10);
+    PT_EXPECT(i.Load(order) == 7);
+    PT_EXPECT(ch.FetchAndAdd(1, order) == 'a');
+    PT_EXPECT(ch.Load(order) == 'b');
+    // Pointers
+    PT_EXPECT(n.Swap(&values[1], order) == &values[0]);
+    PT_EXPECT(n.Load(order) == &values[1]);
+  }
+}
+
 } // namespace test
 } // namespace base
 } // namespace embb
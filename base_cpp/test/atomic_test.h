@@ -53,7 +53,7 @@ class AtomicTest : public partest::TestCase {
  private:
   static size_t numIterations_;
   void BasicTests();
-
+  void MemoryOrderTests();
 
   class TestStressLoadStore : public partest::TestUnit {
    public:
@@ -102,6 +102,20 @@ class AtomicTest : public partest::TestCase {
     void CheckAndDestroy();
   };
 
+  class TestStressAcquireRelease : public partest::TestUnit {
+   public:
+    TestStressAcquireRelease(size_t number_threads, size_t number_iterations);
+
+   private:
+    size_t payload;
+    embb::base::Atomic<int> flag;
+    size_t counter_producer;
+    size_t counter_consumer;
+
+    void produce();
+    void consume();
+  };
+
   class TestStressIncrementDecrement : public partest::TestUnit {
    public:
     TestStressIncrementDecrement(size_t number_threads, size_t number_iterations);
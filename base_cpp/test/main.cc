@@ -29,6 +29,7 @@
 #include <duration_test.h>
 #include <core_set_test.h>
 #include <mutex_test.h>
+#include <shared_mutex_test.h>
 #include <condition_var_test.h>
 #include <thread_test.h>
 #include <thread_specific_storage_test.h>
@@ -41,6 +42,7 @@ using embb::base::test::CoreSetTest;
 using embb::base::test::DurationTest;
 using embb::base::test::ConditionVarTest;
 using embb::base::test::MutexTest;
+using embb::base::test::SharedMutexTest;
 using embb::base::test::ThreadSpecificStorageTest;
 using embb::base::test::AtomicTest;
 using embb::base::test::MemoryAllocationTest;
@@ -54,6 +56,7 @@ PT_MAIN("Base C++") {
   PT_RUN(DurationTest);
   PT_RUN(ConditionVarTest);
   PT_RUN(MutexTest);
+  PT_RUN(SharedMutexTest);
   PT_RUN(ThreadSpecificStorageTest);
   PT_RUN(AtomicTest);
   PT_RUN(MemoryAllocationTest);
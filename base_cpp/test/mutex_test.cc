@@ -33,7 +33,7 @@ namespace embb {
 namespace base {
 namespace test {
 
-MutexTest::MutexTest() : mutex_(), counter_(0),
+MutexTest::MutexTest() : mutex_(), adaptive_mutex_(), counter_(0),
     number_threads_(partest::TestSuite::GetDefaultNumThreads()),
     number_iterations_(partest::TestSuite::GetDefaultNumIterations()) {
   CreateUnit("Mutex protected counter")
@@ -49,6 +49,13 @@ MutexTest::MutexTest() : mutex_(), counter_(0),
           number_iterations_)
       .Post(&MutexTest::PostLockGuardCount, this);
   CreateUnit("Unique Lock").Add(&MutexTest::TestUniqueLock, this);
+  CreateUnit("Adaptive mutex protected counter")
+      .Pre(&MutexTest::PreAdaptiveMutexCount, this)
+      .Add(&MutexTest::TestAdaptiveMutexCount, this, number_threads_,
+          number_iterations_)
+      .Post(&MutexTest::PostAdaptiveMutexCount, this);
+  CreateUnit("Adaptive mutex try lock")
+      .Add(&MutexTest::TestAdaptiveMutexTryLock, this);
 }
 
 void MutexTest::PreMutexCount() {
@@ -92,6 +99,33 @@ void MutexTest::PostLockGuardCount() {
   PT_EXPECT_EQ((size_t)counter_, number_iterations_ * number_threads_);
 }
 
+void MutexTest::PreAdaptiveMutexCount() {
+  counter_ = 0;
+}
+
+void MutexTest::TestAdaptiveMutexCount() {
+  LockGuard<AdaptiveMutex> guard(adaptive_mutex_);
+  ++counter_;
+}
+
+void MutexTest::PostAdaptiveMutexCount() {
+  PT_EXPECT_EQ((size_t)counter_, number_iterations_ * number_threads_);
+}
+
+void MutexTest::TestAdaptiveMutexTryLock() {
+  AdaptiveMutex mutex;
+  PT_EXPECT_EQ(mutex.TryLock(), true);
+  PT_EXPECT_EQ(mutex.TryLock(), false);
+  mutex.Unlock();
+  {
+    UniqueLock<AdaptiveMutex> lock(mutex, try_lock);
+    PT_EXPECT_EQ(lock.OwnsLock(), true);
+    PT_EXPECT_EQ(mutex.TryLock(), false);
+  }
+  PT_EXPECT_EQ(mutex.TryLock(), true);
+  mutex.Unlock();
+}
+
 void MutexTest::TestUniqueLock() {
   { // Test standard usage and releasing
 #ifdef EMBB_USE_EXCEPTIONS
@@ -68,11 +68,28 @@ class MutexTest : public partest::TestCase {
    */
   void TestUniqueLock();
 
+  /**
+   * Uses AdaptiveMutex with LockGuard to realize multi-threaded counting.
+   */
+  void PreAdaptiveMutexCount();
+  void TestAdaptiveMutexCount();
+  void PostAdaptiveMutexCount();
+
+  /**
+   * Tests TryLock and UniqueLock with an AdaptiveMutex.
+   */
+  void TestAdaptiveMutexTryLock();
+
   /**
    * Mutex for tests.
    */
   embb::base::Mutex mutex_;
 
+  /**
+   * Adaptive mutex for tests.
+   */
+  embb::base::AdaptiveMutex adaptive_mutex_;
+
   /**
    * Shared counter to check effectiveness of mutex.
    */
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <shared_mutex_test.h>
+#include <embb/base/shared_mutex.h>
+#include <embb/base/thread.h>
+
+namespace embb {
+namespace base {
+namespace test {
+
+SharedMutexTest::SharedMutexTest() : mutex_(), counter_(0), accesses_(0),
+    writes_(0), readers_inside_(0), writers_inside_(0),
+    number_threads_(partest::TestSuite::GetDefaultNumThreads()),
+    number_iterations_(partest::TestSuite::GetDefaultNumIterations()) {
+  CreateUnit("Shared mutex readers and writers")
+      .Pre(&SharedMutexTest::PreReadersWriters, this)
+      .Add(&SharedMutexTest::TestReadersWriters, this, number_threads_,
+          number_iterations_)
+      .Post(&SharedMutexTest::PostReadersWriters, this);
+  CreateUnit("Shared mutex try lock")
+      .Add(&SharedMutexTest::TestTryLock, this);
+}
+
+void SharedMutexTest::PreReadersWriters() {
+  counter_ = 0;
+  accesses_ = 0;
+  writes_ = 0;
+}
+
+void SharedMutexTest::TestReadersWriters() {
+  // every fourth access writes
+  if (accesses_.FetchAndAdd(1) % 4 == 0) {
+    mutex_.Lock();
+    PT_EXPECT_EQ(++writers_inside_, 1);
+    PT_EXPECT_EQ(readers_inside_.Load(), 0);
+    ++counter_;
+    ++writes_;
+    --writers_inside_;
+    mutex_.Unlock();
+  } else {
+    mutex_.LockShared();
+    ++readers_inside_;
+    PT_EXPECT_EQ(writers_inside_.Load(), 0);
+    --readers_inside_;
+    mutex_.UnlockShared();
+  }
+}
+
+void SharedMutexTest::PostReadersWriters() {
+  PT_EXPECT_EQ(counter_, writes_.Load());
+  PT_EXPECT_EQ(readers_inside_.Load(), 0);
+  PT_EXPECT_EQ(writers_inside_.Load(), 0);
+}
+
+void SharedMutexTest::TestTryLock() {
+  SharedMutex mutex;
+
+  mutex.LockShared();
+  PT_EXPECT_EQ(mutex.TryLock(), false);
+  PT_EXPECT_EQ(mutex.TryLockShared(), true);
+  mutex.UnlockShared();
+  mutex.UnlockShared();
+
+  PT_EXPECT_EQ(mutex.TryLock(), true);
+  PT_EXPECT_EQ(mutex.TryLockShared(), false);
+  PT_EXPECT_EQ(mutex.TryLock(), false);
+  mutex.Unlock();
+
+  {
+    SharedLock<> lock(mutex);
+    PT_EXPECT_EQ(mutex.TryLock(), false);
+  }
+  PT_EXPECT_EQ(mutex.TryLock(), true);
+  mutex.Unlock();
+}
+
+} // namespace test
+} // namespace base
+} // namespace embb
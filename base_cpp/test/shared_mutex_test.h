@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef BASE_CPP_TEST_SHARED_MUTEX_TEST_H_
+#define BASE_CPP_TEST_SHARED_MUTEX_TEST_H_
+
+#include <partest/partest.h>
+#include <embb/base/shared_mutex.h>
+#include <embb/base/atomic.h>
+
+namespace embb {
+namespace base {
+namespace test {
+/**
+ * Provides tests for class SharedMutex.
+ */
+class SharedMutexTest : public partest::TestCase {
+ public:
+  /**
+   * Constructs the test case and adds test units.
+   */
+  SharedMutexTest();
+
+ private:
+  /**
+   * Mixes readers and writers, checking that writers are exclusive.
+   */
+  void PreReadersWriters();
+  void TestReadersWriters();
+  void PostReadersWriters();
+
+  /**
+   * Tests the try lock variants in the different states of the mutex.
+   */
+  void TestTryLock();
+
+  /**
+   * Mutex for tests.
+   */
+  embb::base::SharedMutex mutex_;
+
+  /**
+   * Counter modified by writers only.
+   */
+  int counter_;
+
+  /**
+   * Number of accesses started, every fourth one writes.
+   */
+  embb::base::Atomic<int> accesses_;
+
+  /**
+   * Number of writes performed.
+   */
+  embb::base::Atomic<int> writes_;
+
+  /**
+   * Number of threads currently holding the mutex in shared mode.
+   */
+  embb::base::Atomic<int> readers_inside_;
+
+  /**
+   * Number of threads currently holding the mutex exclusively.
+   */
+  embb::base::Atomic<int> writers_inside_;
+
+  /**
+   * Number of threads used to run tests.
+   */
+  size_t number_threads_;
+
+  /**
+   * Number of times the test method is called by each thread.
+   */
+  size_t number_iterations_;
+};
+
+} // namespace test
+} // namespace base
+} // namespace embb
+
+#endif // BASE_CPP_TEST_SHARED_MUTEX_TEST_H_
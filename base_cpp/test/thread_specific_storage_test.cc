@@ -26,12 +26,19 @@
 
 #include <thread_specific_storage_test.h>
 #include <embb/base/thread.h>
+#include <embb/base/atomic.h>
 #include <iostream>
 
 namespace embb {
 namespace base {
 namespace test {
 
+namespace {
+// Threads wait for each other before exiting, so that they hold distinct
+// thread indices (indices of exited threads are reused).
+embb::base::Atomic<size_t> arrived_threads;
+}
+
 ThreadSpecificStorageTest::ThreadSpecificStorageTest()
     : number_threads_(partest::TestSuite::GetDefaultNumThreads()), tss_() {
   PT_EXPECT_GT(Thread::GetThreadsMaxCount(), number_threads_);
@@ -42,11 +49,14 @@ ThreadSpecificStorageTest::ThreadSpecificStorageTest()
       .Add(&ThreadSpecificStorageTest::TestMultipleTSSVariables, this);
   CreateUnit("TestConstructors")
       .Add(&ThreadSpecificStorageTest::TestConstructors, this);
+  CreateUnit("Reused slots")
+      .Add(&ThreadSpecificStorageTest::TestReusedSlot, this);
 }
 
 void ThreadSpecificStorageTest::TestInternalRepresentation() {
   embb_internal_thread_index_reset();
   size_t num_threads = partest::TestSuite::GetDefaultNumThreads();
+  arrived_threads = 0;
   embb::base::Thread** threads = new embb::base::Thread*[num_threads];
   for (size_t i = 0; i < num_threads; i++) {
     threads[i] = new embb::base::Thread(
@@ -92,6 +102,10 @@ void ThreadSpecificStorageTest::TestInternalRepresentationSetGet(
     PT_EXPECT_EQ(rank, stored_rank);
     if (rank != stored_rank) break;
   }
+  arrived_threads++;
+  while (arrived_threads < partest::TestSuite::GetDefaultNumThreads()) {
+    embb::base::Thread::CurrentYield();
+  }
 }
 
 void ThreadSpecificStorageTest::TestMultipleTSSVariables() {
@@ -124,6 +138,49 @@ void ThreadSpecificStorageTest::TestConstructors() {
   }
 }
 
+void ThreadSpecificStorageTest::TestReusedSlot() {
+  embb_internal_thread_index_reset();
+  unsigned int old_max = embb_thread_get_max_count();
+  ThreadSpecificStorage<size_t> tss(7);
+  ThreadSpecificStorage<NonCopyableType> non_copyable_tss(3, 4);
+  // Both threads get index 0, the second one after the first exited
+  embb_internal_thread_index_set_max(1);
+  for (size_t i = 0; i < 2; i++) {
+    embb::base::Thread thread(
+      ThreadSpecificStorageTest::TestReusedSlotSetGet, &tss, i);
+    thread.Join();
+  }
+  embb_internal_thread_index_reset();
+  embb_internal_thread_index_set_max(1);
+  for (size_t i = 0; i < 2; i++) {
+    embb::base::Thread thread(
+      ThreadSpecificStorageTest::TestReusedNonCopyableSlotSetGet,
+      &non_copyable_tss, i);
+    thread.Join();
+  }
+  embb_internal_thread_index_set_max(old_max);
+}
+
+void ThreadSpecificStorageTest::TestReusedSlotSetGet(
+    ThreadSpecificStorage<size_t>* tss, size_t rank) {
+  unsigned int index = 0;
+  PT_ASSERT_EQ(embb_internal_thread_index(&index), EMBB_SUCCESS);
+  PT_EXPECT_EQ(index, 0u);
+  // The value left by the previous thread is not visible
+  PT_EXPECT_EQ(tss->Get(), 7u);
+  tss->Get() = 100 + rank;
+  PT_EXPECT_EQ(tss->Get(), 100 + rank);
+}
+
+void ThreadSpecificStorageTest::TestReusedNonCopyableSlotSetGet(
+    ThreadSpecificStorage<NonCopyableType>* tss, size_t rank) {
+  // The slot is constructed again from the arguments given to the TSS
+  const ThreadSpecificStorage<NonCopyableType>& const_tss = *tss;
+  PT_EXPECT_EQ(const_tss.Get().var, 7);
+  tss->Get().var = 100 + static_cast<int>(rank);
+  PT_EXPECT_EQ(const_tss.Get().var, 100 + static_cast<int>(rank));
+}
+
 } // namespace test
 } // namespace base
 } // namespace embb
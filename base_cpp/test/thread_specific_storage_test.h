@@ -94,6 +94,30 @@ class ThreadSpecificStorageTest : public partest::TestCase {
    */
   void TestConstructors();
 
+  /**
+   * Type to test reused TSS slots of types that cannot be copied.
+   */
+  class NonCopyableType {
+   public:
+    NonCopyableType(int arg1, int arg2) : var(arg1 + arg2) {}
+    int var;
+
+   private:
+    NonCopyableType(const NonCopyableType&);
+    NonCopyableType& operator=(const NonCopyableType&);
+  };
+
+  /**
+   * Tests that a thread reusing the index of an exited thread gets a
+   * freshly initialized slot.
+   */
+  void TestReusedSlot();
+  static void TestReusedSlotSetGet(ThreadSpecificStorage<size_t>* tss,
+                                   size_t rank);
+  static void TestReusedNonCopyableSlotSetGet(
+                  ThreadSpecificStorage<NonCopyableType>* tss,
+                  size_t rank);
+
   /**
    * Used to differentiate between used and unused TSS slots.
    */
@@ -0,0 +1,155 @@
+/*
+ * Copyright (c) 2014, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef EMBB_BENCHMARK_CPP_INTERNAL_COMPARISON_H_
+#define EMBB_BENCHMARK_CPP_INTERNAL_COMPARISON_H_
+
+#include <embb/base/perf/timer.h>
+#include <embb/base/atomic.h>
+#include <embb/base/thread.h>
+#include <embb/base/memory_allocation.h>
+
+#include <cstddef>
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+namespace embb {
+namespace benchmark {
+namespace internal {
+
+/**
+ * Thread body calling a copy of an operation with the index of its thread,
+ * once all threads have been started.
+ */
+template<typename Operation>
+class ConcurrentWorker {
+private:
+  Operation operation;
+  embb::base::Atomic<bool> * start;
+  size_t index;
+
+public:
+  ConcurrentWorker(
+    const Operation & operation_, embb::base::Atomic<bool> * start_,
+    size_t index_)
+  : operation(operation_), start(start_), index(index_)
+  { }
+
+  void operator()() {
+    while (!start->Load()) {
+      embb::base::Thread::CurrentYield();
+    }
+    operation(index);
+  }
+};
+
+/**
+ * Calls copies of \c operation with the thread indices 0 to
+ * \c numThreads - 1 on as many threads, which are released at once.
+ *
+ * \returns Microseconds from releasing the threads until all have finished
+ */
+template<typename Operation>
+double RunConcurrently(const Operation & operation, size_t numThreads) {
+  typedef embb::base::perf::Timer Timer;
+  embb::base::Atomic<bool> start(false);
+  ::std::vector<embb::base::Thread *> threads;
+  for (size_t t = 0; t < numThreads; ++t) {
+    threads.push_back(embb::base::Allocation::New<embb::base::Thread>(
+      ConcurrentWorker<Operation>(operation, &start, t)));
+  }
+  Timer::timestamp_t begin = Timer::Now();
+  start.Store(true);
+  for (size_t t = 0; t < numThreads; ++t) {
+    threads[t]->Join();
+    embb::base::Allocation::Delete(threads[t]);
+  }
+  Timer::timestamp_t end = Timer::Now();
+  return Timer::FromInterval(begin, end);
+}
+
+/**
+ * Table comparing implementations, one column per implementation and one
+ * row per configuration, written to standard output as rows complete.
+ */
+class ComparisonTable {
+private:
+  const char * rowTitle;
+  int rowWidth;
+  ::std::vector<const char *> titles;
+  ::std::vector<int> widths;
+  size_t column;
+
+public:
+  explicit ComparisonTable(const char * rowTitle_, int rowWidth_ = 8)
+  : rowTitle(rowTitle_), rowWidth(rowWidth_), column(0)
+  { }
+
+  void AddColumn(const char * title, int width = 16) {
+    titles.push_back(title);
+    widths.push_back(width);
+  }
+
+  /**
+   * Writes the column titles, followed by the unit of the values if given.
+   */
+  void WriteHeader(const char * unit = NULL) const {
+    ::std::cout << ::std::setw(rowWidth) << rowTitle;
+    for (size_t i = 0; i < titles.size(); ++i) {
+      ::std::cout << ::std::setw(widths[i]) << titles[i];
+    }
+    if (unit != NULL) {
+      ::std::cout << "  (" << unit << ")";
+    }
+    ::std::cout << ::std::endl;
+  }
+
+  template<typename T>
+  void BeginRow(const T & row) {
+    column = 0;
+    ::std::cout << ::std::setw(rowWidth) << row
+                << ::std::fixed << ::std::setprecision(2);
+  }
+
+  /**
+   * Writes the value of the next column of the current row.
+   */
+  template<typename T>
+  void WriteValue(const T & value) {
+    ::std::cout << ::std::setw(widths[column++]) << value;
+    if (column == widths.size()) {
+      ::std::cout << ::std::endl;
+    }
+  }
+};
+
+} // namespace internal
+} // namespace benchmark
+} // namespace embb
+
+#endif /* EMBB_BENCHMARK_CPP_INTERNAL_COMPARISON_H_ */
@@ -29,7 +29,7 @@
 
 #include <embb/base/thread.h>
 
-#if defined(EMBB_THREADING_POSIXTHREADS)
+#if defined(EMBB_PLATFORM_THREADING_POSIXTHREADS)
 #include <sched.h>
 #endif
 
@@ -40,7 +40,7 @@ namespace internal {
 template< typename TUnit, typename TLatencyMeasurements >
 void ProducerConsumerThread<TUnit, TLatencyMeasurements>::
 TaskWrapper() {
-#if defined(EMBB_THREADING_POSIXTHREADS)
+#if defined(EMBB_PLATFORM_THREADING_POSIXTHREADS)
   if (!callArgs.DefaultScheduler()) {
     // Try to set real-time scheduler (FIFO) to limit 
     // OS interference. Must be run as root. 
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_BENCHMARK_CPP_LOCKS_MUTEX_BENCHMARK_H_
+#define EMBB_BENCHMARK_CPP_LOCKS_MUTEX_BENCHMARK_H_
+
+#include <embb/benchmark/call_args.h>
+
+#include <cstddef>
+
+namespace embb {
+namespace benchmark {
+
+/**
+ * Compares embb::base::Mutex and embb::base::AdaptiveMutex for 1, 2, 4, ...
+ * threads up to the number of threads given with -t (64 by default). Every
+ * thread acquires the lock -n times (100000 by default) and performs -q
+ * increments of shared data while holding it (1 by default). Prints the
+ * acquisitions per microsecond of both locks for each number of threads.
+ */
+class MutexBenchmark {
+private:
+  template<typename Lock>
+  static double Measure(
+    size_t numThreads, size_t numAcquisitions, size_t sectionLength);
+
+public:
+  static void Run(const CallArgs & params);
+};
+
+} // namespace benchmark
+} // namespace embb
+
+#endif /* EMBB_BENCHMARK_CPP_LOCKS_MUTEX_BENCHMARK_H_ */
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_BENCHMARK_CPP_QUEUES_PRIORITY_QUEUE_BENCHMARK_H_
+#define EMBB_BENCHMARK_CPP_QUEUES_PRIORITY_QUEUE_BENCHMARK_H_
+
+#include <embb/benchmark/call_args.h>
+
+#include <cstddef>
+
+namespace embb {
+namespace benchmark {
+
+/**
+ * Compares embb::containers::MultiQueue and a binary heap protected by an
+ * embb::base::Mutex.
+ *
+ * The throughput is measured for 1, 2, 4, ... threads up to the number of
+ * threads given with -t (64 by default). Both queues start with 10000
+ * elements. Every thread performs -n operations (100000 by default),
+ * alternating between enqueueing an element with random priority and
+ * dequeueing an element.
+ *
+ * The rank error is measured by a single thread that dequeues 10000 elements
+ * with distinct priorities. The rank of a dequeued element is the number of
+ * elements with higher priority still in the queue.
+ */
+class PriorityQueueBenchmark {
+private:
+  template<typename Queue>
+  static double MeasureThroughput(size_t numThreads, size_t numOperations);
+
+  template<typename Queue>
+  static void MeasureRankError(double & meanRank, size_t & maxRank);
+
+public:
+  static void Run(const CallArgs & params);
+};
+
+} // namespace benchmark
+} // namespace embb
+
+#endif /* EMBB_BENCHMARK_CPP_QUEUES_PRIORITY_QUEUE_BENCHMARK_H_ */
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_BENCHMARK_CPP_SETS_MAP_BENCHMARK_H_
+#define EMBB_BENCHMARK_CPP_SETS_MAP_BENCHMARK_H_
+
+#include <embb/benchmark/call_args.h>
+
+#include <cstddef>
+
+namespace embb {
+namespace benchmark {
+
+/**
+ * Compares embb::containers::ChromaticTree,
+ * embb::containers::LockFreeHashMap, and embb::containers::LockFreeSkipList
+ * for 1, 2, 4, ... threads up to the
+ * number of threads given with -t (64 by default). All maps start half
+ * filled with keys from a range of 1024. Every thread performs -n operations
+ * (100000 by default) on random keys, every q-th of which is an insertion or
+ * deletion (every 10th by default) and the rest lookups. Prints the
+ * operations per microsecond of all maps for each number of threads.
+ */
+class MapBenchmark {
+private:
+  template<typename Map>
+  static double Measure(
+    size_t numThreads, size_t numOperations, size_t updateInterval);
+
+public:
+  static void Run(const CallArgs & params);
+};
+
+} // namespace benchmark
+} // namespace embb
+
+#endif /* EMBB_BENCHMARK_CPP_SETS_MAP_BENCHMARK_H_ */
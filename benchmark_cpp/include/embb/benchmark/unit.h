@@ -48,7 +48,14 @@ public:
     LOCK_FREE_STACK            = 10,
     WAIT_FREE_SIM_STACK_TAGGED = 11,
     WAIT_FREE_SIM_STACK_TP     = 12,
-    WAIT_FREE_SIM_STACK_AP     = 13
+    WAIT_FREE_SIM_STACK_AP     = 13,
+    READ_WRITE_LOCK            = 14,
+    MUTEX                      = 15,
+    MAP                        = 16,
+    PRIORITY_QUEUE             = 17,
+    BATCH_QUEUE                = 18,
+    STACK_COMPARISON           = 19,
+    TREE_LOOKUP                = 20
   } UnitId;
 
   inline static UnitId FromUnitName(const ::std::string & name) {
@@ -91,6 +98,27 @@ public:
     if (name == "lockfreestack") {
       return Unit::LOCK_FREE_STACK;
     }
+    if (name == "rwlock") {
+      return Unit::READ_WRITE_LOCK;
+    }
+    if (name == "mutex") {
+      return Unit::MUTEX;
+    }
+    if (name == "map") {
+      return Unit::MAP;
+    }
+    if (name == "multiqueue") {
+      return Unit::PRIORITY_QUEUE;
+    }
+    if (name == "queuebatch") {
+      return Unit::BATCH_QUEUE;
+    }
+    if (name == "stacks") {
+      return Unit::STACK_COMPARISON;
+    }
+    if (name == "treelookup") {
+      return Unit::TREE_LOOKUP;
+    }
     return Unit::UNDEFINED;
   }
 
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <embb/benchmark/queues/batch_queue_benchmark.h>
+#include <embb/benchmark/internal/comparison.h>
+#include <embb/base/memory_allocation.h>
+#include <embb/containers/wait_free_queue.h>
+#include <embb/containers/wait_free_phaseless_queue.h>
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+namespace embb {
+namespace benchmark {
+
+using internal::ComparisonTable;
+using internal::RunConcurrently;
+
+namespace {
+
+static const size_t kMaxBatchSize = 256;
+
+// Index-based node pools of WaitFreeQueue are limited to 15 bit
+static const size_t kMaxQueueSize = 32766;
+
+typedef embb::containers::WaitFreeQueue<size_t> WaitFreeQueue;
+typedef embb::containers::WaitFreePhaselessQueue<size_t>
+  WaitFreePhaselessQueue;
+
+template<typename Queue>
+class Operator {
+private:
+  Queue * queue;
+  size_t numElements;
+  size_t batchSize;
+  // Copied into every thread before the threads are released
+  ::std::vector<size_t> batch;
+
+public:
+  Operator(Queue * queue_, size_t numElements_, size_t batchSize_)
+  : queue(queue_), numElements(numElements_), batchSize(batchSize_),
+    batch(batchSize_)
+  {
+    for (size_t i = 0; i < batchSize; ++i) {
+      batch[i] = i;
+    }
+  }
+
+  void operator()(size_t) {
+    for (size_t element = 0; element < numElements; element += batchSize) {
+      queue->TryEnqueueBatch(batch.begin(), batch.end());
+      queue->TryDequeueBatch(batch.begin(), batchSize);
+    }
+  }
+};
+
+} // namespace
+
+template<typename Queue>
+double BatchQueueBenchmark::MeasureThroughput(
+  size_t numThreads, size_t numElements, size_t batchSize) {
+  // Same capacity for all batch sizes, as allocating from the node pool
+  // depends on its size. Queues are allocated cache-aligned, as their
+  // head and tail are.
+  Queue * queue = new (
+    embb::base::Allocation::AllocateCacheAligned(sizeof(Queue)))
+    Queue(::std::min(kMaxQueueSize, 2 * numThreads * kMaxBatchSize));
+  double duration = RunConcurrently(
+    Operator<Queue>(queue, numElements, batchSize), numThreads);
+  queue->~Queue();
+  embb::base::Allocation::FreeAligned(queue);
+  return static_cast<double>(numThreads * numElements) / duration;
+}
+
+void BatchQueueBenchmark::Run(const CallArgs & params) {
+  size_t numThreads  = (params.NumThreads() == 0)
+                       ? 4 : params.NumThreads();
+  size_t numElements = (params.NumElements() == 0)
+                       ? 100000 : params.NumElements();
+  ::std::cout << "===== Batch queue operations, " << numThreads
+              << " threads, " << numElements
+              << " elements per thread" << ::std::endl;
+  ComparisonTable table("batch");
+  table.AddColumn("KoganPetrank");
+  table.AddColumn("Phaseless");
+  table.WriteHeader("elements/us");
+  for (size_t batchSize = 1; batchSize <= kMaxBatchSize; batchSize *= 2) {
+    table.BeginRow(batchSize);
+    table.WriteValue(MeasureThroughput<WaitFreeQueue>(
+      numThreads, numElements, batchSize));
+    table.WriteValue(MeasureThroughput<WaitFreePhaselessQueue>(
+      numThreads, numElements, batchSize));
+  }
+}
+
+} // namespace benchmark
+} // namespace embb
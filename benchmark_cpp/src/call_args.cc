@@ -205,6 +205,7 @@ void CallArgs::Usage() {
   printLn("   michaelscott-ap - lock-free - Michael-Scott queue using array-based pool");
   printLn("   koganpetrank    - wait-free - according to Kogan and Petrank, with hazard pointers");
   printLn("   koganpetrank-pl - wait-free - Kogan-Petrank queue without phase counter");
+  printLn("   queuebatch      - Kogan-Petrank queues with batch operations, batch sizes 1 to 256");
   printLn("Scenarios: 0 1 2 3 4");
   printLn("  ");
   printLn("Stack types: ");
@@ -212,8 +213,20 @@ void CallArgs::Usage() {
   printLn("   simstack        - wait-free - based on the P-SIM universal construction");
   printLn("   simstack-t      - wait-free - with tagged pointers instead of hazard pointers");
   printLn("   simstack-tp     - lock-free - P-SIM stack with tree-based pool");
+  printLn("   stacks          - Treiber's stack vs. P-SIM stack with and without CAS fast path");
   printLn("Scenarios: 0 1 2 3 4");
   printLn("  ");
+  printLn("Lock types: ");
+  printLn("   rwlock          - ReadWriteLock vs. SharedMutex, every q-th access writes");
+  printLn("   mutex           - Mutex vs. AdaptiveMutex, q increments per critical section");
+  printLn("  ");
+  printLn("Map types: ");
+  printLn("   map             - ChromaticTree vs. LockFreeHashMap vs. LockFreeSkipList, every q-th operation updates");
+  printLn("   treelookup      - ChromaticTree lookups for 4096 up to n keys");
+  printLn("  ");
+  printLn("Priority queue types: ");
+  printLn("   multiqueue      - MultiQueue vs. locked binary heap, throughput and rank error");
+  printLn("  ");
 }
 
 void CallArgs::Print() const {
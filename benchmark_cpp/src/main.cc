@@ -36,8 +36,15 @@
 #include <embb/benchmark/pools/pool_benchmark_report.h>
 #include <embb/benchmark/stacks/stack_benchmark_runner.h>
 #include <embb/benchmark/stacks/stack_benchmark_report.h>
+#include <embb/benchmark/stacks/stack_comparison_benchmark.h>
 #include <embb/benchmark/sets/set_benchmark_runner.h>
 #include <embb/benchmark/sets/set_benchmark_report.h>
+#include <embb/benchmark/locks/read_write_lock_benchmark.h>
+#include <embb/benchmark/locks/mutex_benchmark.h>
+#include <embb/benchmark/sets/map_benchmark.h>
+#include <embb/benchmark/sets/tree_lookup_benchmark.h>
+#include <embb/benchmark/queues/priority_queue_benchmark.h>
+#include <embb/benchmark/queues/batch_queue_benchmark.h>
 #include <embb/base/perf/timer.h>
 #include <embb/base/thread.h>
 
@@ -143,6 +150,27 @@ int main(int argc, char* argv[])
       LockFreeStackBenchmarkRunner benchmark(params);
       runBenchmark(benchmark, params);
     }
+    else if (params.UnitId() == Unit::READ_WRITE_LOCK) {
+      ReadWriteLockBenchmark::Run(params);
+    }
+    else if (params.UnitId() == Unit::MUTEX) {
+      MutexBenchmark::Run(params);
+    }
+    else if (params.UnitId() == Unit::MAP) {
+      MapBenchmark::Run(params);
+    }
+    else if (params.UnitId() == Unit::PRIORITY_QUEUE) {
+      PriorityQueueBenchmark::Run(params);
+    }
+    else if (params.UnitId() == Unit::BATCH_QUEUE) {
+      BatchQueueBenchmark::Run(params);
+    }
+    else if (params.UnitId() == Unit::STACK_COMPARISON) {
+      StackComparisonBenchmark::Run(params);
+    }
+    else if (params.UnitId() == Unit::TREE_LOOKUP) {
+      TreeLookupBenchmark::Run(params);
+    }
   }
   catch (embb::base::Exception & embbe) { 
     ::std::cerr << "EMBB exception caught: " << embbe.What() << ::std::endl;
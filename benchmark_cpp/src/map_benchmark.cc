@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <embb/benchmark/sets/map_benchmark.h>
+#include <embb/benchmark/internal/comparison.h>
+#include <embb/containers/lock_free_chromatic_tree.h>
+#include <embb/containers/lock_free_hash_map.h>
+#include <embb/containers/lock_free_skip_list.h>
+
+#include <iostream>
+
+namespace embb {
+namespace benchmark {
+
+using internal::ComparisonTable;
+using internal::RunConcurrently;
+
+namespace {
+
+// Keys are drawn from [1, kKeyRange], 0 is the tree's undefined key
+static const size_t kKeyRange = 1024;
+
+typedef embb::containers::ChromaticTree<size_t, int> TreeMap;
+typedef embb::containers::LockFreeHashMap<size_t, int> HashMap;
+typedef embb::containers::LockFreeSkipList<size_t, int> SkipList;
+
+template<typename Map>
+class Operator {
+private:
+  Map * map;
+  size_t numOperations;
+  size_t updateInterval;
+
+public:
+  Operator(
+    Map * map_, size_t numOperations_, size_t updateInterval_)
+  : map(map_), numOperations(numOperations_),
+    updateInterval(updateInterval_)
+  { }
+
+  void operator()(size_t thread) {
+    size_t found = 0;
+    int value;
+    unsigned int seed = static_cast<unsigned int>(thread + 1);
+    for (size_t operation = 1; operation <= numOperations; ++operation) {
+      seed = seed * 1103515245u + 12345u;
+      size_t key = 1 + (seed >> 8) % kKeyRange;
+      if (updateInterval > 0 && operation % updateInterval == 0) {
+        if ((seed >> 4) & 1) {
+          map->TryInsert(key, static_cast<int>(key));
+        }
+        else {
+          map->TryDelete(key);
+        }
+      }
+      else if (map->Get(key, value)) {
+        ++found;
+      }
+    }
+    // keep the lookups
+    if (found == 1) {
+      ::std::cout << "";
+    }
+  }
+};
+
+} // namespace
+
+template<typename Map>
+double MapBenchmark::Measure(
+  size_t numThreads, size_t numOperations, size_t updateInterval) {
+  Map map(kKeyRange);
+  for (size_t key = 1; key <= kKeyRange; key += 2) {
+    map.TryInsert(key, static_cast<int>(key));
+  }
+  return static_cast<double>(numThreads * numOperations) / RunConcurrently(
+    Operator<Map>(&map, numOperations, updateInterval), numThreads);
+}
+
+void MapBenchmark::Run(const CallArgs & params) {
+  size_t maxThreads     = (params.NumThreads() == 0)
+                          ? 64 : params.NumThreads();
+  size_t numOperations  = (params.NumElements() == 0)
+                          ? 100000 : params.NumElements();
+  size_t updateInterval = (params.QParam() <= 0)
+                          ? 10 : static_cast<size_t>(params.QParam());
+  ::std::cout << "===== Maps, " << numOperations
+              << " operations per thread on " << kKeyRange
+              << " keys, every " << updateInterval
+              << ". operation updates" << ::std::endl;
+  ComparisonTable table("threads");
+  table.AddColumn("ChromaticTree");
+  table.AddColumn("LockFreeHashMap");
+  table.AddColumn("LockFreeSkipList", 18);
+  table.WriteHeader("operations/us");
+  for (size_t numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+    table.BeginRow(numThreads);
+    table.WriteValue(Measure<TreeMap>(
+      numThreads, numOperations, updateInterval));
+    table.WriteValue(Measure<HashMap>(
+      numThreads, numOperations, updateInterval));
+    table.WriteValue(Measure<SkipList>(
+      numThreads, numOperations, updateInterval));
+  }
+}
+
+} // namespace benchmark
+} // namespace embb
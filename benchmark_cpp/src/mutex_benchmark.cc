@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <embb/benchmark/locks/mutex_benchmark.h>
+#include <embb/benchmark/internal/comparison.h>
+#include <embb/base/mutex.h>
+
+#include <iostream>
+
+namespace embb {
+namespace benchmark {
+
+using internal::ComparisonTable;
+using internal::RunConcurrently;
+
+namespace {
+
+template<typename Lock>
+class Contender {
+private:
+  Lock * lock;
+  size_t numAcquisitions;
+  size_t sectionLength;
+  volatile size_t * data;
+
+public:
+  Contender(
+    Lock * lock_, size_t numAcquisitions_, size_t sectionLength_,
+    volatile size_t * data_)
+  : lock(lock_), numAcquisitions(numAcquisitions_),
+    sectionLength(sectionLength_), data(data_)
+  { }
+
+  void operator()(size_t) {
+    for (size_t acquisition = 0; acquisition < numAcquisitions;
+         ++acquisition) {
+      embb::base::LockGuard<Lock> guard(*lock);
+      for (size_t i = 0; i < sectionLength; ++i) {
+        ++(*data);
+      }
+    }
+  }
+};
+
+} // namespace
+
+template<typename Lock>
+double MutexBenchmark::Measure(
+  size_t numThreads, size_t numAcquisitions, size_t sectionLength) {
+  Lock lock;
+  volatile size_t data = 0;
+  double duration = RunConcurrently(
+    Contender<Lock>(&lock, numAcquisitions, sectionLength, &data),
+    numThreads);
+  if (data != numThreads * numAcquisitions * sectionLength) {
+    ::std::cerr << "Lost updates in mutex benchmark" << ::std::endl;
+  }
+  return static_cast<double>(numThreads * numAcquisitions) / duration;
+}
+
+void MutexBenchmark::Run(const CallArgs & params) {
+  size_t maxThreads      = (params.NumThreads() == 0)
+                           ? 64 : params.NumThreads();
+  size_t numAcquisitions = (params.NumElements() == 0)
+                           ? 100000 : params.NumElements();
+  size_t sectionLength   = (params.QParam() <= 0)
+                           ? 1 : static_cast<size_t>(params.QParam());
+  ::std::cout << "===== Mutexes, " << numAcquisitions
+              << " acquisitions per thread, " << sectionLength
+              << " increments per critical section" << ::std::endl;
+  ComparisonTable table("threads");
+  table.AddColumn("Mutex");
+  table.AddColumn("AdaptiveMutex");
+  table.WriteHeader("acquisitions/us");
+  for (size_t numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+    table.BeginRow(numThreads);
+    table.WriteValue(Measure<embb::base::Mutex>(
+      numThreads, numAcquisitions, sectionLength));
+    table.WriteValue(Measure<embb::base::AdaptiveMutex>(
+      numThreads, numAcquisitions, sectionLength));
+  }
+}
+
+} // namespace benchmark
+} // namespace embb
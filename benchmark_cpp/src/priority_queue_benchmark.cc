@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <embb/benchmark/queues/priority_queue_benchmark.h>
+#include <embb/benchmark/internal/comparison.h>
+#include <embb/base/mutex.h>
+#include <embb/containers/multi_queue.h>
+
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace embb {
+namespace benchmark {
+
+using internal::ComparisonTable;
+using internal::RunConcurrently;
+
+namespace {
+
+static const size_t kInitialElements = 10000;
+
+typedef embb::containers::MultiQueue<unsigned int, unsigned int> MultiQueue;
+
+// Binary heap behind a single lock, with the interface of MultiQueue
+class LockedHeap {
+private:
+  typedef ::std::pair<unsigned int, unsigned int> Entry;
+  typedef ::std::priority_queue<
+    Entry, ::std::vector<Entry>, ::std::greater<Entry> > Heap;
+
+  embb::base::Mutex mutex;
+  size_t capacity;
+  Heap heap;
+
+public:
+  explicit LockedHeap(size_t capacity_) : capacity(capacity_) { }
+
+  bool TryEnqueue(unsigned int priority, unsigned int element) {
+    embb::base::LockGuard<embb::base::Mutex> guard(mutex);
+    if (heap.size() >= capacity) {
+      return false;
+    }
+    heap.push(Entry(priority, element));
+    return true;
+  }
+
+  bool TryDequeue(unsigned int & element, unsigned int & priority) {
+    embb::base::LockGuard<embb::base::Mutex> guard(mutex);
+    if (heap.empty()) {
+      return false;
+    }
+    priority = heap.top().first;
+    element = heap.top().second;
+    heap.pop();
+    return true;
+  }
+};
+
+inline unsigned int NextRandom(unsigned int & seed) {
+  seed = seed * 1103515245u + 12345u;
+  return seed >> 8;
+}
+
+template<typename Queue>
+class Operator {
+private:
+  Queue * queue;
+  size_t numOperations;
+
+public:
+  Operator(Queue * queue_, size_t numOperations_)
+  : queue(queue_), numOperations(numOperations_)
+  { }
+
+  void operator()(size_t thread) {
+    unsigned int element;
+    unsigned int priority;
+    // Seed 1 fills the queue initially
+    unsigned int seed = static_cast<unsigned int>(thread + 2);
+    for (size_t operation = 0; operation < numOperations; ++operation) {
+      if (operation % 2 == 0) {
+        queue->TryEnqueue(NextRandom(seed), 0);
+      }
+      else {
+        queue->TryDequeue(element, priority);
+      }
+    }
+  }
+};
+
+// Counts the elements with priority less than a given one, in O(log n)
+class RankCounter {
+private:
+  ::std::vector<size_t> tree;
+
+public:
+  explicit RankCounter(size_t size) : tree(size + 1, 0) { }
+
+  void Insert(size_t priority) {
+    for (size_t i = priority + 1; i < tree.size(); i += i & (0 - i)) {
+      ++tree[i];
+    }
+  }
+
+  void Remove(size_t priority) {
+    for (size_t i = priority + 1; i < tree.size(); i += i & (0 - i)) {
+      --tree[i];
+    }
+  }
+
+  size_t CountLess(size_t priority) const {
+    size_t count = 0;
+    for (size_t i = priority; i > 0; i -= i & (0 - i)) {
+      count += tree[i];
+    }
+    return count;
+  }
+};
+
+} // namespace
+
+template<typename Queue>
+double PriorityQueueBenchmark::MeasureThroughput(
+  size_t numThreads, size_t numOperations) {
+  Queue queue(kInitialElements + numThreads * numOperations);
+  unsigned int seed = 1;
+  for (size_t i = 0; i < kInitialElements; ++i) {
+    queue.TryEnqueue(NextRandom(seed), 0);
+  }
+  return static_cast<double>(numThreads * numOperations) / RunConcurrently(
+    Operator<Queue>(&queue, numOperations), numThreads);
+}
+
+template<typename Queue>
+void PriorityQueueBenchmark::MeasureRankError(
+  double & meanRank, size_t & maxRank) {
+  Queue queue(kInitialElements);
+  ::std::vector<unsigned int> priorities;
+  for (size_t i = 0; i < kInitialElements; ++i) {
+    priorities.push_back(static_cast<unsigned int>(i));
+  }
+  ::std::random_shuffle(priorities.begin(), priorities.end());
+  RankCounter remaining(kInitialElements);
+  for (size_t i = 0; i < kInitialElements; ++i) {
+    queue.TryEnqueue(priorities[i], priorities[i]);
+    remaining.Insert(priorities[i]);
+  }
+  size_t sumRank = 0;
+  maxRank = 0;
+  unsigned int element;
+  unsigned int priority;
+  while (queue.TryDequeue(element, priority)) {
+    size_t rank = remaining.CountLess(priority);
+    remaining.Remove(priority);
+    sumRank += rank;
+    maxRank = ::std::max(maxRank, rank);
+  }
+  meanRank = static_cast<double>(sumRank) /
+    static_cast<double>(kInitialElements);
+}
+
+void PriorityQueueBenchmark::Run(const CallArgs & params) {
+  size_t maxThreads    = (params.NumThreads() == 0)
+                         ? 64 : params.NumThreads();
+  size_t numOperations = (params.NumElements() == 0)
+                         ? 100000 : params.NumElements();
+  ::std::cout << "===== Priority queues, " << numOperations
+              << " operations per thread, " << kInitialElements
+              << " initial elements" << ::std::endl;
+  ComparisonTable throughput("threads");
+  throughput.AddColumn("LockedHeap");
+  throughput.AddColumn("MultiQueue");
+  throughput.WriteHeader("operations/us");
+  for (size_t numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+    throughput.BeginRow(numThreads);
+    throughput.WriteValue(MeasureThroughput<LockedHeap>(
+      numThreads, numOperations));
+    throughput.WriteValue(MeasureThroughput<MultiQueue>(
+      numThreads, numOperations));
+  }
+
+  double meanRank;
+  size_t maxRank;
+  ::std::cout << "===== Rank error of " << kInitialElements
+              << " dequeued elements" << ::std::endl;
+  ComparisonTable rankError("queue", 16);
+  rankError.AddColumn("mean", 10);
+  rankError.AddColumn("max", 10);
+  rankError.WriteHeader();
+  MeasureRankError<LockedHeap>(meanRank, maxRank);
+  rankError.BeginRow("LockedHeap");
+  rankError.WriteValue(meanRank);
+  rankError.WriteValue(maxRank);
+  MeasureRankError<MultiQueue>(meanRank, maxRank);
+  rankError.BeginRow("MultiQueue");
+  rankError.WriteValue(meanRank);
+  rankError.WriteValue(maxRank);
+}
+
+} // namespace benchmark
+} // namespace embb
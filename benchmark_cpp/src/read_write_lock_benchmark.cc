@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <embb/benchmark/locks/read_write_lock_benchmark.h>
+#include <embb/benchmark/internal/comparison.h>
+#include <embb/base/mutex.h>
+#include <embb/base/shared_mutex.h>
+
+#include <iostream>
+
+namespace embb {
+namespace benchmark {
+
+using internal::ComparisonTable;
+using internal::RunConcurrently;
+
+namespace {
+
+// Both locks behind one interface
+class ReadWriteLockAdapter {
+private:
+  embb::base::ReadWriteLock lock;
+
+public:
+  static const char * Name() { return "ReadWriteLock"; }
+  void ReadLock()    { lock.ReadLock(); }
+  void ReadUnlock()  { lock.ReadUnlock(); }
+  void WriteLock()   { lock.WriteLock(); }
+  void WriteUnlock() { lock.WriteUnlock(); }
+};
+
+class SharedMutexAdapter {
+private:
+  embb::base::SharedMutex lock;
+
+public:
+  static const char * Name() { return "SharedMutex"; }
+  void ReadLock()    { lock.LockShared(); }
+  void ReadUnlock()  { lock.UnlockShared(); }
+  void WriteLock()   { lock.Lock(); }
+  void WriteUnlock() { lock.Unlock(); }
+};
+
+template<typename Lock>
+class Accessor {
+private:
+  Lock * lock;
+  size_t numAccesses;
+  size_t writeInterval;
+  volatile size_t * data;
+
+public:
+  Accessor(
+    Lock * lock_, size_t numAccesses_, size_t writeInterval_,
+    volatile size_t * data_)
+  : lock(lock_), numAccesses(numAccesses_),
+    writeInterval(writeInterval_), data(data_)
+  { }
+
+  void operator()(size_t) {
+    size_t sum = 0;
+    for (size_t access = 1; access <= numAccesses; ++access) {
+      if (writeInterval > 0 && access % writeInterval == 0) {
+        lock->WriteLock();
+        ++(*data);
+        lock->WriteUnlock();
+      }
+      else {
+        lock->ReadLock();
+        sum += *data;
+        lock->ReadUnlock();
+      }
+    }
+    // keep the reads
+    if (sum == 1) {
+      ::std::cout << "";
+    }
+  }
+};
+
+} // namespace
+
+template<typename Lock>
+double ReadWriteLockBenchmark::Measure(
+  size_t numThreads, size_t numAccesses, size_t writeInterval) {
+  Lock lock;
+  volatile size_t data = 0;
+  return static_cast<double>(numThreads * numAccesses) / RunConcurrently(
+    Accessor<Lock>(&lock, numAccesses, writeInterval, &data), numThreads);
+}
+
+void ReadWriteLockBenchmark::Run(const CallArgs & params) {
+  size_t maxThreads    = (params.NumThreads() == 0)
+                         ? 64 : params.NumThreads();
+  size_t numAccesses   = (params.NumElements() == 0)
+                         ? 100000 : params.NumElements();
+  size_t writeInterval = (params.QParam() <= 0)
+                         ? 0 : static_cast<size_t>(params.QParam());
+  ::std::cout << "===== Read-write locks, " << numAccesses
+              << " accesses per thread";
+  if (writeInterval > 0) {
+    ::std::cout << ", every " << writeInterval << ". access writes";
+  }
+  ::std::cout << ::std::endl;
+  ComparisonTable table("threads");
+  table.AddColumn(ReadWriteLockAdapter::Name());
+  table.AddColumn(SharedMutexAdapter::Name());
+  table.WriteHeader("accesses/us");
+  for (size_t numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+    table.BeginRow(numThreads);
+    table.WriteValue(Measure<ReadWriteLockAdapter>(
+      numThreads, numAccesses, writeInterval));
+    table.WriteValue(Measure<SharedMutexAdapter>(
+      numThreads, numAccesses, writeInterval));
+  }
+}
+
+} // namespace benchmark
+} // namespace embb
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <embb/benchmark/stacks/stack_comparison_benchmark.h>
+#include <embb/benchmark/internal/comparison.h>
+#include <embb/base/memory_allocation.h>
+#include <embb/containers/lock_free_stack.h>
+#include <embb/containers/wait_free_sim_stack.h>
+
+#include <algorithm>
+#include <iostream>
+
+namespace embb {
+namespace benchmark {
+
+using internal::ComparisonTable;
+using internal::RunConcurrently;
+
+namespace {
+
+static const size_t kInitialElements = 1000;
+
+// WaitFreeSimStack supports at most 64 threads, including the main thread
+static const size_t kMaxThreads = 63;
+
+typedef embb::containers::LockFreeStack<unsigned int> LockFreeStack;
+typedef embb::containers::WaitFreeSimStack<unsigned int> WaitFreeSimStack;
+
+// WaitFreeSimStack announcing every operation for combining
+class CombiningSimStack : public WaitFreeSimStack {
+public:
+  explicit CombiningSimStack(size_t capacity)
+  : WaitFreeSimStack(capacity, 0, false, 64, 0)
+  { }
+};
+
+// WaitFreeSimStack trying a single CAS before combining
+class HybridSimStack : public WaitFreeSimStack {
+public:
+  explicit HybridSimStack(size_t capacity)
+  : WaitFreeSimStack(capacity)
+  { }
+};
+
+template<typename Stack>
+class Operator {
+private:
+  Stack * stack;
+  size_t numOperations;
+
+public:
+  Operator(Stack * stack_, size_t numOperations_)
+  : stack(stack_), numOperations(numOperations_)
+  { }
+
+  void operator()(size_t) {
+    unsigned int element;
+    for (size_t operation = 0; operation < numOperations; ++operation) {
+      if (operation % 2 == 0) {
+        stack->TryPush(static_cast<unsigned int>(operation));
+      }
+      else {
+        stack->TryPop(element);
+      }
+    }
+  }
+};
+
+} // namespace
+
+template<typename Stack>
+double StackComparisonBenchmark::MeasureThroughput(
+  size_t numThreads, size_t numOperations) {
+  // Stacks are allocated cache-aligned, as the state of WaitFreeSimStack
+  // is.
+  Stack * stack = new (
+    embb::base::Allocation::AllocateCacheAligned(sizeof(Stack)))
+    Stack(kInitialElements + numThreads * numOperations);
+  for (size_t i = 0; i < kInitialElements; ++i) {
+    stack->TryPush(static_cast<unsigned int>(i));
+  }
+  double duration = RunConcurrently(
+    Operator<Stack>(stack, numOperations), numThreads);
+  stack->~Stack();
+  embb::base::Allocation::FreeAligned(stack);
+  return static_cast<double>(numThreads * numOperations) / duration;
+}
+
+void StackComparisonBenchmark::Run(const CallArgs & params) {
+  size_t maxThreads    = (params.NumThreads() == 0)
+                         ? 32 : ::std::min(params.NumThreads(), kMaxThreads);
+  size_t numOperations = (params.NumElements() == 0)
+                         ? 100000 : params.NumElements();
+  ::std::cout << "===== Stacks, " << numOperations
+              << " operations per thread, " << kInitialElements
+              << " initial elements" << ::std::endl;
+  ComparisonTable table("threads");
+  table.AddColumn("LockFreeStack");
+  table.AddColumn("SimCombining");
+  table.AddColumn("SimFastPath");
+  table.WriteHeader("operations/us");
+  for (size_t numThreads = 1; numThreads <= maxThreads; numThreads *= 2) {
+    table.BeginRow(numThreads);
+    table.WriteValue(MeasureThroughput<LockFreeStack>(
+      numThreads, numOperations));
+    table.WriteValue(MeasureThroughput<CombiningSimStack>(
+      numThreads, numOperations));
+    table.WriteValue(MeasureThroughput<HybridSimStack>(
+      numThreads, numOperations));
+  }
+}
+
+} // namespace benchmark
+} // namespace embb
@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <embb/benchmark/sets/tree_lookup_benchmark.h>
+#include <embb/benchmark/internal/comparison.h>
+#include <embb/base/memory_allocation.h>
+#include <embb/containers/lock_free_chromatic_tree.h>
+
+#include <iostream>
+
+namespace embb {
+namespace benchmark {
+
+using internal::ComparisonTable;
+using internal::RunConcurrently;
+
+namespace {
+
+static const size_t kMinKeys = 4096;
+
+static const size_t kLookupsPerThread = 1000000;
+
+// Odd, so multiplying by it permutes the keys modulo a power of two
+static const size_t kScramble = 2654435761u;
+
+typedef embb::containers::ChromaticTree<size_t, int> TreeMap;
+typedef embb::containers::internal::ChromaticTreeNode<size_t, int> TreeNode;
+
+template<typename Tree>
+class Looker {
+private:
+  Tree * tree;
+  size_t keyMask;
+
+public:
+  Looker(Tree * tree_, size_t keyMask_)
+  : tree(tree_), keyMask(keyMask_)
+  { }
+
+  void operator()(size_t thread) {
+    size_t found = 0;
+    int value;
+    unsigned int seed = static_cast<unsigned int>(thread + 1);
+    for (size_t lookup = 0; lookup < kLookupsPerThread; ++lookup) {
+      seed = seed * 1103515245u + 12345u;
+      // Keys are drawn from [1, keyMask + 1], 0 is the undefined key
+      if (tree->Get(1 + ((seed >> 4) & keyMask), value)) {
+        ++found;
+      }
+    }
+    // keep the lookups
+    if (found == 1) {
+      ::std::cout << "";
+    }
+  }
+};
+
+} // namespace
+
+template<typename Tree>
+double TreeLookupBenchmark::MeasureLookups(
+  Tree & tree, size_t numThreads, size_t numKeys) {
+  return static_cast<double>(numThreads * kLookupsPerThread) /
+    RunConcurrently(Looker<Tree>(&tree, numKeys - 1), numThreads);
+}
+
+void TreeLookupBenchmark::Run(const CallArgs & params) {
+  size_t numThreads = (params.NumThreads() == 0)
+                      ? 1 : params.NumThreads();
+  size_t maxKeys    = (params.NumElements() == 0)
+                      ? (1u << 23) : params.NumElements();
+  size_t numKeys = kMinKeys;
+  while (2 * numKeys <= maxKeys) {
+    numKeys *= 2;
+  }
+  maxKeys = numKeys;
+  ::std::cout << "===== ChromaticTree lookups, " << numThreads
+              << " threads, " << kLookupsPerThread
+              << " lookups per thread, "
+              << sizeof(TreeNode) << " bytes per node" << ::std::endl;
+  ComparisonTable table("keys", 10);
+  table.AddColumn("MiB", 12);
+  table.AddColumn("ChromaticTree");
+  table.WriteHeader("lookups/us");
+  TreeMap * tree = embb::base::Allocation::New<TreeMap>(maxKeys);
+  size_t inserted = 0;
+  for (numKeys = kMinKeys; numKeys <= maxKeys; numKeys *= 2) {
+    // Keys of the whole range in scrambled order, so lookups of smaller
+    // trees are spread over the same range
+    for (; inserted < numKeys; ++inserted) {
+      size_t key = 1 + ((inserted * kScramble) & (maxKeys - 1));
+      tree->TryInsert(key, static_cast<int>(key));
+    }
+    table.BeginRow(numKeys);
+    table.WriteValue((2 * numKeys * sizeof(TreeNode)) / (1024 * 1024));
+    table.WriteValue(MeasureLookups(*tree, numThreads, maxKeys));
+  }
+  embb::base::Allocation::Delete(tree);
+}
+
+} // namespace benchmark
+} // namespace embb
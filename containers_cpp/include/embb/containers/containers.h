@@ -33,9 +33,12 @@
  * Concurrent data structures, mainly containers
  */
 
+#include <embb/containers/lock_free_hash_map.h>
 #include <embb/containers/lock_free_mpmc_queue.h>
+#include <embb/containers/lock_free_skip_list.h>
 #include <embb/containers/lock_free_stack.h>
 #include <embb/containers/lock_free_tree_value_pool.h>
+#include <embb/containers/multi_queue.h>
 #include <embb/containers/object_pool.h>
 #include <embb/containers/wait_free_array_value_pool.h>
 #include <embb/containers/wait_free_spsc_queue.h>
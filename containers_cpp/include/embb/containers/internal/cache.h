@@ -2,6 +2,7 @@
 #define EMBB_CONTAINERS_INTERNAL_CACHE_H_
 
 #include <embb/containers/internal/flags.h>
+#include <embb/base/c/internal/config.h>
 
 #if EMBB_CONTAINERS_DISABLE_VOLATILE
 #  define EMBB_CONTAINERS_VOLATILE
@@ -15,14 +16,14 @@
 #  define EMBB_CONTAINERS_CACHE_ALIGN
 #  define EMBB_CONTAINERS_VAR_ALIGN
 #else
-#  define EMBB_CONTAINERS_CACHE_ALIGN EMBB_ALIGN(EMBB_CACHE_LINE_SIZE)
-#  define EMBB_CONTAINERS_VAR_ALIGN EMBB_ALIGN(16)
+#  define EMBB_CONTAINERS_CACHE_ALIGN EMBB_PLATFORM_ALIGN(EMBB_PLATFORM_CACHE_LINE_SIZE)
+#  define EMBB_CONTAINERS_VAR_ALIGN EMBB_PLATFORM_ALIGN(16)
 #endif
 
 #ifdef EMBB_ARCH_X86_64
-#define EMBB_CONTAINERS_PAD_CACHE(A) ((EMBB_CACHE_LINE_SIZE - (A % EMBB_CACHE_LINE_SIZE))/sizeof(int64_t))
+#define EMBB_CONTAINERS_PAD_CACHE(A) ((EMBB_PLATFORM_CACHE_LINE_SIZE - (A % EMBB_PLATFORM_CACHE_LINE_SIZE))/sizeof(int64_t))
 #else
-#define EMBB_CONTAINERS_PAD_CACHE(A) ((EMBB_CACHE_LINE_SIZE - (A % EMBB_CACHE_LINE_SIZE))/sizeof(int32_t))
+#define EMBB_CONTAINERS_PAD_CACHE(A) ((EMBB_PLATFORM_CACHE_LINE_SIZE - (A % EMBB_PLATFORM_CACHE_LINE_SIZE))/sizeof(int32_t))
 #endif
 
 #endif /* EMBB_CONTAINERS_INTERNAL_CACHE_H_ */
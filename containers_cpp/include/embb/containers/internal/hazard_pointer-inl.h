@@ -104,12 +104,15 @@ bool HazardPointerThreadEntry<GuardType>::IsActive() {
 template< typename GuardType >
 bool HazardPointerThreadEntry<GuardType>::TryReserve() {
   bool expected = false;
-  return is_active.CompareAndSwap(expected, true);
+  // Pairs with the release in Deactivate(), so that the retired list of the
+  // previous owner is visible.
+  return is_active.CompareAndSwap(expected, true,
+    embb::base::kMemoryOrderAcquire);
 }
 
 template< typename GuardType >
 void HazardPointerThreadEntry<GuardType>::Deactivate() {
-  is_active = false;
+  is_active.Store(false, embb::base::kMemoryOrderRelease);
 }
 
 template< typename GuardType >
@@ -194,7 +197,17 @@ void HazardPointerThreadEntry<GuardType>::AddRetired(GuardType pointerToGuard) {
 template< typename GuardType >
 void HazardPointerThreadEntry<GuardType>::
 GuardPointer(int guardNumber, GuardType pointerToGuard) {
-  guarded_pointers[guardNumber] = pointerToGuard;
+  if (pointerToGuard == undefined_guard) {
+    // Clearing a guard only has to keep the preceding accesses to the
+    // guarded object before it.
+    guarded_pointers[guardNumber].Store(pointerToGuard,
+      embb::base::kMemoryOrderRelease);
+  } else {
+    // Publishing a guard needs a full fence, as the caller validates it by
+    // loading the guarded pointer again, which must not be reordered before
+    // the store.
+    guarded_pointers[guardNumber] = pointerToGuard;
+  }
 }
 
 template< typename GuardType >
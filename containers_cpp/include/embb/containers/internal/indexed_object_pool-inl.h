@@ -77,6 +77,7 @@ IndexedObjectPool<T, IndexPool, Allocator >::
 ~IndexedObjectPool()
 {
   allocator.deallocate(elements, (size_t)size);
+  delete indexPool;
 }
 
 template<typename T, class IndexPool, class Allocator>
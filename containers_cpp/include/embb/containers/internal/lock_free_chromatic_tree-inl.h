@@ -30,6 +30,8 @@
 #include <assert.h>
 #include <algorithm>
 
+#include <embb/base/c/internal/config.h>
+
 namespace embb {
 namespace containers {
 namespace internal {
@@ -40,28 +42,28 @@ ChromaticTreeNode(const Key& key, const Value& value, const int& weight,
                   ChromaticTreeNode<Key, Value>* const & left,
                   ChromaticTreeNode<Key, Value>* const & right)
     : key_(key),
-      value_(value),
-      weight_(weight),
       left_(left),
-      right_(right) {}
+      right_(right),
+      weight_(weight),
+      value_(value) {}
 
 template<typename Key, typename Value>
 ChromaticTreeNode<Key, Value>::
 ChromaticTreeNode(const Key& key, const Value& value)
     : key_(key),
-      value_(value),
-      weight_(1),
       left_(NULL),
-      right_(NULL) {}
+      right_(NULL),
+      weight_(1),
+      value_(value) {}
 
 template<typename Key, typename Value>
 ChromaticTreeNode<Key, Value>::
 ChromaticTreeNode(const ChromaticTreeNode& other)
     : key_(other.key_),
-      value_(other.value_),
-      weight_(other.weight_),
       left_(other.left_),
-      right_(other.right_) {}
+      right_(other.right_),
+      weight_(other.weight_),
+      value_(other.value_) {}
 
 template<typename Key, typename Value>
 const Key& ChromaticTreeNode<Key, Value>::GetKey() const {
@@ -293,6 +295,10 @@ Search(const Key& key, NodePtr& leaf, NodePtr& parent,
   leaf        = entry_->GetLeft();
 
   while (!IsLeaf(leaf)) {
+    // Fetch both children while the key is compared, instead of one
+    // cache miss per level after the branch is resolved
+    EMBB_PLATFORM_PREFETCH(leaf->GetLeft());
+    EMBB_PLATFORM_PREFETCH(leaf->GetRight());
     grandparent = parent;
     parent      = leaf;
     leaf        = (IsSentinel(leaf) || compare_(key, leaf->GetKey())) ?
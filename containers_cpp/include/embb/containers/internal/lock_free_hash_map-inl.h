@@ -0,0 +1,378 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef EMBB_CONTAINERS_INTERNAL_LOCK_FREE_HASH_MAP_INL_H_
+#define EMBB_CONTAINERS_INTERNAL_LOCK_FREE_HASH_MAP_INL_H_
+
+#include <embb/base/internal/config.h>
+#include <embb/base/memory_allocation.h>
+#include <embb/base/thread.h>
+
+#include <new>
+
+/*
+ * Every bucket is a sorted linked list as described in:
+ * Maged M. Michael. "High performance dynamic lock-free hash tables and
+ * list-based sets". Proceedings of the 14th Annual ACM Symposium on Parallel
+ * Algorithms and Architectures (2002): 73-82.
+ *
+ * A node is removed by first setting the lowest bit of its next pointer, which
+ * freezes the pointer, and then unlinking it from its predecessor. To replace
+ * the value of a key, the new node is linked behind the old node and the old
+ * node is marked with the same compare-and-swap, so the key never disappears
+ * from the map. Every traversal unlinks the marked nodes it encounters.
+ */
+
+namespace embb {
+namespace containers {
+namespace internal {
+
+template<typename Key, typename Value>
+LockFreeHashMapNode<Key, Value>::
+LockFreeHashMapNode(const Key& key, const Value& value)
+    : key_(key),
+      value_(value),
+      next_(NULL) {}
+
+template<typename Key, typename Value>
+inline const Key& LockFreeHashMapNode<Key, Value>::GetKey() const {
+  return key_;
+}
+
+template<typename Key, typename Value>
+inline const Value& LockFreeHashMapNode<Key, Value>::GetValue() const {
+  return value_;
+}
+
+template<typename Key, typename Value>
+inline embb::base::Atomic<LockFreeHashMapNode<Key, Value>*>&
+LockFreeHashMapNode<Key, Value>::GetNext() {
+  return next_;
+}
+
+} // namespace internal
+
+template<typename Key, typename Value, typename Hash, typename Compare,
+         typename ValuePool>
+LockFreeHashMap<Key, Value, Hash, Compare, ValuePool>::
+LockFreeHashMap(size_t capacity, Value undefined_value, Hash hash,
+                Compare compare)
+    : undefined_value_(undefined_value),
+      hash_(hash),
+      compare_(compare),
+      capacity_(capacity),
+      bucket_mask_(1),
+      buckets_(NULL),
+// Disable "this is used in base member initializer" warning.
+// We explicitly want this.
+#ifdef EMBB_PLATFORM_COMPILER_MSVC
+#pragma warning(push)
+#pragma warning(disable:4355)
+#endif
+      delete_pointer_callback_(*this, &LockFreeHashMap::DeletePointerCallback),
+#ifdef EMBB_PLATFORM_COMPILER_MSVC
+#pragma warning(pop)
+#endif
+      hazard_pointer_(delete_pointer_callback_, NULL, kGuardsPerThread),
+      // Besides the stored nodes, every thread may hold one node about to be
+      // inserted and a full list of retired nodes not yet eligible for reuse
+      node_pool_(capacity_ +
+                 embb::base::Thread::GetThreadsMaxCount() *
+                 (hazard_pointer_.GetRetiredListMaxSize() + 1)) {
+  // Use about one bucket per element, at least two
+  while (bucket_mask_ + 1 < capacity_) {
+    bucket_mask_ = (bucket_mask_ << 1) | 1;
+  }
+  buckets_ = static_cast<AtomicNodePtr*>(embb::base::Allocation::Allocate(
+    sizeof(AtomicNodePtr) * (bucket_mask_ + 1)));
+  for (size_t i = 0; i <= bucket_mask_; ++i) {
+    new (&buckets_[i]) AtomicNodePtr(NULL);
+  }
+}
+
+template<typename Key, typename Value, typename Hash, typename Compare,
+         typename ValuePool>
+LockFreeHashMap<Key, Value, Hash, Compare, ValuePool>::~LockFreeHashMap() {
+  for (size_t i = 0; i <= bucket_mask_; ++i) {
+    NodePtr node = buckets_[i].Load();
+    while (node != NULL) {
+      NodePtr next = Unmarked(node->GetNext().Load());
+      node_pool_.Free(node);
+      node = next;
+    }
+  }
+  embb::base::Allocation::Free(buckets_);
+}
+
+template<typename Key, typename Value, typename Hash, typename Compare,
+         typename ValuePool>
+bool LockFreeHashMap<Key, Value, Hash, Compare, ValuePool>::
+Get(const Key& key, Value& value) {
+  AtomicNodePtr* prev;
+  NodePtr current;
+  NodePtr next;
+  bool found = Find(GetBucket(key), key, prev, current, next);
+  if (found) {
+    value = current->GetValue();
+  }
+  ReleaseGuards();
+  return found;
+}
+
+template<typename Key, typename Value, typename Hash, typename Compare,
+         typename ValuePool>
+bool LockFreeHashMap<Key, Value, Hash, Compare, ValuePool>::
+TryInsert(const Key& key, const Value& value) {
+  Value old_value;
+  return TryInsert(key, value, old_value);
+}
+
+template<typename Key, typename Value, typename Hash, typename Compare,
+         typename ValuePool>
+bool LockFreeHashMap<Key, Value, Hash, Compare, ValuePool>::
+TryInsert(const Key& key, const Value& value, Value& old_value) {
+  NodePtr node = node_pool_.Allocate(key, value);
+  if (node == NULL) {
+    return false;
+  }
+  AtomicNodePtr& bucket = GetBucket(key);
+  AtomicNodePtr* prev;
+  NodePtr current;
+  NodePtr next;
+  for (;;) {
+    if (Find(bucket, key, prev, current, next)) {
+      // Link the new node behind the current one and mark the current one
+      // as removed in a single step
+      node->GetNext().Store(next);
+      NodePtr expected = next;
+      if (current->GetNext().CompareAndSwap(expected, Marked(node))) {
+        old_value = current->GetValue();
+        expected = current;
+        if (prev->CompareAndSwap(expected, node)) {
+          hazard_pointer_.EnqueuePointerForDeletion(current);
+        } else {
+          // Let the search unlink the replaced node
+          Find(bucket, key, prev, current, next);
+        }
+        break;
+      }
+    } else {
+      node->GetNext().Store(current);
+      NodePtr expected = current;
+      if (prev->CompareAndSwap(expected, node)) {
+        old_value = undefined_value_;
+        break;
+      }
+    }
+  }
+  ReleaseGuards();
+  return true;
+}
+
+template<typename Key, typename Value, typename Hash, typename Compare,
+         typename ValuePool>
+bool LockFreeHashMap<Key, Value, Hash, Compare, ValuePool>::
+TryDelete(const Key& key) {
+  Value old_value;
+  return TryDelete(key, old_value);
+}
+
+template<typename Key, typename Value, typename Hash, typename Compare,
+         typename ValuePool>
+bool LockFreeHashMap<Key, Value, Hash, Compare, ValuePool>::
+TryDelete(const Key& key, Value& old_value) {
+  AtomicNodePtr& bucket = GetBucket(key);
+  AtomicNodePtr* prev;
+  NodePtr current;
+  NodePtr next;
+  for (;;) {
+    if (!Find(bucket, key, prev, current, next)) {
+      ReleaseGuards();
+      return false;
+    }
+    NodePtr expected = next;
+    if (current->GetNext().CompareAndSwap(expected, Marked(next))) {
+      break;
+    }
+  }
+  old_value = current->GetValue();
+  NodePtr expected = current;
+  if (prev->CompareAndSwap(expected, next)) {
+    hazard_pointer_.EnqueuePointerForDeletion(current);
+  } else {
+    // Let the search unlink the removed node
+    Find(bucket, key, prev, current, next);
+  }
+  ReleaseGuards();
+  return true;
+}
+
+template<typename Key, typename Value, typename Hash, typename Compare,
+         typename ValuePool>
+size_t LockFreeHashMap<Key, Value, Hash, Compare, ValuePool>::
+GetCapacity() {
+  return capacity_;
+}
+
+template<typename Key, typename Value, typename Hash, typename Compare,
+         typename ValuePool>
+const Value& LockFreeHashMap<Key, Value, Hash, Compare, ValuePool>::
+GetUndefinedValue() {
+  return undefined_value_;
+}
+
+template<typename Key, typename Value, typename Hash, typename Compare,
+         typename ValuePool>
+bool LockFreeHashMap<Key, Value, Hash, Compare, ValuePool>::
+IsEmpty() {
+  for (size_t i = 0; i <= bucket_mask_; ++i) {
+    for (;;) {
+      NodePtr head = buckets_[i].Load();
+      if (head == NULL) {
+        break;
+      }
+      hazard_pointer_.GuardPointer(1, head);
+      if (buckets_[i].Load() != head) {
+        continue;
+      }
+      NodePtr next = head->GetNext().Load();
+      if (!IsMarked(next)) {
+        ReleaseGuards();
+        return false;
+      }
+      // Removed but not yet unlinked, help unlinking it
+      NodePtr expected = head;
+      if (buckets_[i].CompareAndSwap(expected, Unmarked(next))) {
+        hazard_pointer_.EnqueuePointerForDeletion(head);
+      }
+    }
+  }
+  ReleaseGuards();
+  return true;
+}
+
+template<typename Key, typename Value, typename Hash, typename Compare,
+         typename ValuePool>
+inline bool LockFreeHashMap<Key, Value, Hash, Compare, ValuePool>::
+IsMarked(NodePtr node) {
+  return (reinterpret_cast<size_t>(node) & 1) != 0;
+}
+
+template<typename Key, typename Value, typename Hash, typename Compare,
+         typename ValuePool>
+inline typename LockFreeHashMap<Key, Value, Hash, Compare, ValuePool>::NodePtr
+LockFreeHashMap<Key, Value, Hash, Compare, ValuePool>::
+Marked(NodePtr node) {
+  return reinterpret_cast<NodePtr>(reinterpret_cast<size_t>(node) | 1);
+}
+
+template<typename Key, typename Value, typename Hash, typename Compare,
+         typename ValuePool>
+inline typename LockFreeHashMap<Key, Value, Hash, Compare, ValuePool>::NodePtr
+LockFreeHashMap<Key, Value, Hash, Compare, ValuePool>::
+Unmarked(NodePtr node) {
+  return reinterpret_cast<NodePtr>(
+    reinterpret_cast<size_t>(node) & ~static_cast<size_t>(1));
+}
+
+template<typename Key, typename Value, typename Hash, typename Compare,
+         typename ValuePool>
+inline typename LockFreeHashMap<Key, Value, Hash, Compare, ValuePool>::
+AtomicNodePtr& LockFreeHashMap<Key, Value, Hash, Compare, ValuePool>::
+GetBucket(const Key& key) {
+  // Scramble the hash, so that keys differing only in their upper bits do
+  // not end up in the same bucket
+  size_t hash = hash_(key);
+  hash ^= hash >> 16;
+  hash *= 0x45d9f3b;
+  hash ^= hash >> 16;
+  return buckets_[hash & bucket_mask_];
+}
+
+template<typename Key, typename Value, typename Hash, typename Compare,
+         typename ValuePool>
+bool LockFreeHashMap<Key, Value, Hash, Compare, ValuePool>::
+Find(AtomicNodePtr& bucket, const Key& key, AtomicNodePtr*& prev,
+     NodePtr& current, NodePtr& next) {
+  for (;;) {
+    prev = &bucket;
+    current = prev->Load();
+    hazard_pointer_.GuardPointer(1, current);
+    if (prev->Load() != current) {
+      continue;
+    }
+    for (;;) {
+      if (current == NULL) {
+        return false;
+      }
+      NodePtr link = current->GetNext().Load();
+      next = Unmarked(link);
+      hazard_pointer_.GuardPointer(0, next);
+      // Both checks ensure that current was still linked while guarded next
+      // was its successor, so neither of them has been retired yet
+      if (current->GetNext().Load() != link || prev->Load() != current) {
+        break;
+      }
+      if (!IsMarked(link)) {
+        if (!compare_(current->GetKey(), key)) {
+          return !compare_(key, current->GetKey());
+        }
+        prev = &current->GetNext();
+        hazard_pointer_.GuardPointer(2, current);
+      } else {
+        NodePtr expected = current;
+        if (!prev->CompareAndSwap(expected, next)) {
+          break;
+        }
+        hazard_pointer_.EnqueuePointerForDeletion(current);
+      }
+      current = next;
+      hazard_pointer_.GuardPointer(1, current);
+    }
+  }
+}
+
+template<typename Key, typename Value, typename Hash, typename Compare,
+         typename ValuePool>
+inline void LockFreeHashMap<Key, Value, Hash, Compare, ValuePool>::
+ReleaseGuards() {
+  hazard_pointer_.GuardPointer(0, NULL);
+  hazard_pointer_.GuardPointer(1, NULL);
+  hazard_pointer_.GuardPointer(2, NULL);
+}
+
+template<typename Key, typename Value, typename Hash, typename Compare,
+         typename ValuePool>
+void LockFreeHashMap<Key, Value, Hash, Compare, ValuePool>::
+DeletePointerCallback(NodePtr node) {
+  node_pool_.Free(node);
+}
+
+} // namespace containers
+} // namespace embb
+
+#endif // EMBB_CONTAINERS_INTERNAL_LOCK_FREE_HASH_MAP_INL_H_
@@ -0,0 +1,522 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_INTERNAL_LOCK_FREE_SKIP_LIST_INL_H_
+#define EMBB_CONTAINERS_INTERNAL_LOCK_FREE_SKIP_LIST_INL_H_
+
+#include <embb/base/internal/config.h>
+#include <embb/base/c/internal/thread_index.h>
+#include <embb/base/c/errors.h>
+#include <embb/base/memory_allocation.h>
+#include <embb/base/thread.h>
+
+/*
+ * The list follows the lock-free skip list described in:
+ * Maurice Herlihy and Nir Shavit. "The Art of Multiprocessor Programming",
+ * chapter 14.4. Morgan Kaufmann (2008).
+ *
+ * A node is removed by marking its links top-down, the mark on the lowest
+ * level removes it from the map. Every search unlinks the marked nodes it
+ * encounters. To replace the value of a key, the new node is linked behind
+ * the old node on the lowest level and the old node is marked with the same
+ * compare-and-swap, as in LockFreeHashMap.
+ *
+ * The inserter of a node may still link its upper levels while the node is
+ * removed. Such a node can only be retired once both the inserter and the
+ * remover have finished and have searched for it again, which unlinks it on
+ * every level. The last of both retires it.
+ */
+
+namespace embb {
+namespace containers {
+namespace internal {
+
+template<typename Key, typename Value>
+const int LockFreeSkipListNode<Key, Value>::kMaxHeight;
+
+template<typename Key, typename Value>
+LockFreeSkipListNode<Key, Value>::
+LockFreeSkipListNode(const Key& key, const Value& value, int height)
+    : key_(key),
+      value_(value),
+      height_(height),
+      pending_(2) {
+  for (int i = 0; i < kMaxHeight; ++i) {
+    next_[i].Store(NULL);
+  }
+}
+
+template<typename Key, typename Value>
+inline const Key& LockFreeSkipListNode<Key, Value>::GetKey() const {
+  return key_;
+}
+
+template<typename Key, typename Value>
+inline const Value& LockFreeSkipListNode<Key, Value>::GetValue() const {
+  return value_;
+}
+
+template<typename Key, typename Value>
+inline int LockFreeSkipListNode<Key, Value>::GetHeight() const {
+  return height_;
+}
+
+template<typename Key, typename Value>
+inline embb::base::Atomic<LockFreeSkipListNode<Key, Value>*>&
+LockFreeSkipListNode<Key, Value>::GetNext(int level) {
+  return next_[level];
+}
+
+template<typename Key, typename Value>
+inline embb::base::Atomic<int>& LockFreeSkipListNode<Key, Value>::
+GetPending() {
+  return pending_;
+}
+
+} // namespace internal
+
+template<typename Key, typename Value, typename Compare, typename ValuePool>
+const int LockFreeSkipList<Key, Value, Compare, ValuePool>::kMaxHeight;
+
+template<typename Key, typename Value, typename Compare, typename ValuePool>
+LockFreeSkipList<Key, Value, Compare, ValuePool>::
+LockFreeSkipList(size_t capacity, Value undefined_value, Compare compare)
+    : undefined_value_(undefined_value),
+      compare_(compare),
+      capacity_(capacity),
+// Disable "this is used in base member initializer" warning.
+// We explicitly want this.
+#ifdef EMBB_PLATFORM_COMPILER_MSVC
+#pragma warning(push)
+#pragma warning(disable:4355)
+#endif
+      delete_pointer_callback_(*this,
+                               &LockFreeSkipList::DeletePointerCallback),
+#ifdef EMBB_PLATFORM_COMPILER_MSVC
+#pragma warning(pop)
+#endif
+      hazard_pointer_(delete_pointer_callback_, NULL, kGuardsPerThread),
+      // Besides the stored nodes and the head, every thread may hold one node
+      // about to be inserted, one removed node it is still inserting, and a
+      // full list of retired nodes not yet eligible for reuse
+      node_pool_(capacity_ + 1 +
+                 embb::base::Thread::GetThreadsMaxCount() *
+                 (hazard_pointer_.GetRetiredListMaxSize() + 2)),
+      head_(NULL),
+      num_seeds_(embb::base::Thread::GetThreadsMaxCount()),
+      seeds_(NULL),
+      shared_seed_(0) {
+  head_ = node_pool_.Allocate(Key(), undefined_value_, kMaxHeight);
+  seeds_ = static_cast<RandomState*>(
+    embb::base::Allocation::AllocateCacheAligned(
+      num_seeds_ * sizeof(RandomState)));
+  for (size_t i = 0; i < num_seeds_; ++i) {
+    // Distinct odd multiples of the golden ratio, never zero
+    seeds_[i].seed = static_cast<unsigned int>(i + 1) * 0x9E3779B9u;
+  }
+}
+
+template<typename Key, typename Value, typename Compare, typename ValuePool>
+LockFreeSkipList<Key, Value, Compare, ValuePool>::~LockFreeSkipList() {
+  NodePtr node = head_;
+  while (node != NULL) {
+    NodePtr next = Unmarked(node->GetNext(0).Load());
+    node_pool_.Free(node);
+    node = next;
+  }
+  embb::base::Allocation::FreeAligned(seeds_);
+}
+
+template<typename Key, typename Value, typename Compare, typename ValuePool>
+bool LockFreeSkipList<Key, Value, Compare, ValuePool>::
+Get(const Key& key, Value& value) {
+  NodePtr preds[kMaxHeight];
+  NodePtr succs[kMaxHeight];
+  bool found = Find(&key, false, preds, succs);
+  if (found) {
+    value = succs[0]->GetValue();
+  }
+  ReleaseGuards();
+  return found;
+}
+
+template<typename Key, typename Value, typename Compare, typename ValuePool>
+bool LockFreeSkipList<Key, Value, Compare, ValuePool>::
+LowerBound(const Key& key, Key& found_key, Value& value) {
+  NodePtr preds[kMaxHeight];
+  NodePtr succs[kMaxHeight];
+  Find(&key, false, preds, succs);
+  bool found = (succs[0] != NULL);
+  if (found) {
+    found_key = succs[0]->GetKey();
+    value = succs[0]->GetValue();
+  }
+  ReleaseGuards();
+  return found;
+}
+
+template<typename Key, typename Value, typename Compare, typename ValuePool>
+bool LockFreeSkipList<Key, Value, Compare, ValuePool>::
+TryInsert(const Key& key, const Value& value) {
+  Value old_value;
+  return TryInsert(key, value, old_value);
+}
+
+template<typename Key, typename Value, typename Compare, typename ValuePool>
+bool LockFreeSkipList<Key, Value, Compare, ValuePool>::
+TryInsert(const Key& key, const Value& value, Value& old_value) {
+  NodePtr node = node_pool_.Allocate(key, value, RandomHeight());
+  if (node == NULL) {
+    return false;
+  }
+  NodePtr preds[kMaxHeight];
+  NodePtr succs[kMaxHeight];
+  NodePtr replaced = NULL;
+  for (;;) {
+    if (Find(&key, false, preds, succs)) {
+      // Link the new node behind the current one and mark the current one
+      // as removed in a single step
+      NodePtr current = succs[0];
+      MarkUpperLevels(current);
+      NodePtr next = current->GetNext(0).Load();
+      if (IsMarked(next)) {
+        continue;
+      }
+      node->GetNext(0).Store(next);
+      if (current->GetNext(0).CompareAndSwap(next, Marked(node))) {
+        old_value = current->GetValue();
+        replaced = current;
+        break;
+      }
+    } else {
+      node->GetNext(0).Store(succs[0]);
+      NodePtr expected = succs[0];
+      if (preds[0]->GetNext(0).CompareAndSwap(expected, node)) {
+        old_value = undefined_value_;
+        break;
+      }
+    }
+  }
+  if (replaced != NULL) {
+    // Unlinks the replaced node on every level and finds the neighbors of
+    // the new node
+    Find(&key, false, preds, succs);
+    ReleaseNode(replaced);
+  }
+  LinkUpperLevels(node, preds, succs);
+  ReleaseGuards();
+  ReleaseNode(node);
+  return true;
+}
+
+template<typename Key, typename Value, typename Compare, typename ValuePool>
+bool LockFreeSkipList<Key, Value, Compare, ValuePool>::
+TryDelete(const Key& key) {
+  Value old_value;
+  return TryDelete(key, old_value);
+}
+
+template<typename Key, typename Value, typename Compare, typename ValuePool>
+bool LockFreeSkipList<Key, Value, Compare, ValuePool>::
+TryDelete(const Key& key, Value& old_value) {
+  NodePtr preds[kMaxHeight];
+  NodePtr succs[kMaxHeight];
+  NodePtr current;
+  for (;;) {
+    if (!Find(&key, false, preds, succs)) {
+      ReleaseGuards();
+      return false;
+    }
+    current = succs[0];
+    MarkUpperLevels(current);
+    NodePtr next = current->GetNext(0).Load();
+    if (!IsMarked(next) &&
+        current->GetNext(0).CompareAndSwap(next, Marked(next))) {
+      break;
+    }
+  }
+  old_value = current->GetValue();
+  // Unlinks the removed node on every level
+  Find(&key, false, preds, succs);
+  ReleaseGuards();
+  ReleaseNode(current);
+  return true;
+}
+
+template<typename Key, typename Value, typename Compare, typename ValuePool>
+template<typename Function>
+size_t LockFreeSkipList<Key, Value, Compare, ValuePool>::
+ForEach(Function function) {
+  return Scan(NULL, NULL, function);
+}
+
+template<typename Key, typename Value, typename Compare, typename ValuePool>
+template<typename Function>
+size_t LockFreeSkipList<Key, Value, Compare, ValuePool>::
+ForEachInRange(const Key& lower, const Key& upper, Function function) {
+  return Scan(&lower, &upper, function);
+}
+
+template<typename Key, typename Value, typename Compare, typename ValuePool>
+size_t LockFreeSkipList<Key, Value, Compare, ValuePool>::
+GetCapacity() {
+  return capacity_;
+}
+
+template<typename Key, typename Value, typename Compare, typename ValuePool>
+const Value& LockFreeSkipList<Key, Value, Compare, ValuePool>::
+GetUndefinedValue() {
+  return undefined_value_;
+}
+
+template<typename Key, typename Value, typename Compare, typename ValuePool>
+bool LockFreeSkipList<Key, Value, Compare, ValuePool>::
+IsEmpty() {
+  NodePtr preds[kMaxHeight];
+  NodePtr succs[kMaxHeight];
+  Find(NULL, false, preds, succs);
+  ReleaseGuards();
+  return succs[0] == NULL;
+}
+
+template<typename Key, typename Value, typename Compare, typename ValuePool>
+inline bool LockFreeSkipList<Key, Value, Compare, ValuePool>::
+IsMarked(NodePtr node) {
+  return (reinterpret_cast<size_t>(node) & 1) != 0;
+}
+
+template<typename Key, typename Value, typename Compare, typename ValuePool>
+inline typename LockFreeSkipList<Key, Value, Compare, ValuePool>::NodePtr
+LockFreeSkipList<Key, Value, Compare, ValuePool>::
+Marked(NodePtr node) {
+  return reinterpret_cast<NodePtr>(reinterpret_cast<size_t>(node) | 1);
+}
+
+template<typename Key, typename Value, typename Compare, typename ValuePool>
+inline typename LockFreeSkipList<Key, Value, Compare, ValuePool>::NodePtr
+LockFreeSkipList<Key, Value, Compare, ValuePool>::
+Unmarked(NodePtr node) {
+  return reinterpret_cast<NodePtr>(
+    reinterpret_cast<size_t>(node) & ~static_cast<size_t>(1));
+}
+
+template<typename Key, typename Value, typename Compare, typename ValuePool>
+inline int LockFreeSkipList<Key, Value, Compare, ValuePool>::
+LevelGuard(int level) {
+  return 2 * level;
+}
+
+template<typename Key, typename Value, typename Compare, typename ValuePool>
+inline bool LockFreeSkipList<Key, Value, Compare, ValuePool>::
+IsBefore(NodePtr node, const Key* key, bool strict) const {
+  if (key == NULL) {
+    return false;
+  }
+  if (strict) {
+    return !compare_(*key, node->GetKey());
+  }
+  return compare_(node->GetKey(), *key);
+}
+
+template<typename Key, typename Value, typename Compare, typename ValuePool>
+bool LockFreeSkipList<Key, Value, Compare, ValuePool>::
+Find(const Key* key, bool strict, NodePtr* preds, NodePtr* succs) {
+  while (!TryFind(key, strict, preds, succs)) {}
+  return key != NULL && succs[0] != NULL &&
+    !compare_(*key, succs[0]->GetKey());
+}
+
+template<typename Key, typename Value, typename Compare, typename ValuePool>
+bool LockFreeSkipList<Key, Value, Compare, ValuePool>::
+TryFind(const Key* key, bool strict, NodePtr* preds, NodePtr* succs) {
+  // The head needs no guard. Every other predecessor stays guarded by the
+  // slot it was guarded with as a successor, so every step takes only one
+  // guard, alternating between the two slots of the level.
+  NodePtr pred = head_;
+  for (int level = kMaxHeight - 1; level >= 0; --level) {
+    int guard = LevelGuard(level);
+    NodePtr current = pred->GetNext(level).Load();
+    if (IsMarked(current)) {
+      return false;
+    }
+    while (current != NULL) {
+      hazard_pointer_.GuardPointer(guard, current);
+      // Ensures that current was still linked while guarded, so it has not
+      // been retired yet
+      if (pred->GetNext(level).Load() != current) {
+        return false;
+      }
+      NodePtr next = current->GetNext(level).Load();
+      if (IsMarked(next)) {
+        NodePtr expected = current;
+        if (!pred->GetNext(level).CompareAndSwap(expected, Unmarked(next))) {
+          return false;
+        }
+        current = Unmarked(next);
+        continue;
+      }
+      if (!IsBefore(current, key, strict)) {
+        break;
+      }
+      pred = current;
+      guard ^= 1;
+      current = next;
+    }
+    preds[level] = pred;
+    succs[level] = current;
+  }
+  return true;
+}
+
+template<typename Key, typename Value, typename Compare, typename ValuePool>
+void LockFreeSkipList<Key, Value, Compare, ValuePool>::
+MarkUpperLevels(NodePtr node) {
+  for (int level = node->GetHeight() - 1; level > 0; --level) {
+    NodePtr next = node->GetNext(level).Load();
+    while (!IsMarked(next) &&
+           !node->GetNext(level).CompareAndSwap(next, Marked(next))) {}
+  }
+}
+
+template<typename Key, typename Value, typename Compare, typename ValuePool>
+void LockFreeSkipList<Key, Value, Compare, ValuePool>::
+LinkUpperLevels(NodePtr node, NodePtr* preds, NodePtr* succs) {
+  bool removed = false;
+  for (int level = 1; level < node->GetHeight() && !removed; ++level) {
+    for (;;) {
+      // Fails once the node is removed, which marks all its links
+      NodePtr next = node->GetNext(level).Load();
+      if (IsMarked(next) ||
+          (next != succs[level] &&
+           !node->GetNext(level).CompareAndSwap(next, succs[level]))) {
+        removed = true;
+        break;
+      }
+      NodePtr expected = succs[level];
+      if (preds[level]->GetNext(level).CompareAndSwap(expected, node)) {
+        break;
+      }
+      Find(&node->GetKey(), false, preds, succs);
+    }
+  }
+  if (IsMarked(node->GetNext(0).Load())) {
+    // Removed while being linked, unlink it on the levels linked too late
+    Find(&node->GetKey(), false, preds, succs);
+  }
+}
+
+template<typename Key, typename Value, typename Compare, typename ValuePool>
+template<typename Function>
+size_t LockFreeSkipList<Key, Value, Compare, ValuePool>::
+Scan(const Key* lower, const Key* upper, Function& function) {
+  NodePtr preds[kMaxHeight];
+  NodePtr succs[kMaxHeight];
+  size_t count = 0;
+  Find(lower, false, preds, succs);
+  NodePtr current = succs[0];
+  int guard = kScanGuard;
+  while (current != NULL &&
+         (upper == NULL || compare_(current->GetKey(), *upper))) {
+    function(current->GetKey(), current->GetValue());
+    ++count;
+    NodePtr next = current->GetNext(0).Load();
+    if (next == NULL) {
+      break;
+    }
+    if (!IsMarked(next)) {
+      hazard_pointer_.GuardPointer(guard, next);
+      // Both checks ensure that next was linked behind current while guarded,
+      // and that it has not been removed
+      if (current->GetNext(0).Load() == next &&
+          !IsMarked(next->GetNext(0).Load())) {
+        guard ^= 1;
+        current = next;
+        continue;
+      }
+    }
+    // Current was removed meanwhile, search for its successor
+    Key last = current->GetKey();
+    Find(&last, true, preds, succs);
+    current = succs[0];
+    guard = kScanGuard;
+  }
+  ReleaseGuards();
+  return count;
+}
+
+template<typename Key, typename Value, typename Compare, typename ValuePool>
+int LockFreeSkipList<Key, Value, Compare, ValuePool>::
+RandomHeight() {
+  unsigned int index;
+  unsigned int x;
+  bool has_index = (embb_internal_thread_index(&index) == EMBB_SUCCESS &&
+                    index < num_seeds_);
+  if (has_index) {
+    x = seeds_[index].seed;
+  } else {
+    x = shared_seed_.FetchAndAdd(0x9E3779B9u) | 1u;
+  }
+  // Marsaglia's xorshift generator
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  if (has_index) {
+    seeds_[index].seed = x;
+  }
+  int height = 1;
+  while (height < kMaxHeight && (x & 3) == 0) {
+    ++height;
+    x >>= 2;
+  }
+  return height;
+}
+
+template<typename Key, typename Value, typename Compare, typename ValuePool>
+inline void LockFreeSkipList<Key, Value, Compare, ValuePool>::
+ReleaseNode(NodePtr node) {
+  if (node->GetPending().FetchAndSub(1) == 1) {
+    hazard_pointer_.EnqueuePointerForDeletion(node);
+  }
+}
+
+template<typename Key, typename Value, typename Compare, typename ValuePool>
+inline void LockFreeSkipList<Key, Value, Compare, ValuePool>::
+ReleaseGuards() {
+  for (int i = 0; i < kGuardsPerThread; ++i) {
+    hazard_pointer_.GuardPointer(i, NULL);
+  }
+}
+
+template<typename Key, typename Value, typename Compare, typename ValuePool>
+void LockFreeSkipList<Key, Value, Compare, ValuePool>::
+DeletePointerCallback(NodePtr node) {
+  node_pool_.Free(node);
+}
+
+} // namespace containers
+} // namespace embb
+
+#endif // EMBB_CONTAINERS_INTERNAL_LOCK_FREE_SKIP_LIST_INL_H_
@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_INTERNAL_MULTI_QUEUE_INL_H_
+#define EMBB_CONTAINERS_INTERNAL_MULTI_QUEUE_INL_H_
+
+#include <embb/base/c/internal/thread_index.h>
+#include <embb/base/c/errors.h>
+#include <embb/base/memory_allocation.h>
+#include <embb/base/thread.h>
+
+#include <algorithm>
+#include <new>
+
+/*
+ * The queue follows:
+ * Hamza Rihani, Peter Sanders, and Roman Dementiev. "MultiQueues: Simple
+ * Relaxed Concurrent Priority Queues". Proceedings of the 27th ACM Symposium
+ * on Parallelism in Algorithms and Architectures (2015): 80-82.
+ *
+ * Unlike the original, which compares the cached top priorities of two heaps
+ * without locking, both heaps are locked before their tops are compared, as
+ * priorities of arbitrary type cannot be read atomically.
+ */
+
+namespace embb {
+namespace containers {
+namespace internal {
+
+template<typename Priority, typename Type, typename Compare>
+MultiQueueHeap<Priority, Type, Compare>::
+MultiQueueHeap(size_t capacity, const Compare& compare)
+    : locked_(false),
+      size_(0),
+      capacity_(capacity),
+      compare_(compare),
+      entries_(static_cast<Entry*>(
+        embb::base::Allocation::Allocate(sizeof(Entry) * capacity))) {}
+
+template<typename Priority, typename Type, typename Compare>
+MultiQueueHeap<Priority, Type, Compare>::~MultiQueueHeap() {
+  size_t size = size_.Load();
+  for (size_t i = 0; i < size; ++i) {
+    entries_[i].~Entry();
+  }
+  embb::base::Allocation::Free(entries_);
+}
+
+template<typename Priority, typename Type, typename Compare>
+inline bool MultiQueueHeap<Priority, Type, Compare>::TryLock() {
+  bool expected = false;
+  return locked_.CompareAndSwap(expected, true,
+                                embb::base::kMemoryOrderAcquire);
+}
+
+template<typename Priority, typename Type, typename Compare>
+inline void MultiQueueHeap<Priority, Type, Compare>::Unlock() {
+  locked_.Store(false, embb::base::kMemoryOrderRelease);
+}
+
+template<typename Priority, typename Type, typename Compare>
+inline size_t MultiQueueHeap<Priority, Type, Compare>::GetSize() const {
+  return size_.Load(embb::base::kMemoryOrderRelaxed);
+}
+
+template<typename Priority, typename Type, typename Compare>
+inline bool MultiQueueHeap<Priority, Type, Compare>::IsFull() const {
+  return GetSize() >= capacity_;
+}
+
+template<typename Priority, typename Type, typename Compare>
+inline const Priority&
+MultiQueueHeap<Priority, Type, Compare>::GetTopPriority() const {
+  return entries_[0].priority;
+}
+
+template<typename Priority, typename Type, typename Compare>
+void MultiQueueHeap<Priority, Type, Compare>::
+Push(const Priority& priority, const Type& element) {
+  size_t index = size_.Load(embb::base::kMemoryOrderRelaxed);
+  new (&entries_[index]) Entry(priority, element);
+  size_.Store(index + 1, embb::base::kMemoryOrderRelaxed);
+  while (index > 0) {
+    size_t parent = (index - 1) / 2;
+    if (!IsBefore(index, parent)) {
+      break;
+    }
+    ::std::swap(entries_[index], entries_[parent]);
+    index = parent;
+  }
+}
+
+template<typename Priority, typename Type, typename Compare>
+void MultiQueueHeap<Priority, Type, Compare>::
+Pop(Priority& priority, Type& element) {
+  size_t size = size_.Load(embb::base::kMemoryOrderRelaxed) - 1;
+  priority = entries_[0].priority;
+  element = entries_[0].element;
+  if (size > 0) {
+    entries_[0] = entries_[size];
+  }
+  entries_[size].~Entry();
+  size_.Store(size, embb::base::kMemoryOrderRelaxed);
+  size_t index = 0;
+  for (;;) {
+    size_t child = 2 * index + 1;
+    if (child >= size) {
+      break;
+    }
+    if (child + 1 < size && IsBefore(child + 1, child)) {
+      ++child;
+    }
+    if (!IsBefore(child, index)) {
+      break;
+    }
+    ::std::swap(entries_[index], entries_[child]);
+    index = child;
+  }
+}
+
+template<typename Priority, typename Type, typename Compare>
+inline bool MultiQueueHeap<Priority, Type, Compare>::
+IsBefore(size_t a, size_t b) const {
+  return compare_(entries_[a].priority, entries_[b].priority);
+}
+
+} // namespace internal
+
+template<typename Priority, typename Type, typename Compare>
+MultiQueue<Priority, Type, Compare>::
+MultiQueue(size_t capacity, size_t queues_per_thread, Compare compare)
+    : num_heaps_(0),
+      heap_capacity_(0),
+      heaps_(NULL),
+      num_seeds_(embb::base::Thread::GetThreadsMaxCount()),
+      seeds_(NULL),
+      shared_seed_(0),
+      compare_(compare) {
+  num_heaps_ = ::std::max(queues_per_thread, static_cast<size_t>(1)) *
+    num_seeds_;
+  heap_capacity_ = ::std::max(
+    (capacity + num_heaps_ - 1) / num_heaps_, static_cast<size_t>(1));
+
+  heaps_ = static_cast<Heap*>(embb::base::Allocation::AllocateCacheAligned(
+    num_heaps_ * sizeof(Heap)));
+  for (size_t i = 0; i < num_heaps_; ++i) {
+    new (&heaps_[i]) Heap(heap_capacity_, compare);
+  }
+
+  seeds_ = static_cast<RandomState*>(
+    embb::base::Allocation::AllocateCacheAligned(
+      num_seeds_ * sizeof(RandomState)));
+  for (size_t i = 0; i < num_seeds_; ++i) {
+    // Distinct odd multiples of the golden ratio, never zero
+    seeds_[i].seed = static_cast<unsigned int>(i + 1) * 0x9E3779B9u;
+  }
+}
+
+template<typename Priority, typename Type, typename Compare>
+MultiQueue<Priority, Type, Compare>::~MultiQueue() {
+  for (size_t i = 0; i < num_heaps_; ++i) {
+    heaps_[i].~Heap();
+  }
+  embb::base::Allocation::FreeAligned(heaps_);
+  embb::base::Allocation::FreeAligned(seeds_);
+}
+
+template<typename Priority, typename Type, typename Compare>
+size_t MultiQueue<Priority, Type, Compare>::GetCapacity() {
+  return num_heaps_ * heap_capacity_;
+}
+
+template<typename Priority, typename Type, typename Compare>
+bool MultiQueue<Priority, Type, Compare>::
+TryEnqueue(const Priority& priority, const Type& element) {
+  unsigned int* seed = GetSeed();
+  for (;;) {
+    size_t start = RandomHeap(seed);
+    bool all_full = true;
+    for (size_t i = 0; i < num_heaps_; ++i) {
+      Heap& heap = heaps_[(start + i) % num_heaps_];
+      if (heap.IsFull()) {
+        continue;
+      }
+      all_full = false;
+      if (!heap.TryLock()) {
+        continue;
+      }
+      if (!heap.IsFull()) {
+        heap.Push(priority, element);
+        heap.Unlock();
+        return true;
+      }
+      heap.Unlock();
+    }
+    if (all_full) {
+      return false;
+    }
+  }
+}
+
+template<typename Priority, typename Type, typename Compare>
+bool MultiQueue<Priority, Type, Compare>::TryDequeue(Type& element) {
+  Priority priority;
+  return TryDequeue(element, priority);
+}
+
+template<typename Priority, typename Type, typename Compare>
+bool MultiQueue<Priority, Type, Compare>::
+TryDequeue(Type& element, Priority& priority) {
+  unsigned int* seed = GetSeed();
+  for (;;) {
+    size_t first = RandomHeap(seed);
+    size_t second = RandomHeap(seed);
+    if (second == first) {
+      second = (first + 1) % num_heaps_;
+    }
+    Heap& a = heaps_[first];
+    Heap& b = heaps_[second];
+    if (num_heaps_ > 1 && (a.GetSize() > 0 || b.GetSize() > 0)) {
+      if (!a.TryLock()) {
+        continue;
+      }
+      if (!b.TryLock()) {
+        a.Unlock();
+        continue;
+      }
+      Heap* best = NULL;
+      if (a.GetSize() > 0) {
+        best = &a;
+      }
+      if (b.GetSize() > 0 && (best == NULL ||
+          compare_(b.GetTopPriority(), a.GetTopPriority()))) {
+        best = &b;
+      }
+      if (best != NULL) {
+        best->Pop(priority, element);
+      }
+      b.Unlock();
+      a.Unlock();
+      if (best != NULL) {
+        return true;
+      }
+    }
+    // Both sampled heaps are empty, fall back to visiting all of them
+    bool all_empty;
+    if (TryDequeueAny(first, element, priority, all_empty)) {
+      return true;
+    }
+    if (all_empty) {
+      return false;
+    }
+  }
+}
+
+template<typename Priority, typename Type, typename Compare>
+bool MultiQueue<Priority, Type, Compare>::
+TryDequeueAny(size_t start, Type& element, Priority& priority,
+              bool& all_empty) {
+  all_empty = true;
+  for (size_t i = 0; i < num_heaps_; ++i) {
+    Heap& heap = heaps_[(start + i) % num_heaps_];
+    if (heap.GetSize() == 0) {
+      continue;
+    }
+    all_empty = false;
+    if (!heap.TryLock()) {
+      continue;
+    }
+    if (heap.GetSize() > 0) {
+      heap.Pop(priority, element);
+      heap.Unlock();
+      return true;
+    }
+    heap.Unlock();
+  }
+  return false;
+}
+
+template<typename Priority, typename Type, typename Compare>
+unsigned int* MultiQueue<Priority, Type, Compare>::GetSeed() {
+  unsigned int index;
+  if (embb_internal_thread_index(&index) == EMBB_SUCCESS &&
+      index < num_seeds_) {
+    return &seeds_[index].seed;
+  }
+  return NULL;
+}
+
+template<typename Priority, typename Type, typename Compare>
+size_t MultiQueue<Priority, Type, Compare>::RandomHeap(unsigned int* seed) {
+  unsigned int x;
+  if (seed != NULL) {
+    x = *seed;
+  } else {
+    x = shared_seed_.FetchAndAdd(0x9E3779B9u) | 1u;
+  }
+  // Marsaglia's xorshift generator
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  if (seed != NULL) {
+    *seed = x;
+  }
+  return static_cast<size_t>(x) % num_heaps_;
+}
+
+} // namespace containers
+} // namespace embb
+
+#endif // EMBB_CONTAINERS_INTERNAL_MULTI_QUEUE_INL_H_
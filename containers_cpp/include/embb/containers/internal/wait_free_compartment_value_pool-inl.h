@@ -71,12 +71,8 @@ allocateFrom(
   size_t poolIdxStart,
   size_t poolIdxEnd)
 {
-  assert(
-    poolIdxStart >= 0 && 
-    poolIdxStart <= static_cast<unsigned int>(allocSize));
-  assert(
-    poolIdxEnd >= 0 && 
-    poolIdxEnd <= static_cast<unsigned int>(allocSize));  
+  assert(poolIdxStart <= allocSize);
+  assert(poolIdxEnd <= allocSize);
   // Try to allocate from threads pool range first: 
   for (size_t i = poolIdxStart; i != poolIdxEnd; ++i) {
     T expected;
@@ -57,24 +57,31 @@ size_t WaitFreeSPSCQueue<Type, Allocator>::GetCapacity() {
   return capacity;
 }
 
+/*
+ * Each index is written by one thread only, so it is advanced with a release
+ * store instead of an atomic increment. The release store publishes the
+ * element (or frees its slot), and the acquire load of the index owned by the
+ * other thread makes it visible before the slot is accessed.
+ */
 template<typename Type, class Allocator>
 bool WaitFreeSPSCQueue<Type, Allocator>::TryEnqueue(Type const & element) {
-  if (tail_index - head_index == capacity)
+  size_t tail = tail_index.Load(embb::base::kMemoryOrderRelaxed);
+  if (tail - head_index.Load(embb::base::kMemoryOrderAcquire) == capacity)
     return false;
 
-  queue_array[tail_index % capacity] = element;
-  this->tail_index++;
+  queue_array[tail % capacity] = element;
+  tail_index.Store(tail + 1, embb::base::kMemoryOrderRelease);
   return true;
 }
 
 template<typename Type, class Allocator>
 bool WaitFreeSPSCQueue<Type, Allocator>::TryDequeue(Type & element) {
-  if (tail_index - head_index == 0)
+  size_t head = head_index.Load(embb::base::kMemoryOrderRelaxed);
+  if (tail_index.Load(embb::base::kMemoryOrderAcquire) - head == 0)
     return false;
 
-  Type x = queue_array[head_index % capacity];
-  this->head_index++;
-  element = x;
+  element = queue_array[head % capacity];
+  head_index.Store(head + 1, embb::base::kMemoryOrderRelease);
   return true;
 }
 
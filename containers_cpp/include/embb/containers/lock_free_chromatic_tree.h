@@ -31,6 +31,8 @@
 #include <functional>
 
 #include <embb/base/mutex.h>
+#include <embb/containers/object_pool.h>
+#include <embb/containers/lock_free_tree_value_pool.h>
 
 namespace embb {
 namespace containers {
@@ -40,7 +42,9 @@ namespace internal {
  * Tree node
  * 
  * Stores the key-value pair, as well as the weight value (used for rebalancing)
- * and two pointers to child nodes (left and right).
+ * and two pointers to child nodes (left and right). The fields read while
+ * descending the tree (key and child pointers) come first, so they stay
+ * adjacent also for large values.
  * 
  * \tparam Key   Key type
  * \tparam Value Value type
@@ -115,10 +119,10 @@ class ChromaticTreeNode {
 
  private:
   const Key   key_;                      /**< Stored key */
-  const Value value_;                    /**< Stored value */
-  const int   weight_;                   /**< Weight of the node */
   ChromaticTreeNode<Key, Value>* left_;  /**< Pointer to left child node */
   ChromaticTreeNode<Key, Value>* right_; /**< Pointer to right child node */
+  const int   weight_;                   /**< Weight of the node */
+  const Value value_;                    /**< Stored value */
 };
 
 } // namespace internal
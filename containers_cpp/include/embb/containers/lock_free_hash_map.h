@@ -0,0 +1,398 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef EMBB_CONTAINERS_LOCK_FREE_HASH_MAP_H_
+#define EMBB_CONTAINERS_LOCK_FREE_HASH_MAP_H_
+
+#include <stddef.h>
+#include <functional>
+
+#include <embb/base/atomic.h>
+#include <embb/base/function.h>
+#include <embb/containers/object_pool.h>
+#include <embb/containers/lock_free_tree_value_pool.h>
+#include <embb/containers/internal/hazard_pointer.h>
+
+namespace embb {
+namespace containers {
+namespace internal {
+
+/**
+ * Hash map node
+ *
+ * Stores the key-value pair and a pointer to the next node in the same bucket.
+ * Key and value are never changed after construction, a value is replaced by
+ * replacing the whole node.
+ *
+ * \tparam Key   Key type
+ * \tparam Value Value type
+ */
+template<typename Key, typename Value>
+class LockFreeHashMapNode {
+ public:
+  /**
+   * Creates a node with the given key-value pair and no successor.
+   *
+   * \param[IN] key   Key of the new node
+   * \param[IN] value Value of the new node
+   */
+  LockFreeHashMapNode(const Key& key, const Value& value);
+
+  /**
+   * Accessor for the stored key.
+   *
+   * \return Stored key
+   */
+  const Key& GetKey() const;
+
+  /**
+   * Accessor for the stored value.
+   *
+   * \return Stored value
+   */
+  const Value& GetValue() const;
+
+  /**
+   * Accessor for the pointer to the next node. The lowest bit of the pointer
+   * is set once this node has been removed from the map.
+   *
+   * \return Reference to the atomic pointer to the next node
+   */
+  embb::base::Atomic<LockFreeHashMapNode<Key, Value>*>& GetNext();
+
+ private:
+  /**
+   * Disable copy construction and assignment.
+   */
+  LockFreeHashMapNode(const LockFreeHashMapNode&);
+  LockFreeHashMapNode& operator=(const LockFreeHashMapNode&);
+
+  const Key   key_;   /**< Stored key */
+  const Value value_; /**< Stored value */
+  embb::base::Atomic<LockFreeHashMapNode<Key, Value>*> next_; /**< Next node */
+};
+
+/**
+ * Default hash function of LockFreeHashMap
+ *
+ * Converts integral and enumeration keys to \c size_t. The map scrambles the
+ * result before selecting a bucket, so the identity is a suitable hash.
+ *
+ * \tparam Key Key type
+ */
+template<typename Key>
+struct LockFreeHashMapHash {
+  size_t operator()(const Key& key) const {
+    return static_cast<size_t>(key);
+  }
+};
+
+/**
+ * Default hash function of LockFreeHashMap for pointer keys
+ *
+ * \tparam Key Type the keys point to
+ */
+template<typename Key>
+struct LockFreeHashMapHash<Key*> {
+  size_t operator()(Key* key) const {
+    return reinterpret_cast<size_t>(key);
+  }
+};
+
+} // namespace internal
+
+/**
+ * Lock-free hash map
+ *
+ * Implements a hash map with a fixed number of buckets, each holding a sorted
+ * lock-free linked list, with support for \c Get, \c Insert and \c Delete
+ * operations. The interface matches ChromaticTree, so both can be used
+ * interchangeably where no ordered traversal is needed.
+ *
+ * Removed nodes are reclaimed using hazard pointers, and nodes are allocated
+ * from an object pool, so no operation calls the system allocator.
+ *
+ * \tparam Key       Key type
+ * \tparam Value     Value type
+ * \tparam Hash      Hash function type for the keys. An object of type \c Hash
+ *                   must be a functor taking an argument of type \c Key and
+ *                   returning a \c size_t. The default supports integral,
+ *                   enumeration and pointer keys.
+ * \tparam Compare   Custom comparator type for the keys. An object of the
+ *                   type \c Compare must be a functor taking two arguments
+ *                   \c rhs and \c lhs of type \c Key and returning \c true if
+ *                   and only if <tt>(rhs < lhs)</tt> holds. Keys comparing
+ *                   neither less nor greater are considered equal.
+ * \tparam ValuePool The value pool type used as basis for the object pool
+ *                   holding the nodes
+ */
+template<typename Key,
+         typename Value,
+         typename Hash = internal::LockFreeHashMapHash<Key>,
+         typename Compare = ::std::less<Key>,
+         typename ValuePool = LockFreeTreeValuePool<bool, false>
+         >
+class LockFreeHashMap {
+ public:
+  /**
+   * Creates a new hash map with given capacity.
+   *
+   * \memory Let \c t be the maximum number of threads and \c x be
+   *         <tt>3.75*t+1</tt>. Then, \c b pointers with \c b being \c capacity
+   *         rounded up to a power of two, <tt>x*(3*t+1)</tt> pointers for
+   *         hazard pointer management, and <tt>(capacity + t + x*t)</tt> nodes
+   *         each of size <tt>sizeof(internal::LockFreeHashMapNode<Key,
+   *         Value>)</tt> are allocated.
+   *
+   * \notthreadsafe
+   *
+   * \param[IN] capacity        Required capacity of the map
+   * \param[IN] undefined_value Object of type \c Value to be used as a dummy
+   *                            value. Defaults to <tt>Value()</tt>
+   * \param[IN] hash            Hash function object for managed keys.
+   *                            Defaults to <tt>Hash()</tt>
+   * \param[IN] compare         Custom comparator object for managed keys.
+   *                            Defaults to <tt>Compare()</tt>
+   */
+  explicit LockFreeHashMap(size_t capacity,
+                           Value undefined_value = Value(),
+                           Hash hash = Hash(),
+                           Compare compare = Compare());
+
+  /**
+   * Destroys the map.
+   *
+   * \notthreadsafe
+   */
+  ~LockFreeHashMap();
+
+  /**
+   * Tries to find a value for the given key.
+   *
+   * \param[IN]     key    Key to search for
+   * \param[IN,OUT] value  Reference to the found value. Unchanged if the given
+   *                       key is not stored in the map
+   *
+   * \return \c true if the given key was found in the map, \c false otherwise
+   *
+   * \lockfree
+   */
+  bool Get(const Key& key, Value& value);
+
+  /**
+   * Tries to insert a new key-value pair into the map. If a value for the
+   * given key is already stored in the map, replaces the stored value with the
+   * new one.
+   *
+   * \param[IN] key    New key to be inserted
+   * \param[IN] value  New value to be inserted
+   *
+   * \return \c true if the given key-value pair was successfully inserted into
+   *         the map, \c false if the map has reached its capacity
+   *
+   * \lockfree
+   */
+  bool TryInsert(const Key& key, const Value& value);
+
+  /**
+   * Tries to insert a new key-value pair into the map. If a value for the
+   * given key is already stored in the map, replaces the stored value with the
+   * new one. Also returns the original value stored in the map for the given
+   * \c key, or the \c undefined_value if the key was not present in the map.
+   *
+   * \param[IN]     key       New key to be inserted
+   * \param[IN]     value     New value to be inserted
+   * \param[IN,OUT] old_value Reference to the value previously stored in the
+   *                          map for the given key
+   *
+   * \return \c true if the given key-value pair was successfully inserted into
+   *         the map, \c false if the map has reached its capacity
+   *
+   * \lockfree
+   */
+  bool TryInsert(const Key& key, const Value& value, Value& old_value);
+
+  /**
+   * Tries to remove a given key-value pair from the map.
+   *
+   * \param[IN] key    Key to be removed
+   *
+   * \return \c true if the given key-value pair was successfully deleted from
+   *         the map, \c false if the given key was not stored in the map
+   *
+   * \lockfree
+   */
+  bool TryDelete(const Key& key);
+
+  /**
+   * Tries to remove a given key-value pair from the map, and returns the value
+   * that was stored in the map for the given key (or \c undefined_value if
+   * the key was not present in the map).
+   *
+   * \param[IN]     key       Key to be removed
+   * \param[IN,OUT] old_value Reference to the value previously stored in the
+   *                          map for the given key
+   *
+   * \return \c true if the given key-value pair was successfully deleted from
+   *         the map, \c false if the given key was not stored in the map
+   *
+   * \lockfree
+   */
+  bool TryDelete(const Key& key, Value& old_value);
+
+  /**
+   * Accessor for the capacity of the map.
+   *
+   * \return Number of key-value pairs the map can store
+   */
+  size_t       GetCapacity();
+
+  /**
+   * Accessor for the dummy value used by the map
+   *
+   * \return Object of type \c Value that is used by the map as a dummy value
+   */
+  const Value& GetUndefinedValue();
+
+  /**
+   * Checks whether the map is currently empty. The result is only reliable
+   * if no other thread modifies the map concurrently.
+   *
+   * \return \c true if the map stores no key-value pairs, \c false otherwise
+   *
+   * \lockfree
+   */
+  bool         IsEmpty();
+
+ private:
+  /**
+   * Typedef for a node of the map.
+   */
+  typedef internal::LockFreeHashMapNode<Key, Value> Node;
+  /**
+   * Typedef for a pointer to a node of the map.
+   */
+  typedef internal::LockFreeHashMapNode<Key, Value>* NodePtr;
+  /**
+   * Typedef for an atomic pointer to a node, used as bucket head and link.
+   */
+  typedef embb::base::Atomic<NodePtr> AtomicNodePtr;
+
+  /**
+   * Disable copy construction and assignment.
+   */
+  LockFreeHashMap(const LockFreeHashMap&);
+  LockFreeHashMap& operator=(const LockFreeHashMap&);
+
+  /**
+   * Checks whether the removal mark is set in the given link value.
+   */
+  static bool IsMarked(NodePtr node);
+
+  /**
+   * Returns the given link value with the removal mark set.
+   */
+  static NodePtr Marked(NodePtr node);
+
+  /**
+   * Returns the given link value with the removal mark cleared.
+   */
+  static NodePtr Unmarked(NodePtr node);
+
+  /**
+   * Selects the bucket for the given key.
+   *
+   * \param[IN] key Key to be hashed
+   *
+   * \return Reference to the head pointer of the bucket
+   */
+  AtomicNodePtr& GetBucket(const Key& key);
+
+  /**
+   * Searches the given bucket for the first node whose key is not less than
+   * \c key, unlinking removed nodes on the way. On return, \c prev points to
+   * the link referencing \c current, \c current is guarded by hazard pointer
+   * 1, \c next by hazard pointer 0, and the node owning \c prev by hazard
+   * pointer 2.
+   *
+   * \param[IN]  bucket  Bucket to be searched
+   * \param[IN]  key     Key to search for
+   * \param[OUT] prev    Link pointing to \c current
+   * \param[OUT] current First node with a key not less than \c key, or
+   *                     \c NULL if there is no such node
+   * \param[OUT] next    Successor of \c current
+   *
+   * \return \c true if the key of \c current equals \c key, \c false otherwise
+   */
+  bool Find(AtomicNodePtr& bucket, const Key& key, AtomicNodePtr*& prev,
+            NodePtr& current, NodePtr& next);
+
+  /**
+   * Clears the hazard pointers set by Find().
+   */
+  void ReleaseGuards();
+
+  /**
+   * Callback for the hazard pointers, returns a node to the pool once no
+   * thread accesses it anymore.
+   */
+  void DeletePointerCallback(NodePtr node);
+
+  /**
+   * Number of hazard pointers used by every thread.
+   */
+  static const int kGuardsPerThread = 3;
+
+  const Value   undefined_value_; /**< A dummy value used by the map */
+  const Hash    hash_;            /**< Hash function object for the keys */
+  const Compare compare_;         /**< Comparator object for the keys */
+  size_t        capacity_;        /**< User-requested capacity of the map */
+  size_t        bucket_mask_;     /**< Number of buckets minus one */
+  AtomicNodePtr* buckets_;        /**< Array of bucket heads */
+
+  /**
+   * Callback to DeletePointerCallback(), used by the hazard pointers.
+   */
+  embb::base::Function<void, NodePtr> delete_pointer_callback_;
+
+  /**
+   * The hazard pointer object, used for memory management.
+   */
+  internal::HazardPointer<NodePtr> hazard_pointer_;
+
+  /**
+   * The object pool the nodes are allocated from.
+   */
+  ObjectPool<Node, ValuePool> node_pool_;
+};
+
+} // namespace containers
+} // namespace embb
+
+#include <embb/containers/internal/lock_free_hash_map-inl.h>
+
+#endif // EMBB_CONTAINERS_LOCK_FREE_HASH_MAP_H_
@@ -0,0 +1,510 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_LOCK_FREE_SKIP_LIST_H_
+#define EMBB_CONTAINERS_LOCK_FREE_SKIP_LIST_H_
+
+#include <stddef.h>
+#include <functional>
+
+#include <embb/base/atomic.h>
+#include <embb/base/function.h>
+#include <embb/base/c/internal/config.h>
+#include <embb/containers/object_pool.h>
+#include <embb/containers/lock_free_tree_value_pool.h>
+#include <embb/containers/internal/hazard_pointer.h>
+
+namespace embb {
+namespace containers {
+namespace internal {
+
+/**
+ * Skip list node
+ *
+ * Stores the key-value pair and one link per level. Key and value are never
+ * changed after construction, a value is replaced by replacing the whole node.
+ *
+ * \tparam Key   Key type
+ * \tparam Value Value type
+ */
+template<typename Key, typename Value>
+class LockFreeSkipListNode {
+ public:
+  /**
+   * Maximum number of levels of a node. With a probability of 1/4 for every
+   * further level, this suits lists of up to 4^12 elements.
+   */
+  static const int kMaxHeight = 12;
+
+  /**
+   * Creates an unlinked node with the given key-value pair.
+   *
+   * \param[IN] key    Key of the new node
+   * \param[IN] value  Value of the new node
+   * \param[IN] height Number of levels of the new node
+   */
+  LockFreeSkipListNode(const Key& key, const Value& value, int height);
+
+  /**
+   * Accessor for the stored key.
+   *
+   * \return Stored key
+   */
+  const Key& GetKey() const;
+
+  /**
+   * Accessor for the stored value.
+   *
+   * \return Stored value
+   */
+  const Value& GetValue() const;
+
+  /**
+   * Accessor for the number of levels of this node.
+   *
+   * \return Number of levels
+   */
+  int GetHeight() const;
+
+  /**
+   * Accessor for the link to the next node on the given level. The lowest bit
+   * of the pointer is set once this node has been removed on that level.
+   *
+   * \param[IN] level Level of the link, less than GetHeight()
+   *
+   * \return Reference to the atomic pointer to the next node
+   */
+  embb::base::Atomic<LockFreeSkipListNode<Key, Value>*>& GetNext(int level);
+
+  /**
+   * Accessor for the number of parties that still use the node: the thread
+   * that inserts it and the thread that removes it. The last one to finish
+   * retires the node.
+   *
+   * \return Reference to the counter
+   */
+  embb::base::Atomic<int>& GetPending();
+
+ private:
+  /**
+   * Disable copy construction and assignment.
+   */
+  LockFreeSkipListNode(const LockFreeSkipListNode&);
+  LockFreeSkipListNode& operator=(const LockFreeSkipListNode&);
+
+  const Key               key_;     /**< Stored key */
+  const Value             value_;   /**< Stored value */
+  const int               height_;  /**< Number of levels */
+  embb::base::Atomic<int> pending_; /**< Inserter and remover still busy */
+
+  /**
+   * Links to the next nodes, one per level
+   */
+  embb::base::Atomic<LockFreeSkipListNode<Key, Value>*> next_[kMaxHeight];
+};
+
+} // namespace internal
+
+/**
+ * Lock-free skip list
+ *
+ * Implements an ordered map with support for \c Get, \c Insert and \c Delete
+ * operations like ChromaticTree, and additionally for ordered traversal and
+ * range queries with LowerBound(), ForEach() and ForEachInRange().
+ *
+ * Updates only change the links next to the affected node, so there is no
+ * rebalancing. Removed nodes are reclaimed using hazard pointers, and nodes
+ * are allocated from an object pool, so no operation calls the system
+ * allocator.
+ *
+ * Traversals are weakly consistent: they visit the keys in ascending order,
+ * every key at most once, and see every key that is present during the whole
+ * traversal, but may or may not see concurrently inserted or deleted keys.
+ *
+ * \tparam Key       Key type. Must be default constructible.
+ * \tparam Value     Value type
+ * \tparam Compare   Custom comparator type for the keys. An object of the
+ *                   type \c Compare must be a functor taking two arguments
+ *                   \c rhs and \c lhs of type \c Key and returning \c true if
+ *                   and only if <tt>(rhs < lhs)</tt> holds
+ * \tparam ValuePool The value pool type used as basis for the object pool
+ *                   holding the nodes
+ */
+template<typename Key,
+         typename Value,
+         typename Compare = ::std::less<Key>,
+         typename ValuePool = LockFreeTreeValuePool<bool, false>
+         >
+class LockFreeSkipList {
+ public:
+  /**
+   * Creates a new skip list with given capacity.
+   *
+   * \memory Let \c t be the maximum number of threads and \c x be
+   *         <tt>32.5*t+1</tt>. Then, <tt>x*(3*t+1)</tt> pointers for hazard
+   *         pointer management, \c t cache lines for random number
+   *         generators, and <tt>(capacity + 1 + 2*t + x*t)</tt> nodes each of
+   *         size <tt>sizeof(internal::LockFreeSkipListNode<Key, Value>)</tt>
+   *         are allocated.
+   *
+   * \notthreadsafe
+   *
+   * \param[IN] capacity        Required capacity of the list
+   * \param[IN] undefined_value Object of type \c Value to be used as a dummy
+   *                            value. Defaults to <tt>Value()</tt>
+   * \param[IN] compare         Custom comparator object for managed keys.
+   *                            Defaults to <tt>Compare()</tt>
+   */
+  explicit LockFreeSkipList(size_t capacity,
+                            Value undefined_value = Value(),
+                            Compare compare = Compare());
+
+  /**
+   * Destroys the list.
+   *
+   * \notthreadsafe
+   */
+  ~LockFreeSkipList();
+
+  /**
+   * Tries to find a value for the given key.
+   *
+   * \param[IN]     key    Key to search for
+   * \param[IN,OUT] value  Reference to the found value. Unchanged if the given
+   *                       key is not stored in the list
+   *
+   * \return \c true if the given key was found in the list, \c false
+   *         otherwise
+   *
+   * \lockfree
+   */
+  bool Get(const Key& key, Value& value);
+
+  /**
+   * Finds the smallest key that is not less than the given key.
+   *
+   * \param[IN]     key       Key to search for
+   * \param[IN,OUT] found_key Reference to the found key. Unchanged if there
+   *                          is no such key in the list
+   * \param[IN,OUT] value     Reference to the value of the found key.
+   *                          Unchanged if there is no such key in the list
+   *
+   * \return \c true if such a key was found in the list, \c false otherwise
+   *
+   * \lockfree
+   */
+  bool LowerBound(const Key& key, Key& found_key, Value& value);
+
+  /**
+   * Tries to insert a new key-value pair into the list. If a value for the
+   * given key is already stored in the list, replaces the stored value with
+   * the new one.
+   *
+   * \param[IN] key    New key to be inserted
+   * \param[IN] value  New value to be inserted
+   *
+   * \return \c true if the given key-value pair was successfully inserted into
+   *         the list, \c false if the list has reached its capacity
+   *
+   * \lockfree
+   */
+  bool TryInsert(const Key& key, const Value& value);
+
+  /**
+   * Tries to insert a new key-value pair into the list. If a value for the
+   * given key is already stored in the list, replaces the stored value with
+   * the new one. Also returns the original value stored in the list for the
+   * given \c key, or the \c undefined_value if the key was not present in the
+   * list.
+   *
+   * \param[IN]     key       New key to be inserted
+   * \param[IN]     value     New value to be inserted
+   * \param[IN,OUT] old_value Reference to the value previously stored in the
+   *                          list for the given key
+   *
+   * \return \c true if the given key-value pair was successfully inserted into
+   *         the list, \c false if the list has reached its capacity
+   *
+   * \lockfree
+   */
+  bool TryInsert(const Key& key, const Value& value, Value& old_value);
+
+  /**
+   * Tries to remove a given key-value pair from the list.
+   *
+   * \param[IN] key    Key to be removed
+   *
+   * \return \c true if the given key-value pair was successfully deleted from
+   *         the list, \c false if the given key was not stored in the list
+   *
+   * \lockfree
+   */
+  bool TryDelete(const Key& key);
+
+  /**
+   * Tries to remove a given key-value pair from the list, and returns the
+   * value that was stored in the list for the given key (or
+   * \c undefined_value if the key was not present in the list).
+   *
+   * \param[IN]     key       Key to be removed
+   * \param[IN,OUT] old_value Reference to the value previously stored in the
+   *                          list for the given key
+   *
+   * \return \c true if the given key-value pair was successfully deleted from
+   *         the list, \c false if the given key was not stored in the list
+   *
+   * \lockfree
+   */
+  bool TryDelete(const Key& key, Value& old_value);
+
+  /**
+   * Calls a function for every key-value pair in ascending order of the keys.
+   *
+   * \tparam Function Functor type taking a <tt>const Key&</tt> and a
+   *                  <tt>const Value&</tt>. The functor must not call other
+   *                  operations of this list.
+   *
+   * \param[IN] function Function object to be called
+   *
+   * \return Number of visited key-value pairs
+   *
+   * \lockfree
+   */
+  template<typename Function>
+  size_t ForEach(Function function);
+
+  /**
+   * Calls a function for every key-value pair with a key not less than
+   * \c lower and less than \c upper, in ascending order of the keys.
+   *
+   * \tparam Function Functor type taking a <tt>const Key&</tt> and a
+   *                  <tt>const Value&</tt>. The functor must not call other
+   *                  operations of this list.
+   *
+   * \param[IN] lower    Smallest key to be visited
+   * \param[IN] upper    Bound of the visited keys, not included
+   * \param[IN] function Function object to be called
+   *
+   * \return Number of visited key-value pairs
+   *
+   * \lockfree
+   */
+  template<typename Function>
+  size_t ForEachInRange(const Key& lower, const Key& upper,
+                        Function function);
+
+  /**
+   * Accessor for the capacity of the list.
+   *
+   * \return Number of key-value pairs the list can store
+   */
+  size_t       GetCapacity();
+
+  /**
+   * Accessor for the dummy value used by the list
+   *
+   * \return Object of type \c Value that is used by the list as a dummy value
+   */
+  const Value& GetUndefinedValue();
+
+  /**
+   * Checks whether the list is currently empty. The result is only reliable
+   * if no other thread modifies the list concurrently.
+   *
+   * \return \c true if the list stores no key-value pairs, \c false otherwise
+   *
+   * \lockfree
+   */
+  bool         IsEmpty();
+
+ private:
+  /**
+   * Typedef for a node of the list.
+   */
+  typedef internal::LockFreeSkipListNode<Key, Value> Node;
+  /**
+   * Typedef for a pointer to a node of the list.
+   */
+  typedef internal::LockFreeSkipListNode<Key, Value>* NodePtr;
+
+  /**
+   * State of the random number generator of one thread, padded to a cache
+   * line.
+   */
+  struct RandomState {
+    unsigned int seed;
+    char padding[EMBB_PLATFORM_CACHE_LINE_SIZE - sizeof(unsigned int)];
+  };
+
+  /**
+   * Disable copy construction and assignment.
+   */
+  LockFreeSkipList(const LockFreeSkipList&);
+  LockFreeSkipList& operator=(const LockFreeSkipList&);
+
+  /**
+   * Checks whether the removal mark is set in the given link value.
+   */
+  static bool IsMarked(NodePtr node);
+
+  /**
+   * Returns the given link value with the removal mark set.
+   */
+  static NodePtr Marked(NodePtr node);
+
+  /**
+   * Returns the given link value with the removal mark cleared.
+   */
+  static NodePtr Unmarked(NodePtr node);
+
+  /**
+   * Index of the first of the two hazard pointers used on the given level.
+   */
+  static int LevelGuard(int level);
+
+  /**
+   * Checks whether the given node is in front of the searched position.
+   *
+   * \param[IN] node   Node to be checked
+   * \param[IN] key    Searched key, \c NULL for the front of the list
+   * \param[IN] strict If \c true, the position behind \c key is searched,
+   *                   otherwise the position in front of it
+   */
+  bool IsBefore(NodePtr node, const Key* key, bool strict) const;
+
+  /**
+   * Searches the position of \c key on every level, unlinking removed nodes on
+   * the way. On return, \c preds[i] is the last node on level \c i in front
+   * of the position and \c succs[i] the first node behind it, all guarded by
+   * hazard pointers.
+   *
+   * \param[IN]  key    Key to search for, \c NULL for the front of the list
+   * \param[IN]  strict If \c true, nodes with a key equal to \c key are
+   *                    counted as in front of the position
+   * \param[OUT] preds  Predecessors, one per level
+   * \param[OUT] succs  Successors, one per level
+   *
+   * \return \c true if \c succs[0] holds \c key, \c false otherwise
+   */
+  bool Find(const Key* key, bool strict, NodePtr* preds, NodePtr* succs);
+
+  /**
+   * Performs one attempt of Find().
+   *
+   * \return \c false if the search has to be restarted because a node on the
+   *         path was removed concurrently, \c true otherwise
+   */
+  bool TryFind(const Key* key, bool strict, NodePtr* preds, NodePtr* succs);
+
+  /**
+   * Marks all levels of the given node except the lowest one as removed.
+   */
+  void MarkUpperLevels(NodePtr node);
+
+  /**
+   * Links a node that is already linked on the lowest level on its other
+   * levels, and unlinks it again if it was removed meanwhile.
+   */
+  void LinkUpperLevels(NodePtr node, NodePtr* preds, NodePtr* succs);
+
+  /**
+   * Calls \c function for the nodes from \c lower to \c upper.
+   */
+  template<typename Function>
+  size_t Scan(const Key* lower, const Key* upper, Function& function);
+
+  /**
+   * Returns a random node height, every further level with probability 1/4.
+   */
+  int RandomHeight();
+
+  /**
+   * Ends the use of a node by its inserter or remover, and retires the node
+   * if the other one is done already.
+   */
+  void ReleaseNode(NodePtr node);
+
+  /**
+   * Clears the hazard pointers set by Find().
+   */
+  void ReleaseGuards();
+
+  /**
+   * Callback for the hazard pointers, returns a node to the pool once no
+   * thread accesses it anymore.
+   */
+  void DeletePointerCallback(NodePtr node);
+
+  /**
+   * Number of levels of the list.
+   */
+  static const int kMaxHeight = Node::kMaxHeight;
+
+  /**
+   * Index of the first of the two hazard pointers used by Scan().
+   */
+  static const int kScanGuard = 2 * kMaxHeight;
+
+  /**
+   * Number of hazard pointers used by every thread.
+   */
+  static const int kGuardsPerThread = 2 * kMaxHeight + 2;
+
+  const Value   undefined_value_; /**< A dummy value used by the list */
+  const Compare compare_;         /**< Comparator object for the keys */
+  size_t        capacity_;        /**< User-requested capacity of the list */
+
+  /**
+   * Callback to DeletePointerCallback(), used by the hazard pointers.
+   */
+  embb::base::Function<void, NodePtr> delete_pointer_callback_;
+
+  /**
+   * The hazard pointer object, used for memory management.
+   */
+  internal::HazardPointer<NodePtr> hazard_pointer_;
+
+  /**
+   * The object pool the nodes are allocated from.
+   */
+  ObjectPool<Node, ValuePool> node_pool_;
+
+  NodePtr      head_;      /**< Sentinel in front of all nodes */
+  size_t       num_seeds_; /**< Number of random number generators */
+  RandomState* seeds_;     /**< Per-thread random number generators */
+
+  /**
+   * Source of random numbers for threads without a thread index.
+   */
+  embb::base::Atomic<unsigned int> shared_seed_;
+};
+
+} // namespace containers
+} // namespace embb
+
+#include <embb/containers/internal/lock_free_skip_list-inl.h>
+
+#endif // EMBB_CONTAINERS_LOCK_FREE_SKIP_LIST_H_
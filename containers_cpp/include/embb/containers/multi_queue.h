@@ -0,0 +1,326 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef EMBB_CONTAINERS_MULTI_QUEUE_H_
+#define EMBB_CONTAINERS_MULTI_QUEUE_H_
+
+#include <stddef.h>
+#include <functional>
+
+#include <embb/base/atomic.h>
+#include <embb/base/c/internal/config.h>
+
+namespace embb {
+namespace containers {
+namespace internal {
+
+/**
+ * Element of a MultiQueue together with its priority
+ *
+ * \tparam Priority Priority type
+ * \tparam Type     Element type
+ */
+template<typename Priority, typename Type>
+struct MultiQueueEntry {
+  MultiQueueEntry(const Priority& priority_, const Type& element_)
+      : priority(priority_), element(element_) {}
+
+  Priority priority; /**< Priority of the element */
+  Type     element;  /**< The stored element */
+};
+
+/**
+ * Sequential binary heap with a fixed capacity, protected by a try-lock
+ *
+ * All operations except TryLock(), GetSize() and IsFull() require the lock to
+ * be held by the calling thread. The heap occupies at least one cache line of
+ * its own, so neighboring heaps of a MultiQueue do not share lines.
+ *
+ * \tparam Priority Priority type
+ * \tparam Type     Element type
+ * \tparam Compare  Comparator type for the priorities
+ */
+template<typename Priority, typename Type, typename Compare>
+class MultiQueueHeap {
+ public:
+  /**
+   * Creates an empty heap that can hold \c capacity elements.
+   */
+  MultiQueueHeap(size_t capacity, const Compare& compare);
+
+  /**
+   * Destroys the heap and the elements still stored in it.
+   */
+  ~MultiQueueHeap();
+
+  /**
+   * Tries to acquire the lock of the heap without waiting.
+   *
+   * \return \c true if the lock was acquired, \c false otherwise
+   */
+  bool TryLock();
+
+  /**
+   * Releases the lock of the heap.
+   */
+  void Unlock();
+
+  /**
+   * Returns the number of stored elements. May be called without holding the
+   * lock, the result is then only a hint.
+   */
+  size_t GetSize() const;
+
+  /**
+   * Checks whether the heap is full. May be called without holding the lock,
+   * the result is then only a hint.
+   */
+  bool IsFull() const;
+
+  /**
+   * Returns the priority of the top element.
+   *
+   * \pre The heap is not empty
+   */
+  const Priority& GetTopPriority() const;
+
+  /**
+   * Adds an element to the heap.
+   *
+   * \pre The heap is not full
+   */
+  void Push(const Priority& priority, const Type& element);
+
+  /**
+   * Removes the top element from the heap.
+   *
+   * \pre The heap is not empty
+   */
+  void Pop(Priority& priority, Type& element);
+
+ private:
+  typedef MultiQueueEntry<Priority, Type> Entry;
+
+  /**
+   * Disable copy construction and assignment.
+   */
+  MultiQueueHeap(const MultiQueueHeap&);
+  MultiQueueHeap& operator=(const MultiQueueHeap&);
+
+  /**
+   * Checks whether the entry at index \c a belongs above the one at \c b.
+   */
+  bool IsBefore(size_t a, size_t b) const;
+
+  embb::base::Atomic<bool>   locked_;   /**< Lock flag */
+  embb::base::Atomic<size_t> size_;     /**< Number of stored elements */
+  const size_t               capacity_; /**< Maximum number of elements */
+  const Compare              compare_;  /**< Comparator for priorities */
+  Entry*                     entries_;  /**< Array holding the heap */
+
+  /**
+   * Keeps the fields of the next heap in an array off this cache line.
+   */
+  char padding_[EMBB_PLATFORM_CACHE_LINE_SIZE];
+};
+
+} // namespace internal
+
+/**
+ * Relaxed concurrent priority queue
+ *
+ * Implements the MultiQueue of Rihani, Sanders, and Dementiev: the elements
+ * are distributed over several sequential binary heaps, each protected by its
+ * own lock. An element is added to a randomly chosen heap, and an element is
+ * removed from the better of two randomly chosen heaps. Threads never wait
+ * for a lock but choose other heaps instead, so the queue scales with the
+ * number of threads.
+ *
+ * In exchange, TryDequeue() does not always return the element with the
+ * highest priority, but one whose rank is small on average: with \c c heaps
+ * per thread and \c p threads, the expected rank is in <tt>O(c*p)</tt>.
+ *
+ * All memory is allocated on construction.
+ *
+ * \ingroup CPP_CONTAINERS_QUEUES
+ *
+ * \tparam Priority Priority type
+ * \tparam Type     Element type
+ * \tparam Compare  Custom comparator type for the priorities. An object of
+ *                  type \c Compare must be a functor taking two arguments
+ *                  \c rhs and \c lhs of type \c Priority and returning \c true
+ *                  if and only if \c rhs is to be dequeued before \c lhs. The
+ *                  default dequeues the smallest priority first.
+ */
+template<typename Priority,
+         typename Type,
+         typename Compare = ::std::less<Priority>
+         >
+class MultiQueue {
+ public:
+  /**
+   * Creates a priority queue with the given capacity.
+   *
+   * \memory Let \c t be the maximum number of threads and \c h be
+   *         <tt>queues_per_thread*t</tt>. Then, \c h heaps of at least one
+   *         cache line each, <tt>h*ceil(capacity/h)</tt> elements of type
+   *         \c Priority and \c Type, and \c t cache lines for random number
+   *         generators are allocated.
+   *
+   * \notthreadsafe
+   *
+   * \param[IN] capacity          Required capacity of the queue
+   * \param[IN] queues_per_thread Number of heaps per thread. More heaps
+   *                              reduce contention but increase the rank of
+   *                              dequeued elements. Defaults to 2.
+   * \param[IN] compare           Custom comparator object for the priorities.
+   *                              Defaults to <tt>Compare()</tt>
+   */
+  explicit MultiQueue(size_t capacity,
+                      size_t queues_per_thread = 2,
+                      Compare compare = Compare());
+
+  /**
+   * Destroys the queue.
+   *
+   * \notthreadsafe
+   */
+  ~MultiQueue();
+
+  /**
+   * Returns the capacity of the queue.
+   *
+   * \return Number of elements the queue can hold, at least the capacity
+   *         requested on construction
+   *
+   * \waitfree
+   */
+  size_t GetCapacity();
+
+  /**
+   * Tries to add an element to the queue.
+   *
+   * \param[IN] priority Priority of the new element
+   * \param[IN] element  Element to be added
+   *
+   * \return \c true if the element was added, \c false if every heap was
+   *         full while the queue was searched
+   *
+   * \threadsafe
+   */
+  bool TryEnqueue(const Priority& priority, const Type& element);
+
+  /**
+   * Tries to remove an element with high priority from the queue.
+   * \c Priority must be default constructible to use this overload.
+   *
+   * \param[OUT] element Reference to the removed element. Unchanged if the
+   *                     operation failed.
+   *
+   * \return \c true if an element was removed, \c false if every heap was
+   *         empty while the queue was searched
+   *
+   * \threadsafe
+   */
+  bool TryDequeue(Type& element);
+
+  /**
+   * Tries to remove an element with high priority from the queue, and returns
+   * its priority.
+   *
+   * \param[OUT] element  Reference to the removed element. Unchanged if the
+   *                      operation failed.
+   * \param[OUT] priority Reference to the priority of the removed element.
+   *                      Unchanged if the operation failed.
+   *
+   * \return \c true if an element was removed, \c false if every heap was
+   *         empty while the queue was searched
+   *
+   * \threadsafe
+   */
+  bool TryDequeue(Type& element, Priority& priority);
+
+ private:
+  typedef internal::MultiQueueHeap<Priority, Type, Compare> Heap;
+
+  /**
+   * State of the random number generator of one thread, padded to a cache
+   * line.
+   */
+  struct RandomState {
+    unsigned int seed;
+    char padding[EMBB_PLATFORM_CACHE_LINE_SIZE - sizeof(unsigned int)];
+  };
+
+  /**
+   * Disable copy construction and assignment.
+   */
+  MultiQueue(const MultiQueue&);
+  MultiQueue& operator=(const MultiQueue&);
+
+  /**
+   * Returns the random number generator state of the current thread, or
+   * \c NULL if the thread has no thread index.
+   */
+  unsigned int* GetSeed();
+
+  /**
+   * Returns a random heap index.
+   *
+   * \param[IN,OUT] seed Generator state returned by GetSeed()
+   */
+  size_t RandomHeap(unsigned int* seed);
+
+  /**
+   * Visits every heap once, starting at \c start, and removes the top element
+   * of the first non-empty heap that can be locked.
+   *
+   * \return \c true if an element was removed, \c false otherwise. Sets
+   *         \c all_empty to \c true if every heap was found empty.
+   */
+  bool TryDequeueAny(size_t start, Type& element, Priority& priority,
+                     bool& all_empty);
+
+  size_t       num_heaps_;     /**< Number of heaps */
+  size_t       heap_capacity_; /**< Capacity of every heap */
+  Heap*        heaps_;         /**< Array of heaps */
+  size_t       num_seeds_;     /**< Number of random number generators */
+  RandomState* seeds_;         /**< Per-thread random number generators */
+
+  /**
+   * Source of random numbers for threads without a thread index.
+   */
+  embb::base::Atomic<unsigned int> shared_seed_;
+
+  const Compare compare_; /**< Comparator object for the priorities */
+};
+
+} // namespace containers
+} // namespace embb
+
+#include <embb/containers/internal/multi_queue-inl.h>
+
+#endif // EMBB_CONTAINERS_MULTI_QUEUE_H_
@@ -69,26 +69,34 @@ public:
 
 private:
   T value;                              ///< Node value
-  index_t enq_aid;                      ///< Enqeue accessor id
+  index_t enq_aid;                      ///< Enqeue accessor id. -1 for all but the first node of a batch. 
   embb::base::Atomic<index_t> next_idx; ///< Pool-index of next Node in list (atomic). -1 for none. 
   embb::base::Atomic<index_t> deq_aid;  ///< Dequeue accessor id (atomic). -1 for none. 
+  embb::base::Atomic<index_t> deq_last; ///< Last node dequeued by a batch dequeue claiming this node (atomic). -1 for none. 
+  embb::base::Atomic<index_t> releases; ///< Number of releases until the node can be retired (atomic). 
   
 public:
   WaitFreePhaselessQueueNode() :
     enq_aid(UndefinedIndex) {
     next_idx.Store(UndefinedIndex);
     deq_aid.Store(UndefinedIndex);
+    deq_last.Store(UndefinedIndex);
+    releases.Store(2);
   }
   WaitFreePhaselessQueueNode(const self_t & other) :
     value(other.value),
     enq_aid(other.enq_aid) {
     next_idx.Store(other.next_idx.Load());
     deq_aid.Store(other.deq_aid.Load());
+    deq_last.Store(other.deq_last.Load());
+    releases.Store(other.releases.Load());
   }
   self_t & operator=(const self_t & other) {
     if (this != &other) {
       next_idx.Store(other.next_idx.Load());
       deq_aid.Store(other.deq_aid.Load());
+      deq_last.Store(other.deq_last.Load());
+      releases.Store(other.releases.Load());
       value   = other.value;
       enq_aid = other.enq_aid;
     }
@@ -106,6 +114,8 @@ public:
     value(val), enq_aid(enqAid) {
     next_idx.Store(UndefinedIndex);
     deq_aid.Store(UndefinedIndex);
+    deq_last.Store(UndefinedIndex);
+    releases.Store(2);
   }
   inline T Value() const {
     return value;
@@ -135,6 +145,12 @@ public:
   inline embb::base::Atomic<index_t> & DequeueAID() {
     return deq_aid;
   }
+  inline embb::base::Atomic<index_t> & DequeueLast() {
+    return deq_last;
+  }
+  inline embb::base::Atomic<index_t> & Releases() {
+    return releases;
+  }
 };
 
 /// Using maximum value of OperationDesc::NodeIndex (30 bit) to represent 'undefined'. 
@@ -262,6 +278,9 @@ private:
   /// Stores one state for every concurrent accessor on the queue. 
   /// Size: Two for every concurrent accessor (needed for swapping). 
   embb::base::Atomic<index_t> * operationDescriptions;
+  /// Maximum number of elements to remove in the current dequeue 
+  /// operation of every accessor. 
+  embb::base::Atomic<index_t> * dequeueBatchSizes;
   /// Pool for element nodes in the queue. 
   NodePool      nodePool;
   /// Allocator for memory used for operation descriptions. 
@@ -361,6 +380,7 @@ public:
     // State of the queue is one operation description per queue accessor. 
     // Initialize clear state: Null-operarion for every accessor. 
     operationDescriptions = operationDescriptionAllocator.allocate(num_states);
+    dequeueBatchSizes     = operationDescriptionAllocator.allocate(num_states);
     for (size_t accessorId = 0; accessorId < num_states; ++accessorId) {
       OperationDesc op(
         false,                 // nonpending
@@ -373,6 +393,7 @@ public:
       // an operation pool element and stick to it, as 
       // a threads accessor id will not change. 
       operationDescriptions[accessorId].Store(op.Raw);
+      dequeueBatchSizes[accessorId].Store(1);
     }
   }
 
@@ -390,6 +411,9 @@ public:
     operationDescriptionAllocator.deallocate(
       operationDescriptions, 
       num_states);
+    operationDescriptionAllocator.deallocate(
+      dequeueBatchSizes,
+      num_states);
   }
 
   /**
@@ -432,6 +456,74 @@ public:
     return true; 
   }
 
+  /**
+   * Adds a range of elements to the queue in a single operation.
+   * The elements are linked to a chain of nodes before the operation is 
+   * announced, so the whole chain is appended in one help round instead 
+   * of one round per element. Either all elements are added or none. 
+   * @param [in]  first  Iterator to the first element to add. 
+   * @param [in]  last   Iterator past the last element to add. 
+   * @return  False if the queue cannot hold all elements. 
+   * @throws  embb::base::ErrorException
+   *
+   * \waitfree
+   */
+  template<typename ForwardIterator>
+  bool TryEnqueueBatch(ForwardIterator first, ForwardIterator last) {
+    if (first == last) {
+      return true;
+    }
+    index_t accessorId = Node_t::UndefinedIndex; 
+    if (!loadAccessorThreadIndex(accessorId)) {
+      EMBB_THROW(embb::base::ErrorException, 
+        "Invalid thread ID");
+    }
+    // Link elements to a chain of nodes not yet visible to other 
+    // accessors. Only the first node is registered with the accessor 
+    // id, the tail is moved over the following nodes without helping: 
+    index_t chainHeadIdx = Node_t::UndefinedIndex;
+    index_t chainTailIdx = Node_t::UndefinedIndex;
+    size_t chainLength   = 0;
+    for (; first != last; ++first) {
+      Node_t poolNode;
+      int nodeIndex = nodePool.Allocate(poolNode);
+      if (nodeIndex < 0) {
+        FreeChain(chainHeadIdx);
+        return false; // Queue is at capacity
+      }
+      index_t nodeIdx = static_cast<index_t>(nodeIndex);
+      Node_t newNode(*first, chainLength == 0
+        ? accessorId
+        : Node_t::UndefinedIndex);
+      nodePool[nodeIdx] = newNode;
+      if (chainLength == 0) {
+        chainHeadIdx = nodeIdx;
+      }
+      else {
+        nodePool[chainTailIdx].CASNext(Node_t::UndefinedIndex, nodeIdx);
+      }
+      chainTailIdx = nodeIdx;
+      ++chainLength;
+    }
+    // Guard first node of the chain until enqueue operation has 
+    // been completed: 
+    hp.GuardPointer(0, chainHeadIdx);
+    OperationDesc enqOp(
+      true,    // pending
+      true,    // enqueue
+      chainHeadIdx
+    );
+    operationDescriptions[accessorId].Store(enqOp.Raw);    
+    Help();
+    // Move tail over the appended chain: 
+    for (size_t i = 0; i < chainLength; ++i) {
+      HelpFinishEnqueue();
+    }
+    // Release guard: 
+    hp.GuardPointer(0, UndefinedGuard);
+    return true; 
+  }
+
   /**
    * @brief Dequeue an element from the queue. Returns false when called on 
    *        empty queue.
@@ -441,11 +533,43 @@ public:
    * \waitfree
    */
   bool TryDequeue(T & retElement) {
+    if (TryDequeueBatch(&retElement, 1) == 0) {
+      // Allow dequeueing from empty queue, but 
+      // return false: 
+      retElement = T();
+      return false;
+    }
+    return true; 
+  }
+
+  /**
+   * @brief Dequeue up to the given number of elements from the queue in a 
+   *        single operation. The elements are removed from the head of the 
+   *        queue at once and are written to the output iterator in queue 
+   *        order. 
+   * @param [out]  elements  Output iterator receiving the dequeued elements.
+   * @param [in]   maxCount  Maximum number of elements to dequeue.
+   * @return  Number of elements dequeued, 0 if called on empty queue.
+   * @throws  embb::base::ErrorException
+   * \waitfree
+   */
+  template<typename OutputIterator>
+  size_t TryDequeueBatch(OutputIterator elements, size_t maxCount) {
+    if (maxCount == 0) {
+      return 0;
+    }
     index_t accessorId = static_cast<index_t>(-1);
     if (!loadAccessorThreadIndex(accessorId)) {
       EMBB_THROW(embb::base::ErrorException,
         "Invalid thread ID");
     }
+    // Batch size is only written by this accessor and has to be 
+    // visible to helpers before the operation is announced: 
+    index_t batchSize = static_cast<index_t>(
+      maxCount < QUEUE_SIZE_MAX ? maxCount : QUEUE_SIZE_MAX);
+    if (dequeueBatchSizes[accessorId].Load() != batchSize) {
+      dequeueBatchSizes[accessorId].Store(batchSize);
+    }
     
     OperationDesc curOp(operationDescriptions[accessorId].Load());
     // Assert that current operation of this accessor is completed: 
@@ -470,19 +594,25 @@ public:
     // between. 
     curOp = OperationDesc(operationDescriptions[accessorId].Load());
     index_t nodeIdx = curOp.NodeIndex;
-    Node_t & node   = nodePool[nodeIdx];
     if (nodeIdx == Node_t::UndefinedIndex) {
-      // Allow dequeueing from empty queue, but 
-      // return false: 
-      retElement = T();
-      return false;
+      // Queue was empty: 
+      return 0;
     }
-    index_t deqNodeIdx = node.NextPoolIdx();
-    retElement = nodePool[deqNodeIdx].Value();
-    // Node value returned is safe, release guard on 
-    // dequeued node index: 
-    hp.EnqueuePointerForDeletion(nodeIdx);
-    return true; 
+    Node_t & node   = nodePool[nodeIdx];
+    index_t lastIdx = DequeueBatchLast(accessorId, node, node.NextPoolIdx());
+    size_t count = 0;
+    while (nodeIdx != lastIdx) {
+      index_t deqNodeIdx = nodePool[nodeIdx].NextPoolIdx();
+      *elements = nodePool[deqNodeIdx].Value();
+      ++elements;
+      ++count;
+      // Node value returned is safe, release the dequeued node 
+      // and its predecessor, which is no longer the sentinel: 
+      ReleaseNode(deqNodeIdx);
+      ReleaseNode(nodeIdx);
+      nodeIdx = deqNodeIdx;
+    }
+    return count; 
   }
   
   /**
@@ -559,6 +689,13 @@ private:
       Node_t & nextNode = nodePool[nextIdx];
       // Load accessor id from last (non-tail) element in list: 
       index_t helpAID   = nextNode.EnqueueAID();
+      if (helpAID == Node_t::UndefinedIndex) {
+        // Node follows the first node of a batch, the enqueue 
+        // operation of the batch is completed already. 
+        // Update tail pointer: 
+        tailIdx.CompareAndSwap(lastIdx, nextIdx);
+        return;
+      }
       // Load operation for accessor that started the unfinished enqueue: 
       OperationDesc helpOp(operationDescriptions[helpAID].Load());      
       // tail index still points at last node: 
@@ -699,6 +836,9 @@ private:
         // in HelpDequeue(), but guarding twice is okay:       
         hp.GuardPointer(0, firstIdx); // <<< o/s
 
+        // Resolve new head before completing the operation, so 
+        // the dequeuing accessor can read the removed nodes: 
+        index_t lastIdx = DequeueBatchLast(accessorId, first, nextIdx);
         // Set state of helped operation to NONPENDING: 
         OperationDesc newOp(
           false, // nonpending
@@ -708,13 +848,84 @@ private:
         // CAS without check as possibly another accessor 
         // already helped this dequeue operation.
         operationDescriptions[accessorId].CompareAndSwap(curOp.Raw, newOp.Raw);
-        headIdx.CompareAndSwap(firstIdx, nextIdx);
+        headIdx.CompareAndSwap(firstIdx, lastIdx);
       }
     }
     // Release guard: 
 //  hp.ReleaseGuard(1, nextIdx);
   }
 
+  /**
+   * @brief Resolves the last node removed by the dequeue operation that 
+   *        claimed the given head node. This node becomes the new head.
+   * The dequeue removes up to the batch size of the dequeuing accessor 
+   * but never moves the head past the tail. The first helper resolving 
+   * the last node publishes it in the claimed node, so every helper 
+   * moves the head to the same node.
+   * @param [in]  accessorId  Accessor id of the dequeue operation.
+   * @param [in]  first       Head node claimed by the dequeue operation.
+   * @param [in]  nextIdx     Index of the node following the head node.
+   * @return  Index of the last node removed. 
+   * \waitfree
+   */
+  index_t DequeueBatchLast(
+    index_t accessorId, Node_t & first, index_t nextIdx) {
+    index_t batchSize = dequeueBatchSizes[accessorId].Load();
+    if (batchSize <= 1) {
+      return nextIdx;
+    }
+    index_t lastIdx = first.DequeueLast().Load();
+    if (lastIdx != Node_t::UndefinedIndex) {
+      return lastIdx;
+    }
+    lastIdx = nextIdx;
+    for (index_t i = 1; i < batchSize; ++i) {
+      if (lastIdx == tailIdx.Load()) {
+        break;
+      }
+      index_t idx = nodePool[lastIdx].NextPoolIdx();
+      if (idx == Node_t::UndefinedIndex) {
+        break;
+      }
+      lastIdx = idx;
+    }
+    index_t expected = Node_t::UndefinedIndex;
+    if (!first.DequeueLast().CompareAndSwap(expected, lastIdx)) {
+      // Another helper resolved the last node first: 
+      lastIdx = expected;
+    }
+    return lastIdx;
+  }
+
+  /**
+   * @brief Releases one reference to a node and retires the node after 
+   *        the last release. 
+   * A dequeued node is referenced by the accessor reading its value and 
+   * as sentinel, until the accessor dequeuing its successor removes it. 
+   * Retiring it on the first release would let the node be reused while 
+   * its value is still being read. 
+   * @param [in]  nodeIdx  Index of the node to release.
+   * \waitfree
+   */
+  void ReleaseNode(index_t nodeIdx) {
+    if (nodePool[nodeIdx].Releases().FetchAndSub(1) == 1) {
+      hp.EnqueuePointerForDeletion(nodeIdx);
+    }
+  }
+
+  /**
+   * @brief Frees a chain of nodes that has not been enqueued.
+   * @param [in]  nodeIdx  Index of the first node in the chain.
+   * \waitfree
+   */
+  void FreeChain(index_t nodeIdx) {
+    while (nodeIdx != Node_t::UndefinedIndex) {
+      index_t nextIdx = nodePool[nodeIdx].NextPoolIdx();
+      nodePool.Free(static_cast<int>(nodeIdx));
+      nodeIdx = nextIdx;
+    }
+  }
+
   /**
    * @brief Help finishing pending operations of arbitrary accessors, including
    *        own pending operations.
@@ -75,6 +75,10 @@ public:
 /**
  * Wait-Free Stack using Elimination and Exponential Back-off
  *
+ * Operations are first applied with a single CAS on the global object
+ * state. Only if this fails repeatedly, or if announced operations are
+ * pending, an operation is announced and applied by P-Sim combining.
+ *
  * \tparam T               Type of elements contained in the stack
  * \tparam UndefinedValue  Element value representing and undefined state, 
  *                         returned as result of Push
@@ -176,12 +180,20 @@ private:
   size_t maxBackoff;
   /// Whether exponential backoff will be used on detected contention.
   bool backoffEnabled;
+  /// Number of single-CAS attempts before an operation is announced
+  /// for combining.
+  unsigned int fastPathAttempts;
+  /// Accessor threads that skip the fast path, one bit per thread ID.
+  bitword_t combiningAccessors;
   /// Maximum number of threads accessing this queue instance. 
   size_t numThreads;
   /// Callback instance for release of guarded node indices. 
   embb::base::Function< void, ElementPointer_t > delete_pointer_callback;
   /// Hazard pointer for node index (guards stack top pointer). 
   embb::containers::internal::HazardPointer< ElementPointer_t > hp;
+  /// Number of object states. Covers every thread's local state and
+  /// retired states still guarded by hazard pointers.
+  size_t numStates;
   /// Allocator for object states
   embb::base::Allocator<ObjectState> objectStateAllocator;
   /// Allocator for announced operation arguments (ArgVal)
@@ -192,7 +204,7 @@ private:
   /// guarded by hazard pointers.
   StateIndexPool stateIndexPool;
   /// Bitset recording which thread already initialized their local state
-  uint32_t threadRegistry;
+  AtomicBitVectorValue threadRegistry;
   /// Allocator for the threads' local state (will be replaced 
   /// by thread-specific variable)
   embb::base::Allocator<StackThreadState> stackThreadStateAllocator;
@@ -255,7 +267,13 @@ private:
   void initStackThreadState(
     StackThreadState * threadState,
     unsigned int accessorId) {
-    threadState->localObjectStateIndex = 0;
+    bool dummy;
+    int objectStateIndex = stateIndexPool.Allocate(dummy);
+    if (objectStateIndex < 0) {
+      EMBB_THROW(embb::base::NoMemoryException,
+        "Failed to allocate index for object state");
+    }
+    threadState->localObjectStateIndex = objectStateIndex;
     threadState->mask     = 0;
     threadState->mask    |= (BitWordOne << static_cast<bitword_t>(accessorId));
     threadState->bit      = 0;
@@ -267,6 +285,97 @@ private:
     randomNextTss.Get() = 1;
   }
   
+  /// Completes a successful update of the global object state: reserves
+  /// a new local object state, frees elements removed from the stack and
+  /// retires the replaced object state.
+  inline void RenewLocalState(
+    StackThreadState * threadState,
+    ElementPointer_t replacedStateIndex,
+    const ElementPointer_t * popElementIndices,
+    unsigned int numPopOperations) {
+    // Reserve new index from index pool:
+    bool dummy;
+    int objectStateIndex = stateIndexPool.Allocate(dummy);
+    if (objectStateIndex < 0) {
+      EMBB_THROW(embb::base::NoMemoryException,
+        "Failed to allocate index for object state");
+    }
+    // Assign new index of local object state, the previous one has
+    // been published as global object state:
+    threadState->localObjectStateIndex = objectStateIndex;
+    // Free elements removed in pop operations:
+    for (unsigned int rb = 0; rb < numPopOperations; ++rb) {
+      // Paranoia check that initial element is not freed:
+      if (popElementIndices[rb] != initialElementIndex) {
+        elementPool.Free(popElementIndices[rb]);
+      }
+    }
+    // Retire index of the replaced object state, it might still be
+    // read by threads guarding it:
+    hp.EnqueuePointerForDeletion(replacedStateIndex);
+    // Release guard on index of replaced object state:
+    hp.GuardPointer(0, UndefinedGuard);
+  }
+
+  /// Tries to apply the calling thread's operation to the global object
+  /// state with a single CAS instead of announcing it for combining.
+  /// Fails if the CAS failed or if announced operations are pending, as
+  /// these must not be overtaken indefinitely.
+  inline bool TryApplyOperationDirectly(
+    StackThreadState * threadState,
+    OperationArg arg,
+    RetVal & retVal) {
+    ElementPointer_t elementIndex;
+    ObjectStateUnpadded * localStackState = (ObjectStateUnpadded *)(
+      &stackStates[threadState->localObjectStateIndex]);
+    // Guard index of current object state:
+    ElementPointer_t stackStateIndexCurr = stackStateIndex.Load();
+    hp.GuardPointer(0, stackStateIndexCurr);
+    if (stackStateIndexCurr != stackStateIndex.Load()) {
+      hp.GuardPointer(0, UndefinedGuard);
+      return false;
+    }
+    ObjectStateUnpadded * globalStackState = (ObjectStateUnpadded *)(
+      &stackStates[stackStateIndexCurr]);
+    if (atomicTogglesVector.Load() != globalStackState->applied) {
+      hp.GuardPointer(0, UndefinedGuard);
+      return false;
+    }
+    if (arg == UndefinedValue) {
+      // == POP =======
+      elementIndex = globalStackState->head;
+      if (elementIndex == initialElementIndex) {
+        // Stack is empty in the guarded object state:
+        hp.GuardPointer(0, UndefinedGuard);
+        retVal = UndefinedValue;
+        return true;
+      }
+      *localStackState = *globalStackState;
+      Element_t headNode = elementPool[static_cast<size_t>(elementIndex)];
+      retVal = headNode.value;
+      localStackState->head = headNode.next;
+    } else {
+      // == PUSH ======
+      *localStackState = *globalStackState;
+      elementIndex = PushOperation(localStackState, threadState, arg, 0);
+      retVal = arg;
+    }
+    if (stackStateIndex.CompareAndSwap(
+          stackStateIndexCurr,
+          threadState->localObjectStateIndex)) {
+      RenewLocalState(threadState, stackStateIndexCurr, &elementIndex,
+        arg == UndefinedValue ? 1u : 0u);
+      return true;
+    }
+    // Release guard on index of current object state:
+    hp.GuardPointer(0, UndefinedGuard);
+    if (arg != UndefinedValue) {
+      // Free element allocated in failed push operation:
+      elementPool.Free(elementIndex);
+    }
+    return false;
+  }
+
   inline RetVal ApplyOperation(
     StackThreadState * threadState,
     OperationArg arg,
@@ -289,10 +398,24 @@ private:
     ObjectStateUnpadded * localStackState;
     // The current global stack object state
     ObjectStateUnpadded * globalStackState;
+    RetVal retVal;
     if (threadState->localObjectStateIndex < 0) {
       EMBB_THROW(embb::base::ErrorException,
         "Invalid state index");
     }
+    // Without contention, a single CAS on the global object state is
+    // cheaper than announcing the operation and combining:
+    const unsigned int attempts =
+      ((combiningAccessors >> accessorId) & 1) ? 0 : fastPathAttempts;
+    for (unsigned int attempt = 0; attempt < attempts; ++attempt) {
+      if (TryApplyOperationDirectly(threadState, arg, retVal)) {
+        return retVal;
+      }
+    }
+    // Every other thread may replace the global object state at most
+    // once with a direct update that checked for pending operations
+    // before this operation has been announced:
+    const size_t maxSpins = (fastPathAttempts > 0) ? numThreads + 2 : 2;
     // Prepare thread state:
     threadState->bit    ^= (BitWordOne << static_cast<size_t>(accessorId));
     threadState->toggle  = ~threadState->toggle + 1; // 2s complement negation
@@ -303,7 +426,7 @@ private:
     // Toggle accessorId's bit in atomicTogglesVector, Fetch&Add acts as a 
     // full write-barrier
     atomicTogglesVector.FetchAndAdd(threadState->toggle);    
-    for (int spin = 0; spin < 2; ++spin) {
+    for (size_t spin = 0; spin < maxSpins; ++spin) {
       // Random backoff if enabled:
       if (backoffEnabled) {
         EMBB_CONTAINERS_VOLATILE int k;
@@ -314,8 +437,13 @@ private:
           ;
         }
       }
-      // read reference to struct ObjectState
+      // read reference to struct ObjectState and guard it before it
+      // is dereferenced
       stackStateIndexCurr = stackStateIndex.Load();
+      hp.GuardPointer(0, stackStateIndexCurr);
+      if (stackStateIndexCurr != stackStateIndex.Load()) {
+        continue;
+      }
       // read reference of struct ObjectState in a local variable 
       // localStackState
       globalStackState = (ObjectStateUnpadded *)(
@@ -326,7 +454,9 @@ private:
       diffs ^= threadState->bit;
       // If this operation has already been applied, return
       if ((diffs >> accessorId) & 1) {
-        break;
+        retVal = globalStackState->ret[accessorId];
+        hp.GuardPointer(0, UndefinedGuard);
+        return retVal;
       }
       // Copy global state to local state:
       *localStackState = *globalStackState;
@@ -371,6 +501,8 @@ private:
       }
       // Update applied operations of local stack state:
       localStackState->applied = toggles;
+      // Read return value before the local state is published:
+      retVal = localStackState->ret[accessorId];
       // Store index in pool where localStackState will be stored in 
       // new stack pointer's index field:
       stackStateIndexNew = threadState->localObjectStateIndex;
@@ -378,40 +510,14 @@ private:
         EMBB_THROW(embb::base::ErrorException,
           "Invalid state index");
       }
-      // Guard index of current object state:
-      hp.GuardPointer(0, stackStateIndexCurr);
-      if (stackStateIndexCurr == stackStateIndex.Load() &&
-          stackStateIndex.CompareAndSwap(
+      if (stackStateIndex.CompareAndSwap(
             stackStateIndexCurr, 
             stackStateIndexNew)) {
-        ElementPointer_t lastLocalObjectStateIndex =
-          threadState->localObjectStateIndex;        
-        // Reserve new index from index pool:
-        bool dummy;
-        int objectStateIndex = stateIndexPool.Allocate(dummy);
-        if (objectStateIndex < 0) {
-          EMBB_THROW(embb::base::NoMemoryException,
-            "Failed to allocate index for object state");
-        }
-        // Assign new index of local object state:
-        threadState->localObjectStateIndex = objectStateIndex;
         // Operation succeeded, reduce backoff limit:
         threadState->backoff = (threadState->backoff >> 1) | 1;
-        // Free elements removed in pop operations:
-        for (int rb = 0;
-             static_cast<unsigned int>(rb) < numPopOperations;
-             ++rb) {
-          // Paranoia check that initial element is not freed:
-          if (popElementIndices[rb] != initialElementIndex) {
-            elementPool.Free(popElementIndices[rb]);
-          }
-        }
-        // Retire index of this thread's last local object state:
-        hp.EnqueuePointerForDeletion(lastLocalObjectStateIndex);
-        // Release guard on index of replaced object state:
-        hp.GuardPointer(0, UndefinedGuard);
-        // Return value from local thread state:
-        return localStackState->ret[accessorId];
+        RenewLocalState(threadState, stackStateIndexCurr,
+          popElementIndices, numPopOperations);
+        return retVal;
       }
       else {
         // Release guard on index of current object state:
@@ -421,18 +527,17 @@ private:
           threadState->backoff <<= 1;
         }
         // Free elements allocated during failed push operations:
-        for (int rb = 0;
-             static_cast<unsigned int>(rb) < numPushOperations;
-             ++rb) {
-          // Paranoia check that initial element is not freed:
-          if (popElementIndices[rb] != initialElementIndex) {
-            elementPool.Free(pushElementIndices[rb]);
-          }
+        for (unsigned int rb = 0; rb < numPushOperations; ++rb) {
+          elementPool.Free(pushElementIndices[rb]);
         }
       }
     }
-    // Return the value from the state stored at the current object 
-    // state index:
+    hp.GuardPointer(0, UndefinedGuard);
+    // The operation has been applied by now. Return the value from the
+    // state stored at the current object state index. This state might
+    // be recycled concurrently, but only as copy of an object state
+    // published after this operation has been applied, so the value
+    // is unaffected:
     return stackStates[stackStateIndex.Load()].ret[accessorId];
   }
 
@@ -449,11 +554,16 @@ public:
     size_t size,
     int nThreads = 0,
     bool enableBackoff = false,
-    unsigned int threadLocalPoolSize = LocalPoolSize)
+    unsigned int threadLocalPoolSize = LocalPoolSize,
+    unsigned int directAttempts = 2
+    /**< [IN] Number of attempts to apply an operation with a single CAS
+              before it is announced for combining, 0 to always combine */)
   : size(size),
     localPoolSize(threadLocalPoolSize),
     maxBackoff(MAX_BACK),
     backoffEnabled(enableBackoff),
+    fastPathAttempts(directAttempts),
+    combiningAccessors(0),
     // Using int for numThreads so compiler warning is raised 
     // when size and numThreads are switched by mistake.
     numThreads(nThreads <= 0
@@ -469,6 +579,15 @@ public:
 #pragma warning(pop)
 #endif
     hp(delete_pointer_callback, UndefinedGuard, 2),
+    // Every thread holds a local object state and retires at most
+    // GetRetiredListMaxSize() states, and indices in other threads'
+    // pool compartments are not available to a thread. The default
+    // state index pool has LocalPoolSize indices per compartment, other
+    // pools do not take a compartment size:
+    numStates(
+      ((localPoolSize > LocalPoolSize ? localPoolSize : LocalPoolSize) *
+        embb::base::Thread::GetThreadsMaxCount()) +
+      (numThreads * (hp.GetRetiredListMaxSize() + 2)) + 1),
     // Extend pool size by thread-local range
     elementPool(
       // Add capacity for elements allocated in 
@@ -478,9 +597,7 @@ public:
       Element_t()),
     stateIndexPool(
       internal::ReturningTrueIterator(0),
-      internal::ReturningTrueIterator(
-        (localPoolSize * numThreads * hp.GetRetiredListMaxSize()) +
-        (localPoolSize * numThreads) + 1)),   
+      internal::ReturningTrueIterator(numStates)),
     threadRegistry(0u) {
     if (numThreads > MAX_THREADS) {
       EMBB_THROW(embb::base::ErrorException,
@@ -507,8 +624,7 @@ public:
     hp.GuardPointer(0, initialStateIndex);
     operationArgs = operationArgAllocator.allocate(
       numThreads);
-    stackStates = objectStateAllocator.allocate(
-      (localPoolSize * numThreads) + 1);
+    stackStates = objectStateAllocator.allocate(numStates);
     threadStates = stackThreadStateAllocator.allocate(
       numThreads);
     // Initialize global stack pointer state:
@@ -527,7 +643,8 @@ public:
       numThreads);
     objectStateAllocator.deallocate(
       const_cast<ObjectState *>(stackStates),
-      localPoolSize * numThreads + 1);
+      numStates);
+    stackThreadStateAllocator.deallocate(threadStates, numThreads);
     hp.GuardPointer(0, UndefinedGuard);
   }
 
@@ -545,8 +662,8 @@ public:
         "TryPop: Invalid thread ID");
     }
     StackThreadState * threadState = &threadStates[tId];
-    int threadBitMask = (1 << tId);
-    if ((threadRegistry & threadBitMask) == 0) {
+    const bitword_t threadBitMask = BitWordOne << tId;
+    if ((threadRegistry.Load() & threadBitMask) == 0) {
       // Initialize local state for this thread
       initStackThreadState(threadState, tId);
       threadRegistry |= threadBitMask;
@@ -576,8 +693,8 @@ public:
         "TryPush: Invalid thread ID");
     }
     StackThreadState * threadState = &threadStates[tId];
-    int threadBitMask = (1 << tId);
-    if ((threadRegistry & threadBitMask) == 0) {
+    const bitword_t threadBitMask = BitWordOne << tId;
+    if ((threadRegistry.Load() & threadBitMask) == 0) {
       // Initialize local state for this thread
       initStackThreadState(threadState, tId);
       threadRegistry |= threadBitMask;
@@ -613,9 +730,27 @@ public:
     hp.DeactivateCurrentThread();
   }
 
+protected:
+
+  /**
+   * Lets the accessor thread with the given ID always announce its
+   * operations for combining instead of trying the fast path first.
+   * Other threads still try the fast path.
+   *
+   * \notthreadsafe
+   */
+  void DisableFastPath(unsigned int accessorId) {
+    if (accessorId >= numThreads) {
+      EMBB_THROW(embb::base::ErrorException,
+        "DisableFastPath: Invalid thread ID");
+    }
+    combiningAccessors |= (BitWordOne << accessorId);
+  }
+
 private:
 
-  /// Returns the pool index of the removed element
+  /// Returns the pool index of the removed element, or the index of the
+  /// initial element if the stack is empty
   inline ElementPointer_t PopOperation(
     ObjectStateUnpadded * stack,
     StackThreadState * threadState,
@@ -639,7 +774,7 @@ private:
       // empty:
       stack->ret[accessorId] = UndefinedValue;
     }
-    return UndefinedGuard;
+    return initialElementIndex;
   }
 
   /// Returns the pool index of the added element 
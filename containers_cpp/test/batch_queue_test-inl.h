@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CONTAINERS_CPP_TEST_BATCH_QUEUE_TEST_INL_H_
+#define CONTAINERS_CPP_TEST_BATCH_QUEUE_TEST_INL_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <embb/base/memory_allocation.h>
+
+#include "batch_queue_test.h"
+
+namespace embb {
+namespace containers {
+namespace test {
+
+template<typename Queue>
+BatchQueueTest<Queue>::BatchQueueTest()
+    : queue_(NULL) {
+  CreateUnit("BatchQueueTestSingleThread").
+      Add(&BatchQueueTest::BatchQueueTestSingleThread, this);
+  CreateUnit("BatchQueueTestCapacity").
+      Add(&BatchQueueTest::BatchQueueTestCapacity, this);
+  CreateUnit("BatchQueueTestMultiThread").
+      Pre(&BatchQueueTest::BatchQueueTestMultiThread_Pre, this).
+      Add(&BatchQueueTest::BatchQueueTestMultiThread_ThreadMethod,
+          this, NUM_TEST_THREADS, 1).
+      Post(&BatchQueueTest::BatchQueueTestMultiThread_Post, this);
+}
+
+template<typename Queue>
+void BatchQueueTest<Queue>::
+BatchQueueTestSingleThread() {
+  Queue queue(MAX_BATCH_SIZE * MAX_BATCH_SIZE);
+  ::std::vector<Element> batch;
+  ::std::vector<Element> dequeued;
+  Element next_enqueued = 0;
+  Element next_dequeued = 0;
+  // Batches of every size are dequeued in the order of enqueueing,
+  // mixed with single element operations
+  for (int size = 1; size <= MAX_BATCH_SIZE; ++size) {
+    batch.clear();
+    for (int i = 0; i < size; ++i) {
+      batch.push_back(next_enqueued++);
+    }
+    PT_ASSERT_MSG(queue.TryEnqueueBatch(batch.begin(), batch.end()),
+      "Failed to enqueue batch.");
+    PT_ASSERT(queue.TryEnqueue(next_enqueued++));
+    dequeued.assign(static_cast<size_t>(size), -1);
+    PT_ASSERT_EQ(queue.TryDequeueBatch(dequeued.begin(),
+                                       static_cast<size_t>(size)),
+                 static_cast<size_t>(size));
+    for (int i = 0; i < size; ++i) {
+      PT_ASSERT_EQ(dequeued[static_cast<size_t>(i)], next_dequeued++);
+    }
+  }
+  // The remaining elements are returned, even if more are requested
+  int remaining = next_enqueued - next_dequeued;
+  dequeued.assign(static_cast<size_t>(MAX_BATCH_SIZE * MAX_BATCH_SIZE), -1);
+  PT_ASSERT_EQ(queue.TryDequeueBatch(dequeued.begin(), dequeued.size()),
+               static_cast<size_t>(remaining));
+  for (int i = 0; i < remaining; ++i) {
+    PT_ASSERT_EQ(dequeued[static_cast<size_t>(i)], next_dequeued++);
+  }
+  // Empty batches and empty queue
+  PT_ASSERT(queue.TryEnqueueBatch(batch.begin(), batch.begin()));
+  PT_ASSERT_EQ(queue.TryDequeueBatch(dequeued.begin(), 0), 0u);
+  PT_ASSERT_EQ(queue.TryDequeueBatch(dequeued.begin(), dequeued.size()), 0u);
+  Element element;
+  PT_ASSERT(!queue.TryDequeue(element));
+}
+
+template<typename Queue>
+void BatchQueueTest<Queue>::
+BatchQueueTestCapacity() {
+  Queue queue(MAX_BATCH_SIZE);
+  // A batch exceeding the capacity is not enqueued at all
+  ::std::vector<Element> batch(1 << 16, 1);
+  PT_ASSERT(!queue.TryEnqueueBatch(batch.begin(), batch.end()));
+  Element element;
+  PT_ASSERT(!queue.TryDequeue(element));
+  // The nodes of the failed batch are available again
+  batch.resize(MAX_BATCH_SIZE);
+  for (int i = 0; i < 3; ++i) {
+    PT_ASSERT(queue.TryEnqueueBatch(batch.begin(), batch.end()));
+    PT_ASSERT_EQ(queue.TryDequeueBatch(batch.begin(), batch.size()),
+                 batch.size());
+  }
+}
+
+template<typename Queue>
+void BatchQueueTest<Queue>::
+BatchQueueTestMultiThread_Pre() {
+  // The queue has cache-aligned members
+  queue_ = new (embb::base::Allocation::AllocateCacheAligned(sizeof(Queue)))
+    Queue(NUM_TEST_THREADS * NUM_ELEMENTS_PER_THREAD);
+  dequeued_.clear();
+  dequeued_.resize(NUM_TEST_THREADS);
+}
+
+template<typename Queue>
+void BatchQueueTest<Queue>::
+BatchQueueTestMultiThread_ThreadMethod() {
+  // Every thread enqueues its own elements in batches of varying size
+  // and dequeues batches of whatever it finds
+  size_t thread_id = partest::TestSuite::GetCurrentThreadID();
+  ::std::vector<Element>& dequeued = dequeued_[thread_id];
+  ::std::vector<Element> batch;
+  Element first = static_cast<Element>(thread_id) * NUM_ELEMENTS_PER_THREAD;
+  Element next = first;
+  for (int round = 0; next < first + NUM_ELEMENTS_PER_THREAD; ++round) {
+    int size = ::std::min(round % MAX_BATCH_SIZE + 1,
+                          first + NUM_ELEMENTS_PER_THREAD - next);
+    batch.clear();
+    for (int i = 0; i < size; ++i) {
+      batch.push_back(next++);
+    }
+    PT_ASSERT_MSG(queue_->TryEnqueueBatch(batch.begin(), batch.end()),
+      "Failed to enqueue batch.");
+    batch.assign(static_cast<size_t>(MAX_BATCH_SIZE), -1);
+    size_t count = queue_->TryDequeueBatch(
+      batch.begin(), static_cast<size_t>((round * 7) % MAX_BATCH_SIZE + 1));
+    dequeued.insert(dequeued.end(), batch.begin(),
+                    batch.begin() + static_cast<ptrdiff_t>(count));
+  }
+}
+
+template<typename Queue>
+void BatchQueueTest<Queue>::
+BatchQueueTestMultiThread_Post() {
+  // Elements of one producer are dequeued by a single consumer in the
+  // order of enqueueing
+  for (size_t t = 0; t < dequeued_.size(); ++t) {
+    ::std::vector<Element> last(NUM_TEST_THREADS, -1);
+    for (size_t i = 0; i < dequeued_[t].size(); ++i) {
+      Element element = dequeued_[t][i];
+      PT_ASSERT_MSG(element >= 0 &&
+        element < NUM_TEST_THREADS * NUM_ELEMENTS_PER_THREAD,
+        "Dequeued element was never enqueued.");
+      size_t producer = static_cast<size_t>(element / NUM_ELEMENTS_PER_THREAD);
+      PT_ASSERT_LT_MSG(last[producer], element,
+        "Elements of a producer dequeued out of order.");
+      last[producer] = element;
+    }
+  }
+  // Every element is dequeued exactly once
+  ::std::vector<Element> all;
+  Element element;
+  while (queue_->TryDequeue(element)) {
+    all.push_back(element);
+  }
+  for (size_t t = 0; t < dequeued_.size(); ++t) {
+    all.insert(all.end(), dequeued_[t].begin(), dequeued_[t].end());
+  }
+  ::std::sort(all.begin(), all.end());
+  PT_ASSERT_EQ(all.size(),
+    static_cast<size_t>(NUM_TEST_THREADS * NUM_ELEMENTS_PER_THREAD));
+  for (size_t i = 0; i < all.size(); ++i) {
+    PT_ASSERT_EQ(all[i], static_cast<Element>(i));
+  }
+  queue_->~Queue();
+  embb::base::Allocation::FreeAligned(queue_);
+}
+
+}  // namespace test
+}  // namespace containers
+}  // namespace embb
+
+#endif // CONTAINERS_CPP_TEST_BATCH_QUEUE_TEST_INL_H_
@@ -29,8 +29,14 @@
 #include <embb/containers/wait_free_spsc_queue.h>
 #include <embb/containers/object_pool.h>
 #include <embb/containers/lock_free_stack.h>
+#include <embb/containers/wait_free_sim_stack.h>
 #include <embb/containers/lock_free_mpmc_queue.h>
 #include <embb/containers/lock_free_chromatic_tree.h>
+#include <embb/containers/lock_free_hash_map.h>
+#include <embb/containers/multi_queue.h>
+#include <embb/containers/lock_free_skip_list.h>
+#include <embb/containers/wait_free_queue.h>
+#include <embb/containers/wait_free_phaseless_queue.h>
 #include <embb/base/c/memory_allocation.h>
 
 #include <partest/partest.h>
@@ -39,9 +45,14 @@
 #include "./pool_test.h"
 #include "./queue_test.h"
 #include "./stack_test.h"
+#include "./sim_stack_test.h"
 #include "./hazard_pointer_test.h"
 #include "./object_pool_test.h"
 #include "./tree_test.h"
+#include "./map_test.h"
+#include "./priority_queue_test.h"
+#include "./skip_list_test.h"
+#include "./batch_queue_test.h"
 
 #define COMMA ,
 
@@ -50,15 +61,26 @@ using embb::containers::LockFreeTreeValuePool;
 using embb::containers::WaitFreeSPSCQueue;
 using embb::containers::LockFreeMPMCQueue;
 using embb::containers::LockFreeStack;
+using embb::containers::WaitFreeSimStack;
 using embb::containers::LockFreeTreeValuePool;
 using embb::containers::WaitFreeArrayValuePool;
 using embb::containers::ChromaticTree;
+using embb::containers::LockFreeHashMap;
+using embb::containers::MultiQueue;
+using embb::containers::LockFreeSkipList;
+using embb::containers::WaitFreeQueue;
+using embb::containers::WaitFreePhaselessQueue;
 using embb::containers::test::PoolTest;
 using embb::containers::test::HazardPointerTest;
 using embb::containers::test::QueueTest;
 using embb::containers::test::StackTest;
+using embb::containers::test::SimStackTest;
 using embb::containers::test::ObjectPoolTest;
 using embb::containers::test::TreeTest;
+using embb::containers::test::MapTest;
+using embb::containers::test::PriorityQueueTest;
+using embb::containers::test::SkipListTest;
+using embb::containers::test::BatchQueueTest;
 
 PT_MAIN("Data Structures C++") {
   unsigned int max_threads = static_cast<unsigned int>(
@@ -72,9 +94,17 @@ PT_MAIN("Data Structures C++") {
   PT_RUN(QueueTest< LockFreeMPMCQueue< ::std::pair<size_t COMMA int> >
     COMMA true COMMA true >);
   PT_RUN(StackTest< LockFreeStack<int> >);
+  PT_RUN(StackTest< WaitFreeSimStack<int COMMA -1> >);
+  PT_RUN(SimStackTest);
   PT_RUN(ObjectPoolTest< LockFreeTreeValuePool<bool COMMA false > >);
   PT_RUN(ObjectPoolTest< WaitFreeArrayValuePool<bool COMMA false> >);
   PT_RUN(TreeTest< ChromaticTree<size_t COMMA int> >);
+  PT_RUN(MapTest< LockFreeHashMap<size_t COMMA int> >);
+  PT_RUN(PriorityQueueTest< MultiQueue<int COMMA int> >);
+  PT_RUN(MapTest< LockFreeSkipList<size_t COMMA int> >);
+  PT_RUN(SkipListTest< LockFreeSkipList<size_t COMMA int> >);
+  PT_RUN(BatchQueueTest< WaitFreeQueue<int> >);
+  PT_RUN(BatchQueueTest< WaitFreePhaselessQueue<int> >);
 
   PT_EXPECT(embb_get_bytes_allocated() == 0);
 }
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef CONTAINERS_CPP_TEST_MAP_TEST_INL_H_
+#define CONTAINERS_CPP_TEST_MAP_TEST_INL_H_
+
+#include <cstdlib>
+#include <utility>
+#include <vector>
+#include <algorithm>
+
+#include "map_test.h"
+
+namespace embb {
+namespace containers {
+namespace test {
+
+template<typename Map>
+MapTest<Map>::MapTest()
+    : map_(NULL) {
+  // Repeat twice to ensure that the map remains operational after all the
+  // elements were removed from it
+  CreateUnit("MapTestSingleThreadInsertDelete").
+      Pre(&MapTest::MapTest_Pre, this).
+      Add(&MapTest::MapTestInsertDelete_ThreadMethod, this, 1, 2).
+      Post(&MapTest::MapTest_Post, this);
+  CreateUnit("MapTestMultiThreadInsertDelete").
+      Pre(&MapTest::MapTest_Pre, this).
+      Add(&MapTest::MapTestMultiThreadInsertDelete_ThreadMethod, this,
+          NUM_TEST_THREADS, 2).
+      Post(&MapTest::MapTest_Post, this);
+  CreateUnit("MapTestSharedKeys").
+      Pre(&MapTest::MapTest_Pre, this).
+      Add(&MapTest::MapTestSharedKeys_ThreadMethod, this,
+          NUM_TEST_THREADS, 2).
+      Post(&MapTest::MapTestSharedKeys_Post, this);
+  CreateUnit("MapTestCapacity").
+      Add(&MapTest::MapTestCapacity, this);
+}
+
+template<typename Map>
+void MapTest<Map>::
+InsertDelete(size_t thread_id, int num_elements) {
+  typedef ::std::pair<Key, Value> Element;
+  typedef typename ::std::vector<Element>::iterator ElementIterator;
+  ::std::vector<Element> elements;
+  for (int i = 0; i < num_elements; ++i) {
+    Key   key   = static_cast<Key>(i) * 133 * 100 + thread_id;
+    Value value = i * 133 * 100 + static_cast<Value>(thread_id);
+    elements.push_back(::std::make_pair(key, value));
+  }
+
+  // Insert elements into the map, none of them is present yet
+  ::std::random_shuffle(elements.begin(), elements.end());
+  for (ElementIterator it = elements.begin(); it != elements.end(); ++it) {
+    Value old_value = 0;
+    bool success = map_->TryInsert(it->first, it->second, old_value);
+    PT_ASSERT_MSG(success, "Failed to insert element into the map.");
+    PT_ASSERT_MSG(old_value == map_->GetUndefinedValue(),
+      "Unexpected old value for a new key.");
+  }
+
+  // Verify that all inserted elements are available in the map
+  ::std::random_shuffle(elements.begin(), elements.end());
+  for (ElementIterator it = elements.begin(); it != elements.end(); ++it) {
+    Value value;
+    bool success = map_->Get(it->first, value);
+    PT_ASSERT_MSG(success, "Failed to get an element from the map.");
+    PT_ASSERT_MSG(it->second == value, "Wrong value retrieved from the map.");
+  }
+
+  // Replace some of the elements that were inserted earlier
+  ::std::random_shuffle(elements.begin(), elements.end());
+  ElementIterator elements_middle = elements.begin() + num_elements / 2;
+  for (ElementIterator it = elements.begin(); it != elements_middle; ++it) {
+    Value old_value = 0;
+    Value new_value = it->second * 13;
+    bool success = map_->TryInsert(it->first, new_value, old_value);
+    PT_ASSERT_MSG(success, "Failed to replace element in the map.");
+    PT_ASSERT_MSG(it->second == old_value, "Wrong value replaced in the map.");
+    it->second = new_value;
+  }
+
+  // Verify again that all elements are in the map and have correct values
+  ::std::random_shuffle(elements.begin(), elements.end());
+  for (ElementIterator it = elements.begin(); it != elements.end(); ++it) {
+    Value value;
+    bool success = map_->Get(it->first, value);
+    PT_ASSERT_MSG(success, "Failed to get an element from the map.");
+    PT_ASSERT_MSG(it->second == value, "Wrong value retrieved from the map.");
+  }
+
+  // Delete elements from the map
+  ::std::random_shuffle(elements.begin(), elements.end());
+  for (ElementIterator it = elements.begin(); it != elements.end(); ++it) {
+    Value value;
+    bool success = map_->TryDelete(it->first, value);
+    PT_ASSERT_MSG(success, "Failed to delete element from the map.");
+    PT_ASSERT_MSG(it->second == value, "Wrong value deleted from the map.");
+    success = map_->Get(it->first, value);
+    PT_ASSERT_MSG(!success, "Deleted element still in the map.");
+    success = map_->TryDelete(it->first);
+    PT_ASSERT_MSG(!success, "Deleted element deleted twice.");
+  }
+}
+
+template<typename Map>
+void MapTest<Map>::
+MapTest_Pre() {
+  map_ = new Map(MAP_CAPACITY);
+}
+
+template<typename Map>
+void MapTest<Map>::
+MapTestInsertDelete_ThreadMethod() {
+  size_t thread_id = partest::TestSuite::GetCurrentThreadID();
+  InsertDelete(thread_id, MAP_CAPACITY);
+}
+
+template<typename Map>
+void MapTest<Map>::
+MapTestMultiThreadInsertDelete_ThreadMethod() {
+  size_t thread_id = partest::TestSuite::GetCurrentThreadID();
+  int num_elements = MAP_CAPACITY / (NUM_TEST_THREADS + 1);
+  if (thread_id == 0) {
+    num_elements *= 2;
+  }
+  InsertDelete(thread_id, num_elements);
+}
+
+template<typename Map>
+void MapTest<Map>::
+MapTestSharedKeys_ThreadMethod() {
+  // All threads insert, replace and delete the same few keys. Every value
+  // encodes its key, so a value found for the wrong key is detected.
+  size_t thread_id = partest::TestSuite::GetCurrentThreadID();
+  unsigned int seed = static_cast<unsigned int>(thread_id);
+  for (int i = 0; i < NUM_SHARED_OPERATIONS; ++i) {
+    seed = seed * 1103515245 + 12345;
+    Key key = static_cast<Key>((seed >> 16) % NUM_SHARED_KEYS);
+    Value value = static_cast<Value>(key) * 1000 + i % 1000;
+    Value old_value = -1;
+    switch ((seed >> 8) % 3) {
+    case 0: {
+      bool success = map_->TryInsert(key, value, old_value);
+      PT_ASSERT_MSG(success, "Failed to insert element into the map.");
+      PT_ASSERT_MSG(old_value == map_->GetUndefinedValue() ||
+        old_value / 1000 == static_cast<Value>(key),
+        "Wrong value replaced in the map.");
+      break;
+    }
+    case 1:
+      if (map_->TryDelete(key, old_value)) {
+        PT_ASSERT_MSG(old_value / 1000 == static_cast<Value>(key),
+          "Wrong value deleted from the map.");
+      }
+      break;
+    default:
+      if (map_->Get(key, old_value)) {
+        PT_ASSERT_MSG(old_value / 1000 == static_cast<Value>(key),
+          "Wrong value retrieved from the map.");
+      }
+      break;
+    }
+  }
+}
+
+template<typename Map>
+void MapTest<Map>::
+MapTestSharedKeys_Post() {
+  for (int i = 0; i < NUM_SHARED_KEYS; ++i) {
+    Value value;
+    Key key = static_cast<Key>(i);
+    if (map_->Get(key, value)) {
+      PT_ASSERT_MSG(value / 1000 == i, "Wrong value retrieved from the map.");
+      PT_ASSERT_MSG(map_->TryDelete(key), "Failed to delete element.");
+    }
+    PT_ASSERT_MSG(!map_->Get(key, value), "Deleted element still in the map.");
+  }
+  MapTest_Post();
+}
+
+template<typename Map>
+void MapTest<Map>::
+MapTest_Post() {
+  PT_ASSERT_MSG((map_->IsEmpty()), "The map must be empty at this point.");
+  delete map_;
+}
+
+template<typename Map>
+void MapTest<Map>::
+MapTestCapacity() {
+  Map map(MAP_CAPACITY);
+  PT_ASSERT_EQ(map.GetCapacity(), static_cast<size_t>(MAP_CAPACITY));
+  // The capacity is guaranteed, more elements may fit
+  Key key = 0;
+  while (map.TryInsert(key, static_cast<Value>(key))) {
+    ++key;
+  }
+  PT_ASSERT_GE(key, static_cast<Key>(MAP_CAPACITY));
+  for (Key k = 0; k < key; ++k) {
+    Value value;
+    PT_ASSERT(map.Get(k, value));
+    PT_ASSERT_EQ(value, static_cast<Value>(k));
+    PT_ASSERT(map.TryDelete(k));
+  }
+  PT_ASSERT(map.IsEmpty());
+  // Nodes of deleted elements are reused, so the capacity is available again
+  for (Key k = 0; k < static_cast<Key>(MAP_CAPACITY); ++k) {
+    PT_ASSERT(map.TryInsert(k, static_cast<Value>(k)));
+  }
+  for (Key k = 0; k < static_cast<Key>(MAP_CAPACITY); ++k) {
+    PT_ASSERT(map.TryDelete(k));
+  }
+  PT_ASSERT(map.IsEmpty());
+}
+
+}  // namespace test
+}  // namespace containers
+}  // namespace embb
+
+#endif // CONTAINERS_CPP_TEST_MAP_TEST_INL_H_
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef CONTAINERS_CPP_TEST_MAP_TEST_H_
+#define CONTAINERS_CPP_TEST_MAP_TEST_H_
+
+#include <partest/partest.h>
+
+namespace embb {
+namespace containers {
+namespace test {
+
+template<typename Map>
+class MapTest : public partest::TestCase {
+ public:
+  MapTest();
+
+ private:
+  typedef size_t Key;
+  typedef int    Value;
+
+  static const int MAP_CAPACITY = 2000;
+  static const int NUM_TEST_THREADS = 3;
+  static const int NUM_SHARED_KEYS = 16;
+  static const int NUM_SHARED_OPERATIONS = 2000;
+
+  void MapTest_Pre();
+  void MapTestInsertDelete_ThreadMethod();
+  void MapTestMultiThreadInsertDelete_ThreadMethod();
+  void MapTestSharedKeys_ThreadMethod();
+  void MapTestSharedKeys_Post();
+  void MapTest_Post();
+  void MapTestCapacity();
+
+  void InsertDelete(size_t thread_id, int num_elements);
+
+  Map *map_;
+};
+
+}  // namespace test
+}  // namespace containers
+}  // namespace embb
+
+#include "./map_test-inl.h"
+
+#endif // CONTAINERS_CPP_TEST_MAP_TEST_H_
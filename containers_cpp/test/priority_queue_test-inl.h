@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CONTAINERS_CPP_TEST_PRIORITY_QUEUE_TEST_INL_H_
+#define CONTAINERS_CPP_TEST_PRIORITY_QUEUE_TEST_INL_H_
+
+#include <algorithm>
+#include <vector>
+
+#include "priority_queue_test.h"
+
+namespace embb {
+namespace containers {
+namespace test {
+
+template<typename Queue>
+PriorityQueueTest<Queue>::PriorityQueueTest()
+    : queue_(NULL) {
+  // Repeat twice to ensure that the queue remains operational after all the
+  // elements were removed from it
+  CreateUnit("PriorityQueueTestSingleThread").
+      Pre(&PriorityQueueTest::PriorityQueueTest_Pre, this).
+      Add(&PriorityQueueTest::PriorityQueueTestSingleThread_ThreadMethod,
+          this, 1, 2).
+      Post(&PriorityQueueTest::PriorityQueueTest_Post, this);
+  CreateUnit("PriorityQueueTestMultiThread").
+      Pre(&PriorityQueueTest::PriorityQueueTest_Pre, this).
+      Add(&PriorityQueueTest::PriorityQueueTestMultiThread_ThreadMethod,
+          this, NUM_TEST_THREADS, 1).
+      Post(&PriorityQueueTest::PriorityQueueTestMultiThread_Post, this);
+  CreateUnit("PriorityQueueTestCapacity").
+      Add(&PriorityQueueTest::PriorityQueueTestCapacity, this);
+}
+
+template<typename Queue>
+void PriorityQueueTest<Queue>::
+PriorityQueueTest_Pre() {
+  queue_ = new Queue(QUEUE_CAPACITY);
+  dequeued_.clear();
+  dequeued_.resize(NUM_TEST_THREADS);
+}
+
+template<typename Queue>
+void PriorityQueueTest<Queue>::
+PriorityQueueTestSingleThread_ThreadMethod() {
+  ::std::vector<Element> elements;
+  for (int i = 0; i < QUEUE_CAPACITY; ++i) {
+    elements.push_back(i);
+  }
+
+  // Enqueue elements in random order, the priority of an element is its value
+  ::std::random_shuffle(elements.begin(), elements.end());
+  for (size_t i = 0; i < elements.size(); ++i) {
+    PT_ASSERT_MSG(queue_->TryEnqueue(elements[i], elements[i]),
+      "Failed to enqueue element.");
+  }
+
+  // Every element is dequeued exactly once, with its own priority
+  ::std::vector<bool> seen(elements.size(), false);
+  for (size_t i = 0; i < elements.size(); ++i) {
+    Element element;
+    Priority priority;
+    PT_ASSERT_MSG(queue_->TryDequeue(element, priority),
+      "Failed to dequeue element.");
+    PT_ASSERT_EQ(priority, element);
+    PT_ASSERT_MSG(element >= 0 && element < QUEUE_CAPACITY,
+      "Dequeued element was never enqueued.");
+    PT_ASSERT_MSG(!seen[static_cast<size_t>(element)],
+      "Element dequeued twice.");
+    seen[static_cast<size_t>(element)] = true;
+  }
+}
+
+template<typename Queue>
+void PriorityQueueTest<Queue>::
+PriorityQueueTestMultiThread_ThreadMethod() {
+  // Every thread enqueues its own elements and dequeues whatever it finds
+  size_t thread_id = partest::TestSuite::GetCurrentThreadID();
+  ::std::vector<Element>& dequeued = dequeued_[thread_id];
+  for (int i = 0; i < NUM_ELEMENTS_PER_THREAD; ++i) {
+    Element element = static_cast<Element>(thread_id) *
+      NUM_ELEMENTS_PER_THREAD + i;
+    Priority priority = (element * 7919) % 1000;
+    PT_ASSERT_MSG(queue_->TryEnqueue(priority, element),
+      "Failed to enqueue element.");
+    if (i % 2 == 1 && queue_->TryDequeue(element)) {
+      dequeued.push_back(element);
+    }
+  }
+}
+
+template<typename Queue>
+void PriorityQueueTest<Queue>::
+PriorityQueueTestMultiThread_Post() {
+  // Collect the remaining elements, then check that every element was
+  // dequeued exactly once
+  ::std::vector<Element> all;
+  Element element;
+  while (queue_->TryDequeue(element)) {
+    all.push_back(element);
+  }
+  for (size_t t = 0; t < dequeued_.size(); ++t) {
+    all.insert(all.end(), dequeued_[t].begin(), dequeued_[t].end());
+  }
+  ::std::sort(all.begin(), all.end());
+  PT_ASSERT_EQ(all.size(),
+    static_cast<size_t>(NUM_TEST_THREADS * NUM_ELEMENTS_PER_THREAD));
+  for (size_t i = 0; i < all.size(); ++i) {
+    PT_ASSERT_EQ(all[i], static_cast<Element>(i));
+  }
+  PriorityQueueTest_Post();
+}
+
+template<typename Queue>
+void PriorityQueueTest<Queue>::
+PriorityQueueTest_Post() {
+  Element element;
+  PT_ASSERT_MSG(!queue_->TryDequeue(element),
+    "The queue must be empty at this point.");
+  delete queue_;
+}
+
+template<typename Queue>
+void PriorityQueueTest<Queue>::
+PriorityQueueTestCapacity() {
+  Queue queue(QUEUE_CAPACITY);
+  PT_ASSERT_GE(queue.GetCapacity(), static_cast<size_t>(QUEUE_CAPACITY));
+  // Exactly the reported capacity fits
+  size_t size = 0;
+  while (queue.TryEnqueue(static_cast<Priority>(size),
+                          static_cast<Element>(size))) {
+    ++size;
+  }
+  PT_ASSERT_EQ(size, queue.GetCapacity());
+  Element element;
+  for (size_t i = 0; i < size; ++i) {
+    PT_ASSERT(queue.TryDequeue(element));
+  }
+  PT_ASSERT(!queue.TryDequeue(element));
+  // The capacity is available again
+  for (size_t i = 0; i < size; ++i) {
+    PT_ASSERT(queue.TryEnqueue(static_cast<Priority>(i),
+                               static_cast<Element>(i)));
+  }
+}
+
+}  // namespace test
+}  // namespace containers
+}  // namespace embb
+
+#endif // CONTAINERS_CPP_TEST_PRIORITY_QUEUE_TEST_INL_H_
@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "./sim_stack_test.h"
+
+#include <algorithm>
+
+namespace embb {
+namespace containers {
+namespace test {
+MixedSimStack::MixedSimStack(
+  size_t capacity, unsigned int num_accessors) :
+  WaitFreeSimStack<int, -1>(capacity, 0, false, 64, 1) {
+  for (unsigned int id = 0; id < num_accessors; id += 2) {
+    DisableFastPath(id);
+  }
+}
+
+SimStackTest::SimStackTest() :
+  // Combining and fast path threads need to mix
+  n_threads(std::max(2, static_cast<int>
+    (partest::TestSuite::GetDefaultNumThreads()))),
+  n_iterations(200),
+  n_stack_elements_per_thread(100),
+  stack(static_cast<size_t>(n_stack_elements_per_thread * n_threads),
+    static_cast<unsigned int>(n_threads)),
+  thread_local_vectors(NULL) {
+  CreateUnit("SimStackTestCombiningAndFastPathMixed").
+  Pre(&SimStackTest::SimStackTestMixedPaths_Pre, this).
+  Add(&SimStackTest::SimStackTestMixedPaths_ThreadMethod, this,
+  static_cast<size_t>(n_threads),
+  static_cast<size_t>(n_iterations)).
+  Post(&SimStackTest::SimStackTestMixedPaths_Post, this);
+}
+
+void SimStackTest::SimStackTestMixedPaths_Pre() {
+  embb_internal_thread_index_reset();
+  thread_local_vectors =
+    new std::vector<int>[static_cast<unsigned int>(n_threads)];
+  expected_stack_elements.clear();
+  for (int i = 0; i != n_threads; ++i) {
+    for (int i2 = 0; i2 != n_stack_elements_per_thread; ++i2) {
+      int push_element = i2 + (n_stack_elements_per_thread * i);
+      thread_local_vectors[i].push_back(push_element);
+      expected_stack_elements.push_back(push_element);
+    }
+  }
+}
+
+void SimStackTest::SimStackTestMixedPaths_Post() {
+  std::vector<int> produced;
+  for (int i = 0; i != n_threads; ++i) {
+    produced.insert(produced.end(),
+      thread_local_vectors[i].begin(), thread_local_vectors[i].end());
+  }
+  delete[] thread_local_vectors;
+  thread_local_vectors = NULL;
+
+  // Every element is popped exactly once
+  PT_ASSERT_EQ(produced.size(), expected_stack_elements.size());
+  std::sort(expected_stack_elements.begin(), expected_stack_elements.end());
+  std::sort(produced.begin(), produced.end());
+  PT_ASSERT(produced == expected_stack_elements);
+}
+
+void SimStackTest::SimStackTestMixedPaths_ThreadMethod() {
+  unsigned int thread_index;
+  int return_val = embb_internal_thread_index(&thread_index);
+  PT_ASSERT(EMBB_SUCCESS == return_val);
+
+  std::vector<int>& my_elements = thread_local_vectors[thread_index];
+  std::vector<int> pushed;
+  pushed.swap(my_elements);
+
+  // Pops interleaved with pushes keep both paths contending on the top
+  // element. A thread has pushed more than it popped before each pop, so
+  // every pop finds an element.
+  for (size_t i = 0; i != pushed.size(); ++i) {
+    PT_ASSERT(stack.TryPush(pushed[i]));
+    if (i % 2 == 1) {
+      int element;
+      PT_ASSERT(stack.TryPop(element));
+      my_elements.push_back(element);
+    }
+  }
+  while (my_elements.size() != pushed.size()) {
+    int element;
+    PT_ASSERT(stack.TryPop(element));
+    my_elements.push_back(element);
+  }
+}
+} // namespace test
+} // namespace containers
+} // namespace embb
@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CONTAINERS_CPP_TEST_SKIP_LIST_TEST_INL_H_
+#define CONTAINERS_CPP_TEST_SKIP_LIST_TEST_INL_H_
+
+#include <algorithm>
+#include <vector>
+
+#include "skip_list_test.h"
+
+namespace embb {
+namespace containers {
+namespace test {
+
+template<typename List>
+SkipListTest<List>::Visitor::
+Visitor(bool* ordered, bool* consistent, size_t* stable)
+    : ordered_(ordered),
+      consistent_(consistent),
+      stable_(stable),
+      first_(true),
+      last_(0) {}
+
+template<typename List>
+void SkipListTest<List>::Visitor::
+operator()(const Key& key, const Value& value) {
+  if (!first_ && !(last_ < key)) {
+    *ordered_ = false;
+  }
+  if (value != static_cast<Value>(key) * 10) {
+    *consistent_ = false;
+  }
+  if (key % 4 == 0) {
+    ++(*stable_);
+  }
+  first_ = false;
+  last_ = key;
+}
+
+template<typename List>
+SkipListTest<List>::SkipListTest()
+    : list_(NULL) {
+  CreateUnit("SkipListTestOrder").
+      Add(&SkipListTest::SkipListTestOrder, this);
+  CreateUnit("SkipListTestConcurrentScan").
+      Pre(&SkipListTest::SkipListTestConcurrentScan_Pre, this).
+      Add(&SkipListTest::SkipListTestConcurrentScan_ThreadMethod, this,
+          NUM_TEST_THREADS, 1).
+      Post(&SkipListTest::SkipListTestConcurrentScan_Post, this);
+}
+
+template<typename List>
+void SkipListTest<List>::
+SkipListTestOrder() {
+  List list(LIST_CAPACITY);
+  // Insert the even keys in random order
+  ::std::vector<Key> keys;
+  for (int i = 0; i < LIST_CAPACITY; ++i) {
+    keys.push_back(static_cast<Key>(2 * i));
+  }
+  ::std::random_shuffle(keys.begin(), keys.end());
+  for (size_t i = 0; i < keys.size(); ++i) {
+    PT_ASSERT(list.TryInsert(keys[i], static_cast<Value>(keys[i]) * 10));
+  }
+
+  // A full traversal visits all keys in ascending order
+  bool ordered = true;
+  bool consistent = true;
+  size_t stable = 0;
+  size_t count = list.ForEach(Visitor(&ordered, &consistent, &stable));
+  PT_ASSERT_EQ(count, static_cast<size_t>(LIST_CAPACITY));
+  PT_ASSERT_MSG(ordered, "Keys visited out of order.");
+  PT_ASSERT_MSG(consistent, "Wrong value visited.");
+  PT_ASSERT_EQ(stable, static_cast<size_t>((LIST_CAPACITY + 1) / 2));
+
+  // The lower bound of an odd key is the next even key
+  for (Key key = 1; key < static_cast<Key>(2 * LIST_CAPACITY - 2); key += 2) {
+    Key found_key = 0;
+    Value value = 0;
+    PT_ASSERT(list.LowerBound(key, found_key, value));
+    PT_ASSERT_EQ(found_key, key + 1);
+    PT_ASSERT_EQ(value, static_cast<Value>(key + 1) * 10);
+    PT_ASSERT(list.LowerBound(key + 1, found_key, value));
+    PT_ASSERT_EQ(found_key, key + 1);
+  }
+  Key found_key = 0;
+  Value value = 0;
+  PT_ASSERT(!list.LowerBound(static_cast<Key>(2 * LIST_CAPACITY - 1),
+                             found_key, value));
+
+  // Ranges include the lower and exclude the upper bound
+  count = list.ForEachInRange(10, 20, Visitor(&ordered, &consistent, &stable));
+  PT_ASSERT_EQ(count, static_cast<size_t>(5));
+  count = list.ForEachInRange(11, 21, Visitor(&ordered, &consistent, &stable));
+  PT_ASSERT_EQ(count, static_cast<size_t>(5));
+  count = list.ForEachInRange(20, 20, Visitor(&ordered, &consistent, &stable));
+  PT_ASSERT_EQ(count, static_cast<size_t>(0));
+  PT_ASSERT_MSG(ordered, "Keys visited out of order.");
+
+  // Deleted keys are skipped
+  PT_ASSERT(list.TryDelete(12));
+  PT_ASSERT(list.TryDelete(14));
+  count = list.ForEachInRange(10, 20, Visitor(&ordered, &consistent, &stable));
+  PT_ASSERT_EQ(count, static_cast<size_t>(3));
+  PT_ASSERT(list.LowerBound(11, found_key, value));
+  PT_ASSERT_EQ(found_key, static_cast<Key>(16));
+
+  for (size_t i = 0; i < keys.size(); ++i) {
+    list.TryDelete(keys[i]);
+  }
+  PT_ASSERT(list.IsEmpty());
+  count = list.ForEach(Visitor(&ordered, &consistent, &stable));
+  PT_ASSERT_EQ(count, static_cast<size_t>(0));
+}
+
+template<typename List>
+void SkipListTest<List>::
+SkipListTestConcurrentScan_Pre() {
+  list_ = new List(LIST_CAPACITY);
+  for (int i = 0; i < NUM_STABLE_KEYS; ++i) {
+    Key key = static_cast<Key>(4 * i);
+    PT_ASSERT(list_->TryInsert(key, static_cast<Value>(key) * 10));
+  }
+}
+
+template<typename List>
+void SkipListTest<List>::
+SkipListTestConcurrentScan_ThreadMethod() {
+  size_t thread_id = partest::TestSuite::GetCurrentThreadID();
+  if (thread_id == 0) {
+    // Scans see the keys in order and every key that is never removed
+    for (int i = 0; i < NUM_SCANS; ++i) {
+      bool ordered = true;
+      bool consistent = true;
+      size_t stable = 0;
+      list_->ForEach(Visitor(&ordered, &consistent, &stable));
+      PT_ASSERT_MSG(ordered, "Keys visited out of order.");
+      PT_ASSERT_MSG(consistent, "Wrong value visited.");
+      PT_ASSERT_EQ(stable, static_cast<size_t>(NUM_STABLE_KEYS));
+      stable = 0;
+      list_->ForEachInRange(100, 200,
+                            Visitor(&ordered, &consistent, &stable));
+      PT_ASSERT_MSG(ordered, "Keys visited out of order.");
+      PT_ASSERT_EQ(stable, static_cast<size_t>(25));
+    }
+  } else {
+    // The other threads insert, replace and remove the keys in between
+    unsigned int seed = static_cast<unsigned int>(thread_id);
+    for (int i = 0; i < NUM_UPDATES; ++i) {
+      seed = seed * 1103515245 + 12345;
+      Key key = static_cast<Key>((seed >> 16) % (4 * NUM_STABLE_KEYS));
+      if (key % 4 == 0) {
+        ++key;
+      }
+      if ((seed >> 8) % 2 == 0) {
+        PT_ASSERT(list_->TryInsert(key, static_cast<Value>(key) * 10));
+      } else {
+        list_->TryDelete(key);
+      }
+    }
+  }
+}
+
+template<typename List>
+void SkipListTest<List>::
+SkipListTestConcurrentScan_Post() {
+  for (Key key = 0; key < static_cast<Key>(4 * NUM_STABLE_KEYS); ++key) {
+    Value value;
+    if (key % 4 == 0) {
+      PT_ASSERT(list_->Get(key, value));
+      PT_ASSERT_EQ(value, static_cast<Value>(key) * 10);
+    }
+    list_->TryDelete(key);
+  }
+  PT_ASSERT_MSG(list_->IsEmpty(), "The list must be empty at this point.");
+  delete list_;
+}
+
+}  // namespace test
+}  // namespace containers
+}  // namespace embb
+
+#endif // CONTAINERS_CPP_TEST_SKIP_LIST_TEST_INL_H_
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef CONTAINERS_CPP_TEST_SKIP_LIST_TEST_H_
+#define CONTAINERS_CPP_TEST_SKIP_LIST_TEST_H_
+
+#include <partest/partest.h>
+
+namespace embb {
+namespace containers {
+namespace test {
+
+template<typename List>
+class SkipListTest : public partest::TestCase {
+ public:
+  SkipListTest();
+
+ private:
+  typedef size_t Key;
+  typedef int    Value;
+
+  static const int LIST_CAPACITY = 2000;
+  static const int NUM_TEST_THREADS = 3;
+  static const int NUM_STABLE_KEYS = 200;
+  static const int NUM_SCANS = 50;
+  static const int NUM_UPDATES = 2000;
+
+  /**
+   * Checks that the visited keys ascend and that every value encodes its key,
+   * and counts the visited keys that are multiples of 4.
+   */
+  class Visitor {
+   public:
+    Visitor(bool* ordered, bool* consistent, size_t* stable);
+    void operator()(const Key& key, const Value& value);
+
+   private:
+    bool*  ordered_;
+    bool*  consistent_;
+    size_t* stable_;
+    bool   first_;
+    Key    last_;
+  };
+
+  void SkipListTestOrder();
+  void SkipListTestConcurrentScan_Pre();
+  void SkipListTestConcurrentScan_ThreadMethod();
+  void SkipListTestConcurrentScan_Post();
+
+  List *list_;
+};
+
+}  // namespace test
+}  // namespace containers
+}  // namespace embb
+
+#include "./skip_list_test-inl.h"
+
+#endif // CONTAINERS_CPP_TEST_SKIP_LIST_TEST_H_
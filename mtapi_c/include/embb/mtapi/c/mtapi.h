@@ -244,6 +244,7 @@
 
 #include <stdint.h>
 #include <embb/base/c/core_set.h>
+#include <embb/base/c/time.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -527,8 +528,34 @@ enum mtapi_node_attributes_enum {
                                             the node */
   MTAPI_NODE_MAX_ACTIONS_PER_JOB,      /**< maximum number of actions in a job
                                             allowed by the node */
-  MTAPI_NODE_MAX_PRIORITIES            /**< maximum number of priorities
+  MTAPI_NODE_MAX_PRIORITIES,           /**< maximum number of priorities
                                             allowed by the node */
+  MTAPI_NODE_TRACE_CAPACITY,           /**< number of scheduler events
+                                            recorded per worker thread,
+                                            0 disables tracing
+                                            (implementation specific) */
+  MTAPI_NODE_TRACE_FILE,               /**< name of the file the recorded
+                                            events are written to in Chrome
+                                            trace format on finalization
+                                            (implementation specific) */
+  MTAPI_NODE_SCHEDULER_MODE,           /**< scheduling strategy used by the
+                                            worker threads, one of the
+                                            MTAPI_NODE_SCHEDULER_* values
+                                            (implementation specific) */
+  MTAPI_NODE_PRIORITY_AGING,           /**< number of consecutive tasks a
+                                            worker fetches in priority order
+                                            before it serves the lowest
+                                            priority with pending work once,
+                                            0 disables aging, only used by
+                                            MTAPI_NODE_SCHEDULER_HPF
+                                            (implementation specific) */
+  MTAPI_NODE_DEADLINE_TASKS,           /**< number of completed tasks that
+                                            had a deadline, read only
+                                            (implementation specific) */
+  MTAPI_NODE_DEADLINES_MISSED          /**< number of completed tasks that
+                                            finished after their deadline,
+                                            read only
+                                            (implementation specific) */
 };
 /** size of the \a MTAPI_NODE_CORE_AFFINITY attribute */
 #define MTAPI_NODE_CORE_AFFINITY_SIZE sizeof(embb_core_set_t)
@@ -552,11 +579,35 @@ enum mtapi_node_attributes_enum {
 #define MTAPI_NODE_MAX_ACTIONS_PER_JOB_SIZE sizeof(mtapi_uint_t)
 /** size of the \a MTAPI_NODE_MAX_PRIORITIES attribute */
 #define MTAPI_NODE_MAX_PRIORITIES_SIZE sizeof(mtapi_uint_t)
+/** size of the \a MTAPI_NODE_TRACE_CAPACITY attribute */
+#define MTAPI_NODE_TRACE_CAPACITY_SIZE sizeof(mtapi_uint_t)
+/** size of the \a MTAPI_NODE_TRACE_FILE attribute */
+#define MTAPI_NODE_TRACE_FILE_SIZE sizeof(const char *)
+/** size of the \a MTAPI_NODE_SCHEDULER_MODE attribute */
+#define MTAPI_NODE_SCHEDULER_MODE_SIZE sizeof(mtapi_uint_t)
+/** size of the \a MTAPI_NODE_PRIORITY_AGING attribute */
+#define MTAPI_NODE_PRIORITY_AGING_SIZE sizeof(mtapi_uint_t)
+/** size of the \a MTAPI_NODE_DEADLINE_TASKS attribute */
+#define MTAPI_NODE_DEADLINE_TASKS_SIZE sizeof(mtapi_uint_t)
+/** size of the \a MTAPI_NODE_DEADLINES_MISSED attribute */
+#define MTAPI_NODE_DEADLINES_MISSED_SIZE sizeof(mtapi_uint_t)
 
 /* example attribute value */
 #define MTAPI_NODE_TYPE_SMP 1
 #define MTAPI_NODE_TYPE_DSP 2
 
+/** Victim Higher Priority First: for each priority, try local queues, then
+    steal from other workers */
+#define MTAPI_NODE_SCHEDULER_VHPF 0
+/** Local First: try all local queues, then steal from other workers */
+#define MTAPI_NODE_SCHEDULER_LF 1
+/** Highest Priority First: skip priorities without pending work anywhere on
+    the node, steal before taking lower priority local work */
+#define MTAPI_NODE_SCHEDULER_HPF 2
+/** Earliest Deadline First: take the local task with the earliest
+    MTAPI_TASK_DEADLINE, steal the earliest deadline from other workers */
+#define MTAPI_NODE_SCHEDULER_EDF 3
+
 /**
  * Task handle type.
  * \memberof mtapi_task_hndl_struct
@@ -587,7 +638,13 @@ enum mtapi_task_attributes_enum {
   MTAPI_TASK_PRIORITY,
   MTAPI_TASK_AFFINITY,
   MTAPI_TASK_USER_DATA,
-  MTAPI_TASK_COMPLETE_FUNCTION
+  MTAPI_TASK_COMPLETE_FUNCTION,
+  MTAPI_TASK_DEADLINE                  /**< absolute point in time the task
+                                            should be completed by, used by
+                                            MTAPI_NODE_SCHEDULER_EDF and for
+                                            the missed deadline statistics,
+                                            a zero time means no deadline
+                                            (implementation specific) */
 };
 /** size of the \a MTAPI_TASK_DETACHED attribute */
 #define MTAPI_TASK_DETACHED_SIZE sizeof(mtapi_boolean_t)
@@ -597,6 +654,8 @@ enum mtapi_task_attributes_enum {
 #define MTAPI_TASK_PRIORITY_SIZE sizeof(mtapi_uint_t)
 /** size of the \a MTAPI_TASK_AFFINITY attribute */
 #define MTAPI_TASK_AFFINITY_SIZE sizeof(mtapi_affinity_t)
+/** size of the \a MTAPI_TASK_DEADLINE attribute */
+#define MTAPI_TASK_DEADLINE_SIZE sizeof(embb_time_t)
 
 
 /**
@@ -663,6 +722,10 @@ struct mtapi_node_attributes_struct {
   mtapi_uint_t max_actions_per_job;    /**< stores
                                             MTAPI_NODE_MAX_ACTIONS_PER_JOB */
   mtapi_uint_t max_priorities;         /**< stores MTAPI_NODE_MAX_PRIORITIES */
+  mtapi_uint_t trace_capacity;         /**< stores MTAPI_NODE_TRACE_CAPACITY */
+  const char * trace_file;             /**< stores MTAPI_NODE_TRACE_FILE */
+  mtapi_uint_t scheduler_mode;         /**< stores MTAPI_NODE_SCHEDULER_MODE */
+  mtapi_uint_t priority_aging;         /**< stores MTAPI_NODE_PRIORITY_AGING */
 };
 
 /**
@@ -688,6 +751,7 @@ struct mtapi_task_attributes_struct {
   mtapi_task_complete_function_t
     complete_func;                     /**< stores
                                             MTAPI_TASK_COMPLETE_FUNCTION */
+  embb_time_t deadline;                /**< stores MTAPI_TASK_DEADLINE */
 };
 
 /**
@@ -912,6 +976,12 @@ extern mtapi_group_hndl_t MTAPI_GROUP_NONE;
 #define MTAPI_NODE_MAX_JOBS_DEFAULT 256
 #define MTAPI_NODE_MAX_ACTIONS_PER_JOB_DEFAULT 4
 #define MTAPI_NODE_MAX_PRIORITIES_DEFAULT 4
+/** tracing is disabled by default */
+#define MTAPI_NODE_TRACE_CAPACITY_DEFAULT 0
+#define MTAPI_NODE_TRACE_FILE_DEFAULT "mtapi_trace.json"
+#define MTAPI_NODE_SCHEDULER_MODE_DEFAULT MTAPI_NODE_SCHEDULER_VHPF
+/** priority aging is disabled by default */
+#define MTAPI_NODE_PRIORITY_AGING_DEFAULT 0
 
 #define MTAPI_JOB_ID_INVALID 0
 #define MTAPI_DOMAIN_ID_INVALID 0
@@ -63,6 +63,7 @@ mtapi_action_hndl_t mtapi_ext_plugin_action_create(
         new_action->enabled = MTAPI_TRUE;
         new_action->is_plugin_action = MTAPI_TRUE;
         embb_atomic_store_int(&new_action->num_tasks, 0);
+        embb_atomic_store_unsigned_int(&new_action->average_cost, 0);
 
         new_action->plugin_task_start_function = task_start_function;
         new_action->plugin_task_cancel_function = task_cancel_function;
@@ -58,6 +58,7 @@ void embb_mtapi_action_initialize(embb_mtapi_action_t* that) {
   that->node_local_data_size = 0;
   that->plugin_data = MTAPI_NULL;
   embb_atomic_store_int(&that->num_tasks, 0);
+  embb_atomic_store_unsigned_int(&that->average_cost, 0);
 }
 
 void embb_mtapi_action_finalize(embb_mtapi_action_t* that) {
@@ -68,6 +69,79 @@ void embb_mtapi_action_finalize(embb_mtapi_action_t* that) {
   embb_mtapi_action_initialize(that);
 }
 
+void embb_mtapi_action_account_cost(
+  embb_mtapi_action_t* that,
+  embb_time_t const * start_time,
+  mtapi_uint_t num_tasks) {
+  embb_time_t now;
+  unsigned long long elapsed;
+  unsigned int cost;
+  unsigned int average;
+  unsigned int new_average;
+
+  assert(MTAPI_NULL != that);
+  assert(MTAPI_NULL != start_time);
+
+  embb_time_now(&now);
+  if (embb_time_compare(&now, start_time) > 0) {
+    elapsed = (now.seconds - start_time->seconds) * 1000000ull;
+    elapsed += now.nanoseconds / 1000;
+    elapsed -= start_time->nanoseconds / 1000;
+  } else {
+    elapsed = 0;
+  }
+  if (0 < num_tasks) {
+    elapsed /= num_tasks;
+  }
+  /* 0 marks an action that was not measured yet */
+  if (0 == elapsed) {
+    cost = 1;
+  } else if (0xffffffffull < elapsed) {
+    cost = 0xffffffffu;
+  } else {
+    cost = (unsigned int)elapsed;
+  }
+
+  average = embb_atomic_load_unsigned_int(&that->average_cost);
+  do {
+    if (0 == average) {
+      new_average = cost;
+    } else if (cost > average) {
+      new_average = average +
+        ((cost - average) >> EMBB_MTAPI_ACTION_COST_SHIFT);
+    } else {
+      new_average = average -
+        ((average - cost) >> EMBB_MTAPI_ACTION_COST_SHIFT);
+    }
+    if (0 == new_average) {
+      new_average = 1;
+    }
+  } while (!embb_atomic_compare_and_swap_unsigned_int(
+    &that->average_cost, &average, new_average));
+}
+
+unsigned long long embb_mtapi_action_predict_cost(
+  embb_mtapi_action_t* that,
+  mtapi_uint_t concurrency) {
+  unsigned long long average;
+  unsigned long long tasks;
+  int num_tasks;
+
+  assert(MTAPI_NULL != that);
+
+  average = embb_atomic_load_unsigned_int(&that->average_cost);
+  num_tasks = embb_atomic_load_int(&that->num_tasks);
+  tasks = (0 < num_tasks) ? (unsigned long long)num_tasks : 0;
+  if (0 == average) {
+    return (0 == tasks) ? 0 : EMBB_MTAPI_ACTION_NO_COST;
+  }
+  if (0 == concurrency) {
+    concurrency = 1;
+  }
+  /* the new task waits for its share of the tasks in flight */
+  return average + average * tasks / concurrency;
+}
+
 static mtapi_boolean_t embb_mtapi_action_delete_visitor(
   embb_mtapi_task_t * task,
   void * user_data) {
@@ -141,6 +215,7 @@ mtapi_action_hndl_t mtapi_action_create(
         new_action->enabled = MTAPI_TRUE;
         new_action->is_plugin_action = MTAPI_FALSE;
         embb_atomic_store_int(&new_action->num_tasks, 0);
+        embb_atomic_store_unsigned_int(&new_action->average_cost, 0);
 
         new_action->action_function = action_function;
 
@@ -29,6 +29,7 @@
 
 #include <embb/mtapi/c/mtapi_ext.h>
 #include <embb/base/c/atomic.h>
+#include <embb/base/c/time.h>
 
 #include <embb_mtapi_pool_template.h>
 
@@ -39,6 +40,16 @@ extern "C" {
 
 /* ---- CLASS DECLARATION -------------------------------------------------- */
 
+/**
+ * Prediction of an action that is busy and has no average cost yet.
+ */
+#define EMBB_MTAPI_ACTION_NO_COST 0xffffffffffffffffull
+
+/**
+ * Weight of a new measurement in the average cost is 1 / 2^shift.
+ */
+#define EMBB_MTAPI_ACTION_COST_SHIFT 3
+
 /**
  * \internal
  * Action class.
@@ -64,6 +75,9 @@ struct embb_mtapi_action_struct {
   mtapi_ext_plugin_action_finalize_function_t plugin_action_finalize_function;
 
   embb_atomic_int num_tasks;
+  /* moving average of the execution time of a task in microseconds, 0 until
+     the first task of the action completed */
+  embb_atomic_unsigned_int average_cost;
 };
 
 #include <embb_mtapi_action_t_fwd.h>
@@ -80,6 +94,29 @@ void embb_mtapi_action_initialize(embb_mtapi_action_t* that);
  */
 void embb_mtapi_action_finalize(embb_mtapi_action_t* that);
 
+/**
+ * Adds the execution time of tasks that started at \c start_time and
+ * completed now to the average cost of the action. Tasks completing
+ * together, e.g., in one kernel launch, share the elapsed time.
+ * \memberof embb_mtapi_action_struct
+ */
+void embb_mtapi_action_account_cost(
+  embb_mtapi_action_t* that,
+  embb_time_t const * start_time,
+  mtapi_uint_t num_tasks);
+
+/**
+ * Predicts the microseconds until a task started now would complete on the
+ * action, given its average cost, the tasks already in flight and the number
+ * of tasks it runs concurrently. Returns 0 for an idle action that has not
+ * completed a task yet, so it gets measured, and EMBB_MTAPI_ACTION_NO_COST
+ * for a busy one.
+ * \memberof embb_mtapi_action_struct
+ */
+unsigned long long embb_mtapi_action_predict_cost(
+  embb_mtapi_action_t* that,
+  mtapi_uint_t concurrency);
+
 
 /* ---- POOL DECLARATION --------------------------------------------------- */
 
@@ -38,6 +38,7 @@
 #include <embb_mtapi_scheduler_t.h>
 #include <embb_mtapi_thread_context_t.h>
 #include <embb_mtapi_task_context_t.h>
+#include <embb_mtapi_trace_buffer_t.h>
 #include <embb_mtapi_pool_template-inl.h>
 
 
@@ -57,6 +58,8 @@ void embb_mtapi_group_initialize(embb_mtapi_group_t * that) {
   that->group_id = MTAPI_GROUP_ID_NONE;
   that->deleted = MTAPI_FALSE;
   that->num_tasks.internal_variable = 0;
+  that->num_completed.internal_variable = 0;
+  that->num_waiters = 0;
   embb_mtapi_task_queue_initialize(&that->queue);
 }
 
@@ -69,8 +72,12 @@ void embb_mtapi_group_initialize_with_node(
   that->group_id = MTAPI_GROUP_ID_NONE;
   that->deleted = MTAPI_FALSE;
   that->num_tasks.internal_variable = 0;
+  that->num_completed.internal_variable = 0;
+  that->num_waiters = 0;
   embb_mtapi_task_queue_initialize_with_capacity(
     &that->queue, node->attributes.queue_limit);
+  embb_mutex_init(&that->wait_mutex, EMBB_MUTEX_PLAIN);
+  embb_condition_init(&that->wait_condition);
 }
 
 void embb_mtapi_group_finalize(embb_mtapi_group_t * that) {
@@ -79,6 +86,49 @@ void embb_mtapi_group_finalize(embb_mtapi_group_t * that) {
   that->deleted = MTAPI_TRUE;
   that->num_tasks.internal_variable = 0;
   embb_mtapi_task_queue_finalize(&that->queue);
+
+  /* a finishing task may still be signalling, wait for it to leave */
+  embb_mutex_lock(&that->wait_mutex);
+  embb_mutex_unlock(&that->wait_mutex);
+  embb_condition_destroy(&that->wait_condition);
+  embb_mutex_destroy(&that->wait_mutex);
+}
+
+void embb_mtapi_group_push_task(
+  embb_mtapi_group_t * that,
+  embb_mtapi_task_t * task) {
+  assert(MTAPI_NULL != that);
+  assert(MTAPI_NULL != task);
+
+  /* push under the mutex, so the group cannot be finalized by a waiter
+     that picked up the task before it was signalled */
+  embb_mutex_lock(&that->wait_mutex);
+  embb_mtapi_task_queue_push(&that->queue, task);
+  embb_atomic_fetch_and_add_int(&that->num_completed, 1);
+  if (0 < that->num_waiters) {
+    embb_condition_notify_all(&that->wait_condition);
+  }
+  embb_mutex_unlock(&that->wait_mutex);
+}
+
+void embb_mtapi_group_wait_for_completion(
+  embb_mtapi_group_t * that,
+  int completed,
+  embb_time_t const * end_time) {
+  assert(MTAPI_NULL != that);
+
+  embb_mutex_lock(&that->wait_mutex);
+  if (completed == embb_atomic_load_int(&that->num_completed)) {
+    that->num_waiters++;
+    if (MTAPI_NULL == end_time) {
+      embb_condition_wait(&that->wait_condition, &that->wait_mutex);
+    } else {
+      embb_condition_wait_until(
+        &that->wait_condition, &that->wait_mutex, end_time);
+    }
+    that->num_waiters--;
+  }
+  embb_mutex_unlock(&that->wait_mutex);
 }
 
 
@@ -109,7 +159,8 @@ mtapi_group_hndl_t mtapi_group_create(
       if (MTAPI_SUCCESS == local_status) {
         group_hndl = group->handle;
       } else {
-        embb_mtapi_group_finalize(group);
+        /* this is done by pool deallocate:
+           embb_mtapi_group_finalize(group); */
         embb_mtapi_group_pool_deallocate(node->group_pool, group);
       }
     } else {
@@ -208,6 +259,7 @@ void mtapi_group_wait_all(
     embb_mtapi_node_t* node = embb_mtapi_node_get_instance();
     if (embb_mtapi_group_pool_is_handle_valid(node->group_pool, group)) {
       embb_mtapi_thread_context_t * context = NULL;
+      embb_mtapi_trace_buffer_t * trace = MTAPI_NULL;
       embb_mtapi_group_t* local_group =
         embb_mtapi_group_pool_get_storage_for_handle(
           node->group_pool, group);
@@ -223,11 +275,15 @@ void mtapi_group_wait_all(
       /* find out on which thread we are */
       context = embb_mtapi_scheduler_get_current_thread_context(
         node->scheduler);
+      trace = embb_mtapi_scheduler_get_trace_buffer(node->scheduler, context);
+      embb_mtapi_trace(trace, EMBB_MTAPI_TRACE_GROUP_WAIT_BEGIN,
+        group.id, 0, 0);
 
       /* wait for all tasks to arrive in the queue */
       local_status = MTAPI_SUCCESS;
       while (embb_atomic_load_int(&local_group->num_tasks)) {
         embb_mtapi_task_t* local_task;
+        int completed = embb_atomic_load_int(&local_group->num_completed);
 
         if (MTAPI_INFINITE < timeout) {
           embb_time_t current_time;
@@ -251,12 +307,19 @@ void mtapi_group_wait_all(
           local_task = embb_mtapi_task_queue_pop(&local_group->queue);
         }
 
-        /* do other work if applicable */
-        embb_mtapi_scheduler_execute_task_or_yield(
-          node->scheduler,
-          node,
-          context);
+        if (MTAPI_NULL != context) {
+          /* do other work if applicable */
+          embb_mtapi_scheduler_execute_task_or_yield(
+            node->scheduler,
+            node,
+            context);
+        } else if (embb_atomic_load_int(&local_group->num_tasks)) {
+          /* not a worker, sleep until the next task finishes */
+          embb_mtapi_group_wait_for_completion(local_group, completed,
+            (MTAPI_INFINITE < timeout) ? &end_time : MTAPI_NULL);
+        }
       }
+      embb_mtapi_trace(trace, EMBB_MTAPI_TRACE_GROUP_WAIT_END, group.id, 0, 0);
       if (MTAPI_TIMEOUT != local_status) {
         /* group becomes invalid, so delete it */
         mtapi_group_delete(group, MTAPI_NULL);
@@ -297,6 +360,8 @@ void mtapi_group_wait_any(
         local_status = MTAPI_GROUP_COMPLETED;
       } else {
         embb_mtapi_thread_context_t * context = NULL;
+        embb_mtapi_trace_buffer_t * trace = MTAPI_NULL;
+        int completed;
 
         embb_duration_t wait_duration;
         embb_time_t end_time;
@@ -309,9 +374,14 @@ void mtapi_group_wait_any(
         /* find out on which thread we are */
         context = embb_mtapi_scheduler_get_current_thread_context(
           node->scheduler);
+        trace = embb_mtapi_scheduler_get_trace_buffer(
+          node->scheduler, context);
+        embb_mtapi_trace(trace, EMBB_MTAPI_TRACE_GROUP_WAIT_BEGIN,
+          group.id, 0, 0);
 
         /* wait for any task to arrive */
         local_status = MTAPI_SUCCESS;
+        completed = embb_atomic_load_int(&local_group->num_completed);
         local_task = embb_mtapi_task_queue_pop(&local_group->queue);
         while (MTAPI_NULL == local_task) {
           if (MTAPI_INFINITE < timeout) {
@@ -324,15 +394,24 @@ void mtapi_group_wait_any(
             }
           }
 
-          /* do other work if applicable */
-          embb_mtapi_scheduler_execute_task_or_yield(
-            node->scheduler,
-            node,
-            context);
+          if (MTAPI_NULL != context) {
+            /* do other work if applicable */
+            embb_mtapi_scheduler_execute_task_or_yield(
+              node->scheduler,
+              node,
+              context);
+          } else {
+            /* not a worker, sleep until the next task finishes */
+            embb_mtapi_group_wait_for_completion(local_group, completed,
+              (MTAPI_INFINITE < timeout) ? &end_time : MTAPI_NULL);
+          }
 
           /* try to pop a task from the group queue */
+          completed = embb_atomic_load_int(&local_group->num_completed);
           local_task = embb_mtapi_task_queue_pop(&local_group->queue);
         }
+        embb_mtapi_trace(trace, EMBB_MTAPI_TRACE_GROUP_WAIT_END,
+          group.id, 0, 0);
         /* was there a timeout, or is there a result? */
         if (MTAPI_NULL != local_task) {
           /* store result */
@@ -375,7 +454,8 @@ void mtapi_group_delete(
       if (local_group->deleted) {
         local_status = MTAPI_ERR_GROUP_INVALID;
       } else {
-        embb_mtapi_group_finalize(local_group);
+        /* this is done by pool deallocate:
+           embb_mtapi_group_finalize(local_group); */
         embb_mtapi_group_pool_deallocate(node->group_pool, local_group);
         local_status = MTAPI_SUCCESS;
       }
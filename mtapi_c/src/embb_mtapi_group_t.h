@@ -29,6 +29,8 @@
 
 #include <embb/mtapi/c/mtapi.h>
 #include <embb/base/c/atomic.h>
+#include <embb/base/c/mutex.h>
+#include <embb/base/c/condition_variable.h>
 
 #include <embb_mtapi_pool_template.h>
 #include <embb_mtapi_task_queue_t.h>
@@ -41,6 +43,7 @@ extern "C" {
 /* ---- FORWARD DECLARATIONS ----------------------------------------------- */
 
 #include <embb_mtapi_node_t_fwd.h>
+#include <embb_mtapi_task_t_fwd.h>
 
 
 /* ---- CLASS DECLARATION -------------------------------------------------- */
@@ -59,6 +62,12 @@ struct embb_mtapi_group_struct {
   embb_atomic_int num_tasks;
   mtapi_group_attributes_t attributes;
   embb_mtapi_task_queue_t queue;
+
+  /* completion signalling for waiters that do not run on a worker */
+  embb_atomic_int num_completed;
+  int num_waiters;
+  embb_mutex_t wait_mutex;
+  embb_condition_t wait_condition;
 };
 
 #include <embb_mtapi_group_t_fwd.h>
@@ -83,6 +92,26 @@ void embb_mtapi_group_initialize_with_node(
  */
 void embb_mtapi_group_finalize(embb_mtapi_group_t * that);
 
+/**
+ * Hands a finished task over to the group and wakes up parked waiters.
+ * \memberof embb_mtapi_group_struct
+ */
+void embb_mtapi_group_push_task(
+  embb_mtapi_group_t * that,
+  embb_mtapi_task_t * task);
+
+/**
+ * Parks the calling thread until a task of the group has finished after
+ * \c completed was read from the num_completed counter, or until
+ * \c end_time is reached. Passing MTAPI_NULL as \c end_time waits without
+ * timeout.
+ * \memberof embb_mtapi_group_struct
+ */
+void embb_mtapi_group_wait_for_completion(
+  embb_mtapi_group_t * that,
+  int completed,
+  embb_time_t const * end_time);
+
 
 /* ---- POOL DECLARATION --------------------------------------------------- */
 
@@ -38,6 +38,8 @@ void embb_mtapi_id_pool_initialize(
   that->capacity = capacity;
   that->id_buffer = (mtapi_uint_t*)
     embb_mtapi_alloc_allocate(sizeof(mtapi_uint_t)*(capacity + 1));
+  /* the ring has one entry more than ids, so the position to put the next
+     id to never holds an id yet */
   that->id_buffer[0] = EMBB_MTAPI_IDPOOL_INVALID_ID;
   for (ii = 1; ii <= capacity; ii++) {
     that->id_buffer[ii] = ii;
@@ -71,7 +73,7 @@ mtapi_uint_t embb_mtapi_id_pool_allocate(embb_mtapi_id_pool_t * that) {
       /* acquire position to fetch id from */
       mtapi_uint_t id_position = that->get_id_position;
       that->get_id_position++;
-      if (that->capacity <= that->get_id_position) {
+      if (that->capacity < that->get_id_position) {
         that->get_id_position = 0;
       }
 
@@ -97,7 +99,7 @@ void embb_mtapi_id_pool_deallocate(
       /* acquire position to put id to */
       mtapi_uint_t id_position = that->put_id_position;
       that->put_id_position++;
-      if (that->capacity <= that->put_id_position) {
+      if (that->capacity < that->put_id_position) {
         that->put_id_position = 0;
       }
 
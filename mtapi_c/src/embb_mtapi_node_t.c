@@ -271,6 +271,46 @@ void mtapi_node_get_attribute(
             &local_node->attributes.max_priorities, attribute, attribute_size);
           break;
 
+        case MTAPI_NODE_TRACE_CAPACITY:
+          local_status = embb_mtapi_attr_get_mtapi_uint_t(
+            &local_node->attributes.trace_capacity, attribute, attribute_size);
+          break;
+
+        case MTAPI_NODE_TRACE_FILE:
+          if (MTAPI_NODE_TRACE_FILE_SIZE == attribute_size) {
+            *(const char **)attribute = local_node->attributes.trace_file;
+            local_status = MTAPI_SUCCESS;
+          } else {
+            local_status = MTAPI_ERR_ATTR_SIZE;
+          }
+          break;
+
+        case MTAPI_NODE_SCHEDULER_MODE:
+          local_status = embb_mtapi_attr_get_mtapi_uint_t(
+            &local_node->attributes.scheduler_mode, attribute, attribute_size);
+          break;
+
+        case MTAPI_NODE_PRIORITY_AGING:
+          local_status = embb_mtapi_attr_get_mtapi_uint_t(
+            &local_node->attributes.priority_aging, attribute, attribute_size);
+          break;
+
+        case MTAPI_NODE_DEADLINE_TASKS: {
+          mtapi_uint_t value = (mtapi_uint_t)embb_atomic_load_int(
+            &local_node->scheduler->deadline_tasks);
+          local_status = embb_mtapi_attr_get_mtapi_uint_t(
+            &value, attribute, attribute_size);
+          break;
+        }
+
+        case MTAPI_NODE_DEADLINES_MISSED: {
+          mtapi_uint_t value = (mtapi_uint_t)embb_atomic_load_int(
+            &local_node->scheduler->deadlines_missed);
+          local_status = embb_mtapi_attr_get_mtapi_uint_t(
+            &value, attribute, attribute_size);
+          break;
+        }
+
         default:
           local_status = MTAPI_ERR_ATTR_NUM;
           break;
@@ -37,6 +37,7 @@
 #include <embb_mtapi_node_t.h>
 #include <embb_mtapi_task_t.h>
 #include <embb_mtapi_job_t.h>
+#include <embb_mtapi_group_t.h>
 #include <embb_mtapi_pool_template-inl.h>
 #include <embb_mtapi_task_queue_t.h>
 #include <embb_mtapi_scheduler_t.h>
@@ -60,6 +61,8 @@ void embb_mtapi_queue_initialize(embb_mtapi_queue_t* that) {
   embb_atomic_store_int(&that->num_tasks, 0);
   that->job_handle.id = 0;
   that->job_handle.tag = 0;
+  embb_mtapi_task_queue_initialize(&that->ordered_tasks);
+  embb_atomic_store_int(&that->ordered_pending, 0);
 }
 
 void embb_mtapi_queue_initialize_with_attributes_and_job(
@@ -74,6 +77,13 @@ void embb_mtapi_queue_initialize_with_attributes_and_job(
   embb_atomic_store_char(&that->enabled, MTAPI_TRUE);
   embb_atomic_store_int(&that->num_tasks, 0);
   that->job_handle = job;
+  if (that->attributes.ordered) {
+    embb_mtapi_task_queue_initialize_with_capacity(
+      &that->ordered_tasks, that->attributes.limit);
+  } else {
+    embb_mtapi_task_queue_initialize(&that->ordered_tasks);
+  }
+  embb_atomic_store_int(&that->ordered_pending, 0);
 }
 
 void embb_mtapi_queue_finalize(embb_mtapi_queue_t* that) {
@@ -81,6 +91,7 @@ void embb_mtapi_queue_finalize(embb_mtapi_queue_t* that) {
 
   that->job_handle.id = 0;
   that->job_handle.tag = 0;
+  embb_mtapi_task_queue_finalize(&that->ordered_tasks);
   embb_mtapi_queue_initialize(that);
 }
 
@@ -89,11 +100,103 @@ void embb_mtapi_queue_task_started(embb_mtapi_queue_t* that) {
   embb_atomic_fetch_and_add_int(&that->num_tasks, 1);
 }
 
+/* completes a task whose remaining instances could not be scheduled, the
+   same way a worker completes it. Returns MTAPI_TRUE if no other instance
+   is still running, so the task is done. */
+static mtapi_boolean_t embb_mtapi_queue_fail_ordered_task(
+  embb_mtapi_node_t* node,
+  embb_mtapi_task_t* task,
+  mtapi_uint_t failed_instances) {
+  unsigned int todo;
+
+  task->error_code = MTAPI_ERR_TASK_LIMIT;
+  embb_atomic_memory_barrier();
+  todo = embb_atomic_fetch_and_add_unsigned_int(
+    &task->instances_todo, (unsigned int)-(int)failed_instances);
+  if (todo != failed_instances) {
+    /* a running instance finishes the task */
+    return MTAPI_FALSE;
+  }
+
+  embb_mtapi_task_set_state(task, MTAPI_TASK_ERROR);
+  if (embb_mtapi_group_pool_is_handle_valid(node->group_pool, task->group)) {
+    embb_mtapi_group_t* local_group =
+      embb_mtapi_group_pool_get_storage_for_handle(
+        node->group_pool, task->group);
+    embb_mtapi_group_push_task(local_group, task);
+  } else if (task->attributes.is_detached) {
+    /* nobody holds a handle to a detached task */
+    embb_mtapi_task_delete(task, node->task_pool);
+  }
+  return MTAPI_TRUE;
+}
+
+/* hands out the tasks of an ordered queue one after another, until one is
+   running or no task is pending */
+static void embb_mtapi_queue_dispatch_ordered_tasks(embb_mtapi_queue_t* that) {
+  embb_mtapi_node_t* node = embb_mtapi_node_get_instance();
+  embb_mtapi_task_t* task;
+  mtapi_uint_t failed;
+  mtapi_uint_t kk;
+
+  assert(MTAPI_NULL != that);
+  assert(MTAPI_NULL != node);
+
+  do {
+    /* the task was pushed before ordered_pending was raised */
+    task = embb_mtapi_task_queue_pop_waiting(&that->ordered_tasks);
+    assert(MTAPI_NULL != task);
+
+    failed = 0;
+    for (kk = 0; kk < task->attributes.num_instances; kk++) {
+      if (MTAPI_FALSE ==
+        embb_mtapi_scheduler_schedule_task(node->scheduler, task, kk)) {
+        failed++;
+      }
+    }
+    if (0 == failed) {
+      /* the turn is handed on when the task finishes */
+      return;
+    }
+
+    embb_mtapi_log_error(
+      "embb_mtapi_queue_dispatch_ordered_tasks() could not schedule task\n");
+    if (MTAPI_FALSE == embb_mtapi_queue_fail_ordered_task(node, task, failed)) {
+      return;
+    }
+    embb_atomic_fetch_and_add_int(&that->num_tasks, -1);
+    /* the task is done, keep going with the next one, if there is one */
+  } while (1 < embb_atomic_fetch_and_add_int(&that->ordered_pending, -1));
+}
+
 void embb_mtapi_queue_task_finished(embb_mtapi_queue_t* that) {
   assert(MTAPI_NULL != that);
+  if (that->attributes.ordered) {
+    /* hand the turn on to the next task, if there is one */
+    if (1 < embb_atomic_fetch_and_add_int(&that->ordered_pending, -1)) {
+      embb_mtapi_queue_dispatch_ordered_tasks(that);
+    }
+  }
   embb_atomic_fetch_and_add_int(&that->num_tasks, -1);
 }
 
+mtapi_boolean_t embb_mtapi_queue_schedule_ordered_task(
+  embb_mtapi_queue_t* that,
+  embb_mtapi_task_t* task) {
+  assert(MTAPI_NULL != that);
+  assert(MTAPI_NULL != task);
+  assert(that->attributes.ordered);
+
+  if (MTAPI_FALSE == embb_mtapi_task_queue_push(&that->ordered_tasks, task)) {
+    return MTAPI_FALSE;
+  }
+  if (0 == embb_atomic_fetch_and_add_int(&that->ordered_pending, 1)) {
+    /* no task of this queue is active, so it is our turn */
+    embb_mtapi_queue_dispatch_ordered_tasks(that);
+  }
+  return MTAPI_TRUE;
+}
+
 static mtapi_boolean_t embb_mtapi_queue_delete_visitor(
   embb_mtapi_task_t * task,
   void * user_data) {
@@ -187,16 +290,6 @@ mtapi_queue_hndl_t mtapi_queue_create(
         if (embb_mtapi_job_is_handle_valid(node, job)) {
           embb_mtapi_queue_initialize_with_attributes_and_job(
             queue, &attr, job);
-          /* for an ordered queue, initialize affinity */
-          if (queue->attributes.ordered) {
-            mtapi_affinity_init(
-              &queue->ordered_affinity,
-              MTAPI_FALSE, MTAPI_NULL);
-            mtapi_affinity_set(
-              &queue->ordered_affinity,
-              queue->handle.id % node->scheduler->worker_count,
-              MTAPI_TRUE, MTAPI_NULL);
-          }
           queue->queue_id = queue_id;
           queue_hndl = queue->handle;
         } else {
@@ -371,9 +464,11 @@ void mtapi_queue_delete(
       context = embb_mtapi_scheduler_get_current_thread_context(
         node->scheduler);
 
-      /* cancel all tasks */
+      /* cancel all tasks, including those still waiting for their turn */
       embb_mtapi_scheduler_process_tasks(
         node->scheduler, embb_mtapi_queue_delete_visitor, local_queue);
+      embb_mtapi_task_queue_process(&local_queue->ordered_tasks,
+        embb_mtapi_queue_delete_visitor, local_queue);
 
       /* wait for tasks in queue to finish */
       local_status = MTAPI_SUCCESS;
@@ -427,6 +522,8 @@ void mtapi_queue_disable(
       /* cancel or retain all tasks scheduled via queue */
       embb_mtapi_scheduler_process_tasks(
         node->scheduler, embb_mtapi_queue_disable_visitor, local_queue);
+      embb_mtapi_task_queue_process(&local_queue->ordered_tasks,
+        embb_mtapi_queue_disable_visitor, local_queue);
 
       /* if queue is not retaining, wait for all tasks to finish */
       if (MTAPI_FALSE == local_queue->attributes.retain) {
@@ -493,6 +590,8 @@ void mtapi_queue_enable(
         /* reschedule retained tasks */
         embb_mtapi_scheduler_process_tasks(
           node->scheduler, embb_mtapi_queue_enable_visitor, local_queue);
+        embb_mtapi_task_queue_process(&local_queue->ordered_tasks,
+          embb_mtapi_queue_enable_visitor, local_queue);
       }
     } else {
       local_status = MTAPI_ERR_QUEUE_INVALID;
@@ -32,6 +32,7 @@
 
 #include <embb_mtapi_pool_template.h>
 #include <embb_mtapi_spinlock_t.h>
+#include <embb_mtapi_task_queue_t.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -40,7 +41,7 @@ extern "C" {
 
 /* ---- FORWARD DECLARATIONS ----------------------------------------------- */
 
-#include <embb_mtapi_task_queue_t_fwd.h>
+#include <embb_mtapi_task_t_fwd.h>
 
 
 /* ---- CLASS DECLARATION -------------------------------------------------- */
@@ -60,7 +61,15 @@ struct embb_mtapi_queue_struct {
   mtapi_queue_attributes_t attributes;
 
   embb_atomic_int num_tasks;
-  mtapi_affinity_t ordered_affinity;
+
+  /* ordered queues only: tasks waiting for their turn, and the number of
+     tasks that were submitted but have not finished yet; the task that
+     raises it from 0, or finishes while it stays above 0, dispatches the
+     next waiting task, so exactly one task is active at any time;
+     the waiting tasks are kept in a spinlocked task queue like all other
+     task queues of the runtime, only the hand-over is lock-free */
+  embb_mtapi_task_queue_t ordered_tasks;
+  embb_atomic_int ordered_pending;
 };
 
 #include <embb_mtapi_queue_t_fwd.h>
@@ -98,6 +107,16 @@ void embb_mtapi_queue_task_started(embb_mtapi_queue_t* that);
  */
 void embb_mtapi_queue_task_finished(embb_mtapi_queue_t* that);
 
+/**
+ * Schedule a Task of an ordered queue. The Task is executed by any worker
+ * as soon as all tasks submitted before it have finished. Returns
+ * MTAPI_FALSE if the queue limit is exceeded.
+ * \memberof embb_mtapi_queue_struct
+ */
+mtapi_boolean_t embb_mtapi_queue_schedule_ordered_task(
+  embb_mtapi_queue_t* that,
+  embb_mtapi_task_t* task);
+
 /* ---- POOL DECLARATION --------------------------------------------------- */
 
 embb_mtapi_pool(queue)
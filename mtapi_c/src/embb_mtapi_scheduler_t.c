@@ -25,6 +25,7 @@
  */
 
 #include <assert.h>
+#include <stdio.h>
 
 #include <embb/base/c/base.h>
 
@@ -38,8 +39,11 @@
 #include <embb_mtapi_task_context_t.h>
 #include <embb_mtapi_task_t.h>
 #include <embb_mtapi_action_t.h>
+#include <embb_mtapi_group_t.h>
 #include <embb_mtapi_alloc.h>
 #include <embb_mtapi_queue_t.h>
+#include <embb_mtapi_task_heap_t.h>
+#include <embb_mtapi_trace_buffer_t.h>
 
 
 /* ---- CLASS MEMBERS ------------------------------------------------------ */
@@ -73,6 +77,26 @@ embb_mtapi_task_t * embb_mtapi_scheduler_get_public_task_from_context(
   return task;
 }
 
+embb_mtapi_task_t * embb_mtapi_scheduler_steal_task_from_context(
+  embb_mtapi_scheduler_t * that,
+  embb_mtapi_thread_context_t * thread_context,
+  mtapi_uint_t victim_index,
+  mtapi_uint_t priority) {
+  embb_mtapi_task_t * task;
+
+  assert(MTAPI_NULL != that);
+  assert(NULL != thread_context);
+  assert(victim_index < that->worker_count);
+
+  task = embb_mtapi_task_queue_pop(
+    that->worker_contexts[victim_index].queue[priority]);
+  if (MTAPI_NULL != task) {
+    embb_mtapi_trace(thread_context->trace, EMBB_MTAPI_TRACE_STEAL,
+      task->handle.id, task->job.id, victim_index);
+  }
+  return task;
+}
+
 embb_mtapi_task_t * embb_mtapi_scheduler_get_next_task_vhpf(
   embb_mtapi_scheduler_t * that,
   embb_mtapi_node_t * node,
@@ -105,8 +129,8 @@ embb_mtapi_task_t * embb_mtapi_scheduler_get_next_task_vhpf(
         for (kk = 0;
           kk < that->worker_count - 1 && MTAPI_NULL == task;
           kk++) {
-          task = embb_mtapi_task_queue_pop(
-            that->worker_contexts[context_index].queue[ii]);
+          task = embb_mtapi_scheduler_steal_task_from_context(
+            that, thread_context, context_index, ii);
           context_index =
             (context_index + 1) % that->worker_count;
         }
@@ -156,11 +180,136 @@ embb_mtapi_task_t * embb_mtapi_scheduler_get_next_task_lf(
     for (kk = 0;
       kk < that->worker_count - 1 && MTAPI_NULL == task;
       kk++) {
-      task = embb_mtapi_task_queue_pop(
-        that->worker_contexts[context_index].queue[prio]);
+      task = embb_mtapi_scheduler_steal_task_from_context(
+        that, thread_context, context_index, prio);
+      context_index =
+        (context_index + 1) % that->worker_count;
+    }
+  }
+  return task;
+}
+
+embb_mtapi_task_t * embb_mtapi_scheduler_get_next_task_hpf(
+  embb_mtapi_scheduler_t * that,
+  embb_mtapi_node_t * node,
+  embb_mtapi_thread_context_t * thread_context) {
+  embb_mtapi_task_t * task = MTAPI_NULL;
+  mtapi_uint_t max_priorities = node->attributes.max_priorities;
+  mtapi_boolean_t aging = MTAPI_FALSE;
+  mtapi_uint_t prio = 0;
+  mtapi_uint_t ii = 0;
+  mtapi_uint_t kk = 0;
+
+  assert(MTAPI_NULL != that);
+  assert(MTAPI_NULL != node);
+  assert(NULL != thread_context);
+  assert(MTAPI_NULL != that->pending_tasks);
+
+  /* after priority_aging tasks in priority order serve the lowest pending
+     priority once, so low priority work cannot starve */
+  if (0 < that->priority_aging &&
+    thread_context->aging_counter >= that->priority_aging) {
+    aging = MTAPI_TRUE;
+  }
+
+  for (ii = 0; ii < max_priorities && MTAPI_NULL == task; ii++) {
+    prio = aging ? (max_priorities - 1 - ii) : ii;
+
+    /* skip priorities without pending work anywhere on the node */
+    if (0 == embb_atomic_load_int(&that->pending_tasks[prio])) {
+      continue;
+    }
+
+    /* try local queues, first private. */
+    task = embb_mtapi_scheduler_get_private_task_from_context(
+      that, thread_context, prio);
+    if (MTAPI_NULL == task) {
+      /* found nothing, so local public next. */
+      task = embb_mtapi_scheduler_get_public_task_from_context(
+        that, thread_context, prio);
+    }
+    if (MTAPI_NULL == task) {
+      /* still nothing, steal before looking at lower priorities */
+      mtapi_uint_t context_index =
+        (thread_context->worker_index + 1) % that->worker_count;
+      for (kk = 0;
+        kk < that->worker_count - 1 && MTAPI_NULL == task;
+        kk++) {
+        task = embb_mtapi_scheduler_steal_task_from_context(
+          that, thread_context, context_index, prio);
+        context_index =
+          (context_index + 1) % that->worker_count;
+      }
+    }
+  }
+
+  if (MTAPI_NULL != task) {
+    embb_atomic_fetch_and_add_int(&that->pending_tasks[prio], -1);
+    if (aging) {
+      thread_context->aging_counter = 0;
+    } else {
+      thread_context->aging_counter++;
+    }
+  }
+  return task;
+}
+
+embb_mtapi_task_t * embb_mtapi_scheduler_get_next_task_edf(
+  embb_mtapi_scheduler_t * that,
+  embb_mtapi_node_t * node,
+  embb_mtapi_thread_context_t * thread_context) {
+  embb_mtapi_task_t * task = MTAPI_NULL;
+  embb_mtapi_task_t * private_top;
+  embb_mtapi_task_t * public_top;
+  mtapi_uint_t kk = 0;
+
+  assert(MTAPI_NULL != that);
+  assert(MTAPI_NULL != node);
+  assert(NULL != thread_context);
+  assert(MTAPI_NULL != thread_context->heap);
+  EMBB_UNUSED_IN_RELEASE(node);
+
+  /* take the earlier of the local private and public candidates */
+  private_top = embb_mtapi_task_heap_peek(thread_context->private_heap);
+  public_top = embb_mtapi_task_heap_peek(thread_context->heap);
+  if (MTAPI_NULL != public_top && (MTAPI_NULL == private_top ||
+    embb_mtapi_task_heap_is_due_before(public_top, private_top))) {
+    task = embb_mtapi_task_heap_pop(thread_context->heap);
+  }
+  if (MTAPI_NULL == task) {
+    task = embb_mtapi_task_heap_pop(thread_context->private_heap);
+  }
+  if (MTAPI_NULL == task) {
+    task = embb_mtapi_task_heap_pop(thread_context->heap);
+  }
+
+  if (MTAPI_NULL == task) {
+    /* nothing local, steal the earliest deadline of all other workers */
+    embb_mtapi_task_t * best = MTAPI_NULL;
+    mtapi_uint_t best_index = 0;
+    mtapi_uint_t context_index =
+      (thread_context->worker_index + 1) % that->worker_count;
+    for (kk = 0; kk < that->worker_count - 1; kk++) {
+      embb_mtapi_task_t * candidate = embb_mtapi_task_heap_peek(
+        that->worker_contexts[context_index].heap);
+      if (MTAPI_NULL != candidate && (MTAPI_NULL == best ||
+        embb_mtapi_task_heap_is_due_before(candidate, best))) {
+        best = candidate;
+        best_index = context_index;
+      }
       context_index =
         (context_index + 1) % that->worker_count;
     }
+    /* the victim's earliest task might have changed meanwhile,
+       take whatever is its earliest now */
+    if (MTAPI_NULL != best) {
+      task = embb_mtapi_task_heap_pop(
+        that->worker_contexts[best_index].heap);
+      if (MTAPI_NULL != task) {
+        embb_mtapi_trace(thread_context->trace, EMBB_MTAPI_TRACE_STEAL,
+          task->handle.id, task->job.id, best_index);
+      }
+    }
   }
   return task;
 }
@@ -184,6 +333,14 @@ embb_mtapi_task_t * embb_mtapi_scheduler_get_next_task(
     task = embb_mtapi_scheduler_get_next_task_vhpf(
       that, node, thread_context);
     break;
+  case WORK_STEAL_HPF:
+    task = embb_mtapi_scheduler_get_next_task_hpf(
+      that, node, thread_context);
+    break;
+  case WORK_STEAL_EDF:
+    task = embb_mtapi_scheduler_get_next_task_edf(
+      that, node, thread_context);
+    break;
   case NUM_SCHEDULER_MODES:
   default:
     embb_mtapi_log_error(
@@ -212,6 +369,117 @@ embb_mtapi_thread_context_t * embb_mtapi_scheduler_get_current_thread_context(
   return context;
 }
 
+embb_mtapi_trace_buffer_t * embb_mtapi_scheduler_get_trace_buffer(
+  embb_mtapi_scheduler_t * that,
+  embb_mtapi_thread_context_t * thread_context) {
+  assert(MTAPI_NULL != that);
+
+  if (NULL != thread_context) {
+    return thread_context->trace;
+  } else {
+    return that->external_trace;
+  }
+}
+
+mtapi_boolean_t embb_mtapi_scheduler_execute_task(
+  embb_mtapi_scheduler_t * that,
+  embb_mtapi_node_t * node,
+  embb_mtapi_thread_context_t * thread_context,
+  embb_mtapi_task_t * task) {
+  embb_mtapi_task_context_t task_context;
+  embb_mtapi_queue_t * local_queue = MTAPI_NULL;
+  mtapi_task_complete_function_t complete_func;
+  mtapi_task_hndl_t task_hndl;
+  mtapi_boolean_t executed = MTAPI_FALSE;
+  mtapi_boolean_t finished = MTAPI_FALSE;
+
+  assert(MTAPI_NULL != that);
+  assert(MTAPI_NULL != node);
+  assert(NULL != thread_context);
+  assert(MTAPI_NULL != task);
+
+  /* once the last instance finished, the task may be deleted by a waiting
+  thread or below, so only the instance that finished it may access it
+  afterwards */
+  complete_func = task->attributes.complete_func;
+  task_hndl = task->handle;
+
+  /* is task associated with a queue? */
+  if (embb_mtapi_queue_pool_is_handle_valid(
+    node->queue_pool, task->queue)) {
+    local_queue =
+      embb_mtapi_queue_pool_get_storage_for_handle(
+        node->queue_pool, task->queue);
+  }
+
+  switch (task->state) {
+  case MTAPI_TASK_SCHEDULED:
+  /* multi-instance task, another instance might be running */
+  case MTAPI_TASK_RUNNING:
+    /* there was work, execute it */
+    embb_mtapi_task_context_initialize_with_thread_context_and_task(
+      &task_context, thread_context, task);
+    if (embb_mtapi_task_execute(task, &task_context)) {
+      finished = MTAPI_TRUE;
+      /* tell queue that a task is done */
+      if (MTAPI_NULL != local_queue) {
+        embb_mtapi_queue_task_finished(local_queue);
+      }
+    }
+    executed = MTAPI_TRUE;
+    break;
+
+  case MTAPI_TASK_RETAINED:
+    /* put task into queue again for later execution */
+    embb_mtapi_scheduler_schedule_task(that, task, 0);
+    /* yield, as there may be only retained tasks in the queue */
+    embb_thread_yield();
+    /* task is not done, so do not notify queue */
+    break;
+
+  case MTAPI_TASK_CANCELLED:
+    /* set return value to canceled */
+    task->error_code = MTAPI_ERR_ACTION_CANCELLED;
+    if (embb_atomic_fetch_and_add_unsigned_int(
+      &task->instances_todo, (unsigned int)-1) == 1) {
+      finished = MTAPI_TRUE;
+      /* tell queue that a task is done */
+      if (MTAPI_NULL != local_queue) {
+        embb_mtapi_queue_task_finished(local_queue);
+      }
+    }
+    break;
+
+  case MTAPI_TASK_COMPLETED:
+  case MTAPI_TASK_DELETED:
+  case MTAPI_TASK_WAITING:
+  case MTAPI_TASK_CREATED:
+  case MTAPI_TASK_PRENATAL:
+  case MTAPI_TASK_ERROR:
+  case MTAPI_TASK_INTENTIONALLY_UNUSED:
+  default:
+    /* do nothing, although this is an error */
+    break;
+  }
+
+  if (finished) {
+    /* issue task complete callback if set */
+    if (MTAPI_NULL != complete_func) {
+      complete_func(task_hndl, MTAPI_NULL);
+    }
+
+    /* nobody holds a handle to a detached task, so it is deleted here
+    unless a group takes care of it */
+    if (task->attributes.is_detached &&
+      MTAPI_FALSE == embb_mtapi_group_pool_is_handle_valid(
+        node->group_pool, task->group)) {
+      embb_mtapi_task_delete(task, node->task_pool);
+    }
+  }
+
+  return executed;
+}
+
 void embb_mtapi_scheduler_execute_task_or_yield(
   embb_mtapi_scheduler_t * that,
   embb_mtapi_node_t * node,
@@ -224,10 +492,8 @@ void embb_mtapi_scheduler_execute_task_or_yield(
       that, node, thread_context);
     /* if there was work, execute it */
     if (MTAPI_NULL != new_task) {
-      embb_mtapi_task_context_t task_context;
-      embb_mtapi_task_context_initialize_with_thread_context_and_task(
-        &task_context, thread_context, new_task);
-      embb_mtapi_task_execute(new_task, &task_context);
+      embb_mtapi_scheduler_execute_task(
+        that, node, thread_context, new_task);
     } else {
       embb_thread_yield();
     }
@@ -252,7 +518,6 @@ embb_mtapi_scheduler_worker_func(embb_mtapi_scheduler_t * that) {
 int embb_mtapi_scheduler_worker(void * arg) {
   embb_mtapi_thread_context_t * thread_context =
     (embb_mtapi_thread_context_t*)arg;
-  embb_mtapi_task_context_t task_context;
   embb_mtapi_node_t * node;
   embb_duration_t sleep_duration;
   int err;
@@ -292,68 +557,9 @@ int embb_mtapi_scheduler_worker(void * arg) {
       node->scheduler, node, thread_context);
     /* check if there was work */
     if (MTAPI_NULL != task) {
-      embb_mtapi_queue_t * local_queue = MTAPI_NULL;
-
-      /* is task associated with a queue? */
-      if (embb_mtapi_queue_pool_is_handle_valid(
-        node->queue_pool, task->queue)) {
-        local_queue =
-          embb_mtapi_queue_pool_get_storage_for_handle(
-            node->queue_pool, task->queue);
-      }
-
-      switch (task->state) {
-      case MTAPI_TASK_SCHEDULED:
-      /* multi-instance task, another instance might be running */
-      case MTAPI_TASK_RUNNING:
-        /* there was work, execute it */
-        embb_mtapi_task_context_initialize_with_thread_context_and_task(
-          &task_context, thread_context, task);
-        if (embb_mtapi_task_execute(task, &task_context)) {
-          /* tell queue that a task is done */
-          if (MTAPI_NULL != local_queue) {
-            embb_mtapi_queue_task_finished(local_queue);
-          }
-        }
+      if (embb_mtapi_scheduler_execute_task(
+        node->scheduler, node, thread_context, task)) {
         counter = 0;
-        break;
-
-      case MTAPI_TASK_RETAINED:
-        /* put task into queue again for later execution */
-        embb_mtapi_scheduler_schedule_task(
-          node->scheduler, task, 0);
-        /* yield, as there may be only retained tasks in the queue */
-        embb_thread_yield();
-        /* task is not done, so do not notify queue */
-        break;
-
-      case MTAPI_TASK_CANCELLED:
-        /* set return value to canceled */
-        task->error_code = MTAPI_ERR_ACTION_CANCELLED;
-        if (embb_atomic_fetch_and_add_unsigned_int(
-          &task->instances_todo, (unsigned int)-1) == 0) {
-          /* tell queue that a task is done */
-          if (MTAPI_NULL != local_queue) {
-            embb_mtapi_queue_task_finished(local_queue);
-          }
-        }
-        break;
-
-      case MTAPI_TASK_COMPLETED:
-      case MTAPI_TASK_DELETED:
-      case MTAPI_TASK_WAITING:
-      case MTAPI_TASK_CREATED:
-      case MTAPI_TASK_PRENATAL:
-      case MTAPI_TASK_ERROR:
-      case MTAPI_TASK_INTENTIONALLY_UNUSED:
-      default:
-        /* do nothing, although this is an error */
-        break;
-      }
-
-      /* issue task complete callback if set */
-      if (MTAPI_NULL != task->attributes.complete_func) {
-        task->attributes.complete_func(task->handle, MTAPI_NULL);
       }
     } else if (counter < 1024) {
       /* spin and yield for a while before going to sleep */
@@ -361,6 +567,7 @@ int embb_mtapi_scheduler_worker(void * arg) {
       counter++;
     } else {
       /* no work, go to sleep */
+      embb_mtapi_trace(thread_context->trace, EMBB_MTAPI_TRACE_SLEEP, 0, 0, 0);
       embb_atomic_store_int(&thread_context->is_sleeping, 1);
       embb_mutex_lock(&thread_context->work_available_mutex);
       embb_condition_wait_for(
@@ -369,6 +576,7 @@ int embb_mtapi_scheduler_worker(void * arg) {
         &sleep_duration);
       embb_mutex_unlock(&thread_context->work_available_mutex);
       embb_atomic_store_int(&thread_context->is_sleeping, 0);
+      embb_mtapi_trace(thread_context->trace, EMBB_MTAPI_TRACE_WAKE, 0, 0, 0);
     }
   }
 
@@ -423,7 +631,12 @@ mtapi_boolean_t embb_mtapi_scheduler_wait_for_task(
 
 mtapi_boolean_t embb_mtapi_scheduler_initialize(
   embb_mtapi_scheduler_t * that) {
-  return embb_mtapi_scheduler_initialize_with_mode(that, WORK_STEAL_VHPF);
+  embb_mtapi_node_t* node = embb_mtapi_node_get_instance();
+
+  assert(MTAPI_NULL != node);
+
+  return embb_mtapi_scheduler_initialize_with_mode(that,
+    (embb_mtapi_scheduler_mode_t)node->attributes.scheduler_mode);
 }
 
 mtapi_boolean_t embb_mtapi_scheduler_initialize_with_mode(
@@ -438,6 +651,17 @@ mtapi_boolean_t embb_mtapi_scheduler_initialize_with_mode(
   assert(MTAPI_NULL != node);
 
   embb_atomic_store_int(&that->affine_task_counter, 0);
+  embb_atomic_store_int(&that->deadline_tasks, 0);
+  embb_atomic_store_int(&that->deadlines_missed, 0);
+
+  /* worker trace buffers are set up by the thread contexts */
+  embb_time_now(&that->trace_origin);
+  if (0 < node->attributes.trace_capacity) {
+    that->external_trace = embb_mtapi_trace_buffer_new(
+      node->attributes.trace_capacity, MTAPI_TRUE);
+  } else {
+    that->external_trace = MTAPI_NULL;
+  }
 
   /* Paranoia sanitizing of scheduler mode */
   if (mode >= NUM_SCHEDULER_MODES) {
@@ -445,6 +669,27 @@ mtapi_boolean_t embb_mtapi_scheduler_initialize_with_mode(
   }
   that->mode = mode;
 
+  /* the per priority summary is only needed for WORK_STEAL_HPF */
+  that->priority_aging = node->attributes.priority_aging;
+  if (WORK_STEAL_HPF == mode) {
+    that->pending_tasks = (embb_atomic_int*)embb_mtapi_alloc_allocate(
+      sizeof(embb_atomic_int)*node->attributes.max_priorities);
+    if (MTAPI_NULL == that->pending_tasks) {
+      if (MTAPI_NULL != that->external_trace) {
+        embb_mtapi_trace_buffer_delete(that->external_trace);
+        that->external_trace = MTAPI_NULL;
+      }
+      that->worker_count = 0;
+      that->worker_contexts = MTAPI_NULL;
+      return MTAPI_FALSE;
+    }
+    for (ii = 0; ii < node->attributes.max_priorities; ii++) {
+      embb_atomic_store_int(&that->pending_tasks[ii], 0);
+    }
+  } else {
+    that->pending_tasks = MTAPI_NULL;
+  }
+
   assert(node->attributes.num_cores ==
     embb_core_set_count(&node->attributes.core_affinity));
   that->worker_count = node->attributes.num_cores;
@@ -452,6 +697,10 @@ mtapi_boolean_t embb_mtapi_scheduler_initialize_with_mode(
   that->worker_contexts = (embb_mtapi_thread_context_t*)
     embb_mtapi_alloc_allocate(
       sizeof(embb_mtapi_thread_context_t)*that->worker_count);
+  if (MTAPI_NULL == that->worker_contexts) {
+    that->worker_count = 0;
+    return MTAPI_FALSE;
+  }
   for (ii = 0; ii < that->worker_count; ii++) {
     unsigned int core_num = 0;
     mtapi_uint_t ll = 0;
@@ -463,8 +712,13 @@ mtapi_boolean_t embb_mtapi_scheduler_initialize_with_mode(
       }
       core_num++;
     }
-    embb_mtapi_thread_context_initialize_with_node_worker_and_core(
-      &that->worker_contexts[ii], node, ii, core_num);
+    if (MTAPI_FALSE ==
+      embb_mtapi_thread_context_initialize_with_node_worker_and_core(
+        &that->worker_contexts[ii], node, ii, core_num)) {
+      /* only the contexts initialized so far need to be finalized */
+      that->worker_count = ii + 1;
+      return MTAPI_FALSE;
+    }
   }
   for (ii = 0; ii < that->worker_count; ii++) {
     if (MTAPI_FALSE == embb_mtapi_thread_context_start(
@@ -476,6 +730,42 @@ mtapi_boolean_t embb_mtapi_scheduler_initialize_with_mode(
   return MTAPI_TRUE;
 }
 
+static void embb_mtapi_scheduler_write_trace(
+  embb_mtapi_scheduler_t * that,
+  const char * file_name) {
+  embb_mtapi_node_t* node = embb_mtapi_node_get_instance();
+  mtapi_boolean_t is_first = MTAPI_TRUE;
+  char thread_name[32];
+  mtapi_uint_t ii;
+  FILE * file;
+
+  assert(MTAPI_NULL != that);
+  assert(MTAPI_NULL != node);
+  assert(MTAPI_NULL != file_name);
+
+  file = fopen(file_name, "w");
+  if (NULL == file) {
+    embb_mtapi_log_error(
+      "embb_mtapi_scheduler_write_trace() could not open %s\n", file_name);
+    return;
+  }
+
+  fprintf(file, "{\"traceEvents\":[");
+  for (ii = 0; ii < that->worker_count; ii++) {
+    if (MTAPI_NULL != that->worker_contexts[ii].trace) {
+      sprintf(thread_name, "worker %u", (unsigned int)ii);
+      embb_mtapi_trace_buffer_write(that->worker_contexts[ii].trace, file,
+        node->node_id, ii, thread_name, &that->trace_origin, &is_first);
+    }
+  }
+  embb_mtapi_trace_buffer_write(that->external_trace, file,
+    node->node_id, that->worker_count, "external", &that->trace_origin,
+    &is_first);
+  fprintf(file, "\n],\"displayTimeUnit\":\"ns\"}\n");
+
+  fclose(file);
+}
+
 void embb_mtapi_scheduler_finalize(embb_mtapi_scheduler_t * that) {
   mtapi_uint_t ii = 0;
   embb_mtapi_log_trace("embb_mtapi_scheduler_finalize() called\n");
@@ -486,6 +776,18 @@ void embb_mtapi_scheduler_finalize(embb_mtapi_scheduler_t * that) {
   for (ii = 0; ii < that->worker_count; ii++) {
     embb_mtapi_thread_context_stop(&that->worker_contexts[ii]);
   }
+
+  /* workers are stopped, so the trace buffers are stable now */
+  if (MTAPI_NULL != that->external_trace) {
+    embb_mtapi_node_t* node = embb_mtapi_node_get_instance();
+    assert(MTAPI_NULL != node);
+    if (MTAPI_NULL != node->attributes.trace_file) {
+      embb_mtapi_scheduler_write_trace(that, node->attributes.trace_file);
+    }
+    embb_mtapi_trace_buffer_delete(that->external_trace);
+    that->external_trace = MTAPI_NULL;
+  }
+
   for (ii = 0; ii < that->worker_count; ii++) {
     embb_mtapi_thread_context_finalize(&that->worker_contexts[ii]);
   }
@@ -493,6 +795,11 @@ void embb_mtapi_scheduler_finalize(embb_mtapi_scheduler_t * that) {
   that->worker_count = 0;
   embb_mtapi_alloc_deallocate(that->worker_contexts);
   that->worker_contexts = MTAPI_NULL;
+
+  if (MTAPI_NULL != that->pending_tasks) {
+    embb_mtapi_alloc_deallocate(that->pending_tasks);
+    that->pending_tasks = MTAPI_NULL;
+  }
 }
 
 embb_mtapi_scheduler_t * embb_mtapi_scheduler_new() {
@@ -550,7 +857,6 @@ mtapi_boolean_t embb_mtapi_scheduler_schedule_task(
 
   if (embb_mtapi_action_pool_is_handle_valid(
     node->action_pool, task->action)) {
-    embb_mtapi_queue_t* local_queue = MTAPI_NULL;
     /* fetch action and schedule */
     embb_mtapi_action_t* local_action =
       embb_mtapi_action_pool_get_storage_for_handle(
@@ -559,16 +865,6 @@ mtapi_boolean_t embb_mtapi_scheduler_schedule_task(
     mtapi_affinity_t affinity =
       local_action->attributes.affinity & task->attributes.affinity;
 
-    /* check if task is running from an ordered queue */
-    if (embb_mtapi_queue_pool_is_handle_valid(node->queue_pool, task->queue)) {
-      local_queue = embb_mtapi_queue_pool_get_storage_for_handle(
-        node->queue_pool, task->queue);
-      if (local_queue->attributes.ordered) {
-        /* yes, modify affinity accordingly */
-        affinity = local_queue->ordered_affinity;
-      }
-    }
-
     /* check affinity */
     if (affinity == 0) {
       affinity = node->affinity_all;
@@ -577,11 +873,23 @@ mtapi_boolean_t embb_mtapi_scheduler_schedule_task(
     /* one more task in flight for this action */
     embb_atomic_fetch_and_add_int(&local_action->num_tasks, 1);
 
+    /* announce the task before it becomes visible, so the summary never
+       hides queued work from the workers */
+    if (MTAPI_NULL != scheduler->pending_tasks) {
+      embb_atomic_fetch_and_add_int(
+        &scheduler->pending_tasks[task->attributes.priority], 1);
+    }
+
     if (affinity == node->affinity_all) {
       /* no affinity restrictions, schedule for stealing */
-      pushed = embb_mtapi_task_queue_push(
-        scheduler->worker_contexts[ii].queue[task->attributes.priority],
-        task);
+      if (WORK_STEAL_EDF == scheduler->mode) {
+        pushed = embb_mtapi_task_heap_push(
+          scheduler->worker_contexts[ii].heap, task);
+      } else {
+        pushed = embb_mtapi_task_queue_push(
+          scheduler->worker_contexts[ii].queue[task->attributes.priority],
+          task);
+      }
     } else {
       mtapi_status_t affinity_status;
 
@@ -593,9 +901,15 @@ mtapi_boolean_t embb_mtapi_scheduler_schedule_task(
         ii = (ii + 1) % scheduler->worker_count;
       }
       /* schedule into private queue to disable stealing */
-      pushed = embb_mtapi_task_queue_push(
-        scheduler->worker_contexts[ii].private_queue[task->attributes.priority],
-        task);
+      if (WORK_STEAL_EDF == scheduler->mode) {
+        pushed = embb_mtapi_task_heap_push(
+          scheduler->worker_contexts[ii].private_heap, task);
+      } else {
+        pushed = embb_mtapi_task_queue_push(
+          scheduler->worker_contexts[ii].private_queue[
+            task->attributes.priority],
+          task);
+      }
     }
 
     if (pushed) {
@@ -607,8 +921,27 @@ mtapi_boolean_t embb_mtapi_scheduler_schedule_task(
     } else {
       /* task could not be launched */
       embb_atomic_fetch_and_add_int(&local_action->num_tasks, -1);
+      if (MTAPI_NULL != scheduler->pending_tasks) {
+        embb_atomic_fetch_and_add_int(
+          &scheduler->pending_tasks[task->attributes.priority], -1);
+      }
     }
   }
 
   return pushed;
 }
+
+void embb_mtapi_scheduler_account_deadline(
+  embb_mtapi_scheduler_t * that,
+  embb_mtapi_task_t * task) {
+  embb_time_t now;
+
+  assert(MTAPI_NULL != that);
+  assert(MTAPI_NULL != task);
+
+  embb_time_now(&now);
+  embb_atomic_fetch_and_add_int(&that->deadline_tasks, 1);
+  if (embb_time_compare(&now, &task->attributes.deadline) > 0) {
+    embb_atomic_fetch_and_add_int(&that->deadlines_missed, 1);
+  }
+}
@@ -29,6 +29,7 @@
 
 #include <embb/mtapi/c/mtapi.h>
 #include <embb/base/c/atomic.h>
+#include <embb/base/c/time.h>
 
 #include <embb_mtapi_task_visitor_function_t.h>
 
@@ -43,6 +44,7 @@ extern "C" {
 #include <embb_mtapi_thread_context_t_fwd.h>
 #include <embb_mtapi_task_t_fwd.h>
 #include <embb_mtapi_node_t_fwd.h>
+#include <embb_mtapi_trace_buffer_t_fwd.h>
 typedef int (embb_mtapi_scheduler_worker_func_t)(void * args);
 
 /* ---- CLASS DECLARATION -------------------------------------------------- */
@@ -58,6 +60,12 @@ enum embb_mtapi_scheduler_mode_enum {
   WORK_STEAL_VHPF = 0,
   // Local First. Steal if all local queues are empty.
   WORK_STEAL_LF   = 1,
+  // Highest Priority First. Skip priorities without pending work on the
+  // node, steal before taking lower priority local work.
+  WORK_STEAL_HPF  = 2,
+  // Earliest Deadline First. Take the local task with the earliest deadline,
+  // steal the earliest deadline if all local heaps are empty.
+  WORK_STEAL_EDF  = 3,
 
   NUM_SCHEDULER_MODES
 };
@@ -85,6 +93,20 @@ struct embb_mtapi_scheduler_struct {
   embb_mtapi_scheduler_mode_t mode;
 
   embb_atomic_int affine_task_counter;
+
+  // number of pending tasks per priority on the whole node, only maintained
+  // for WORK_STEAL_HPF, MTAPI_NULL otherwise
+  embb_atomic_int * pending_tasks;
+  mtapi_uint_t priority_aging;
+
+  // statistics of completed tasks with MTAPI_TASK_DEADLINE set
+  embb_atomic_int deadline_tasks;
+  embb_atomic_int deadlines_missed;
+
+  /* trace buffer for threads that are not workers, MTAPI_NULL if tracing
+     is disabled */
+  embb_mtapi_trace_buffer_t * external_trace;
+  embb_time_t trace_origin;
 };
 
 #include <embb_mtapi_scheduler_t_fwd.h>
@@ -137,6 +159,28 @@ void embb_mtapi_scheduler_set_mode(
 embb_mtapi_thread_context_t * embb_mtapi_scheduler_get_current_thread_context(
   embb_mtapi_scheduler_t * that);
 
+/**
+ * Returns the trace buffer to use for the given thread context, which is
+ * the scheduler's shared buffer if \c thread_context is NULL. Returns
+ * MTAPI_NULL if tracing is disabled.
+ * \memberof embb_mtapi_scheduler_struct
+ */
+embb_mtapi_trace_buffer_t * embb_mtapi_scheduler_get_trace_buffer(
+  embb_mtapi_scheduler_t * that,
+  embb_mtapi_thread_context_t * thread_context);
+
+/**
+ * Executes, retains or cancels a task fetched by a worker depending on its
+ * state and notifies the associated queue when the task is done. Returns
+ * MTAPI_TRUE if the action function was run.
+ * \memberof embb_mtapi_scheduler_struct
+ */
+mtapi_boolean_t embb_mtapi_scheduler_execute_task(
+  embb_mtapi_scheduler_t * that,
+  embb_mtapi_node_t * node,
+  embb_mtapi_thread_context_t * thread_context,
+  embb_mtapi_task_t * task);
+
 /**
  * Fetches and executes a single task if the thread context is valid,
  * yields otherwise.
@@ -161,7 +205,8 @@ embb_mtapi_scheduler_t * embb_mtapi_scheduler_new();
 void embb_mtapi_scheduler_delete(embb_mtapi_scheduler_t * that);
 
 /**
- * Default constructor. Using default scheduling strategy.
+ * Default constructor. Using the scheduling strategy set in the node
+ * attributes.
  * \memberof embb_mtapi_scheduler_struct
  * \returns MTAPI_TRUE on success, MTAPI_FALSE on error
  */
@@ -201,6 +246,14 @@ mtapi_boolean_t embb_mtapi_scheduler_schedule_task(
   embb_mtapi_task_t * task,
   mtapi_uint_t instance);
 
+/**
+ * Update the deadline statistics for a completed Task that has a deadline.
+ * \memberof embb_mtapi_scheduler_struct
+ */
+void embb_mtapi_scheduler_account_deadline(
+  embb_mtapi_scheduler_t * that,
+  embb_mtapi_task_t * task);
+
 
 #ifdef __cplusplus
 }
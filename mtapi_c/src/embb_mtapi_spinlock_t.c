@@ -38,9 +38,10 @@ embb_atomic_int embb_mtapi_spinlock_spins = { 0 };
 
 mtapi_boolean_t embb_mtapi_spinlock_acquire(embb_mtapi_spinlock_t * that) {
   int expected = 0;
-  while (0 == embb_atomic_compare_and_swap_int(that, &expected, 1)) {
-    /* empty */
-    embb_atomic_fetch_and_add_int(&embb_mtapi_spinlock_spins, 1);
+  while (0 == embb_atomic_compare_and_swap_explicit_int(
+    that, &expected, 1, EMBB_MEMORY_ORDER_ACQUIRE)) {
+    embb_atomic_fetch_and_add_explicit_int(&embb_mtapi_spinlock_spins, 1,
+      EMBB_MEMORY_ORDER_RELAXED);
     expected = 0;
   }
   return MTAPI_TRUE;
@@ -51,8 +52,10 @@ mtapi_boolean_t embb_mtapi_spinlock_acquire_with_spincount(
   mtapi_uint_t max_spin_count) {
   int expected = 0;
   mtapi_uint_t spin_count = max_spin_count;
-  while (0 == embb_atomic_compare_and_swap_int(that, &expected, 1)) {
-    embb_atomic_fetch_and_add_int(&embb_mtapi_spinlock_spins, 1);
+  while (0 == embb_atomic_compare_and_swap_explicit_int(
+    that, &expected, 1, EMBB_MEMORY_ORDER_ACQUIRE)) {
+    embb_atomic_fetch_and_add_explicit_int(&embb_mtapi_spinlock_spins, 1,
+      EMBB_MEMORY_ORDER_RELAXED);
     spin_count--;
     if (0 == spin_count) {
       return MTAPI_FALSE;
@@ -65,6 +68,7 @@ mtapi_boolean_t embb_mtapi_spinlock_acquire_with_spincount(
 
 mtapi_boolean_t embb_mtapi_spinlock_release(embb_mtapi_spinlock_t * that) {
   int expected = 1;
-  return embb_atomic_compare_and_swap_int(that, &expected, 0) ?
+  return embb_atomic_compare_and_swap_explicit_int(
+    that, &expected, 0, EMBB_MEMORY_ORDER_RELEASE) ?
     MTAPI_TRUE : MTAPI_FALSE;
 }
@@ -0,0 +1,219 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <assert.h>
+
+#include <embb/mtapi/c/mtapi.h>
+#include <embb/base/c/time.h>
+
+#include <embb_mtapi_log.h>
+#include <embb_mtapi_task_heap_t.h>
+#include <embb_mtapi_task_t.h>
+#include <embb_mtapi_alloc.h>
+
+
+/* ---- CLASS MEMBERS ------------------------------------------------------ */
+
+mtapi_boolean_t embb_mtapi_task_heap_is_due_before(
+  const embb_mtapi_task_t * lhs,
+  const embb_mtapi_task_t * rhs) {
+  mtapi_boolean_t lhs_has_deadline;
+  mtapi_boolean_t rhs_has_deadline;
+
+  assert(MTAPI_NULL != lhs);
+  assert(MTAPI_NULL != rhs);
+
+  lhs_has_deadline = embb_mtapi_task_has_deadline(lhs);
+  rhs_has_deadline = embb_mtapi_task_has_deadline(rhs);
+
+  if (lhs_has_deadline && rhs_has_deadline) {
+    int cmp = embb_time_compare(
+      &lhs->attributes.deadline, &rhs->attributes.deadline);
+    if (0 != cmp) {
+      return (cmp < 0) ? MTAPI_TRUE : MTAPI_FALSE;
+    }
+  } else if (lhs_has_deadline != rhs_has_deadline) {
+    /* tasks without deadline come last */
+    return lhs_has_deadline;
+  }
+
+  return (lhs->attributes.priority < rhs->attributes.priority) ?
+    MTAPI_TRUE : MTAPI_FALSE;
+}
+
+static mtapi_boolean_t embb_mtapi_task_heap_entry_is_before(
+  const embb_mtapi_task_heap_entry_t * lhs,
+  const embb_mtapi_task_heap_entry_t * rhs) {
+  if (embb_mtapi_task_heap_is_due_before(lhs->task, rhs->task)) {
+    return MTAPI_TRUE;
+  }
+  if (embb_mtapi_task_heap_is_due_before(rhs->task, lhs->task)) {
+    return MTAPI_FALSE;
+  }
+  /* same key, keep FIFO order, robust against wrap around */
+  return ((mtapi_int_t)(lhs->sequence - rhs->sequence) < 0) ?
+    MTAPI_TRUE : MTAPI_FALSE;
+}
+
+void embb_mtapi_task_heap_initialize_with_capacity(
+  embb_mtapi_task_heap_t* that,
+  mtapi_uint_t capacity) {
+  assert(MTAPI_NULL != that);
+
+  that->entries = (embb_mtapi_task_heap_entry_t *)embb_mtapi_alloc_allocate(
+    sizeof(embb_mtapi_task_heap_entry_t)*capacity);
+  that->tasks_available = 0;
+  that->capacity = (MTAPI_NULL != that->entries) ? capacity : 0;
+  that->next_sequence = 0;
+  embb_mtapi_spinlock_initialize(&that->lock);
+}
+
+void embb_mtapi_task_heap_finalize(embb_mtapi_task_heap_t* that) {
+  assert(MTAPI_NULL != that);
+
+  embb_mtapi_alloc_deallocate(that->entries);
+  that->entries = MTAPI_NULL;
+  that->tasks_available = 0;
+  that->capacity = 0;
+
+  embb_mtapi_spinlock_finalize(&that->lock);
+}
+
+embb_mtapi_task_t * embb_mtapi_task_heap_pop(embb_mtapi_task_heap_t* that) {
+  embb_mtapi_task_t * task = MTAPI_NULL;
+
+  assert(MTAPI_NULL != that);
+
+  if (embb_mtapi_spinlock_acquire_with_spincount(&that->lock, 128)) {
+    if (0 < that->tasks_available) {
+      embb_mtapi_task_heap_entry_t last;
+      mtapi_uint_t pos = 0;
+
+      task = that->entries[0].task;
+      that->tasks_available--;
+      last = that->entries[that->tasks_available];
+
+      /* sift the last entry down from the root */
+      for (;;) {
+        mtapi_uint_t child = 2 * pos + 1;
+        if (child >= that->tasks_available) {
+          break;
+        }
+        if (child + 1 < that->tasks_available &&
+          embb_mtapi_task_heap_entry_is_before(
+            &that->entries[child + 1], &that->entries[child])) {
+          child++;
+        }
+        if (!embb_mtapi_task_heap_entry_is_before(
+          &that->entries[child], &last)) {
+          break;
+        }
+        that->entries[pos] = that->entries[child];
+        pos = child;
+      }
+      that->entries[pos] = last;
+    }
+    embb_mtapi_spinlock_release(&that->lock);
+  }
+
+  return task;
+}
+
+embb_mtapi_task_t * embb_mtapi_task_heap_peek(embb_mtapi_task_heap_t* that) {
+  embb_mtapi_task_t * task = MTAPI_NULL;
+
+  assert(MTAPI_NULL != that);
+
+  if (embb_mtapi_spinlock_acquire_with_spincount(&that->lock, 128)) {
+    if (0 < that->tasks_available) {
+      task = that->entries[0].task;
+    }
+    embb_mtapi_spinlock_release(&that->lock);
+  }
+
+  return task;
+}
+
+mtapi_boolean_t embb_mtapi_task_heap_push(
+  embb_mtapi_task_heap_t* that,
+  embb_mtapi_task_t * task) {
+  mtapi_boolean_t result = MTAPI_FALSE;
+
+  assert(MTAPI_NULL != that);
+  assert(MTAPI_NULL != task);
+
+  if (embb_mtapi_spinlock_acquire(&that->lock)) {
+    if (that->capacity > that->tasks_available) {
+      embb_mtapi_task_heap_entry_t entry;
+      mtapi_uint_t pos = that->tasks_available;
+
+      entry.task = task;
+      entry.sequence = that->next_sequence++;
+
+      /* sift the new entry up from the bottom */
+      while (0 < pos) {
+        mtapi_uint_t parent = (pos - 1) / 2;
+        if (!embb_mtapi_task_heap_entry_is_before(
+          &entry, &that->entries[parent])) {
+          break;
+        }
+        that->entries[pos] = that->entries[parent];
+        pos = parent;
+      }
+      that->entries[pos] = entry;
+      that->tasks_available++;
+
+      result = MTAPI_TRUE;
+    }
+    embb_mtapi_spinlock_release(&that->lock);
+  }
+
+  return result;
+}
+
+mtapi_boolean_t embb_mtapi_task_heap_process(
+  embb_mtapi_task_heap_t * that,
+  embb_mtapi_task_visitor_function_t process,
+  void * user_data) {
+  mtapi_boolean_t result = MTAPI_TRUE;
+  mtapi_uint_t ii;
+
+  assert(MTAPI_NULL != that);
+  assert(MTAPI_NULL != process);
+
+  if (embb_mtapi_spinlock_acquire(&that->lock)) {
+    for (ii = 0; ii < that->tasks_available; ii++) {
+      result = process(that->entries[ii].task, user_data);
+      if (MTAPI_FALSE == result) {
+        break;
+      }
+    }
+    embb_mtapi_spinlock_release(&that->lock);
+  }
+
+  return result;
+}
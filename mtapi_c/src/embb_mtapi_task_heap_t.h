@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef MTAPI_C_SRC_EMBB_MTAPI_TASK_HEAP_T_H_
+#define MTAPI_C_SRC_EMBB_MTAPI_TASK_HEAP_T_H_
+
+#include <embb/mtapi/c/mtapi.h>
+
+#include <embb_mtapi_spinlock_t.h>
+#include <embb_mtapi_task_visitor_function_t.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* ---- FORWARD DECLARATIONS ----------------------------------------------- */
+
+#include <embb_mtapi_task_t_fwd.h>
+
+
+/* ---- CLASS DECLARATION -------------------------------------------------- */
+
+/**
+ * \internal
+ * Entry of the task heap, the sequence number keeps tasks with equal keys
+ * in FIFO order.
+ *
+ * \ingroup INTERNAL
+ */
+typedef struct {
+  embb_mtapi_task_t * task;
+  mtapi_uint_t sequence;
+} embb_mtapi_task_heap_entry_t;
+
+/**
+ * \internal
+ * Task heap class. Binary min-heap of tasks ordered by deadline, then by
+ * priority. Tasks without a deadline are ordered after all tasks with one.
+ *
+ * \ingroup INTERNAL
+ */
+struct embb_mtapi_task_heap_struct {
+  embb_mtapi_task_heap_entry_t * entries;
+  mtapi_uint_t tasks_available;
+  mtapi_uint_t capacity;
+  mtapi_uint_t next_sequence;
+  embb_mtapi_spinlock_t lock;
+};
+
+#include <embb_mtapi_task_heap_t_fwd.h>
+
+/**
+ * Constructor with configurable capacity.
+ * \memberof embb_mtapi_task_heap_struct
+ */
+void embb_mtapi_task_heap_initialize_with_capacity(
+  embb_mtapi_task_heap_t* that,
+  mtapi_uint_t capacity);
+
+/**
+ * Destructor.
+ * \memberof embb_mtapi_task_heap_struct
+ */
+void embb_mtapi_task_heap_finalize(embb_mtapi_task_heap_t* that);
+
+/**
+ * Pop the task with the earliest deadline from the heap. Returns MTAPI_NULL
+ * if the heap is empty or cannot be locked in time.
+ * \memberof embb_mtapi_task_heap_struct
+ */
+embb_mtapi_task_t * embb_mtapi_task_heap_pop(embb_mtapi_task_heap_t* that);
+
+/**
+ * Returns the task with the earliest deadline without removing it, or
+ * MTAPI_NULL if the heap is empty or cannot be locked in time. The result
+ * is only a hint, the task may be taken by another worker at any time.
+ * \memberof embb_mtapi_task_heap_struct
+ */
+embb_mtapi_task_t * embb_mtapi_task_heap_peek(embb_mtapi_task_heap_t* that);
+
+/**
+ * Push a task into the heap. Returns MTAPI_TRUE if successfull and
+ * MTAPI_FALSE if the heap is full or cannot be locked in time.
+ * \memberof embb_mtapi_task_heap_struct
+ */
+mtapi_boolean_t embb_mtapi_task_heap_push(
+  embb_mtapi_task_heap_t* that,
+  embb_mtapi_task_t * task);
+
+/**
+ * Process all elements of the task heap using the given functor.
+ * \memberof embb_mtapi_task_heap_struct
+ */
+mtapi_boolean_t embb_mtapi_task_heap_process(
+  embb_mtapi_task_heap_t * that,
+  embb_mtapi_task_visitor_function_t process,
+  void * user_data);
+
+/**
+ * Returns MTAPI_TRUE if task \c lhs is due before task \c rhs, i.e., it has
+ * an earlier deadline or the same deadline and a higher priority.
+ * \memberof embb_mtapi_task_heap_struct
+ */
+mtapi_boolean_t embb_mtapi_task_heap_is_due_before(
+  const embb_mtapi_task_t * lhs,
+  const embb_mtapi_task_t * rhs);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MTAPI_C_SRC_EMBB_MTAPI_TASK_HEAP_T_H_
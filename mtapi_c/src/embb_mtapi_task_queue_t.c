@@ -73,29 +73,53 @@ void embb_mtapi_task_queue_finalize(embb_mtapi_task_queue_t* that) {
   embb_mtapi_spinlock_finalize(&that->lock);
 }
 
+/* takes the oldest task, the lock needs to be held */
+static embb_mtapi_task_t * embb_mtapi_task_queue_take(
+  embb_mtapi_task_queue_t* that) {
+  embb_mtapi_task_t * task = MTAPI_NULL;
+
+  if (0 < that->tasks_available) {
+    /* take away one task */
+    that->tasks_available--;
+
+    /* acquire position to fetch task from */
+    mtapi_uint_t task_position = that->get_task_position;
+    that->get_task_position++;
+    if (that->attributes.limit <= that->get_task_position) {
+      that->get_task_position = 0;
+    }
+
+    /* fetch task */
+    task = that->task_buffer[task_position];
+
+    /* make task entry invalid just in case */
+    that->task_buffer[task_position] = MTAPI_NULL;
+  }
+
+  return task;
+}
+
 embb_mtapi_task_t * embb_mtapi_task_queue_pop(embb_mtapi_task_queue_t* that) {
   embb_mtapi_task_t * task = MTAPI_NULL;
 
   assert(MTAPI_NULL != that);
 
   if (embb_mtapi_spinlock_acquire_with_spincount(&that->lock, 128)) {
-    if (0 < that->tasks_available) {
-      /* take away one task */
-      that->tasks_available--;
-
-      /* acquire position to fetch task from */
-      mtapi_uint_t task_position = that->get_task_position;
-      that->get_task_position++;
-      if (that->attributes.limit <= that->get_task_position) {
-        that->get_task_position = 0;
-      }
+    task = embb_mtapi_task_queue_take(that);
+    embb_mtapi_spinlock_release(&that->lock);
+  }
 
-      /* fetch task */
-      task = that->task_buffer[task_position];
+  return task;
+}
 
-      /* make task entry invalid just in case */
-      that->task_buffer[task_position] = MTAPI_NULL;
-    }
+embb_mtapi_task_t * embb_mtapi_task_queue_pop_waiting(
+  embb_mtapi_task_queue_t* that) {
+  embb_mtapi_task_t * task = MTAPI_NULL;
+
+  assert(MTAPI_NULL != that);
+
+  if (embb_mtapi_spinlock_acquire(&that->lock)) {
+    task = embb_mtapi_task_queue_take(that);
     embb_mtapi_spinlock_release(&that->lock);
   }
 
@@ -146,7 +170,7 @@ mtapi_boolean_t embb_mtapi_task_queue_process(
   if (embb_mtapi_spinlock_acquire(&that->lock)) {
     idx = that->get_task_position;
     for (ii = 0; ii < that->tasks_available; ii++) {
-      result = process(that->task_buffer[ii], user_data);
+      result = process(that->task_buffer[idx], user_data);
       if (MTAPI_FALSE == result) {
         break;
       }
@@ -88,6 +88,14 @@ void embb_mtapi_task_queue_finalize(embb_mtapi_task_queue_t* that);
  */
 embb_mtapi_task_t * embb_mtapi_task_queue_pop(embb_mtapi_task_queue_t* that);
 
+/**
+ * Pop a task from the queue, waiting for the lock instead of giving up
+ * under contention. Returns MTAPI_NULL only if the queue is empty.
+ * \memberof embb_mtapi_task_queue_struct
+ */
+embb_mtapi_task_t * embb_mtapi_task_queue_pop_waiting(
+  embb_mtapi_task_queue_t* that);
+
 /**
  * Push a task into the queue. Returns MTAPI_TRUE if successfull and
  * MTAPI_FALSE if the queue is full or cannot be locked in time.
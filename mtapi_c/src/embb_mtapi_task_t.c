@@ -25,6 +25,7 @@
  */
 
 #include <assert.h>
+#include <string.h>
 
 #include <embb/mtapi/c/mtapi.h>
 
@@ -41,6 +42,7 @@
 #include <embb_mtapi_scheduler_t.h>
 #include <embb_mtapi_attr.h>
 #include <embb_mtapi_task_context_t.h>
+#include <embb_mtapi_trace_buffer_t.h>
 
 
 /* ---- POOL STORAGE FUNCTIONS --------------------------------------------- */
@@ -78,6 +80,7 @@ void embb_mtapi_task_initialize(embb_mtapi_task_t* that) {
   assert(MTAPI_NULL != that);
 
   that->action.id = EMBB_MTAPI_IDPOOL_INVALID_ID;
+  that->measure_cost = MTAPI_FALSE;
   that->job.id = EMBB_MTAPI_IDPOOL_INVALID_ID;
   that->state = MTAPI_TASK_ERROR;
   that->task_id = MTAPI_TASK_ID_NONE;
@@ -114,6 +117,14 @@ mtapi_boolean_t embb_mtapi_task_execute(
       context->thread_context->node->action_pool, that->action);
     /* only continue if there was no error so far */
     if (context->task->error_code == MTAPI_SUCCESS) {
+      mtapi_boolean_t measure = that->measure_cost;
+      embb_time_t start_time;
+      if (measure) {
+        embb_time_now(&start_time);
+      }
+      embb_mtapi_trace(context->thread_context->trace,
+        EMBB_MTAPI_TRACE_TASK_START,
+        that->handle.id, that->job.id, that->action.id);
       local_action->action_function(
         that->arguments,
         that->arguments_size,
@@ -122,6 +133,12 @@ mtapi_boolean_t embb_mtapi_task_execute(
         local_action->node_local_data,
         local_action->node_local_data_size,
         context);
+      embb_mtapi_trace(context->thread_context->trace,
+        EMBB_MTAPI_TRACE_TASK_FINISH,
+        that->handle.id, that->job.id, that->action.id);
+      if (measure) {
+        embb_mtapi_action_account_cost(local_action, &start_time, 1);
+      }
     }
     embb_atomic_memory_barrier();
     todo = embb_atomic_fetch_and_add_unsigned_int(
@@ -130,12 +147,21 @@ mtapi_boolean_t embb_mtapi_task_execute(
     if (todo == 1) {
       /* task has completed successfully */
       embb_mtapi_task_set_state(that, MTAPI_TASK_COMPLETED);
+      if (embb_mtapi_task_has_deadline(that)) {
+        embb_mtapi_scheduler_account_deadline(
+          context->thread_context->node->scheduler, that);
+      }
     }
     embb_atomic_fetch_and_add_int(&local_action->num_tasks, -1);
   } else {
-    /* action was deleted, task did not complete */
+    /* action was deleted, task did not complete; the last instance
+    reports it, waiters may delete the task from then on */
     that->error_code = MTAPI_ERR_ACTION_DELETED;
-    embb_mtapi_task_set_state(that, MTAPI_TASK_ERROR);
+    todo = embb_atomic_fetch_and_add_unsigned_int(
+      &that->instances_todo, (unsigned int)-1);
+    if (todo == 1) {
+      embb_mtapi_task_set_state(that, MTAPI_TASK_ERROR);
+    }
   }
 
   if (todo == 1) {
@@ -145,7 +171,7 @@ mtapi_boolean_t embb_mtapi_task_execute(
       embb_mtapi_group_t* local_group =
         embb_mtapi_group_pool_get_storage_for_handle(
         context->thread_context->node->group_pool, that->group);
-      embb_mtapi_task_queue_push(&local_group->queue, that);
+      embb_mtapi_group_push_task(local_group, that);
     }
     return MTAPI_TRUE;
   } else {
@@ -164,6 +190,85 @@ void embb_mtapi_task_set_state(
   embb_mtapi_spinlock_release(&that->state_lock);
 }
 
+mtapi_boolean_t embb_mtapi_task_has_deadline(const embb_mtapi_task_t* that) {
+  assert(MTAPI_NULL != that);
+
+  return (0 != that->attributes.deadline.seconds ||
+    0 != that->attributes.deadline.nanoseconds) ? MTAPI_TRUE : MTAPI_FALSE;
+}
+
+/* number of tasks an action runs at the same time */
+static mtapi_uint_t embb_mtapi_task_action_concurrency(
+  embb_mtapi_node_t* node,
+  embb_mtapi_action_t* action) {
+  mtapi_affinity_t affinity;
+  mtapi_uint_t result = 0;
+
+  if (action->is_plugin_action) {
+    /* the device or remote node is accounted as one unit */
+    return 1;
+  }
+  affinity = action->attributes.affinity & node->affinity_all;
+  if (affinity == node->affinity_all) {
+    return node->scheduler->worker_count;
+  }
+  while (0 != affinity) {
+    affinity &= affinity - 1;
+    result++;
+  }
+  return result;
+}
+
+/* load balancing: choose the action of the job that is predicted to finish
+   a new task first, actions that have not completed a task yet are tried
+   while idle and otherwise ignored; if no action has a prediction, choose
+   the action with the minimum number of tasks */
+static mtapi_uint_t embb_mtapi_task_select_action(
+  embb_mtapi_node_t* node,
+  embb_mtapi_job_t* local_job) {
+  mtapi_uint_t action_index = 0;
+  unsigned long long best_cost = EMBB_MTAPI_ACTION_NO_COST;
+
+  if (1 >= local_job->num_actions) {
+    return 0;
+  }
+
+  for (mtapi_uint_t ii = 0; ii < local_job->num_actions; ii++) {
+    if (embb_mtapi_action_pool_is_handle_valid(
+      node->action_pool, local_job->actions[ii])) {
+      embb_mtapi_action_t * act_i =
+        embb_mtapi_action_pool_get_storage_for_handle(
+        node->action_pool, local_job->actions[ii]);
+      unsigned long long cost = embb_mtapi_action_predict_cost(act_i,
+        embb_mtapi_task_action_concurrency(node, act_i));
+      if (cost < best_cost) {
+        best_cost = cost;
+        action_index = ii;
+      }
+    }
+  }
+
+  if (EMBB_MTAPI_ACTION_NO_COST == best_cost) {
+    for (mtapi_uint_t ii = 0; ii < local_job->num_actions; ii++) {
+      if (embb_mtapi_action_pool_is_handle_valid(
+        node->action_pool, local_job->actions[ii])) {
+        embb_mtapi_action_t * act_m =
+          embb_mtapi_action_pool_get_storage_for_handle(
+          node->action_pool, local_job->actions[action_index]);
+        embb_mtapi_action_t * act_i =
+          embb_mtapi_action_pool_get_storage_for_handle(
+          node->action_pool, local_job->actions[ii]);
+        if (embb_atomic_load_int(&act_m->num_tasks) >
+          embb_atomic_load_int(&act_i->num_tasks)) {
+          action_index = ii;
+        }
+      }
+    }
+  }
+
+  return action_index;
+}
+
 static mtapi_task_hndl_t embb_mtapi_task_start(
   MTAPI_IN mtapi_task_id_t task_id,
   MTAPI_IN mtapi_job_hndl_t job,
@@ -227,26 +332,13 @@ static mtapi_task_hndl_t embb_mtapi_task_start(
           task->queue.id = EMBB_MTAPI_IDPOOL_INVALID_ID;
         }
 
-        /* load balancing: choose action with minimum tasks */
-        action_index = 0;
-        for (mtapi_uint_t ii = 0; ii < local_job->num_actions; ii++) {
-          if (embb_mtapi_action_pool_is_handle_valid(
-            node->action_pool, local_job->actions[ii])) {
-            embb_mtapi_action_t * act_m =
-              embb_mtapi_action_pool_get_storage_for_handle(
-              node->action_pool, local_job->actions[action_index]);
-            embb_mtapi_action_t * act_i =
-              embb_mtapi_action_pool_get_storage_for_handle(
-              node->action_pool, local_job->actions[ii]);
-            if (embb_atomic_load_int(&act_m->num_tasks) >
-              embb_atomic_load_int(&act_i->num_tasks)) {
-              action_index = ii;
-            }
-          }
-        }
+        action_index = embb_mtapi_task_select_action(node, local_job);
         if (embb_mtapi_action_pool_is_handle_valid(
           node->action_pool, local_job->actions[action_index])) {
           task->action = local_job->actions[action_index];
+          /* the cost of an action only matters if its job has a choice */
+          task->measure_cost =
+            (mtapi_boolean_t)(1 < local_job->num_actions);
           embb_mtapi_task_set_state(task, MTAPI_TASK_CREATED);
           task_hndl = task->handle;
           local_status = MTAPI_SUCCESS;
@@ -262,6 +354,8 @@ static mtapi_task_hndl_t embb_mtapi_task_start(
         if (MTAPI_SUCCESS == local_status) {
           embb_mtapi_scheduler_t * scheduler = node->scheduler;
           mtapi_boolean_t was_scheduled;
+          /* a detached task may already be gone when scheduling returns */
+          mtapi_boolean_t is_detached = task->attributes.is_detached;
           embb_mtapi_action_t * local_action =
             embb_mtapi_action_pool_get_storage_for_handle(
               node->action_pool, task->action);
@@ -277,19 +371,33 @@ static mtapi_task_hndl_t embb_mtapi_task_start(
               MTAPI_TRUE : MTAPI_FALSE;
           } else {
             /* schedule local task */
-            was_scheduled = MTAPI_TRUE;
+            embb_mtapi_queue_t * local_queue = MTAPI_NULL;
+            if (embb_mtapi_queue_pool_is_handle_valid(
+              node->queue_pool, task->queue)) {
+              local_queue = embb_mtapi_queue_pool_get_storage_for_handle(
+                node->queue_pool, task->queue);
+            }
 
-            for (mtapi_uint_t kk = 0; kk < task->attributes.num_instances;
-              kk++) {
-              was_scheduled = (mtapi_boolean_t)(was_scheduled &
-                embb_mtapi_scheduler_schedule_task(scheduler, task, kk));
+            if (MTAPI_NULL != local_queue &&
+              local_queue->attributes.ordered) {
+              /* ordered queues hand out their tasks one after another */
+              was_scheduled = embb_mtapi_queue_schedule_ordered_task(
+                local_queue, task);
+            } else {
+              was_scheduled = MTAPI_TRUE;
+
+              for (mtapi_uint_t kk = 0; kk < task->attributes.num_instances;
+                kk++) {
+                was_scheduled = (mtapi_boolean_t)(was_scheduled &
+                  embb_mtapi_scheduler_schedule_task(scheduler, task, kk));
+              }
             }
           }
 
           if (was_scheduled) {
             /* if task is detached, do not return a handle, it will be deleted
             on completion */
-            if (task->attributes.is_detached) {
+            if (is_detached) {
               task_hndl.id = EMBB_MTAPI_IDPOOL_INVALID_ID;
             }
 
@@ -302,6 +410,22 @@ static mtapi_task_hndl_t embb_mtapi_task_start(
         }
 
         if (MTAPI_SUCCESS != local_status) {
+          /* the task will never finish, so take it back from its group
+             and queue, otherwise waiting for them would block forever */
+          if (embb_mtapi_group_pool_is_handle_valid(
+            node->group_pool, task->group)) {
+            embb_mtapi_group_t* local_group =
+              embb_mtapi_group_pool_get_storage_for_handle(
+              node->group_pool, task->group);
+            embb_atomic_fetch_and_add_int(&local_group->num_tasks, -1);
+          }
+          if (embb_mtapi_queue_pool_is_handle_valid(
+            node->queue_pool, task->queue)) {
+            embb_mtapi_queue_t* local_queue =
+              embb_mtapi_queue_pool_get_storage_for_handle(
+              node->queue_pool, task->queue);
+            embb_atomic_fetch_and_add_int(&local_queue->num_tasks, -1);
+          }
           embb_mtapi_task_delete(task, node->task_pool);
           task_hndl.id = EMBB_MTAPI_IDPOOL_INVALID_ID;
         }
@@ -439,6 +563,16 @@ void mtapi_task_get_attribute(
             &local_task->attributes.priority, attribute, attribute_size);
           break;
 
+        case MTAPI_TASK_DEADLINE:
+          if (MTAPI_TASK_DEADLINE_SIZE == attribute_size) {
+            memcpy(attribute, &local_task->attributes.deadline,
+              sizeof(embb_time_t));
+            local_status = MTAPI_SUCCESS;
+          } else {
+            local_status = MTAPI_ERR_ATTR_SIZE;
+          }
+          break;
+
         default:
           local_status = MTAPI_ERR_ATTR_NUM;
           break;
@@ -65,6 +65,9 @@ struct embb_mtapi_task_struct {
   mtapi_queue_hndl_t queue;
 
   mtapi_action_hndl_t action;
+  /* the job had more than one action to choose from when the task started,
+     only then the cost of the action is measured */
+  mtapi_boolean_t measure_cost;
   embb_mtapi_spinlock_t state_lock;
   volatile mtapi_task_state_t state;
   embb_atomic_unsigned_int current_instance;
@@ -119,6 +122,13 @@ void embb_mtapi_task_set_state(
   embb_mtapi_task_t* that,
   mtapi_task_state_t state);
 
+/**
+ * Returns MTAPI_TRUE if the task has a deadline set, i.e., its
+ * MTAPI_TASK_DEADLINE attribute is not zero.
+ * \memberof embb_mtapi_task_struct
+ */
+mtapi_boolean_t embb_mtapi_task_has_deadline(const embb_mtapi_task_t* that);
+
 
 /* ---- POOL DECLARATION --------------------------------------------------- */
 
@@ -31,19 +31,45 @@
 #include <embb_mtapi_log.h>
 #include <embb_mtapi_alloc.h>
 #include <embb_mtapi_task_queue_t.h>
+#include <embb_mtapi_task_heap_t.h>
 #include <embb_mtapi_scheduler_t.h>
 #include <embb_mtapi_node_t.h>
 #include <embb_mtapi_thread_context_t.h>
+#include <embb_mtapi_trace_buffer_t.h>
 
 
 /* ---- CLASS MEMBERS ------------------------------------------------------ */
 
-void embb_mtapi_thread_context_initialize_with_node_worker_and_core(
+static embb_mtapi_task_heap_t* embb_mtapi_thread_context_heap_new(
+  mtapi_uint_t capacity) {
+  embb_mtapi_task_heap_t* heap = (embb_mtapi_task_heap_t*)
+    embb_mtapi_alloc_allocate(sizeof(embb_mtapi_task_heap_t));
+  if (MTAPI_NULL != heap) {
+    embb_mtapi_task_heap_initialize_with_capacity(heap, capacity);
+    if (MTAPI_NULL == heap->entries) {
+      embb_mtapi_task_heap_finalize(heap);
+      embb_mtapi_alloc_deallocate(heap);
+      heap = MTAPI_NULL;
+    }
+  }
+  return heap;
+}
+
+static void embb_mtapi_thread_context_heap_delete(
+  embb_mtapi_task_heap_t* heap) {
+  if (MTAPI_NULL != heap) {
+    embb_mtapi_task_heap_finalize(heap);
+    embb_mtapi_alloc_deallocate(heap);
+  }
+}
+
+mtapi_boolean_t embb_mtapi_thread_context_initialize_with_node_worker_and_core(
   embb_mtapi_thread_context_t* that,
   embb_mtapi_node_t* node,
   mtapi_uint_t worker_index,
   mtapi_uint_t core_num) {
   mtapi_uint_t ii;
+  mtapi_boolean_t result = MTAPI_TRUE;
 
   assert(MTAPI_NULL != that);
   assert(MTAPI_NULL != node);
@@ -51,6 +77,7 @@ void embb_mtapi_thread_context_initialize_with_node_worker_and_core(
   that->node = node;
   that->worker_index = worker_index;
   that->core_num = core_num;
+  that->aging_counter = 0;
   that->priorities = node->attributes.max_priorities;
   embb_atomic_store_int(&that->run, 0);
   that->queue = (embb_mtapi_task_queue_t**)embb_mtapi_alloc_allocate(
@@ -68,9 +95,36 @@ void embb_mtapi_thread_context_initialize_with_node_worker_and_core(
       that->private_queue[ii], node->attributes.queue_limit);
   }
 
+  if (MTAPI_NODE_SCHEDULER_EDF == node->attributes.scheduler_mode) {
+    /* a single heap holds the tasks of all priorities */
+    mtapi_uint_t capacity = node->attributes.queue_limit * that->priorities;
+    that->heap = embb_mtapi_thread_context_heap_new(capacity);
+    that->private_heap = embb_mtapi_thread_context_heap_new(capacity);
+    if (MTAPI_NULL == that->heap || MTAPI_NULL == that->private_heap) {
+      /* leave the context without heaps, finalize copes with that */
+      embb_mtapi_thread_context_heap_delete(that->heap);
+      embb_mtapi_thread_context_heap_delete(that->private_heap);
+      that->heap = MTAPI_NULL;
+      that->private_heap = MTAPI_NULL;
+      result = MTAPI_FALSE;
+    }
+  } else {
+    that->heap = MTAPI_NULL;
+    that->private_heap = MTAPI_NULL;
+  }
+
   embb_mutex_init(&that->work_available_mutex, EMBB_MUTEX_PLAIN);
   embb_condition_init(&that->work_available);
   embb_atomic_store_int(&that->is_sleeping, 0);
+
+  if (0 < node->attributes.trace_capacity) {
+    that->trace = embb_mtapi_trace_buffer_new(
+      node->attributes.trace_capacity, MTAPI_FALSE);
+  } else {
+    that->trace = MTAPI_NULL;
+  }
+
+  return result;
 }
 
 mtapi_boolean_t embb_mtapi_thread_context_start(
@@ -143,6 +197,16 @@ void embb_mtapi_thread_context_finalize(embb_mtapi_thread_context_t* that) {
   that->private_queue = MTAPI_NULL;
   that->priorities = 0;
 
+  embb_mtapi_thread_context_heap_delete(that->heap);
+  that->heap = MTAPI_NULL;
+  embb_mtapi_thread_context_heap_delete(that->private_heap);
+  that->private_heap = MTAPI_NULL;
+
+  if (MTAPI_NULL != that->trace) {
+    embb_mtapi_trace_buffer_delete(that->trace);
+    that->trace = MTAPI_NULL;
+  }
+
   that->node = MTAPI_NULL;
 }
 
@@ -169,5 +233,14 @@ mtapi_boolean_t embb_mtapi_thread_context_process_tasks(
     }
   }
 
+  if (MTAPI_TRUE == result && MTAPI_NULL != that->heap) {
+    result = embb_mtapi_task_heap_process(
+      that->private_heap, process, user_data);
+    if (MTAPI_TRUE == result) {
+      result = embb_mtapi_task_heap_process(
+        that->heap, process, user_data);
+    }
+  }
+
   return result;
 }
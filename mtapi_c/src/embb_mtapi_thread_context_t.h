@@ -40,8 +40,10 @@ extern "C" {
 /* ---- FORWARD DECLARATIONS ----------------------------------------------- */
 
 #include <embb_mtapi_task_queue_t_fwd.h>
+#include <embb_mtapi_task_heap_t_fwd.h>
 #include <embb_mtapi_node_t_fwd.h>
 #include <embb_mtapi_scheduler_t_fwd.h>
+#include <embb_mtapi_trace_buffer_t_fwd.h>
 
 /* ---- CLASS DECLARATION -------------------------------------------------- */
 
@@ -62,20 +64,31 @@ struct embb_mtapi_thread_context_struct {
   embb_mtapi_task_queue_t** queue;
   embb_mtapi_task_queue_t** private_queue;
 
+  /* deadline ordered counterparts of queue and private_queue, only used by
+     MTAPI_NODE_SCHEDULER_EDF, MTAPI_NULL otherwise */
+  embb_mtapi_task_heap_t* heap;
+  embb_mtapi_task_heap_t* private_heap;
+
   mtapi_uint_t priorities;
   mtapi_uint_t worker_index;
   mtapi_uint_t core_num;
+  mtapi_uint_t aging_counter;
   embb_atomic_int run;
   mtapi_status_t status;
+
+  /* MTAPI_NULL if tracing is disabled */
+  embb_mtapi_trace_buffer_t * trace;
 };
 
 #include <embb_mtapi_thread_context_t_fwd.h>
 
 /**
  * Constructor using attributes from node and a given core number.
+ * Returns MTAPI_FALSE if the context could not allocate its task storage,
+ * the context still needs to be finalized in that case.
  * \memberof embb_mtapi_thread_context_struct
  */
-void embb_mtapi_thread_context_initialize_with_node_worker_and_core(
+mtapi_boolean_t embb_mtapi_thread_context_initialize_with_node_worker_and_core(
   embb_mtapi_thread_context_t* that,
   embb_mtapi_node_t* node,
   mtapi_uint_t worker_index,
@@ -0,0 +1,262 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <assert.h>
+
+#include <embb/mtapi/c/mtapi.h>
+
+#include <embb_mtapi_log.h>
+#include <embb_mtapi_alloc.h>
+#include <embb_mtapi_trace_buffer_t.h>
+
+
+/* ---- CLASS MEMBERS ------------------------------------------------------ */
+
+embb_mtapi_trace_buffer_t * embb_mtapi_trace_buffer_new(
+  mtapi_uint_t capacity,
+  mtapi_boolean_t is_shared) {
+  embb_mtapi_trace_buffer_t * that =
+    (embb_mtapi_trace_buffer_t*)embb_mtapi_alloc_allocate(
+      sizeof(embb_mtapi_trace_buffer_t));
+  if (MTAPI_NULL != that) {
+    if (MTAPI_FALSE == embb_mtapi_trace_buffer_initialize_with_capacity(
+      that, capacity, is_shared)) {
+      /* on error delete and return MTAPI_NULL */
+      embb_mtapi_trace_buffer_delete(that);
+      return MTAPI_NULL;
+    }
+  }
+  return that;
+}
+
+void embb_mtapi_trace_buffer_delete(embb_mtapi_trace_buffer_t * that) {
+  assert(MTAPI_NULL != that);
+
+  embb_mtapi_trace_buffer_finalize(that);
+  embb_mtapi_alloc_deallocate(that);
+}
+
+mtapi_boolean_t embb_mtapi_trace_buffer_initialize_with_capacity(
+  embb_mtapi_trace_buffer_t * that,
+  mtapi_uint_t capacity,
+  mtapi_boolean_t is_shared) {
+  assert(MTAPI_NULL != that);
+  assert(0 < capacity);
+
+  that->capacity = capacity;
+  that->count = 0;
+  that->is_shared = is_shared;
+  embb_mtapi_spinlock_initialize(&that->lock);
+  that->events = (embb_mtapi_trace_event_t*)embb_mtapi_alloc_allocate(
+    sizeof(embb_mtapi_trace_event_t)*capacity);
+
+  return (MTAPI_NULL != that->events) ? MTAPI_TRUE : MTAPI_FALSE;
+}
+
+void embb_mtapi_trace_buffer_finalize(embb_mtapi_trace_buffer_t * that) {
+  assert(MTAPI_NULL != that);
+
+  if (MTAPI_NULL != that->events) {
+    embb_mtapi_alloc_deallocate(that->events);
+    that->events = MTAPI_NULL;
+  }
+  that->capacity = 0;
+  that->count = 0;
+  embb_mtapi_spinlock_finalize(&that->lock);
+}
+
+void embb_mtapi_trace_buffer_record(
+  embb_mtapi_trace_buffer_t * that,
+  embb_mtapi_trace_event_type_t type,
+  mtapi_uint_t id,
+  mtapi_uint_t job,
+  mtapi_uint_t info) {
+  embb_mtapi_trace_event_t * event;
+
+  assert(MTAPI_NULL != that);
+  assert(MTAPI_NULL != that->events);
+
+  if (that->is_shared) {
+    embb_mtapi_spinlock_acquire(&that->lock);
+  }
+
+  event = &that->events[that->count % that->capacity];
+  that->count++;
+  /* keep the position in range, but remember that the buffer wrapped */
+  if (that->count == 2 * that->capacity) {
+    that->count = that->capacity;
+  }
+
+  embb_time_now(&event->timestamp);
+  event->type = type;
+  event->id = id;
+  event->job = job;
+  event->info = info;
+
+  if (that->is_shared) {
+    embb_mtapi_spinlock_release(&that->lock);
+  }
+}
+
+static void embb_mtapi_trace_buffer_write_event(
+  const embb_mtapi_trace_event_t * event,
+  FILE * file,
+  mtapi_uint_t process_id,
+  mtapi_uint_t thread_id,
+  const embb_time_t * origin) {
+  unsigned long long seconds = 0;
+  unsigned long nanoseconds = 0;
+  unsigned long long microseconds;
+  const char * name = "";
+  char phase = 'i';
+
+  /* timestamp relative to the origin in microseconds */
+  if (embb_time_compare(&event->timestamp, origin) > 0) {
+    seconds = event->timestamp.seconds - origin->seconds;
+    if (event->timestamp.nanoseconds >= origin->nanoseconds) {
+      nanoseconds = event->timestamp.nanoseconds - origin->nanoseconds;
+    } else {
+      seconds--;
+      nanoseconds =
+        1000000000 + event->timestamp.nanoseconds - origin->nanoseconds;
+    }
+  }
+  microseconds = seconds * 1000000 + nanoseconds / 1000;
+
+  switch (event->type) {
+  case EMBB_MTAPI_TRACE_TASK_START:
+    name = "task";
+    phase = 'B';
+    break;
+  case EMBB_MTAPI_TRACE_TASK_FINISH:
+    name = "task";
+    phase = 'E';
+    break;
+  case EMBB_MTAPI_TRACE_STEAL:
+    name = "steal";
+    phase = 'i';
+    break;
+  case EMBB_MTAPI_TRACE_SLEEP:
+    name = "sleep";
+    phase = 'B';
+    break;
+  case EMBB_MTAPI_TRACE_WAKE:
+    name = "sleep";
+    phase = 'E';
+    break;
+  case EMBB_MTAPI_TRACE_GROUP_WAIT_BEGIN:
+    name = "group wait";
+    phase = 'B';
+    break;
+  case EMBB_MTAPI_TRACE_GROUP_WAIT_END:
+    name = "group wait";
+    phase = 'E';
+    break;
+  case EMBB_MTAPI_TRACE_NUM_EVENT_TYPES:
+  default:
+    embb_mtapi_log_error(
+      "embb_mtapi_trace_buffer_write() unknown event type: %d\n",
+      event->type);
+    return;
+  }
+
+  fprintf(file,
+    "{\"name\":\"%s\",\"cat\":\"mtapi\",\"ph\":\"%c\","
+    "\"ts\":%llu.%03lu,\"pid\":%u,\"tid\":%u",
+    name, phase, microseconds, nanoseconds % 1000,
+    (unsigned int)process_id, (unsigned int)thread_id);
+
+  switch (event->type) {
+  case EMBB_MTAPI_TRACE_TASK_START:
+    fprintf(file, ",\"args\":{\"task\":%u,\"job\":%u,\"action\":%u}",
+      (unsigned int)event->id, (unsigned int)event->job,
+      (unsigned int)event->info);
+    break;
+  case EMBB_MTAPI_TRACE_STEAL:
+    fprintf(file, ",\"s\":\"t\",\"args\":{\"task\":%u,\"job\":%u,"
+      "\"victim\":%u}",
+      (unsigned int)event->id, (unsigned int)event->job,
+      (unsigned int)event->info);
+    break;
+  case EMBB_MTAPI_TRACE_GROUP_WAIT_BEGIN:
+    fprintf(file, ",\"args\":{\"group\":%u}", (unsigned int)event->id);
+    break;
+  default:
+    break;
+  }
+
+  fprintf(file, "}");
+}
+
+void embb_mtapi_trace_buffer_write(
+  embb_mtapi_trace_buffer_t * that,
+  FILE * file,
+  mtapi_uint_t process_id,
+  mtapi_uint_t thread_id,
+  const char * thread_name,
+  const embb_time_t * origin,
+  mtapi_boolean_t * is_first) {
+  mtapi_uint_t first;
+  mtapi_uint_t available;
+  mtapi_uint_t ii;
+
+  assert(MTAPI_NULL != that);
+  assert(MTAPI_NULL != file);
+  assert(MTAPI_NULL != origin);
+  assert(MTAPI_NULL != is_first);
+
+  if (that->is_shared) {
+    embb_mtapi_spinlock_acquire(&that->lock);
+  }
+
+  /* name the thread the events belong to */
+  fprintf(file,
+    "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,"
+    "\"args\":{\"name\":\"%s\"}}",
+    (*is_first) ? "" : ",",
+    (unsigned int)process_id, (unsigned int)thread_id, thread_name);
+  *is_first = MTAPI_FALSE;
+
+  /* oldest event first */
+  if (that->count > that->capacity) {
+    available = that->capacity;
+    first = that->count % that->capacity;
+  } else {
+    available = that->count;
+    first = 0;
+  }
+  for (ii = 0; ii < available; ii++) {
+    fprintf(file, ",\n");
+    embb_mtapi_trace_buffer_write_event(
+      &that->events[(first + ii) % that->capacity],
+      file, process_id, thread_id, origin);
+  }
+
+  if (that->is_shared) {
+    embb_mtapi_spinlock_release(&that->lock);
+  }
+}
@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef MTAPI_C_SRC_EMBB_MTAPI_TRACE_BUFFER_T_H_
+#define MTAPI_C_SRC_EMBB_MTAPI_TRACE_BUFFER_T_H_
+
+#include <stdio.h>
+
+#include <embb/mtapi/c/mtapi.h>
+#include <embb/base/c/time.h>
+
+#include <embb_mtapi_spinlock_t.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/* ---- CLASS DECLARATION -------------------------------------------------- */
+
+/**
+ * \internal
+ * Trace event type.
+ *
+ * \ingroup INTERNAL
+ */
+enum embb_mtapi_trace_event_type_enum {
+  EMBB_MTAPI_TRACE_TASK_START = 0,     /**< a task instance starts executing */
+  EMBB_MTAPI_TRACE_TASK_FINISH,        /**< a task instance finished */
+  EMBB_MTAPI_TRACE_STEAL,              /**< a task was stolen from a worker */
+  EMBB_MTAPI_TRACE_SLEEP,              /**< a worker goes to sleep */
+  EMBB_MTAPI_TRACE_WAKE,               /**< a worker woke up */
+  EMBB_MTAPI_TRACE_GROUP_WAIT_BEGIN,   /**< a thread starts waiting on a
+                                            group */
+  EMBB_MTAPI_TRACE_GROUP_WAIT_END,     /**< a thread stopped waiting on a
+                                            group */
+
+  EMBB_MTAPI_TRACE_NUM_EVENT_TYPES
+};
+
+/**
+ * Trace event type type.
+ * \memberof embb_mtapi_trace_event_struct
+ */
+typedef enum embb_mtapi_trace_event_type_enum embb_mtapi_trace_event_type_t;
+
+/**
+ * \internal
+ * A single entry of a trace buffer. The meaning of \c id, \c job and \c info
+ * depends on the event type:
+ *   - task start / finish: task handle id, job id, action handle id
+ *   - steal: task handle id, job id, index of the victim worker
+ *   - group wait begin / end: group handle id, unused, unused
+ *
+ * \ingroup INTERNAL
+ */
+struct embb_mtapi_trace_event_struct {
+  embb_time_t timestamp;
+  embb_mtapi_trace_event_type_t type;
+  mtapi_uint_t id;
+  mtapi_uint_t job;
+  mtapi_uint_t info;
+};
+
+/**
+ * Trace event type.
+ * \memberof embb_mtapi_trace_event_struct
+ */
+typedef struct embb_mtapi_trace_event_struct embb_mtapi_trace_event_t;
+
+/**
+ * \internal
+ * Trace buffer class.
+ *
+ * A fixed size ring buffer of trace events. When the buffer is full, the
+ * oldest events are overwritten. Buffers owned by a single worker are
+ * written without synchronization, shared buffers are protected by a
+ * spinlock.
+ *
+ * \ingroup INTERNAL
+ */
+struct embb_mtapi_trace_buffer_struct {
+  embb_mtapi_trace_event_t * events;
+  mtapi_uint_t capacity;
+  mtapi_uint_t count;
+  mtapi_boolean_t is_shared;
+  embb_mtapi_spinlock_t lock;
+};
+
+#include <embb_mtapi_trace_buffer_t_fwd.h>
+
+/**
+ * Records an event if tracing is enabled, i.e., if \c buffer is not
+ * MTAPI_NULL. Costs a single comparison when tracing is disabled.
+ * \memberof embb_mtapi_trace_buffer_struct
+ */
+#define embb_mtapi_trace(buffer, type, id, job, info) \
+  do { \
+    if (MTAPI_NULL != (buffer)) { \
+      embb_mtapi_trace_buffer_record((buffer), (type), (id), (job), (info)); \
+    } \
+  } while (0)
+
+/**
+ * operator new.
+ * \memberof embb_mtapi_trace_buffer_struct
+ * \returns pointer to the trace buffer or MTAPI_NULL on error
+ */
+embb_mtapi_trace_buffer_t * embb_mtapi_trace_buffer_new(
+  mtapi_uint_t capacity,
+  mtapi_boolean_t is_shared);
+
+/**
+ * operator delete.
+ * \memberof embb_mtapi_trace_buffer_struct
+ */
+void embb_mtapi_trace_buffer_delete(embb_mtapi_trace_buffer_t * that);
+
+/**
+ * Constructor with configurable capacity.
+ * \memberof embb_mtapi_trace_buffer_struct
+ * \returns MTAPI_TRUE on success, MTAPI_FALSE on error
+ */
+mtapi_boolean_t embb_mtapi_trace_buffer_initialize_with_capacity(
+  embb_mtapi_trace_buffer_t * that,
+  mtapi_uint_t capacity,
+  mtapi_boolean_t is_shared);
+
+/**
+ * Destructor.
+ * \memberof embb_mtapi_trace_buffer_struct
+ */
+void embb_mtapi_trace_buffer_finalize(embb_mtapi_trace_buffer_t * that);
+
+/**
+ * Appends an event to the buffer, overwriting the oldest one if the buffer
+ * is full.
+ * \memberof embb_mtapi_trace_buffer_struct
+ */
+void embb_mtapi_trace_buffer_record(
+  embb_mtapi_trace_buffer_t * that,
+  embb_mtapi_trace_event_type_t type,
+  mtapi_uint_t id,
+  mtapi_uint_t job,
+  mtapi_uint_t info);
+
+/**
+ * Writes all events in the buffer to the given file as Chrome trace event
+ * objects (without the enclosing array). Timestamps are written relative to
+ * \c origin. \c is_first indicates whether any events were written to the
+ * file before and is updated accordingly.
+ * \memberof embb_mtapi_trace_buffer_struct
+ */
+void embb_mtapi_trace_buffer_write(
+  embb_mtapi_trace_buffer_t * that,
+  FILE * file,
+  mtapi_uint_t process_id,
+  mtapi_uint_t thread_id,
+  const char * thread_name,
+  const embb_time_t * origin,
+  mtapi_boolean_t * is_first);
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MTAPI_C_SRC_EMBB_MTAPI_TRACE_BUFFER_T_H_
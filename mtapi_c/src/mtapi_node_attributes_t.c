@@ -52,6 +52,10 @@ void mtapi_nodeattr_init(
     attributes->max_jobs = MTAPI_NODE_MAX_JOBS_DEFAULT;
     attributes->max_actions_per_job = MTAPI_NODE_MAX_ACTIONS_PER_JOB_DEFAULT;
     attributes->max_priorities = MTAPI_NODE_MAX_PRIORITIES_DEFAULT;
+    attributes->trace_capacity = MTAPI_NODE_TRACE_CAPACITY_DEFAULT;
+    attributes->trace_file = MTAPI_NODE_TRACE_FILE_DEFAULT;
+    attributes->scheduler_mode = MTAPI_NODE_SCHEDULER_MODE_DEFAULT;
+    attributes->priority_aging = MTAPI_NODE_PRIORITY_AGING_DEFAULT;
 
     embb_core_set_init(&attributes->core_affinity, 1);
     attributes->num_cores = embb_core_set_count(&attributes->core_affinity);
@@ -95,6 +99,8 @@ void mtapi_nodeattr_set(
         break;
 
       case MTAPI_NODE_NUMCORES:
+      case MTAPI_NODE_DEADLINE_TASKS:
+      case MTAPI_NODE_DEADLINES_MISSED:
         local_status = MTAPI_ERR_ATTR_READONLY;
         break;
 
@@ -143,6 +149,33 @@ void mtapi_nodeattr_set(
           &attributes->max_priorities, attribute, attribute_size);
         break;
 
+      case MTAPI_NODE_TRACE_CAPACITY:
+        local_status = embb_mtapi_attr_set_mtapi_uint_t(
+          &attributes->trace_capacity, attribute, attribute_size);
+        break;
+
+      case MTAPI_NODE_TRACE_FILE:
+        if (MTAPI_ATTRIBUTE_POINTER_AS_VALUE == attribute_size) {
+          attributes->trace_file = (const char *)attribute;
+          local_status = MTAPI_SUCCESS;
+        } else if (MTAPI_NODE_TRACE_FILE_SIZE == attribute_size) {
+          attributes->trace_file = *(const char * const *)attribute;
+          local_status = MTAPI_SUCCESS;
+        } else {
+          local_status = MTAPI_ERR_ATTR_SIZE;
+        }
+        break;
+
+      case MTAPI_NODE_SCHEDULER_MODE:
+        local_status = embb_mtapi_attr_set_mtapi_uint_t(
+          &attributes->scheduler_mode, attribute, attribute_size);
+        break;
+
+      case MTAPI_NODE_PRIORITY_AGING:
+        local_status = embb_mtapi_attr_set_mtapi_uint_t(
+          &attributes->priority_aging, attribute, attribute_size);
+        break;
+
       default:
         /* attribute unknown */
         local_status = MTAPI_ERR_ATTR_NUM;
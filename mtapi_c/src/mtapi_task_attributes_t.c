@@ -48,6 +48,8 @@ void mtapi_taskattr_init(
     attributes->is_detached = MTAPI_FALSE;
     attributes->priority = 0;
     attributes->complete_func = MTAPI_NULL;
+    attributes->deadline.seconds = 0;
+    attributes->deadline.nanoseconds = 0;
     mtapi_affinity_init(&attributes->affinity, MTAPI_TRUE, &local_status);
   } else {
     local_status = MTAPI_ERR_PARAMETER;
@@ -102,6 +104,16 @@ void mtapi_taskattr_set(
         local_status = MTAPI_SUCCESS;
         break;
 
+      case MTAPI_TASK_DEADLINE:
+        /* embb_time_t does not fit into a pointer, no value passing */
+        if (MTAPI_TASK_DEADLINE_SIZE == attribute_size) {
+          memcpy(&attributes->deadline, attribute, sizeof(embb_time_t));
+          local_status = MTAPI_SUCCESS;
+        } else {
+          local_status = MTAPI_ERR_ATTR_SIZE;
+        }
+        break;
+
       default:
         /* attribute unknown */
         local_status = MTAPI_ERR_ATTR_NUM;
@@ -26,6 +26,7 @@
 
 #include <stdlib.h>
 #include <embb/base/c/thread.h>
+#include <embb/base/c/atomic.h>
 #include <embb/base/c/memory_allocation.h>
 
 #include <embb_mtapi_test_config.h>
@@ -70,8 +71,25 @@ static void testGroupAction(
 static void testDoSomethingElse() {
 }
 
+static embb_atomic_int blocking_release;
+
+static void testBlockingAction(
+  const void* /*args*/,
+  mtapi_size_t /*arg_size*/,
+  void* /*result_buffer*/,
+  mtapi_size_t /*result_buffer_size*/,
+  const void* /*node_local_data*/,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t* /*task_context*/) {
+  while (0 == embb_atomic_load_int(&blocking_release)) {
+    embb_thread_yield();
+  }
+}
+
 GroupTest::GroupTest() {
   CreateUnit("mtapi group test").Add(&GroupTest::TestBasic, this, 1, 1000);
+  CreateUnit("mtapi group blocking wait test")
+    .Add(&GroupTest::TestBlocking, this);
 }
 
 void GroupTest::TestBasic() {
@@ -200,3 +218,63 @@ void GroupTest::TestBasic() {
 
   embb_mtapi_log_info("...done\n\n");
 }
+
+void GroupTest::TestBlocking() {
+  mtapi_status_t status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_hndl_t action;
+  mtapi_job_hndl_t job;
+  mtapi_group_hndl_t group;
+  void* result;
+  int ii;
+
+  embb_mtapi_log_info("running testGroupBlocking...\n");
+
+  mtapi_initialize(THIS_DOMAIN_ID, THIS_NODE_ID,
+    MTAPI_DEFAULT_NODE_ATTRIBUTES, MTAPI_NULL, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  action = mtapi_action_create(JOB_TEST_TASK, testBlockingAction,
+    MTAPI_NULL, 0, MTAPI_DEFAULT_ACTION_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  job = mtapi_job_get(JOB_TEST_TASK, THIS_DOMAIN_ID, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  embb_atomic_store_int(&blocking_release, 0);
+
+  group = mtapi_group_create(MTAPI_GROUP_ID_NONE,
+    MTAPI_DEFAULT_GROUP_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  for (ii = 0; ii < NUM_TASKS; ii++) {
+    mtapi_task_start(MTAPI_TASK_ID_NONE, job, MTAPI_NULL, 0, MTAPI_NULL, 0,
+      MTAPI_DEFAULT_TASK_ATTRIBUTES, group, &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+
+  /* the main thread is no worker, so it parks until the timeout expires */
+  mtapi_group_wait_any(group, &result, 10, &status);
+  PT_EXPECT_EQ(status, MTAPI_TIMEOUT);
+  mtapi_group_wait_all(group, 10, &status);
+  PT_EXPECT_EQ(status, MTAPI_TIMEOUT);
+
+  /* release the tasks, the parked waiter has to be woken up */
+  embb_atomic_store_int(&blocking_release, 1);
+
+  mtapi_group_wait_any(group, &result, MTAPI_INFINITE, &status);
+  PT_EXPECT_EQ(status, MTAPI_SUCCESS);
+  mtapi_group_wait_all(group, MTAPI_INFINITE, &status);
+  PT_EXPECT_EQ(status, MTAPI_SUCCESS);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_delete(action, 10, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  PT_EXPECT(embb_get_bytes_allocated() == 0);
+
+  embb_mtapi_log_info("...done\n\n");
+}
@@ -35,6 +35,7 @@ class GroupTest : public partest::TestCase {
 
  private:
   void TestBasic();
+  void TestBlocking();
 };
 
 #endif // MTAPI_C_TEST_EMBB_MTAPI_TEST_GROUP_H_
@@ -29,12 +29,24 @@
 #include <embb_mtapi_test_config.h>
 #include <embb_mtapi_test_queue.h>
 
+#include <embb/base/c/atomic.h>
 #include <embb/base/c/memory_allocation.h>
+#include <embb/base/c/thread.h>
+#include <embb/base/c/core_set.h>
 #include <embb/base/c/internal/unused.h>
 
 #define JOB_TEST_TASK 42
 #define TASK_TEST_ID 23
 #define QUEUE_TEST_ID 17
+#define JOB_TEST_ORDERED 43
+#define ORDERED_TEST_TASKS 100
+#define JOB_TEST_FILLER 44
+#define FAILING_TEST_TASKS 10
+#define FAILING_TEST_QUEUE_LIMIT 4
+
+static embb_atomic_int ordered_active;
+static embb_atomic_int ordered_next;
+static embb_atomic_int ordered_errors;
 
 static void testQueueAction(
   const void* args,
@@ -55,11 +67,77 @@ static void testQueueAction(
   EMBB_UNUSED(workload_id);
 }
 
+static void testOrderedAction(
+  const void* args,
+  mtapi_size_t /*arg_size*/,
+  void* /*result_buffer*/,
+  mtapi_size_t /*result_buffer_size*/,
+  const void* /*node_local_data*/,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t* /*task_context*/) {
+  int sequence = *reinterpret_cast<const int*>(args);
+  /* no other task of the queue may run concurrently */
+  if (0 != embb_atomic_fetch_and_add_int(&ordered_active, 1)) {
+    embb_atomic_fetch_and_add_int(&ordered_errors, 1);
+  }
+  /* tasks have to run in the order they were enqueued */
+  if (sequence != embb_atomic_fetch_and_add_int(&ordered_next, 1)) {
+    embb_atomic_fetch_and_add_int(&ordered_errors, 1);
+  }
+  embb_atomic_fetch_and_add_int(&ordered_active, -1);
+}
+
+static embb_atomic_int ordered_enqueued;
+static embb_atomic_int fillers_started;
+static mtapi_group_hndl_t filler_group;
+
+static void testFillerAction(
+  const void* /*args*/,
+  mtapi_size_t /*arg_size*/,
+  void* /*result_buffer*/,
+  mtapi_size_t /*result_buffer_size*/,
+  const void* /*node_local_data*/,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t* /*task_context*/) {
+}
+
+/* fills the worker queue, so the ordered tasks behind this one cannot be
+   scheduled when it finishes */
+static void testFillingAction(
+  const void* /*args*/,
+  mtapi_size_t /*arg_size*/,
+  void* /*result_buffer*/,
+  mtapi_size_t /*result_buffer_size*/,
+  const void* /*node_local_data*/,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t* /*task_context*/) {
+  mtapi_status_t status;
+  mtapi_job_hndl_t job;
+
+  while (0 == embb_atomic_load_int(&ordered_enqueued)) {
+    embb_thread_yield();
+  }
+
+  job = mtapi_job_get(JOB_TEST_FILLER, THIS_DOMAIN_ID, &status);
+  MTAPI_CHECK_STATUS(status);
+  do {
+    status = MTAPI_ERR_UNKNOWN;
+    mtapi_task_start(MTAPI_TASK_ID_NONE, job, MTAPI_NULL, 0, MTAPI_NULL, 0,
+      MTAPI_DEFAULT_TASK_ATTRIBUTES, filler_group, &status);
+    if (MTAPI_SUCCESS == status) {
+      embb_atomic_fetch_and_add_int(&fillers_started, 1);
+    }
+  } while (MTAPI_SUCCESS == status);
+}
+
 static void testDoSomethingElse() {
 }
 
 QueueTest::QueueTest() {
   CreateUnit("mtapi queue test").Add(&QueueTest::TestBasic, this);
+  CreateUnit("mtapi ordered queue test").Add(&QueueTest::TestOrdered, this);
+  CreateUnit("mtapi ordered queue failure test")
+    .Add(&QueueTest::TestOrderedFailure, this);
 }
 
 void QueueTest::TestBasic() {
@@ -134,3 +212,225 @@ void QueueTest::TestBasic() {
 
   embb_mtapi_log_info("...done\n\n");
 }
+
+void QueueTest::TestOrdered() {
+  mtapi_status_t status;
+  mtapi_action_hndl_t action;
+  mtapi_job_hndl_t job;
+  mtapi_queue_attributes_t queue_attr;
+  mtapi_queue_hndl_t queue;
+  mtapi_group_hndl_t group;
+  mtapi_boolean_t ordered = MTAPI_TRUE;
+  int args[ORDERED_TEST_TASKS];
+
+  embb_mtapi_log_info("running testOrderedQueue...\n");
+
+  embb_atomic_store_int(&ordered_active, 0);
+  embb_atomic_store_int(&ordered_next, 0);
+  embb_atomic_store_int(&ordered_errors, 0);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_initialize(THIS_DOMAIN_ID, THIS_NODE_ID,
+    MTAPI_DEFAULT_NODE_ATTRIBUTES, MTAPI_NULL, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  action = mtapi_action_create(JOB_TEST_ORDERED, testOrderedAction,
+    MTAPI_NULL, 0, MTAPI_DEFAULT_ACTION_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  job = mtapi_job_get(JOB_TEST_ORDERED, THIS_DOMAIN_ID, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_queueattr_init(&queue_attr, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_queueattr_set(&queue_attr, MTAPI_QUEUE_ORDERED,
+    &ordered, MTAPI_QUEUE_ORDERED_SIZE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  queue = mtapi_queue_create(MTAPI_QUEUE_ID_NONE, job, &queue_attr, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  group = mtapi_group_create(MTAPI_GROUP_ID_NONE,
+    MTAPI_DEFAULT_GROUP_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  for (int ii = 0; ii < ORDERED_TEST_TASKS; ii++) {
+    args[ii] = ii;
+    status = MTAPI_ERR_UNKNOWN;
+    mtapi_task_enqueue(MTAPI_TASK_ID_NONE, queue,
+      &args[ii], sizeof(int), MTAPI_NULL, 0, MTAPI_DEFAULT_TASK_ATTRIBUTES,
+      group, &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_group_wait_all(group, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  PT_EXPECT_EQ(embb_atomic_load_int(&ordered_next), ORDERED_TEST_TASKS);
+  PT_EXPECT_EQ(embb_atomic_load_int(&ordered_errors), 0);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_queue_delete(queue, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_delete(action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  PT_EXPECT(embb_get_bytes_allocated() == 0);
+
+  embb_mtapi_log_info("...done\n\n");
+}
+
+void QueueTest::TestOrderedFailure() {
+  mtapi_status_t status;
+  mtapi_node_attributes_t node_attr;
+  mtapi_action_hndl_t action;
+  mtapi_action_hndl_t filler_action;
+  mtapi_job_hndl_t job;
+  mtapi_queue_attributes_t queue_attr;
+  mtapi_queue_hndl_t queue;
+  mtapi_group_hndl_t group;
+  mtapi_boolean_t ordered = MTAPI_TRUE;
+  mtapi_uint_t queue_limit = FAILING_TEST_QUEUE_LIMIT;
+  mtapi_uint_t ordered_limit = FAILING_TEST_TASKS;
+  embb_core_set_t core_set;
+  int succeeded = 0;
+  int failed = 0;
+
+  embb_mtapi_log_info("running testOrderedQueueFailure...\n");
+
+  embb_atomic_store_int(&ordered_enqueued, 0);
+  embb_atomic_store_int(&fillers_started, 0);
+
+  /* a single worker with small queues, so they are easily filled */
+  embb_core_set_init(&core_set, 0);
+  embb_core_set_add(&core_set, 0);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_init(&node_attr, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_set(&node_attr, MTAPI_NODE_CORE_AFFINITY,
+    &core_set, MTAPI_NODE_CORE_AFFINITY_SIZE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_set(&node_attr, MTAPI_NODE_QUEUE_LIMIT,
+    &queue_limit, MTAPI_NODE_QUEUE_LIMIT_SIZE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_initialize(THIS_DOMAIN_ID, THIS_NODE_ID, &node_attr, MTAPI_NULL,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  action = mtapi_action_create(JOB_TEST_ORDERED, testFillingAction,
+    MTAPI_NULL, 0, MTAPI_DEFAULT_ACTION_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  filler_action = mtapi_action_create(JOB_TEST_FILLER, testFillerAction,
+    MTAPI_NULL, 0, MTAPI_DEFAULT_ACTION_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  job = mtapi_job_get(JOB_TEST_ORDERED, THIS_DOMAIN_ID, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_queueattr_init(&queue_attr, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_queueattr_set(&queue_attr, MTAPI_QUEUE_ORDERED,
+    &ordered, MTAPI_QUEUE_ORDERED_SIZE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_queueattr_set(&queue_attr, MTAPI_QUEUE_LIMIT,
+    &ordered_limit, MTAPI_QUEUE_LIMIT_SIZE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  queue = mtapi_queue_create(MTAPI_QUEUE_ID_NONE, job, &queue_attr, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  group = mtapi_group_create(MTAPI_GROUP_ID_NONE,
+    MTAPI_DEFAULT_GROUP_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  filler_group = mtapi_group_create(MTAPI_GROUP_ID_NONE,
+    MTAPI_DEFAULT_GROUP_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  /* the first task runs, the others wait for their turn */
+  for (int ii = 0; ii < FAILING_TEST_TASKS; ii++) {
+    status = MTAPI_ERR_UNKNOWN;
+    mtapi_task_enqueue(MTAPI_TASK_ID_NONE, queue,
+      MTAPI_NULL, 0, MTAPI_NULL, 0, MTAPI_DEFAULT_TASK_ATTRIBUTES,
+      group, &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+  embb_atomic_store_int(&ordered_enqueued, 1);
+
+  /* every task has to show up in the group, including the failed ones */
+  for (int ii = 0; ii < FAILING_TEST_TASKS; ii++) {
+    status = MTAPI_ERR_UNKNOWN;
+    mtapi_group_wait_any(group, MTAPI_NULL, MTAPI_INFINITE, &status);
+    if (MTAPI_SUCCESS == status) {
+      succeeded++;
+    } else if (MTAPI_ERR_TASK_LIMIT == status) {
+      failed++;
+    }
+  }
+  PT_EXPECT_EQ(succeeded, 1);
+  PT_EXPECT_EQ(failed, FAILING_TEST_TASKS - 1);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_group_delete(group, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_group_wait_all(filler_group, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+  PT_EXPECT_EQ(embb_atomic_load_int(&fillers_started),
+    FAILING_TEST_QUEUE_LIMIT);
+
+  /* the failed tasks are no longer accounted to the queue */
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_queue_delete(queue, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_delete(filler_action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_delete(action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  PT_EXPECT(embb_get_bytes_allocated() == 0);
+
+  embb_mtapi_log_info("...done\n\n");
+}
@@ -35,6 +35,8 @@ class QueueTest : public partest::TestCase {
 
  private:
   void TestBasic();
+  void TestOrdered();
+  void TestOrderedFailure();
 };
 
 #endif // MTAPI_C_TEST_EMBB_MTAPI_TEST_QUEUE_H_
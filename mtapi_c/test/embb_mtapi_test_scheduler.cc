@@ -0,0 +1,723 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <embb_mtapi_test_config.h>
+#include <embb_mtapi_test_scheduler.h>
+#include <embb_mtapi_action_t.h>
+#include <embb_mtapi_node_t.h>
+
+#include <embb/base/c/atomic.h>
+#include <embb/base/c/memory_allocation.h>
+#include <embb/base/c/time.h>
+#include <embb/base/c/thread.h>
+#include <embb/base/c/core_set.h>
+
+#define JOB_TEST_SCHEDULER 42
+#define SCHEDULER_TEST_PRIORITIES 4
+#define SCHEDULER_TEST_TASKS 400
+
+static embb_atomic_int tasks_executed;
+
+static void testSchedulerAction(
+  const void* /*args*/,
+  mtapi_size_t /*arg_size*/,
+  void* /*result_buffer*/,
+  mtapi_size_t /*result_buffer_size*/,
+  const void* /*node_local_data*/,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t* /*task_context*/) {
+  embb_atomic_fetch_and_add_int(&tasks_executed, 1);
+}
+
+static embb_atomic_int slow_tasks_executed;
+
+/* stands in for an implementation of the job that takes much longer, the
+   test seeds its cost instead of measuring it */
+static void testSlowAction(
+  const void* /*args*/,
+  mtapi_size_t /*arg_size*/,
+  void* /*result_buffer*/,
+  mtapi_size_t /*result_buffer_size*/,
+  const void* /*node_local_data*/,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t* /*task_context*/) {
+  embb_atomic_fetch_and_add_int(&slow_tasks_executed, 1);
+}
+
+/* an hour per task, no measured cost of the fast action comes close */
+#define DISPATCH_TEST_SLOW_COST 3600000000u
+
+static void seedActionCost(mtapi_action_hndl_t action, unsigned int cost) {
+  embb_mtapi_node_t * node = embb_mtapi_node_get_instance();
+  PT_ASSERT(embb_mtapi_action_pool_is_handle_valid(node->action_pool, action));
+  embb_mtapi_action_t * local_action =
+    embb_mtapi_action_pool_get_storage_for_handle(node->action_pool, action);
+  embb_atomic_store_unsigned_int(&local_action->average_cost, cost);
+}
+
+#define JOB_TEST_BLOCKER 43
+#define ORDER_TEST_TASKS 40
+
+static embb_atomic_int blocker_started;
+static embb_atomic_int blocker_released;
+
+/* occupies the only worker until released, so tasks queue up behind it */
+static void testBlockingAction(
+  const void* /*args*/,
+  mtapi_size_t /*arg_size*/,
+  void* /*result_buffer*/,
+  mtapi_size_t /*result_buffer_size*/,
+  const void* /*node_local_data*/,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t* /*task_context*/) {
+  embb_atomic_store_int(&blocker_started, 1);
+  while (0 == embb_atomic_load_int(&blocker_released)) {
+    embb_thread_yield();
+  }
+}
+
+static int order_args[ORDER_TEST_TASKS];
+static int order_executed[ORDER_TEST_TASKS];
+static embb_atomic_int order_count;
+
+/* records the integer argument of each task in execution order */
+static void testRecordingAction(
+  const void* args,
+  mtapi_size_t /*arg_size*/,
+  void* /*result_buffer*/,
+  mtapi_size_t /*result_buffer_size*/,
+  const void* /*node_local_data*/,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t* /*task_context*/) {
+  int index = embb_atomic_fetch_and_add_int(&order_count, 1);
+  if (index < ORDER_TEST_TASKS) {
+    order_executed[index] = *static_cast<const int*>(args);
+  }
+}
+
+/* initializes the node with a single worker, so the execution order is
+   determined by the scheduler alone */
+static void initializeSingleWorkerNode(mtapi_uint_t mode, mtapi_uint_t aging) {
+  mtapi_node_attributes_t node_attr;
+  mtapi_status_t status;
+  embb_core_set_t core_set;
+
+  embb_core_set_init(&core_set, 0);
+  embb_core_set_add(&core_set, 0);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_init(&node_attr, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_set(&node_attr, MTAPI_NODE_CORE_AFFINITY,
+    &core_set, MTAPI_NODE_CORE_AFFINITY_SIZE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_set(&node_attr, MTAPI_NODE_MAX_PRIORITIES,
+    MTAPI_ATTRIBUTE_VALUE(SCHEDULER_TEST_PRIORITIES),
+    MTAPI_ATTRIBUTE_POINTER_AS_VALUE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_set(&node_attr, MTAPI_NODE_SCHEDULER_MODE,
+    &mode, MTAPI_NODE_SCHEDULER_MODE_SIZE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_set(&node_attr, MTAPI_NODE_PRIORITY_AGING,
+    &aging, MTAPI_NODE_PRIORITY_AGING_SIZE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_initialize(THIS_DOMAIN_ID, THIS_NODE_ID, &node_attr, MTAPI_NULL,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  embb_atomic_store_int(&order_count, 0);
+}
+
+/* starts a task that occupies the worker and waits until it runs */
+static mtapi_task_hndl_t startBlocker(mtapi_job_hndl_t job) {
+  mtapi_status_t status;
+  mtapi_task_hndl_t task;
+
+  embb_atomic_store_int(&blocker_started, 0);
+  embb_atomic_store_int(&blocker_released, 0);
+
+  status = MTAPI_ERR_UNKNOWN;
+  task = mtapi_task_start(MTAPI_TASK_ID_NONE, job, MTAPI_NULL, 0,
+    MTAPI_NULL, 0, MTAPI_DEFAULT_TASK_ATTRIBUTES, MTAPI_GROUP_NONE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  while (0 == embb_atomic_load_int(&blocker_started)) {
+    embb_thread_yield();
+  }
+  return task;
+}
+
+static void testPriorityOrder(mtapi_uint_t aging) {
+  mtapi_task_attributes_t task_attr;
+  mtapi_status_t status;
+  mtapi_action_hndl_t blocker_action;
+  mtapi_action_hndl_t action;
+  mtapi_job_hndl_t blocker_job;
+  mtapi_job_hndl_t job;
+  mtapi_group_hndl_t group;
+  mtapi_task_hndl_t blocker;
+  int pending[SCHEDULER_TEST_PRIORITIES];
+  int expected[ORDER_TEST_TASKS];
+  mtapi_uint_t aging_counter;
+
+  initializeSingleWorkerNode(MTAPI_NODE_SCHEDULER_HPF, aging);
+
+  status = MTAPI_ERR_UNKNOWN;
+  blocker_action = mtapi_action_create(JOB_TEST_BLOCKER, testBlockingAction,
+    MTAPI_NULL, 0, MTAPI_DEFAULT_ACTION_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  action = mtapi_action_create(JOB_TEST_SCHEDULER, testRecordingAction,
+    MTAPI_NULL, 0, MTAPI_DEFAULT_ACTION_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  blocker_job = mtapi_job_get(JOB_TEST_BLOCKER, THIS_DOMAIN_ID, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  job = mtapi_job_get(JOB_TEST_SCHEDULER, THIS_DOMAIN_ID, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  group = mtapi_group_create(MTAPI_GROUP_ID_NONE,
+    MTAPI_DEFAULT_GROUP_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  blocker = startBlocker(blocker_job);
+
+  /* queue all priorities mixed behind the blocker, lowest first */
+  for (int ii = 0; ii < ORDER_TEST_TASKS; ii++) {
+    mtapi_uint_t priority = (mtapi_uint_t)(SCHEDULER_TEST_PRIORITIES - 1 -
+      ii % SCHEDULER_TEST_PRIORITIES);
+    order_args[ii] = (int)priority;
+
+    status = MTAPI_ERR_UNKNOWN;
+    mtapi_taskattr_init(&task_attr, &status);
+    MTAPI_CHECK_STATUS(status);
+
+    status = MTAPI_ERR_UNKNOWN;
+    mtapi_taskattr_set(&task_attr, MTAPI_TASK_PRIORITY,
+      &priority, MTAPI_TASK_PRIORITY_SIZE, &status);
+    MTAPI_CHECK_STATUS(status);
+
+    status = MTAPI_ERR_UNKNOWN;
+    mtapi_task_start(MTAPI_TASK_ID_NONE, job,
+      &order_args[ii], sizeof(int), MTAPI_NULL, 0, &task_attr, group,
+      &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+
+  embb_atomic_store_int(&blocker_released, 1);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_task_wait(blocker, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_group_wait_all(group, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  PT_ASSERT_EQ(embb_atomic_load_int(&order_count), ORDER_TEST_TASKS);
+
+  /* highest priority first, but after every aging tasks taken in priority
+     order, the lowest pending priority is served once. The blocker was the
+     first task taken in priority order. */
+  for (int pp = 0; pp < SCHEDULER_TEST_PRIORITIES; pp++) {
+    pending[pp] = ORDER_TEST_TASKS / SCHEDULER_TEST_PRIORITIES;
+  }
+  aging_counter = 1;
+  for (int ii = 0; ii < ORDER_TEST_TASKS; ii++) {
+    int pp;
+    if (0 < aging && aging_counter >= aging) {
+      for (pp = SCHEDULER_TEST_PRIORITIES - 1; 0 == pending[pp]; pp--) {}
+      aging_counter = 0;
+    } else {
+      for (pp = 0; 0 == pending[pp]; pp++) {}
+      aging_counter++;
+    }
+    pending[pp]--;
+    expected[ii] = pp;
+  }
+  for (int ii = 0; ii < ORDER_TEST_TASKS; ii++) {
+    PT_EXPECT_EQ(order_executed[ii], expected[ii]);
+  }
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_delete(action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_delete(blocker_action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  PT_EXPECT_EQ(embb_get_bytes_allocated(), 0u);
+}
+
+static void testSchedulerMode(mtapi_uint_t mode, mtapi_uint_t aging) {
+  mtapi_node_attributes_t node_attr;
+  mtapi_task_attributes_t task_attr;
+  mtapi_status_t status;
+  mtapi_action_hndl_t action;
+  mtapi_job_hndl_t job;
+  mtapi_group_hndl_t group;
+  mtapi_uint_t value = 0;
+
+  embb_atomic_store_int(&tasks_executed, 0);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_init(&node_attr, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_set(&node_attr, MTAPI_NODE_MAX_PRIORITIES,
+    MTAPI_ATTRIBUTE_VALUE(SCHEDULER_TEST_PRIORITIES),
+    MTAPI_ATTRIBUTE_POINTER_AS_VALUE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_set(&node_attr, MTAPI_NODE_SCHEDULER_MODE,
+    &mode, MTAPI_NODE_SCHEDULER_MODE_SIZE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_set(&node_attr, MTAPI_NODE_PRIORITY_AGING,
+    &aging, MTAPI_NODE_PRIORITY_AGING_SIZE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_initialize(THIS_DOMAIN_ID, THIS_NODE_ID, &node_attr, MTAPI_NULL,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_node_get_attribute(THIS_NODE_ID, MTAPI_NODE_SCHEDULER_MODE,
+    &value, MTAPI_NODE_SCHEDULER_MODE_SIZE, &status);
+  MTAPI_CHECK_STATUS(status);
+  PT_EXPECT_EQ(value, mode);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_node_get_attribute(THIS_NODE_ID, MTAPI_NODE_PRIORITY_AGING,
+    &value, MTAPI_NODE_PRIORITY_AGING_SIZE, &status);
+  MTAPI_CHECK_STATUS(status);
+  PT_EXPECT_EQ(value, aging);
+
+  status = MTAPI_ERR_UNKNOWN;
+  action = mtapi_action_create(JOB_TEST_SCHEDULER, testSchedulerAction,
+    MTAPI_NULL, 0, MTAPI_DEFAULT_ACTION_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  job = mtapi_job_get(JOB_TEST_SCHEDULER, THIS_DOMAIN_ID, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  group = mtapi_group_create(MTAPI_GROUP_ID_NONE,
+    MTAPI_DEFAULT_GROUP_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  /* mix all priorities, so idle levels are skipped and aging kicks in */
+  for (int ii = 0; ii < SCHEDULER_TEST_TASKS; ii++) {
+    mtapi_uint_t priority = (mtapi_uint_t)(ii % SCHEDULER_TEST_PRIORITIES);
+
+    status = MTAPI_ERR_UNKNOWN;
+    mtapi_taskattr_init(&task_attr, &status);
+    MTAPI_CHECK_STATUS(status);
+
+    status = MTAPI_ERR_UNKNOWN;
+    mtapi_taskattr_set(&task_attr, MTAPI_TASK_PRIORITY,
+      &priority, MTAPI_TASK_PRIORITY_SIZE, &status);
+    MTAPI_CHECK_STATUS(status);
+
+    status = MTAPI_ERR_UNKNOWN;
+    mtapi_task_start(MTAPI_TASK_ID_NONE, job, MTAPI_NULL, 0, MTAPI_NULL, 0,
+      &task_attr, group, &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_group_wait_all(group, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  PT_EXPECT_EQ(embb_atomic_load_int(&tasks_executed), SCHEDULER_TEST_TASKS);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_delete(action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  PT_EXPECT_EQ(embb_get_bytes_allocated(), 0u);
+}
+
+SchedulerTest::SchedulerTest() {
+  CreateUnit("mtapi scheduler test").Add(&SchedulerTest::TestModes, this);
+  CreateUnit("mtapi priority order test")
+    .Add(&SchedulerTest::TestPriorityOrder, this);
+  CreateUnit("mtapi deadline test").Add(&SchedulerTest::TestDeadlines, this);
+  CreateUnit("mtapi deadline order test")
+    .Add(&SchedulerTest::TestDeadlineOrder, this);
+  CreateUnit("mtapi dispatch test").Add(&SchedulerTest::TestDispatch, this);
+}
+
+void SchedulerTest::TestModes() {
+  embb_mtapi_log_info("running testScheduler...\n");
+
+  testSchedulerMode(MTAPI_NODE_SCHEDULER_VHPF, 0);
+  testSchedulerMode(MTAPI_NODE_SCHEDULER_LF, 0);
+  testSchedulerMode(MTAPI_NODE_SCHEDULER_HPF, 0);
+  testSchedulerMode(MTAPI_NODE_SCHEDULER_HPF, 3);
+  testSchedulerMode(MTAPI_NODE_SCHEDULER_EDF, 0);
+}
+
+void SchedulerTest::TestPriorityOrder() {
+  embb_mtapi_log_info("running testPriorityOrder...\n");
+
+  /* without aging the order is strictly by priority */
+  testPriorityOrder(0);
+  testPriorityOrder(3);
+}
+
+void SchedulerTest::TestDeadlines() {
+  mtapi_node_attributes_t node_attr;
+  mtapi_task_attributes_t task_attr;
+  mtapi_status_t status;
+  mtapi_action_hndl_t action;
+  mtapi_job_hndl_t job;
+  mtapi_group_hndl_t group;
+  mtapi_uint_t mode = MTAPI_NODE_SCHEDULER_EDF;
+  mtapi_uint_t value = 0;
+  embb_duration_t duration;
+  embb_time_t deadline;
+  embb_time_t passed_deadline;
+  const int kTaskCount = 100;
+  int missed = 0;
+
+  embb_mtapi_log_info("running testDeadlines...\n");
+
+  embb_atomic_store_int(&tasks_executed, 0);
+
+  /* one deadline far in the future, one that has already passed */
+  embb_duration_set_seconds(&duration, 3600);
+  embb_time_in(&deadline, &duration);
+  embb_time_now(&passed_deadline);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_init(&node_attr, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_set(&node_attr, MTAPI_NODE_SCHEDULER_MODE,
+    &mode, MTAPI_NODE_SCHEDULER_MODE_SIZE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_set(&node_attr, MTAPI_NODE_DEADLINES_MISSED,
+    &value, MTAPI_NODE_DEADLINES_MISSED_SIZE, &status);
+  PT_EXPECT_EQ(status, MTAPI_ERR_ATTR_READONLY);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_initialize(THIS_DOMAIN_ID, THIS_NODE_ID, &node_attr, MTAPI_NULL,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  action = mtapi_action_create(JOB_TEST_SCHEDULER, testSchedulerAction,
+    MTAPI_NULL, 0, MTAPI_DEFAULT_ACTION_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  job = mtapi_job_get(JOB_TEST_SCHEDULER, THIS_DOMAIN_ID, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  group = mtapi_group_create(MTAPI_GROUP_ID_NONE,
+    MTAPI_DEFAULT_GROUP_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  /* every third task has no deadline, every third one has missed it */
+  for (int ii = 0; ii < kTaskCount; ii++) {
+    status = MTAPI_ERR_UNKNOWN;
+    mtapi_taskattr_init(&task_attr, &status);
+    MTAPI_CHECK_STATUS(status);
+
+    if (1 == ii % 3) {
+      status = MTAPI_ERR_UNKNOWN;
+      mtapi_taskattr_set(&task_attr, MTAPI_TASK_DEADLINE,
+        &deadline, MTAPI_TASK_DEADLINE_SIZE, &status);
+      MTAPI_CHECK_STATUS(status);
+    } else if (2 == ii % 3) {
+      status = MTAPI_ERR_UNKNOWN;
+      mtapi_taskattr_set(&task_attr, MTAPI_TASK_DEADLINE,
+        &passed_deadline, MTAPI_TASK_DEADLINE_SIZE, &status);
+      MTAPI_CHECK_STATUS(status);
+      missed++;
+    }
+
+    status = MTAPI_ERR_UNKNOWN;
+    mtapi_task_start(MTAPI_TASK_ID_NONE, job, MTAPI_NULL, 0, MTAPI_NULL, 0,
+      &task_attr, group, &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_group_wait_all(group, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  PT_EXPECT_EQ(embb_atomic_load_int(&tasks_executed), kTaskCount);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_node_get_attribute(THIS_NODE_ID, MTAPI_NODE_DEADLINE_TASKS,
+    &value, MTAPI_NODE_DEADLINE_TASKS_SIZE, &status);
+  MTAPI_CHECK_STATUS(status);
+  PT_EXPECT_EQ(value, (mtapi_uint_t)(kTaskCount * 2 / 3));
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_node_get_attribute(THIS_NODE_ID, MTAPI_NODE_DEADLINES_MISSED,
+    &value, MTAPI_NODE_DEADLINES_MISSED_SIZE, &status);
+  MTAPI_CHECK_STATUS(status);
+  PT_EXPECT_EQ(value, (mtapi_uint_t)missed);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_delete(action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  PT_EXPECT_EQ(embb_get_bytes_allocated(), 0u);
+}
+
+void SchedulerTest::TestDeadlineOrder() {
+  mtapi_task_attributes_t task_attr;
+  mtapi_status_t status;
+  mtapi_action_hndl_t blocker_action;
+  mtapi_action_hndl_t action;
+  mtapi_job_hndl_t blocker_job;
+  mtapi_job_hndl_t job;
+  mtapi_group_hndl_t group;
+  mtapi_task_hndl_t blocker;
+  embb_duration_t duration;
+  embb_time_t deadline;
+
+  embb_mtapi_log_info("running testDeadlineOrder...\n");
+
+  initializeSingleWorkerNode(MTAPI_NODE_SCHEDULER_EDF, 0);
+
+  status = MTAPI_ERR_UNKNOWN;
+  blocker_action = mtapi_action_create(JOB_TEST_BLOCKER, testBlockingAction,
+    MTAPI_NULL, 0, MTAPI_DEFAULT_ACTION_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  action = mtapi_action_create(JOB_TEST_SCHEDULER, testRecordingAction,
+    MTAPI_NULL, 0, MTAPI_DEFAULT_ACTION_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  blocker_job = mtapi_job_get(JOB_TEST_BLOCKER, THIS_DOMAIN_ID, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  job = mtapi_job_get(JOB_TEST_SCHEDULER, THIS_DOMAIN_ID, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  group = mtapi_group_create(MTAPI_GROUP_ID_NONE,
+    MTAPI_DEFAULT_GROUP_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  blocker = startBlocker(blocker_job);
+
+  /* distinct deadlines in scrambled order, every fifth task has none and
+     is recorded as ORDER_TEST_TASKS, since those come last */
+  for (int ii = 0; ii < ORDER_TEST_TASKS; ii++) {
+    status = MTAPI_ERR_UNKNOWN;
+    mtapi_taskattr_init(&task_attr, &status);
+    MTAPI_CHECK_STATUS(status);
+
+    if (0 == ii % 5) {
+      order_args[ii] = ORDER_TEST_TASKS;
+    } else {
+      order_args[ii] = (ii * 7) % ORDER_TEST_TASKS;
+      embb_duration_set_seconds(&duration, 3600u + order_args[ii]);
+      embb_time_in(&deadline, &duration);
+
+      status = MTAPI_ERR_UNKNOWN;
+      mtapi_taskattr_set(&task_attr, MTAPI_TASK_DEADLINE,
+        &deadline, MTAPI_TASK_DEADLINE_SIZE, &status);
+      MTAPI_CHECK_STATUS(status);
+    }
+
+    status = MTAPI_ERR_UNKNOWN;
+    mtapi_task_start(MTAPI_TASK_ID_NONE, job,
+      &order_args[ii], sizeof(int), MTAPI_NULL, 0, &task_attr, group,
+      &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+
+  embb_atomic_store_int(&blocker_released, 1);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_task_wait(blocker, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_group_wait_all(group, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  PT_ASSERT_EQ(embb_atomic_load_int(&order_count), ORDER_TEST_TASKS);
+
+  /* the earliest deadline is always taken first */
+  for (int ii = 1; ii < ORDER_TEST_TASKS; ii++) {
+    PT_EXPECT_LE(order_executed[ii - 1], order_executed[ii]);
+  }
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_delete(action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_delete(blocker_action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  PT_EXPECT_EQ(embb_get_bytes_allocated(), 0u);
+}
+
+void SchedulerTest::TestDispatch() {
+  mtapi_status_t status;
+  mtapi_action_hndl_t slow_action;
+  mtapi_action_hndl_t fast_action;
+  mtapi_job_hndl_t job;
+  mtapi_group_hndl_t group;
+  mtapi_task_hndl_t task;
+  const int kTaskCount = 100;
+
+  embb_mtapi_log_info("running testDispatch...\n");
+
+  embb_atomic_store_int(&tasks_executed, 0);
+  embb_atomic_store_int(&slow_tasks_executed, 0);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_initialize(THIS_DOMAIN_ID, THIS_NODE_ID, MTAPI_DEFAULT_NODE_ATTRIBUTES,
+    MTAPI_NULL, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  /* two implementations of the same job */
+  status = MTAPI_ERR_UNKNOWN;
+  slow_action = mtapi_action_create(JOB_TEST_SCHEDULER, testSlowAction,
+    MTAPI_NULL, 0, MTAPI_DEFAULT_ACTION_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  fast_action = mtapi_action_create(JOB_TEST_SCHEDULER, testSchedulerAction,
+    MTAPI_NULL, 0, MTAPI_DEFAULT_ACTION_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  job = mtapi_job_get(JOB_TEST_SCHEDULER, THIS_DOMAIN_ID, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  /* one task after another, each action is tried once while idle and the
+     fast one is chosen from then on */
+  for (int ii = 0; ii < kTaskCount; ii++) {
+    if (1 == ii) {
+      PT_EXPECT_EQ(embb_atomic_load_int(&slow_tasks_executed), 1);
+      seedActionCost(slow_action, DISPATCH_TEST_SLOW_COST);
+    }
+
+    status = MTAPI_ERR_UNKNOWN;
+    task = mtapi_task_start(MTAPI_TASK_ID_NONE, job, MTAPI_NULL, 0,
+      MTAPI_NULL, 0, MTAPI_DEFAULT_TASK_ATTRIBUTES, MTAPI_GROUP_NONE,
+      &status);
+    MTAPI_CHECK_STATUS(status);
+
+    status = MTAPI_ERR_UNKNOWN;
+    mtapi_task_wait(task, MTAPI_INFINITE, &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+
+  PT_EXPECT_EQ(embb_atomic_load_int(&slow_tasks_executed), 1);
+  PT_EXPECT_EQ(embb_atomic_load_int(&tasks_executed), kTaskCount - 1);
+
+  /* all at once, the queue of the fast action never grows long enough to
+     make the slow one finish first */
+  status = MTAPI_ERR_UNKNOWN;
+  group = mtapi_group_create(MTAPI_GROUP_ID_NONE,
+    MTAPI_DEFAULT_GROUP_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  for (int ii = 0; ii < kTaskCount; ii++) {
+    status = MTAPI_ERR_UNKNOWN;
+    mtapi_task_start(MTAPI_TASK_ID_NONE, job, MTAPI_NULL, 0, MTAPI_NULL, 0,
+      MTAPI_DEFAULT_TASK_ATTRIBUTES, group, &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_group_wait_all(group, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  PT_EXPECT_EQ(embb_atomic_load_int(&slow_tasks_executed), 1);
+  PT_EXPECT_EQ(embb_atomic_load_int(&tasks_executed), 2 * kTaskCount - 1);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_delete(fast_action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_delete(slow_action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  PT_EXPECT_EQ(embb_get_bytes_allocated(), 0u);
+}
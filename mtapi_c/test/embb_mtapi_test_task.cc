@@ -25,16 +25,23 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 
 #include <embb_mtapi_test_config.h>
 #include <embb_mtapi_test_task.h>
 
+#include <embb/base/c/atomic.h>
 #include <embb/base/c/memory_allocation.h>
+#include <embb/base/c/thread.h>
+#include <embb/base/c/time.h>
 #include <embb/base/c/internal/unused.h>
 
 #define JOB_TEST_TASK 42
 #define JOB_TEST_MULTIINSTANCE_TASK 43
+#define JOB_TEST_DETACHED_TASK 44
 #define TASK_TEST_ID 23
+#define DETACHED_TEST_TASKS 100
+#define DETACHED_TEST_MAX_TASKS 4
 
 static void testTaskAction(
   const void* args,
@@ -91,11 +98,83 @@ void testMultiInstanceTaskAction(
 }
 
 
+static embb_atomic_int detached_instances_executed;
+static embb_atomic_int detached_tasks_completed;
+
+static void testDetachedAction(
+  const void* /*args*/,
+  mtapi_size_t /*arg_size*/,
+  void* /*result_buffer*/,
+  mtapi_size_t /*result_buffer_size*/,
+  const void* /*node_local_data*/,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t* /*task_context*/) {
+  embb_atomic_fetch_and_add_int(&detached_instances_executed, 1);
+  /* give other instances of the task the chance to finish first */
+  embb_thread_yield();
+}
+
+static void testDetachedComplete(
+  MTAPI_IN mtapi_task_hndl_t /*task*/,
+  MTAPI_OUT mtapi_status_t* /*status*/) {
+  embb_atomic_fetch_and_add_int(&detached_tasks_completed, 1);
+}
+
+/* starts a detached task, a slot in the task pool becomes available again
+   only after the runtime deleted a finished task */
+static void startDetachedTask(
+  mtapi_job_hndl_t job,
+  mtapi_uint_t instances) {
+  mtapi_task_attributes_t task_attr;
+  mtapi_task_complete_function_t func = testDetachedComplete;
+  void * func_void;
+  mtapi_boolean_t detached = MTAPI_TRUE;
+  mtapi_status_t status;
+  embb_duration_t timeout;
+  embb_time_t deadline;
+  embb_time_t now;
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_taskattr_init(&task_attr, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_taskattr_set(&task_attr, MTAPI_TASK_DETACHED,
+    &detached, sizeof(mtapi_boolean_t), &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_taskattr_set(&task_attr, MTAPI_TASK_INSTANCES,
+    &instances, sizeof(mtapi_uint_t), &status);
+  MTAPI_CHECK_STATUS(status);
+
+  memcpy(&func_void, &func, sizeof(void*));
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_taskattr_set(&task_attr, MTAPI_TASK_COMPLETE_FUNCTION,
+    func_void, 0, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  embb_duration_set_seconds(&timeout, 10);
+  embb_time_in(&deadline, &timeout);
+  do {
+    status = MTAPI_ERR_UNKNOWN;
+    mtapi_task_start(MTAPI_TASK_ID_NONE, job, MTAPI_NULL, 0, MTAPI_NULL, 0,
+      &task_attr, MTAPI_GROUP_NONE, &status);
+    if (MTAPI_ERR_TASK_LIMIT != status) {
+      break;
+    }
+    embb_thread_yield();
+    embb_time_now(&now);
+  } while (embb_time_compare(&now, &deadline) < 0);
+  MTAPI_CHECK_STATUS(status);
+}
+
 static void testDoSomethingElse() {
 }
 
 TaskTest::TaskTest() {
   CreateUnit("mtapi task test").Add(&TaskTest::TestBasic, this);
+  CreateUnit("mtapi detached task test").Add(&TaskTest::TestDetached, this);
 }
 
 void TaskTest::TestBasic() {
@@ -261,3 +340,73 @@ void TaskTest::TestBasic() {
 
   embb_mtapi_log_info("...done\n\n");
 }
+
+void TaskTest::TestDetached() {
+  mtapi_node_attributes_t node_attr;
+  mtapi_status_t status;
+  mtapi_action_hndl_t action;
+  mtapi_job_hndl_t job;
+  const mtapi_uint_t kTaskInstances = 4;
+
+  embb_mtapi_log_info("running testDetached...\n");
+
+  embb_atomic_store_int(&detached_instances_executed, 0);
+  embb_atomic_store_int(&detached_tasks_completed, 0);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_init(&node_attr, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  /* leaked tasks would exhaust the pool after a few starts */
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_set(&node_attr, MTAPI_NODE_MAX_TASKS,
+    MTAPI_ATTRIBUTE_VALUE(DETACHED_TEST_MAX_TASKS),
+    MTAPI_ATTRIBUTE_POINTER_AS_VALUE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_initialize(THIS_DOMAIN_ID, THIS_NODE_ID, &node_attr, MTAPI_NULL,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  action = mtapi_action_create(JOB_TEST_DETACHED_TASK, testDetachedAction,
+    MTAPI_NULL, 0, MTAPI_DEFAULT_ACTION_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  job = mtapi_job_get(JOB_TEST_DETACHED_TASK, THIS_DOMAIN_ID, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  /* single instance tasks, then tasks whose instances may run on several
+     workers at once and are deleted after the last one finished */
+  for (int ii = 0; ii < DETACHED_TEST_TASKS; ii++) {
+    startDetachedTask(job, 1);
+  }
+  for (int ii = 0; ii < DETACHED_TEST_TASKS; ii++) {
+    startDetachedTask(job, kTaskInstances);
+  }
+
+  while (embb_atomic_load_int(&detached_tasks_completed) <
+    2 * DETACHED_TEST_TASKS) {
+    embb_thread_yield();
+  }
+
+  /* the callback runs once per task, not once per instance */
+  PT_EXPECT_EQ(embb_atomic_load_int(&detached_tasks_completed),
+    2 * DETACHED_TEST_TASKS);
+  PT_EXPECT_EQ(embb_atomic_load_int(&detached_instances_executed),
+    DETACHED_TEST_TASKS * (1 + static_cast<int>(kTaskInstances)));
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_delete(action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  PT_EXPECT_EQ(embb_get_bytes_allocated(), 0u);
+
+  embb_mtapi_log_info("...done\n\n");
+}
@@ -35,6 +35,7 @@ class TaskTest : public partest::TestCase {
 
  private:
   void TestBasic();
+  void TestDetached();
 };
 
 #endif // MTAPI_C_TEST_EMBB_MTAPI_TEST_TASK_H_
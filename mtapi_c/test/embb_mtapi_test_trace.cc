@@ -0,0 +1,260 @@
+/*
+ * Copyright (c) 2014-2015, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdio.h>
+#include <string.h>
+
+#include <embb_mtapi_test_config.h>
+#include <embb_mtapi_test_trace.h>
+
+#include <embb/base/c/memory_allocation.h>
+#include <embb/base/c/internal/unused.h>
+
+#define JOB_TEST_TRACE 42
+#define TRACE_TEST_FILE "embb_mtapi_test_trace.json"
+
+static void testTraceAction(
+  const void* /*args*/,
+  mtapi_size_t /*arg_size*/,
+  void* /*result_buffer*/,
+  mtapi_size_t /*result_buffer_size*/,
+  const void* /*node_local_data*/,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t* /*task_context*/) {
+  // empty
+}
+
+#define TRACE_TEST_MAX_THREADS 256
+
+/* per thread state while checking a trace file */
+typedef struct {
+  unsigned int events;
+  unsigned long long last_us;
+  unsigned long last_ns;
+  unsigned int task_begins;
+  unsigned int task_ends;
+  int in_task;
+} trace_thread_t;
+
+/* copies the string value following the given key, e.g. "name":"task" */
+static int traceGetString(
+  const char * line, const char * key, char * value, size_t size) {
+  const char * pos = strstr(line, key);
+  size_t ii = 0;
+  if (NULL == pos) {
+    return 0;
+  }
+  pos += strlen(key);
+  while (*pos != '"' && *pos != '\0' && ii + 1 < size) {
+    value[ii++] = *pos++;
+  }
+  value[ii] = '\0';
+  return 1;
+}
+
+TraceTest::TraceTest() {
+  CreateUnit("mtapi trace test").Add(&TraceTest::TestBasic, this);
+  CreateUnit("mtapi trace wrap test").Add(&TraceTest::TestWrap, this);
+}
+
+void TraceTest::RunTasks(mtapi_uint_t trace_capacity, int task_count) {
+  mtapi_node_attributes_t node_attr;
+  mtapi_status_t status;
+  mtapi_action_hndl_t action;
+  mtapi_job_hndl_t job;
+  mtapi_group_hndl_t group;
+  mtapi_uint_t capacity = 0;
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_init(&node_attr, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_set(&node_attr, MTAPI_NODE_TRACE_CAPACITY,
+    &trace_capacity, MTAPI_NODE_TRACE_CAPACITY_SIZE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_nodeattr_set(&node_attr, MTAPI_NODE_TRACE_FILE,
+    MTAPI_ATTRIBUTE_VALUE(TRACE_TEST_FILE), MTAPI_ATTRIBUTE_POINTER_AS_VALUE,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_initialize(THIS_DOMAIN_ID, THIS_NODE_ID, &node_attr, MTAPI_NULL,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_node_get_attribute(THIS_NODE_ID, MTAPI_NODE_TRACE_CAPACITY,
+    &capacity, MTAPI_NODE_TRACE_CAPACITY_SIZE, &status);
+  MTAPI_CHECK_STATUS(status);
+  PT_EXPECT_EQ(capacity, trace_capacity);
+
+  status = MTAPI_ERR_UNKNOWN;
+  action = mtapi_action_create(JOB_TEST_TRACE, testTraceAction,
+    MTAPI_NULL, 0, MTAPI_DEFAULT_ACTION_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  job = mtapi_job_get(JOB_TEST_TRACE, THIS_DOMAIN_ID, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  group = mtapi_group_create(MTAPI_GROUP_ID_NONE,
+    MTAPI_DEFAULT_GROUP_ATTRIBUTES, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  for (int ii = 0; ii < task_count; ii++) {
+    status = MTAPI_ERR_UNKNOWN;
+    mtapi_task_start(MTAPI_TASK_ID_NONE, job, MTAPI_NULL, 0, MTAPI_NULL, 0,
+      MTAPI_DEFAULT_TASK_ATTRIBUTES, group, &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_group_wait_all(group, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_action_delete(action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  status = MTAPI_ERR_UNKNOWN;
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  PT_EXPECT_EQ(embb_get_bytes_allocated(), 0u);
+}
+
+void TraceTest::CheckTrace(
+  mtapi_uint_t trace_capacity, int task_count, bool wrapped) {
+  trace_thread_t threads[TRACE_TEST_MAX_THREADS];
+  char line[512];
+  char name[32];
+  char phase[4];
+  unsigned int tid;
+  unsigned long long us;
+  unsigned long ns;
+  unsigned int task_begins = 0;
+  unsigned int task_ends = 0;
+  bool has_thread_name = false;
+
+  memset(threads, 0, sizeof(threads));
+
+  /* the trace was written on finalization */
+  FILE * file = fopen(TRACE_TEST_FILE, "r");
+  PT_ASSERT(NULL != file);
+
+  PT_EXPECT(NULL != fgets(line, sizeof(line), file));
+  PT_EXPECT(0 == strncmp(line, "{\"traceEvents\":[", 16));
+
+  /* one event per line, oldest first within each thread */
+  while (NULL != fgets(line, sizeof(line), file)) {
+    if (0 != strncmp(line, "{\"name\":\"", 9)) {
+      continue;
+    }
+    PT_EXPECT(traceGetString(line, "\"name\":\"", name, sizeof(name)));
+    PT_EXPECT(traceGetString(line, "\"ph\":\"", phase, sizeof(phase)));
+    const char * tid_pos = strstr(line, "\"tid\":");
+    PT_ASSERT(NULL != tid_pos);
+    PT_ASSERT(1 == sscanf(tid_pos, "\"tid\":%u", &tid));
+    PT_ASSERT(tid < TRACE_TEST_MAX_THREADS);
+    trace_thread_t * thread = &threads[tid];
+
+    if (0 == strcmp(name, "thread_name")) {
+      PT_EXPECT_EQ(phase[0], 'M');
+      has_thread_name = true;
+      continue;
+    }
+
+    const char * ts_pos = strstr(line, "\"ts\":");
+    PT_ASSERT(NULL != ts_pos);
+    PT_ASSERT(2 == sscanf(ts_pos, "\"ts\":%llu.%lu", &us, &ns));
+    /* timestamps never go backwards within a thread */
+    PT_EXPECT(us > thread->last_us ||
+      (us == thread->last_us && ns >= thread->last_ns));
+    thread->last_us = us;
+    thread->last_ns = ns;
+    thread->events++;
+
+    if (0 == strcmp(name, "task")) {
+      if ('B' == phase[0]) {
+        /* no nested tasks, so begin and end alternate */
+        PT_EXPECT(!thread->in_task);
+        thread->in_task = 1;
+        thread->task_begins++;
+        task_begins++;
+      } else {
+        PT_EXPECT_EQ(phase[0], 'E');
+        /* a wrapped buffer may have lost the begin of its first task */
+        PT_EXPECT(thread->in_task ||
+          (wrapped && 0 == thread->task_begins));
+        thread->in_task = 0;
+        thread->task_ends++;
+        task_ends++;
+      }
+    }
+  }
+  fclose(file);
+  remove(TRACE_TEST_FILE);
+
+  PT_EXPECT(has_thread_name);
+  for (tid = 0; tid < TRACE_TEST_MAX_THREADS; tid++) {
+    PT_EXPECT(threads[tid].events <= trace_capacity);
+    PT_EXPECT(!threads[tid].in_task);
+  }
+  if (wrapped) {
+    PT_EXPECT(task_ends <= static_cast<unsigned int>(task_count));
+  } else {
+    /* every task began and ended exactly once */
+    PT_EXPECT_EQ(task_begins, static_cast<unsigned int>(task_count));
+    PT_EXPECT_EQ(task_ends, static_cast<unsigned int>(task_count));
+  }
+}
+
+void TraceTest::TestBasic() {
+  /* enough trace entries for all events, so none are dropped */
+  const mtapi_uint_t kTraceCapacity = 4096;
+  const int kTaskCount = 100;
+
+  embb_mtapi_log_info("running testTrace...\n");
+
+  RunTasks(kTraceCapacity, kTaskCount);
+  CheckTrace(kTraceCapacity, kTaskCount, false);
+}
+
+void TraceTest::TestWrap() {
+  /* more tasks than trace entries, so the ring buffers wrap */
+  const mtapi_uint_t kTraceCapacity = 16;
+  const int kTaskCount = 100;
+
+  embb_mtapi_log_info("running testTraceWrap...\n");
+
+  RunTasks(kTraceCapacity, kTaskCount);
+  CheckTrace(kTraceCapacity, kTaskCount, true);
+}
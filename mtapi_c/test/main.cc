@@ -37,6 +37,8 @@
 #include <embb_mtapi_test_group.h>
 #include <embb_mtapi_test_queue.h>
 #include <embb_mtapi_test_error.h>
+#include <embb_mtapi_test_trace.h>
+#include <embb_mtapi_test_scheduler.h>
 
 PT_MAIN("MTAPI C") {
   embb_log_set_log_level(EMBB_LOG_LEVEL_NONE);
@@ -48,4 +50,6 @@ PT_MAIN("MTAPI C") {
   PT_RUN(InitFinalizeTest);
   PT_RUN(GroupTest);
   PT_RUN(QueueTest);
+  PT_RUN(TraceTest);
+  PT_RUN(SchedulerTest);
 }
@@ -215,6 +215,77 @@ class NodeAttributes {
     return *this;
   }
 
+  /**
+   * Sets the number of scheduler events recorded per worker thread. A value
+   * of 0 disables tracing. The recorded events are written in Chrome trace
+   * format to the file set by SetTraceFile() when the Node is finalized.
+   *
+   * \returns Reference to this object.
+   * \notthreadsafe
+   */
+  NodeAttributes & SetTraceCapacity(
+    mtapi_uint_t value                 /**< The value to set. */
+    ) {
+    mtapi_status_t status;
+    mtapi_nodeattr_set(&attributes_, MTAPI_NODE_TRACE_CAPACITY,
+      &value, sizeof(value), &status);
+    internal::CheckStatus(status);
+    return *this;
+  }
+
+  /**
+   * Sets the name of the file the trace is written to. The string is not
+   * copied and needs to stay valid until the Node is finalized.
+   *
+   * \returns Reference to this object.
+   * \notthreadsafe
+   */
+  NodeAttributes & SetTraceFile(
+    const char * file_name             /**< The file name to use. */
+    ) {
+    mtapi_status_t status;
+    mtapi_nodeattr_set(&attributes_, MTAPI_NODE_TRACE_FILE,
+      &file_name, MTAPI_NODE_TRACE_FILE_SIZE, &status);
+    internal::CheckStatus(status);
+    return *this;
+  }
+
+  /**
+   * Sets the scheduling strategy used by the worker threads, one of
+   * MTAPI_NODE_SCHEDULER_VHPF, MTAPI_NODE_SCHEDULER_LF,
+   * MTAPI_NODE_SCHEDULER_HPF or MTAPI_NODE_SCHEDULER_EDF.
+   *
+   * \returns Reference to this object.
+   * \notthreadsafe
+   */
+  NodeAttributes & SetSchedulerMode(
+    mtapi_uint_t value                 /**< The value to set. */
+    ) {
+    mtapi_status_t status;
+    mtapi_nodeattr_set(&attributes_, MTAPI_NODE_SCHEDULER_MODE,
+      &value, sizeof(value), &status);
+    internal::CheckStatus(status);
+    return *this;
+  }
+
+  /**
+   * Sets the number of tasks a worker fetches in priority order before it
+   * serves the lowest pending priority once. A value of 0 disables aging.
+   * Only used by MTAPI_NODE_SCHEDULER_HPF.
+   *
+   * \returns Reference to this object.
+   * \notthreadsafe
+   */
+  NodeAttributes & SetPriorityAging(
+    mtapi_uint_t value                 /**< The value to set. */
+    ) {
+    mtapi_status_t status;
+    mtapi_nodeattr_set(&attributes_, MTAPI_NODE_PRIORITY_AGING,
+      &value, sizeof(value), &status);
+    internal::CheckStatus(status);
+    return *this;
+  }
+
   /**
    * Returns the internal representation of this object.
    * Allows for interoperability with the C interface.
@@ -85,6 +85,25 @@ class TaskAttributes {
     return *this;
   }
 
+  /**
+   * Sets the absolute deadline of a Task, e.g., obtained by embb_time_in().
+   * Nodes using MTAPI_NODE_SCHEDULER_EDF execute tasks with earlier
+   * deadlines first.
+   *
+   * \returns Reference to this object.
+   * \notthreadsafe
+   */
+  TaskAttributes & SetDeadline(
+    embb_time_t const & deadline       /**< The deadline to set. */
+    ) {
+    mtapi_status_t status;
+    mtapi_taskattr_set(&attributes_, MTAPI_TASK_DEADLINE,
+      const_cast<embb_time_t *>(&deadline), MTAPI_TASK_DEADLINE_SIZE,
+      &status);
+    internal::CheckStatus(status);
+    return *this;
+  }
+
   /**
    * Sets the number of instances in a Task.
    * The Task will be launched \c instances times. In the action function,
@@ -85,6 +85,52 @@ void mtapi_network_plugin_initialize(
                                             may be \c MTAPI_NULL */
 );
 
+/**
+ * Enables or disables the shared memory transport for network actions
+ * created afterwards.
+ *
+ * If enabled, which is the default, network actions whose remote node runs
+ * on the same host exchange tasks and results through a shared memory ring
+ * buffer instead of the TCP connection. The connection is still established
+ * and used to wake up the receiving side. If the remote node does not
+ * support shared memory, TCP is used.
+ *
+ * On success, \c *status is set to \c MTAPI_SUCCESS.
+ *
+ * \see mtapi_network_action_create()
+ *
+ * \notthreadsafe
+ * \ingroup C_MTAPI_NETWORK
+ */
+void mtapi_network_plugin_set_shared_memory(
+  MTAPI_IN mtapi_boolean_t enable,     /**< [in] \c MTAPI_TRUE to use shared
+                                            memory for local peers */
+  MTAPI_OUT mtapi_status_t* status     /**< [out] Pointer to error code,
+                                            may be \c MTAPI_NULL */
+);
+
+/**
+ * Sets how many tasks a remote node may have in flight on each connection
+ * accepted afterwards.
+ *
+ * The credits are granted to the remote node when it connects, each result
+ * sent back returns one credit. A remote node that runs out of credits waits
+ * in mtapi_task_start() until results come in, instead of exhausting the
+ * local task pool. The default of 0 divides the \c MTAPI_NODE_MAX_TASKS
+ * attribute of the local node among the possible connections.
+ *
+ * On success, \c *status is set to \c MTAPI_SUCCESS.
+ *
+ * \notthreadsafe
+ * \ingroup C_MTAPI_NETWORK
+ */
+void mtapi_network_plugin_set_credits(
+  MTAPI_IN mtapi_uint_t credits,       /**< [in] Tasks per connection, 0 for
+                                            the default */
+  MTAPI_OUT mtapi_status_t* status     /**< [out] Pointer to error code,
+                                            may be \c MTAPI_NULL */
+);
+
 /**
  * Finalizes the MTAPI network environment on the local MTAPI node.
  *
@@ -200,6 +246,66 @@ mtapi_action_hndl_t mtapi_network_action_create(
 );
 
 
+/** Sends tasks to the peers in turn. */
+#define MTAPI_NETWORK_DISPATCH_ROUND_ROBIN 0
+/** Sends each task to the peer with the fewest tasks in flight. */
+#define MTAPI_NETWORK_DISPATCH_LEAST_OUTSTANDING 1
+/** Sends each task to the peer expected to finish it first, based on the
+    tasks in flight and the measured round trip time of each peer. */
+#define MTAPI_NETWORK_DISPATCH_LATENCY_WEIGHTED 2
+
+/**
+ * This function creates a network action that is served by several remote
+ * nodes.
+ *
+ * It works like mtapi_network_action_create(), but connects to all given
+ * peers. Each task started through the action is sent to one of them as
+ * selected by \c dispatch, one of \c MTAPI_NETWORK_DISPATCH_ROUND_ROBIN,
+ * \c MTAPI_NETWORK_DISPATCH_LEAST_OUTSTANDING or
+ * \c MTAPI_NETWORK_DISPATCH_LATENCY_WEIGHTED. All peers have to implement
+ * the remote job.
+ *
+ * If \c max_tasks_per_peer is not 0, no peer gets more tasks in flight than
+ * that. Starting a task blocks while all peers are at their limit, worker
+ * threads execute other tasks in the meantime. Peers that closed their
+ * connection do not get new tasks.
+ *
+ * On success, an action handle is returned and \c *status is set to
+ * \c MTAPI_SUCCESS. On error, \c *status is set to the appropriate error
+ * defined below.
+ * Error code                    | Description
+ * ----------------------------- | --------------------------------------------
+ * \c MTAPI_ERR_PARAMETER        | No peers or an unknown \c dispatch value.
+ * \c MTAPI_ERR_NODE_NOTINIT     | The calling node is not initialized.
+ * \c MTAPI_ERR_UNKNOWN          | One of the peers could not be reached.
+ *
+ * \see mtapi_network_action_create(), mtapi_action_delete()
+ *
+ * \returns Handle to newly created network action, invalid handle on error
+ * \threadsafe
+ * \ingroup C_MTAPI_NETWORK
+ */
+mtapi_action_hndl_t mtapi_network_action_create_balanced(
+  MTAPI_IN mtapi_domain_t domain_id,   /**< [in] The domain the action is
+                                            associated with */
+  MTAPI_IN mtapi_job_id_t local_job_id,
+                                       /**< [in] The ID of the local job */
+  MTAPI_IN mtapi_job_id_t remote_job_id,
+                                       /**< [in] The ID of the remote job */
+  MTAPI_IN char ** hosts,              /**< [in] The hosts to connect to, the
+                                            strings need to stay valid
+                                            while the action exists */
+  MTAPI_IN mtapi_uint16_t * ports,     /**< [in] The ports the hosts are
+                                            listening on */
+  MTAPI_IN mtapi_uint_t num_peers,     /**< [in] Number of hosts and ports */
+  MTAPI_IN mtapi_uint_t dispatch,      /**< [in] How tasks are distributed */
+  MTAPI_IN mtapi_uint_t max_tasks_per_peer,
+                                       /**< [in] Limit of tasks in flight per
+                                            peer, 0 for no limit */
+  MTAPI_OUT mtapi_status_t* status     /**< [out] Pointer to error code,
+                                            may be \c MTAPI_NULL */
+);
+
 #ifdef __cplusplus
 }
 #endif
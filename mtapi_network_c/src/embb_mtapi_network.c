@@ -33,17 +33,22 @@
 #include <embb/base/c/thread.h>
 #include <embb/base/c/atomic.h>
 #include <embb/base/c/mutex.h>
+#include <embb/base/c/time.h>
 #include <embb/base/c/internal/unused.h>
 #include <embb_mtapi_network_socket.h>
+#include <embb_mtapi_network_poller.h>
+#include <embb_mtapi_network_shm.h>
 #include <embb_mtapi_network.h>
 
 #include <embb_mtapi_task_t.h>
 #include <embb_mtapi_action_t.h>
 #include <embb_mtapi_node_t.h>
 #include <embb_mtapi_group_t.h>
+#include <embb_mtapi_scheduler_t.h>
 #include <mtapi_status_t.h>
 
 #include <assert.h>
+#include <string.h>
 
 int embb_mtapi_network_initialize() {
 #ifdef _WIN32
@@ -72,52 +77,567 @@ void embb_mtapi_network_finalize() {
 
 enum embb_mtapi_network_operation_enum {
   EMBB_MTAPI_NETWORK_START_TASK,
-  EMBB_MTAPI_NETWORK_RETURN_RESULT
+  EMBB_MTAPI_NETWORK_RETURN_RESULT,
+  EMBB_MTAPI_NETWORK_ATTACH_SHM,
+  EMBB_MTAPI_NETWORK_CREDIT
 };
 
+// header sizes following the operation byte, the last header field is
+// the size of the payload that follows
+#define EMBB_MTAPI_NETWORK_START_TASK_HEADER_SIZE 28
+#define EMBB_MTAPI_NETWORK_RETURN_RESULT_HEADER_SIZE 16
+#define EMBB_MTAPI_NETWORK_ATTACH_SHM_HEADER_SIZE 4
+#define EMBB_MTAPI_NETWORK_CREDIT_HEADER_SIZE 4
+
+// a peer announces how many tasks it accepts on a connection right after
+// accepting it, each result returns one credit
+#define EMBB_MTAPI_NETWORK_CREDIT_TIMEOUT 1000
+#define EMBB_MTAPI_NETWORK_UNLIMITED_CREDITS 0x3fffffff
+
+// maximum number of ready connections handled per poller wakeup
+#define EMBB_MTAPI_NETWORK_MAX_EVENTS 64
+
+// maximum number of messages waiting to be sent on a connection
+#define EMBB_MTAPI_NETWORK_SEND_QUEUE_SIZE 32
+
+// bytes read ahead on a connection, larger payloads are mostly received
+// directly into their final location
+#define EMBB_MTAPI_NETWORK_READ_AHEAD_SIZE 1024
+
+// task blocks are recycled in power of two size classes starting at
+// 1 << EMBB_MTAPI_NETWORK_POOL_MIN_SHIFT bytes, at most
+// EMBB_MTAPI_NETWORK_POOL_DEPTH blocks per class and connection are kept
+#define EMBB_MTAPI_NETWORK_POOL_MIN_SHIFT 8
+#define EMBB_MTAPI_NETWORK_POOL_CLASSES 10
+#define EMBB_MTAPI_NETWORK_POOL_DEPTH 16
+
+// a connection slot is free, holds a connection or waits until the network
+// thread reclaims it
+#define EMBB_MTAPI_NETWORK_SLOT_FREE 0
+#define EMBB_MTAPI_NETWORK_SLOT_USED 1
+#define EMBB_MTAPI_NETWORK_SLOT_RETIRED 2
+
+#define EMBB_MTAPI_NETWORK_ALIGN(size) \
+  (((size_t)(size) + 15) & ~(size_t)15)
+
+typedef struct embb_mtapi_network_connection_struct
+  embb_mtapi_network_connection_t;
+
+// A task received from a remote node. Results and arguments are stored
+// behind this header in the same block.
+struct embb_mtapi_network_task_struct {
+  embb_mtapi_network_connection_t * connection;
+  int32_t remote_task_id;
+  int32_t remote_task_tag;
+  int32_t domain_id;
+  int32_t job_id;
+  int32_t priority;
+  int32_t results_size;
+  int32_t arguments_size;
+  // size class of the block, -1 if it is not pooled
+  int size_class;
+  struct embb_mtapi_network_task_struct * next;
+};
+
+typedef struct embb_mtapi_network_task_struct embb_mtapi_network_task_t;
+
+struct embb_mtapi_network_message_struct {
+  // operation and header, serialized
+  char header[1 + EMBB_MTAPI_NETWORK_START_TASK_HEADER_SIZE];
+  int header_size;
+  // payload is sent from where it is, not copied
+  void const * payload;
+  int payload_size;
+  // released once the message was sent, may be NULL
+  embb_mtapi_network_task_t * release;
+  // local task started by the message, failed if it cannot be sent
+  embb_mtapi_task_t * task;
+};
+
+typedef struct embb_mtapi_network_message_struct embb_mtapi_network_message_t;
+
+struct embb_mtapi_network_connection_struct {
+  // one of EMBB_MTAPI_NETWORK_SLOT_*, set to used only once the connection
+  // is initialized
+  embb_atomic_int slot_state;
+  // next free slot, -1 for none
+  int next_free;
+  // held by the plugin for accepted connections, by the network action for
+  // outgoing connections and by each task block taken from the connection,
+  // the slot is retired once the last one is given back
+  embb_atomic_int references;
+  embb_mtapi_network_socket_t socket;
+  // partially received messages are accumulated here
+  embb_mtapi_network_buffer_t buffer;
+  // accepted connections are owned and closed by the plugin,
+  // outgoing connections by their network action
+  int owned;
+  // set once the peer went away
+  embb_atomic_int closed;
+  // tasks the peer still accepts on this connection
+  embb_atomic_int credits;
+  // tasks sent on an outgoing connection whose result did not arrive yet,
+  // indexed by the id of the local task, see embb_mtapi_network_task_mark
+  embb_atomic_int * outstanding;
+  mtapi_uint_t max_tasks;
+
+  // messages go through shared memory if both ends are on the same host,
+  // the socket then only carries wake up bytes
+  int shared;
+  embb_mtapi_network_shm_t shm;
+  char shm_name[EMBB_MTAPI_NETWORK_SHM_NAME_SIZE];
+
+  // outgoing messages, sent in batches by whichever producer finds the
+  // connection idle
+  embb_adaptive_mutex_t send_mutex;
+  embb_mtapi_network_message_t send_queue[EMBB_MTAPI_NETWORK_SEND_QUEUE_SIZE];
+  int send_head;
+  int send_count;
+  int sending;
+
+  // recycled task blocks, one free list per size class
+  embb_mutex_t pool_mutex;
+  embb_mtapi_network_task_t * pool[EMBB_MTAPI_NETWORK_POOL_CLASSES];
+  int pool_count[EMBB_MTAPI_NETWORK_POOL_CLASSES];
+
+  // payload of the message currently received, NULL while it is skipped
+  int payload_pending;
+  int payload_operation;
+  char * payload;
+  int payload_remaining;
+  embb_mtapi_network_task_t * payload_task;
+  embb_mtapi_task_t * payload_result_task;
+  mtapi_status_t payload_status;
+};
+
+static char * embb_mtapi_network_task_results(
+  embb_mtapi_network_task_t * that) {
+  return (char*)that +
+    EMBB_MTAPI_NETWORK_ALIGN(sizeof(embb_mtapi_network_task_t));
+}
+
+static char * embb_mtapi_network_task_arguments(
+  embb_mtapi_network_task_t * that) {
+  return embb_mtapi_network_task_results(that) +
+    EMBB_MTAPI_NETWORK_ALIGN(that->results_size);
+}
+
+static void embb_mtapi_network_connection_release(
+  embb_mtapi_network_connection_t * that);
+
+static embb_mtapi_network_task_t * embb_mtapi_network_task_allocate(
+  embb_mtapi_network_connection_t * connection,
+  int32_t results_size,
+  int32_t arguments_size) {
+  embb_mtapi_network_task_t * task = NULL;
+  size_t size = EMBB_MTAPI_NETWORK_ALIGN(sizeof(embb_mtapi_network_task_t)) +
+    EMBB_MTAPI_NETWORK_ALIGN(results_size) +
+    EMBB_MTAPI_NETWORK_ALIGN(arguments_size);
+  int size_class = 0;
+
+  while (size_class < EMBB_MTAPI_NETWORK_POOL_CLASSES &&
+    ((size_t)1 << (EMBB_MTAPI_NETWORK_POOL_MIN_SHIFT + size_class)) < size) {
+    size_class++;
+  }
+  if (size_class < EMBB_MTAPI_NETWORK_POOL_CLASSES) {
+    embb_mutex_lock(&connection->pool_mutex);
+    task = connection->pool[size_class];
+    if (NULL != task) {
+      connection->pool[size_class] = task->next;
+      connection->pool_count[size_class]--;
+    }
+    embb_mutex_unlock(&connection->pool_mutex);
+    if (NULL == task) {
+      task = (embb_mtapi_network_task_t*)embb_alloc(
+        (size_t)1 << (EMBB_MTAPI_NETWORK_POOL_MIN_SHIFT + size_class));
+    }
+  } else {
+    size_class = -1;
+    task = (embb_mtapi_network_task_t*)embb_alloc(size);
+  }
+
+  if (NULL != task) {
+    embb_atomic_fetch_and_add_int(&connection->references, 1);
+    task->connection = connection;
+    task->results_size = results_size;
+    task->arguments_size = arguments_size;
+    task->size_class = size_class;
+    task->next = NULL;
+  }
+  return task;
+}
+
+static void embb_mtapi_network_task_release(
+  embb_mtapi_network_task_t * that) {
+  embb_mtapi_network_connection_t * connection = that->connection;
+  int size_class = that->size_class;
+
+  if (0 <= size_class) {
+    embb_mutex_lock(&connection->pool_mutex);
+    if (connection->pool_count[size_class] < EMBB_MTAPI_NETWORK_POOL_DEPTH) {
+      that->next = connection->pool[size_class];
+      connection->pool[size_class] = that;
+      connection->pool_count[size_class]++;
+      that = NULL;
+    }
+    embb_mutex_unlock(&connection->pool_mutex);
+  }
+  if (NULL != that) {
+    embb_free(that);
+  }
+  embb_mtapi_network_connection_release(connection);
+}
+
+static void embb_mtapi_network_message_initialize(
+  embb_mtapi_network_message_t * that,
+  embb_mtapi_network_buffer_t * header) {
+  // the header is serialized into storage inside the message
+  header->data = that->header;
+  header->capacity = (int)sizeof(that->header);
+  header->size = 0;
+  header->position = 0;
+  that->header_size = 0;
+  that->payload = NULL;
+  that->payload_size = 0;
+  that->release = NULL;
+  that->task = NULL;
+}
+
+// Value stored for a task outstanding on a connection, never 0.
+static int embb_mtapi_network_task_mark(
+  embb_mtapi_task_t const * local_task) {
+  return (int)(local_task->handle.tag % 0x7fffffffu) + 1;
+}
+
+// Takes a task sent on the connection back. Returns 0 if its result was
+// handled or it was failed already.
+static int embb_mtapi_network_connection_claim(
+  embb_mtapi_network_connection_t * that,
+  embb_mtapi_task_t * local_task) {
+  int expected = embb_mtapi_network_task_mark(local_task);
+  return embb_atomic_compare_and_swap_int(
+    &that->outstanding[local_task->handle.id], &expected, 0);
+}
+
+static void embb_mtapi_network_complete_result(
+  embb_mtapi_task_t * local_task,
+  mtapi_task_state_t task_state,
+  mtapi_status_t task_status);
+
+// Completes a task sent on the connection with an error, unless that
+// happened already, and gives back its credit.
+static void embb_mtapi_network_connection_fail_task(
+  embb_mtapi_network_connection_t * that,
+  embb_mtapi_task_t * local_task) {
+  if (embb_mtapi_network_connection_claim(that, local_task)) {
+    embb_atomic_fetch_and_add_int(&that->credits, 1);
+    embb_mtapi_network_complete_result(
+      local_task, MTAPI_TASK_ERROR, MTAPI_ERR_ACTION_FAILED);
+  }
+}
+
+// Handles messages that will never be sent.
+static void embb_mtapi_network_connection_drop(
+  embb_mtapi_network_connection_t * that,
+  embb_mtapi_network_message_t const * messages,
+  int count) {
+  int ii;
+  for (ii = 0; ii < count; ii++) {
+    if (NULL != messages[ii].task) {
+      embb_mtapi_network_connection_fail_task(that, messages[ii].task);
+    }
+    if (NULL != messages[ii].release) {
+      embb_mtapi_network_task_release(messages[ii].release);
+    }
+  }
+}
+
+static void embb_mtapi_network_connection_send(
+  embb_mtapi_network_connection_t * that,
+  embb_mtapi_network_message_t const * message) {
+  embb_mtapi_network_message_t batch[EMBB_MTAPI_NETWORK_SEND_QUEUE_SIZE];
+  embb_mtapi_network_iovec_t iov[EMBB_MTAPI_NETWORK_SEND_QUEUE_SIZE * 2];
+  int num;
+  int ii;
+  int err;
+
+  embb_adaptive_mutex_lock(&that->send_mutex);
+  if (embb_atomic_load_int(&that->closed)) {
+    // the socket may be gone already
+    embb_adaptive_mutex_unlock(&that->send_mutex);
+    embb_mtapi_network_connection_drop(that, message, 1);
+    return;
+  }
+  while (EMBB_MTAPI_NETWORK_SEND_QUEUE_SIZE == that->send_count) {
+    // queue is full, the current sender is draining it
+    embb_adaptive_mutex_unlock(&that->send_mutex);
+    embb_thread_yield();
+    embb_adaptive_mutex_lock(&that->send_mutex);
+  }
+  that->send_queue[(that->send_head + that->send_count) %
+    EMBB_MTAPI_NETWORK_SEND_QUEUE_SIZE] = *message;
+  that->send_count++;
+  if (that->sending) {
+    // someone else is sending and will pick up the message
+    embb_adaptive_mutex_unlock(&that->send_mutex);
+    return;
+  }
+
+  that->sending = 1;
+  while (0 < that->send_count) {
+    // take all queued messages and send them with a single call
+    num = that->send_count;
+    for (ii = 0; ii < num; ii++) {
+      batch[ii] = that->send_queue[(that->send_head + ii) %
+        EMBB_MTAPI_NETWORK_SEND_QUEUE_SIZE];
+    }
+    that->send_head = (that->send_head + num) %
+      EMBB_MTAPI_NETWORK_SEND_QUEUE_SIZE;
+    that->send_count = 0;
+    if (embb_atomic_load_int(&that->closed)) {
+      // closing waits for this sender, so the socket is still there, but
+      // the peer is not
+      embb_adaptive_mutex_unlock(&that->send_mutex);
+      embb_mtapi_network_connection_drop(that, batch, num);
+      embb_adaptive_mutex_lock(&that->send_mutex);
+      continue;
+    }
+    embb_adaptive_mutex_unlock(&that->send_mutex);
+
+    for (ii = 0; ii < num; ii++) {
+      iov[ii * 2].data = batch[ii].header;
+      iov[ii * 2].size = batch[ii].header_size;
+      iov[ii * 2 + 1].data = batch[ii].payload;
+      iov[ii * 2 + 1].size = batch[ii].payload_size;
+    }
+    if (that->shared) {
+      err = embb_mtapi_network_shm_writev(&that->shm, iov, num * 2);
+    } else {
+      err = embb_mtapi_network_socket_sendv(&that->socket, iov, num * 2);
+    }
+    if (0 == err) {
+      // the peer cannot be reached anymore, the network thread notices the
+      // shut down socket, closes the connection and fails the tasks sent
+      // on it earlier
+      embb_atomic_store_int(&that->closed, 1);
+      embb_mtapi_network_socket_shutdown(&that->socket);
+      embb_mtapi_network_connection_drop(that, batch, num);
+    } else {
+      for (ii = 0; ii < num; ii++) {
+        if (NULL != batch[ii].release) {
+          embb_mtapi_network_task_release(batch[ii].release);
+        }
+      }
+    }
+
+    embb_adaptive_mutex_lock(&that->send_mutex);
+  }
+  that->sending = 0;
+  embb_adaptive_mutex_unlock(&that->send_mutex);
+}
+
 struct embb_mtapi_network_plugin_struct {
   embb_thread_t thread;
-  embb_mtapi_network_socket_t *sockets; // sockets[0] is the listening socket
-  int socket_count;
+  embb_mtapi_network_socket_t listen_socket;
+  embb_mtapi_network_poller_t poller;
+  embb_mtapi_network_connection_t * connections;
+  int connection_capacity;
+  // first free slot, -1 for none
+  embb_mutex_t slot_mutex;
+  int free_slot;
+  // slots waiting to be reclaimed
+  embb_atomic_int retired;
   embb_atomic_int run;
   mtapi_size_t buffer_size;
-
-  embb_mutex_t send_mutex;
-  embb_mtapi_network_buffer_t send_buffer;
+  // try shared memory for peers on the same host
+  int shared_memory;
+  // tasks accepted per incoming connection, 0 to share the task pool
+  int credits;
 };
 
 typedef struct embb_mtapi_network_plugin_struct embb_mtapi_network_plugin_t;
 
+static int embb_mtapi_network_elapsed_microseconds(
+  embb_time_t const * since) {
+  embb_time_t now;
+  long long elapsed;
+  embb_time_now(&now);
+  elapsed = (long long)(now.seconds - since->seconds) * 1000000 +
+    ((long long)now.nanoseconds - (long long)since->nanoseconds) / 1000;
+  if (elapsed < 0) {
+    return 0;
+  } else if (elapsed > 0x7fffffff) {
+    return 0x7fffffff;
+  } else {
+    return (int)elapsed;
+  }
+}
+
 static embb_mtapi_network_plugin_t embb_mtapi_network_plugin;
 
-struct embb_mtapi_network_action_struct {
-  mtapi_domain_t domain_id;
-  mtapi_job_id_t job_id;
+static void embb_mtapi_network_connection_release(
+  embb_mtapi_network_connection_t * that) {
+  if (1 == embb_atomic_fetch_and_add_int(&that->references, -1)) {
+    // the network thread reclaims the slot between two poller waits, so no
+    // event it still handles refers to a new connection
+    embb_atomic_store_int(&that->slot_state,
+      EMBB_MTAPI_NETWORK_SLOT_RETIRED);
+    embb_atomic_fetch_and_add_int(&embb_mtapi_network_plugin.retired, 1);
+  }
+}
+
+// Releases everything held by an initialized connection slot.
+static void embb_mtapi_network_connection_finalize(
+  embb_mtapi_network_connection_t * that) {
+  int ii;
+  // a worker may still be draining the send queue
+  embb_adaptive_mutex_lock(&that->send_mutex);
+  while (that->sending) {
+    embb_adaptive_mutex_unlock(&that->send_mutex);
+    embb_thread_yield();
+    embb_adaptive_mutex_lock(&that->send_mutex);
+  }
+  embb_adaptive_mutex_unlock(&that->send_mutex);
+  if (NULL != that->payload_task) {
+    embb_mtapi_network_task_release(that->payload_task);
+    that->payload_task = NULL;
+  }
+  if (that->shared) {
+    embb_mtapi_network_shm_finalize(&that->shm);
+  }
+  if (that->owned) {
+    embb_mtapi_network_socket_finalize(&that->socket);
+  }
+  embb_mtapi_network_buffer_finalize(&that->buffer);
+  if (NULL != that->outstanding) {
+    embb_free(that->outstanding);
+  }
+  embb_adaptive_mutex_destroy(&that->send_mutex);
+  for (ii = 0; ii < EMBB_MTAPI_NETWORK_POOL_CLASSES; ii++) {
+    while (NULL != that->pool[ii]) {
+      embb_mtapi_network_task_t * block = that->pool[ii];
+      that->pool[ii] = block->next;
+      embb_free(block);
+    }
+  }
+  embb_mutex_destroy(&that->pool_mutex);
+}
+
+static void embb_mtapi_network_free_slot(
+  embb_mtapi_network_plugin_t * plugin,
+  embb_mtapi_network_connection_t * connection) {
+  embb_atomic_store_int(&connection->slot_state,
+    EMBB_MTAPI_NETWORK_SLOT_FREE);
+  embb_mutex_lock(&plugin->slot_mutex);
+  connection->next_free = plugin->free_slot;
+  plugin->free_slot = (int)(connection - plugin->connections);
+  embb_mutex_unlock(&plugin->slot_mutex);
+}
+
+// Makes the slots of connections that are gone available again, only
+// called by the network thread.
+static void embb_mtapi_network_reclaim_connections(
+  embb_mtapi_network_plugin_t * plugin) {
+  int ii;
+  for (ii = 0; ii < plugin->connection_capacity; ii++) {
+    embb_mtapi_network_connection_t * connection = &plugin->connections[ii];
+    if (EMBB_MTAPI_NETWORK_SLOT_RETIRED ==
+      embb_atomic_load_int(&connection->slot_state)) {
+      embb_atomic_fetch_and_add_int(&plugin->retired, -1);
+      embb_mtapi_network_connection_finalize(connection);
+      embb_mtapi_network_free_slot(plugin, connection);
+    }
+  }
+}
 
+// A remote node serving a network action.
+struct embb_mtapi_network_peer_struct {
   char const * host;
   mtapi_uint16_t port;
   embb_mtapi_network_socket_t socket;
+  embb_mtapi_network_connection_t * connection;
+  // tasks sent to this peer that did not return yet
+  embb_atomic_int in_flight;
+  // smoothed round trip time in microseconds, 0 until the first result
+  embb_atomic_int latency;
+};
+
+typedef struct embb_mtapi_network_peer_struct embb_mtapi_network_peer_t;
 
-  embb_mutex_t send_mutex;
-  embb_mtapi_network_buffer_t send_buffer;
+// Where and when a task was sent to.
+struct embb_mtapi_network_dispatch_struct {
+  embb_mtapi_network_peer_t * peer;
+  embb_time_t sent;
 };
 
-typedef struct embb_mtapi_network_action_struct embb_mtapi_network_action_t;
+typedef struct embb_mtapi_network_dispatch_struct
+  embb_mtapi_network_dispatch_t;
 
-struct embb_mtapi_network_task_struct {
-  embb_mtapi_network_socket_t socket;
-  int32_t remote_task_id;
-  int32_t remote_task_tag;
+struct embb_mtapi_network_action_struct {
+  mtapi_domain_t domain_id;
+  mtapi_job_id_t job_id;
+
+  embb_mtapi_network_peer_t * peers;
+  int num_peers;
+  mtapi_uint_t dispatch;
+  // maximum number of tasks in flight per peer, 0 for no limit
+  int max_in_flight;
+  embb_atomic_int next_peer;
+
+  // indexed by the id of the local task
+  embb_mtapi_network_dispatch_t * dispatched;
+  mtapi_uint_t max_tasks;
 };
 
-typedef struct embb_mtapi_network_task_struct embb_mtapi_network_task_t;
+typedef struct embb_mtapi_network_action_struct embb_mtapi_network_action_t;
+
+// Sends the result of a task received from a remote node, which also
+// gives the peer back the credit of the task. The task block is released
+// once the result was sent.
+static void embb_mtapi_network_return_result(
+  embb_mtapi_network_task_t * network_task,
+  mtapi_status_t task_status,
+  void const * results,
+  mtapi_size_t results_size) {
+  embb_mtapi_network_message_t message;
+  embb_mtapi_network_buffer_t header;
+  int err;
+  EMBB_UNUSED_IN_RELEASE(err);
+
+  embb_mtapi_network_message_initialize(&message, &header);
+
+  // operation is "return result"
+  err = embb_mtapi_network_buffer_push_back_int8(
+    &header, EMBB_MTAPI_NETWORK_RETURN_RESULT);
+  assert(err == 1);
+  // remote task id
+  err = embb_mtapi_network_buffer_push_back_int32(
+    &header, network_task->remote_task_id);
+  assert(err == 4);
+  err = embb_mtapi_network_buffer_push_back_int32(
+    &header, network_task->remote_task_tag);
+  assert(err == 4);
+  // status
+  err = embb_mtapi_network_buffer_push_back_int32(&header, task_status);
+  assert(err == 4);
+  // result size
+  err = embb_mtapi_network_buffer_push_back_int32(
+    &header, (int32_t)results_size);
+  assert(err == 4);
+  message.header_size = header.size;
+  message.payload = results;
+  message.payload_size = (int)results_size;
+  // results and arguments live in the task block, which is recycled
+  // once the results were sent
+  message.release = network_task;
+
+  embb_mtapi_network_connection_send(network_task->connection, &message);
+}
 
 static void embb_mtapi_network_task_complete(
   MTAPI_IN mtapi_task_hndl_t task,
   MTAPI_OUT mtapi_status_t* status) {
   mtapi_status_t local_status = MTAPI_ERR_UNKNOWN;
-  int err;
-  EMBB_UNUSED_IN_RELEASE(err);
 
   if (embb_mtapi_node_is_initialized()) {
     embb_mtapi_node_t * node = embb_mtapi_node_get_instance();
@@ -133,269 +653,660 @@ static void embb_mtapi_network_task_complete(
           embb_mtapi_action_pool_get_storage_for_handle(
           node->action_pool, local_task->action);*/
 
-        embb_mtapi_network_plugin_t * plugin = &embb_mtapi_network_plugin;
-        embb_mtapi_network_task_t * network_task =
-          (embb_mtapi_network_task_t*)local_task->attributes.user_data;
-        embb_mtapi_network_buffer_t * send_buf = &plugin->send_buffer;
+        embb_mtapi_network_return_result(
+          (embb_mtapi_network_task_t*)local_task->attributes.user_data,
+          local_task->error_code,
+          local_task->result_buffer, local_task->result_size);
 
-        // serialize sending of results
-        embb_mutex_lock(&plugin->send_mutex);
-        embb_mtapi_network_buffer_clear(send_buf);
+        local_status = MTAPI_SUCCESS;
+      }
+    }
+  }
 
-        // operation is "return result"
-        err = embb_mtapi_network_buffer_push_back_int8(
-          send_buf, EMBB_MTAPI_NETWORK_RETURN_RESULT);
-        assert(err == 1);
-        // remote task id
-        err = embb_mtapi_network_buffer_push_back_int32(
-          send_buf, network_task->remote_task_id);
-        assert(err == 4);
-        err = embb_mtapi_network_buffer_push_back_int32(
-          send_buf, network_task->remote_task_tag);
-        assert(err == 4);
-        // status
-        err = embb_mtapi_network_buffer_push_back_int32(
-          send_buf, local_task->error_code);
-        assert(err == 4);
-        // result size
-        err = embb_mtapi_network_buffer_push_back_int32(
-          send_buf, (int32_t)local_task->result_size);
-        assert(err == 4);
-        err = embb_mtapi_network_buffer_push_back_rawdata(
-          send_buf, (int32_t)local_task->result_size, local_task->result_buffer);
-        assert(err == (int)local_task->result_size);
+  mtapi_status_set(status, local_status);
+}
 
-        err = embb_mtapi_network_socket_sendbuffer(
-          &network_task->socket, send_buf);
-        assert(err == send_buf->size);
+// Takes over the shared memory segment if one is given, the socket is
+// left to the caller on failure.
+static embb_mtapi_network_connection_t * embb_mtapi_network_add_connection(
+  embb_mtapi_network_plugin_t * plugin,
+  embb_mtapi_network_socket_t * socket,
+  embb_mtapi_network_shm_t * shm,
+  int owned) {
+  embb_mtapi_network_connection_t * connection;
+  int read_ahead;
+  int ii;
+  embb_mutex_lock(&plugin->slot_mutex);
+  ii = plugin->free_slot;
+  if (0 <= ii) {
+    plugin->free_slot = plugin->connections[ii].next_free;
+  }
+  embb_mutex_unlock(&plugin->slot_mutex);
+  if (0 > ii) {
+    if (NULL != shm) {
+      embb_mtapi_network_shm_finalize(shm);
+    }
+    return NULL;
+  }
+  // the slot stays free for everyone else until it is fully initialized
+  connection = &plugin->connections[ii];
+  embb_atomic_store_int(&connection->references, 1);
+  connection->socket = *socket;
+  connection->owned = owned;
+  embb_atomic_store_int(&connection->closed, 0);
+  embb_atomic_store_int(&connection->credits, 0);
+  connection->shared = (NULL != shm);
+  if (NULL != shm) {
+    connection->shm = *shm;
+    connection->shm.socket = &connection->socket;
+    connection->shm.closed = &connection->closed;
+  }
+  embb_adaptive_mutex_init(&connection->send_mutex);
+  connection->send_head = 0;
+  connection->send_count = 0;
+  connection->sending = 0;
+  embb_mutex_init(&connection->pool_mutex, EMBB_MUTEX_PLAIN);
+  for (ii = 0; ii < EMBB_MTAPI_NETWORK_POOL_CLASSES; ii++) {
+    connection->pool[ii] = NULL;
+    connection->pool_count[ii] = 0;
+  }
+  connection->payload_pending = 0;
+  connection->payload = NULL;
+  connection->payload_remaining = 0;
+  connection->payload_task = NULL;
+  connection->payload_result_task = NULL;
+  // room for at least one header
+  read_ahead = (int)plugin->buffer_size;
+  if (read_ahead > EMBB_MTAPI_NETWORK_READ_AHEAD_SIZE) {
+    read_ahead = EMBB_MTAPI_NETWORK_READ_AHEAD_SIZE;
+  }
+  embb_mtapi_network_buffer_initialize(&connection->buffer,
+    read_ahead + 1 + EMBB_MTAPI_NETWORK_START_TASK_HEADER_SIZE);
+  // tasks are only sent on outgoing connections
+  connection->max_tasks = embb_mtapi_node_get_instance()->attributes.max_tasks;
+  connection->outstanding = NULL;
+  if (!owned) {
+    connection->outstanding = (embb_atomic_int*)embb_alloc(
+      sizeof(embb_atomic_int) * (connection->max_tasks + 1));
+    if (NULL != connection->outstanding) {
+      for (ii = 0; ii <= (int)connection->max_tasks; ii++) {
+        embb_atomic_store_int(&connection->outstanding[ii], 0);
+      }
+    }
+  }
+  if ((!owned && NULL == connection->outstanding) ||
+    0 == embb_mtapi_network_socket_set_nonblocking(socket) ||
+    0 == embb_mtapi_network_poller_add(&plugin->poller, socket, connection)) {
+    // the socket is left to the caller
+    connection->owned = 0;
+    embb_mtapi_network_connection_finalize(connection);
+    embb_mtapi_network_free_slot(plugin, connection);
+    return NULL;
+  }
+  embb_atomic_store_int(&connection->slot_state,
+    EMBB_MTAPI_NETWORK_SLOT_USED);
+  return connection;
+}
 
-        // sending done
-        embb_mutex_unlock(&plugin->send_mutex);
+// Fails all tasks whose results will not arrive on the connection anymore.
+static void embb_mtapi_network_fail_outstanding(
+  embb_mtapi_network_connection_t * connection) {
+  embb_mtapi_node_t * node = embb_mtapi_node_get_instance();
+  mtapi_uint_t ii;
 
-        // we allocated arguments and results on receive, so free them here
-        embb_free((void*)local_task->arguments);
-        embb_free(local_task->result_buffer);
+  if (NULL == connection->outstanding) {
+    return;
+  }
+  for (ii = 1; ii <= connection->max_tasks; ii++) {
+    if (0 != embb_atomic_load_int(&connection->outstanding[ii])) {
+      // the task cannot be deleted before it completes
+      embb_mtapi_network_connection_fail_task(
+        connection, &node->task_pool->storage[ii]);
+    }
+  }
+}
 
-        local_status = MTAPI_SUCCESS;
+static void embb_mtapi_network_close_connection(
+  embb_mtapi_network_plugin_t * plugin,
+  embb_mtapi_network_connection_t * connection) {
+  int owned = connection->owned;
+  embb_mtapi_network_poller_remove(&plugin->poller, &connection->socket);
+  // no new tasks are sent to this peer, a sender still writing to the
+  // socket is waited for before the socket goes away
+  embb_adaptive_mutex_lock(&connection->send_mutex);
+  embb_atomic_store_int(&connection->closed, 1);
+  while (connection->sending) {
+    embb_adaptive_mutex_unlock(&connection->send_mutex);
+    embb_thread_yield();
+    embb_adaptive_mutex_lock(&connection->send_mutex);
+  }
+  if (connection->owned) {
+    embb_mtapi_network_socket_finalize(&connection->socket);
+    connection->owned = 0;
+  }
+  embb_adaptive_mutex_unlock(&connection->send_mutex);
+  // tasks sent and not yet answered will never complete otherwise
+  embb_mtapi_network_fail_outstanding(connection);
+  embb_mtapi_network_buffer_clear(&connection->buffer);
+  // drop a partially received task
+  if (NULL != connection->payload_task) {
+    embb_mtapi_network_task_release(connection->payload_task);
+    connection->payload_task = NULL;
+  }
+  connection->payload_pending = 0;
+  if (owned) {
+    // outgoing connections are given back by their network action
+    embb_mtapi_network_connection_release(connection);
+  }
+}
+
+static void embb_mtapi_network_start_task(
+  embb_mtapi_network_task_t * network_task) {
+  mtapi_job_hndl_t job_hndl;
+  mtapi_task_attributes_t task_attr;
+  mtapi_task_complete_function_t func = embb_mtapi_network_task_complete;
+  void * func_void;
+  mtapi_uint_t priority = (mtapi_uint_t)network_task->priority;
+  mtapi_status_t local_status = MTAPI_ERR_UNKNOWN;
+  mtapi_boolean_t task_detached = MTAPI_TRUE;
+
+  mtapi_taskattr_init(&task_attr, &local_status);
+  assert(local_status == MTAPI_SUCCESS);
+  mtapi_taskattr_set(&task_attr, MTAPI_TASK_USER_DATA,
+    (void*)network_task, 0, &local_status);
+  assert(local_status == MTAPI_SUCCESS);
+  mtapi_taskattr_set(&task_attr, MTAPI_TASK_DETACHED,
+    (void*)&task_detached, sizeof(mtapi_boolean_t), &local_status);
+  assert(local_status == MTAPI_SUCCESS);
+  mtapi_taskattr_set(&task_attr, MTAPI_TASK_PRIORITY,
+    (void*)&priority, sizeof(mtapi_uint_t), &local_status);
+  assert(local_status == MTAPI_SUCCESS);
+  memcpy(&func_void, &func, sizeof(void*));
+  mtapi_taskattr_set(&task_attr, MTAPI_TASK_COMPLETE_FUNCTION,
+    func_void, 0, &local_status);
+  assert(local_status == MTAPI_SUCCESS);
+  job_hndl = mtapi_job_get((mtapi_job_id_t)network_task->job_id,
+    (mtapi_domain_t)network_task->domain_id, &local_status);
+  if (MTAPI_SUCCESS == local_status) {
+    mtapi_task_start(
+      MTAPI_TASK_ID_NONE, job_hndl,
+      embb_mtapi_network_task_arguments(network_task),
+      (mtapi_size_t)network_task->arguments_size,
+      embb_mtapi_network_task_results(network_task),
+      (mtapi_size_t)network_task->results_size,
+      &task_attr, MTAPI_GROUP_NONE,
+      &local_status);
+  }
+  if (MTAPI_SUCCESS != local_status) {
+    // the task will not run, e.g. if the node is out of tasks, but the
+    // peer still waits for its result and credit
+    embb_mtapi_network_return_result(network_task, local_status, NULL, 0);
+  }
+}
+
+// Parses a START_TASK header and prepares receiving the arguments into a
+// task block. Returns 0 on a protocol error.
+static int embb_mtapi_network_receive_start_task(
+  embb_mtapi_network_connection_t * connection) {
+  embb_mtapi_network_buffer_t * buffer = &connection->buffer;
+  embb_mtapi_network_task_t * network_task;
+  int32_t domain_id;
+  int32_t job_id;
+  int32_t priority;
+  int32_t remote_task_id;
+  int32_t remote_task_tag;
+  int32_t results_size;
+  int32_t arguments_size;
+  int err;
+  EMBB_UNUSED_IN_RELEASE(err);
+
+  // domain id
+  err = embb_mtapi_network_buffer_pop_front_int32(buffer, &domain_id);
+  assert(err == 4);
+  // job id
+  err = embb_mtapi_network_buffer_pop_front_int32(buffer, &job_id);
+  assert(err == 4);
+  // priority
+  err = embb_mtapi_network_buffer_pop_front_int32(buffer, &priority);
+  assert(err == 4);
+  // remote task handle
+  err = embb_mtapi_network_buffer_pop_front_int32(buffer, &remote_task_id);
+  assert(err == 4);
+  err = embb_mtapi_network_buffer_pop_front_int32(buffer, &remote_task_tag);
+  assert(err == 4);
+  // result size
+  err = embb_mtapi_network_buffer_pop_front_int32(buffer, &results_size);
+  assert(err == 4);
+  // arguments size
+  err = embb_mtapi_network_buffer_pop_front_int32(buffer, &arguments_size);
+  assert(err == 4);
+
+  if (0 > results_size || 0 > arguments_size) {
+    return 0;
+  }
+  network_task = embb_mtapi_network_task_allocate(
+    connection, results_size, arguments_size);
+  if (NULL == network_task) {
+    return 0;
+  }
+  network_task->domain_id = domain_id;
+  network_task->job_id = job_id;
+  network_task->priority = priority;
+  network_task->remote_task_id = remote_task_id;
+  network_task->remote_task_tag = remote_task_tag;
+
+  connection->payload_pending = 1;
+  connection->payload_operation = EMBB_MTAPI_NETWORK_START_TASK;
+  connection->payload = embb_mtapi_network_task_arguments(network_task);
+  connection->payload_remaining = arguments_size;
+  connection->payload_task = network_task;
+  return 1;
+}
+
+// Parses a RETURN_RESULT header and prepares receiving the results into the
+// result buffer of the local task. Returns 0 on a protocol error.
+static int embb_mtapi_network_receive_result(
+  embb_mtapi_network_connection_t * connection) {
+  embb_mtapi_network_buffer_t * buffer = &connection->buffer;
+  int32_t results_size;
+  int task_status;
+  int task_id;
+  int task_tag;
+  int err;
+  EMBB_UNUSED_IN_RELEASE(err);
+
+  // local task id
+  err = embb_mtapi_network_buffer_pop_front_int32(buffer, &task_id);
+  assert(err == 4);
+  err = embb_mtapi_network_buffer_pop_front_int32(buffer, &task_tag);
+  assert(err == 4);
+  // task status
+  err = embb_mtapi_network_buffer_pop_front_int32(buffer, &task_status);
+  assert(err == 4);
+  // result size
+  err = embb_mtapi_network_buffer_pop_front_int32(buffer, &results_size);
+  assert(err == 4);
+
+  if (0 > results_size) {
+    return 0;
+  }
+
+  // the result is skipped if the task is gone
+  connection->payload_pending = 1;
+  connection->payload_operation = EMBB_MTAPI_NETWORK_RETURN_RESULT;
+  connection->payload = NULL;
+  connection->payload_remaining = results_size;
+  connection->payload_result_task = NULL;
+  connection->payload_status = (mtapi_status_t)task_status;
+
+  if (embb_mtapi_node_is_initialized()) {
+    embb_mtapi_node_t * node = embb_mtapi_node_get_instance();
+    mtapi_task_hndl_t task;
+
+    task.id = (mtapi_task_id_t)task_id;
+    task.tag = (mtapi_uint_t)task_tag;
+
+    if (embb_mtapi_task_pool_is_handle_valid(node->task_pool, task)) {
+      embb_mtapi_task_t * local_task =
+        embb_mtapi_task_pool_get_storage_for_handle(
+        node->task_pool, task);
+
+      // results of failed tasks are dropped, their buffers may be reused
+      if (NULL != connection->outstanding &&
+        embb_mtapi_network_task_mark(local_task) == embb_atomic_load_int(
+          &connection->outstanding[local_task->handle.id]) &&
+        embb_mtapi_action_pool_is_handle_valid(
+        node->action_pool, local_task->action)) {
+        connection->payload_result_task = local_task;
+        if ((mtapi_size_t)results_size <= local_task->result_size) {
+          connection->payload = (char*)local_task->result_buffer;
+        } else {
+          connection->payload_status = MTAPI_ERR_RESULT_SIZE;
+        }
       }
     }
   }
 
-  mtapi_status_set(status, local_status);
+  return 1;
 }
 
-static int embb_mtapi_network_thread(void * args) {
-  embb_mtapi_network_plugin_t * plugin = &embb_mtapi_network_plugin;
-  embb_mtapi_network_buffer_t buffer;
+// Parses an ATTACH_SHM header and prepares receiving the name of the shared
+// memory segment. Returns 0 on a protocol error.
+static int embb_mtapi_network_receive_attach_shm(
+  embb_mtapi_network_connection_t * connection) {
+  int32_t name_size;
   int err;
+  EMBB_UNUSED_IN_RELEASE(err);
 
-  EMBB_UNUSED(args);
+  err = embb_mtapi_network_buffer_pop_front_int32(
+    &connection->buffer, &name_size);
+  assert(err == 4);
 
-  embb_mtapi_network_buffer_initialize(&buffer, (int)plugin->buffer_size);
+  if (0 >= name_size || EMBB_MTAPI_NETWORK_SHM_NAME_SIZE <= name_size ||
+    connection->shared) {
+    return 0;
+  }
+  memset(connection->shm_name, 0, EMBB_MTAPI_NETWORK_SHM_NAME_SIZE);
+  connection->payload_pending = 1;
+  connection->payload_operation = EMBB_MTAPI_NETWORK_ATTACH_SHM;
+  connection->payload = connection->shm_name;
+  connection->payload_remaining = name_size;
+  return 1;
+}
 
-  while (embb_atomic_load_int(&plugin->run)) {
-    err = embb_mtapi_network_socket_select(
-      plugin->sockets, plugin->socket_count, 100);
-    if (0 == err) {
-      // listening socket, accept connection
-      embb_mtapi_network_socket_t accept_socket;
-      err = embb_mtapi_network_socket_accept(
-        &plugin->sockets[0], &accept_socket);
-      if (0 < err) {
-        // add socket to socket list
-        plugin->sockets[plugin->socket_count] = accept_socket;
-        plugin->socket_count++;
-      }
-    } else if (0 < err) {
-      int32_t domain_id;
-      int32_t job_id;
-      int32_t results_size;
-      void * results;
-      int8_t operation;
-      embb_mtapi_network_socket_t * socket = &plugin->sockets[err];
+// Switches the connection over to the shared memory segment announced by
+// the peer and tells the peer whether that worked.
+static void embb_mtapi_network_attach_shm(
+  embb_mtapi_network_connection_t * connection) {
+  char answer = (char)embb_mtapi_network_shm_attach(
+    &connection->shm, &connection->socket, connection->shm_name);
+  embb_mtapi_network_iovec_t iov;
+
+  connection->shm.closed = &connection->closed;
+  iov.data = &answer;
+  iov.size = 1;
+  if (embb_mtapi_network_socket_sendv(&connection->socket, &iov, 1) &&
+    answer) {
+    // the peer sends nothing else on the socket before the answer arrived
+    connection->shared = 1;
+  }
+}
+
+// Adds the credits granted by the peer. Returns 0 on a protocol error.
+static int embb_mtapi_network_receive_credit(
+  embb_mtapi_network_connection_t * connection) {
+  int32_t credits;
+  int err;
+  EMBB_UNUSED_IN_RELEASE(err);
 
-      embb_mtapi_network_buffer_clear(&buffer);
+  err = embb_mtapi_network_buffer_pop_front_int32(
+    &connection->buffer, &credits);
+  assert(err == 4);
 
-      err = embb_mtapi_network_socket_recvbuffer_sized(
-        socket, &buffer, 1);
-      if (err == 0) {
-        // there was some socket error, ignore
-        continue;
+  if (0 > credits) {
+    return 0;
+  }
+  embb_atomic_fetch_and_add_int(&connection->credits, credits);
+  return 1;
+}
+
+static void embb_mtapi_network_complete_result(
+  embb_mtapi_task_t * local_task,
+  mtapi_task_state_t task_state,
+  mtapi_status_t task_status) {
+  embb_mtapi_node_t * node = embb_mtapi_node_get_instance();
+  embb_mtapi_action_t * local_action =
+    embb_mtapi_action_pool_get_storage_for_handle(
+    node->action_pool, local_task->action);
+
+  embb_mtapi_network_action_t * network_action =
+    (embb_mtapi_network_action_t*)local_action->plugin_data;
+  embb_mtapi_network_dispatch_t * dispatched =
+    &network_action->dispatched[local_task->handle.id];
+
+  // account the peer before the waiting thread may reuse the task
+  if (NULL != dispatched->peer) {
+    embb_mtapi_network_peer_t * peer = dispatched->peer;
+    int latency = embb_mtapi_network_elapsed_microseconds(&dispatched->sent);
+    int average = embb_atomic_load_int(&peer->latency);
+    average = (0 == average) ? latency : (average * 7 + latency) / 8;
+    embb_atomic_store_int(&peer->latency, (0 < average) ? average : 1);
+    embb_mtapi_action_account_cost(local_action, &dispatched->sent, 1);
+    dispatched->peer = NULL;
+    embb_atomic_fetch_and_add_int(&peer->in_flight, -1);
+  }
+
+  local_task->error_code = task_status;
+  local_task->state = task_state;
+  embb_atomic_fetch_and_add_int(&local_action->num_tasks, -1);
+
+  /* is task associated with a group? */
+  if (embb_mtapi_group_pool_is_handle_valid(
+    node->group_pool, local_task->group)) {
+    embb_mtapi_group_t* local_group =
+      embb_mtapi_group_pool_get_storage_for_handle(
+      node->group_pool, local_task->group);
+    embb_mtapi_group_push_task(local_group, local_task);
+  }
+}
+
+// Called once the payload of the current message is complete.
+static void embb_mtapi_network_finish_payload(
+  embb_mtapi_network_connection_t * connection) {
+  if (EMBB_MTAPI_NETWORK_START_TASK == connection->payload_operation) {
+    embb_mtapi_network_start_task(connection->payload_task);
+  } else if (EMBB_MTAPI_NETWORK_ATTACH_SHM == connection->payload_operation) {
+    embb_mtapi_network_attach_shm(connection);
+  } else {
+    // the peer is done with the task, whether we still know it or not
+    embb_atomic_fetch_and_add_int(&connection->credits, 1);
+    if (NULL != connection->payload_result_task &&
+      embb_mtapi_network_connection_claim(
+        connection, connection->payload_result_task)) {
+      embb_mtapi_network_complete_result(connection->payload_result_task,
+        MTAPI_TASK_COMPLETED, connection->payload_status);
+    }
+  }
+  connection->payload_pending = 0;
+  connection->payload = NULL;
+  connection->payload_task = NULL;
+  connection->payload_result_task = NULL;
+}
+
+// Dispatches all complete messages in the read ahead buffer and moves a
+// trailing partial header to the front. Returns 0 on a protocol error.
+static int embb_mtapi_network_process_messages(
+  embb_mtapi_network_connection_t * connection) {
+  embb_mtapi_network_buffer_t * buffer = &connection->buffer;
+
+  for (;;) {
+    int available = buffer->size - buffer->position;
+
+    if (connection->payload_pending) {
+      // the beginning of the payload was read ahead
+      int num = (available < connection->payload_remaining) ?
+        available : connection->payload_remaining;
+      if (NULL != connection->payload) {
+        memcpy(connection->payload, buffer->data + buffer->position,
+          (size_t)num);
+        connection->payload += num;
       }
-      assert(err == 1);
-      err = embb_mtapi_network_buffer_pop_front_int8(
-        &buffer, &operation);
-      assert(err == 1);
+      buffer->position += num;
+      connection->payload_remaining -= num;
+      if (0 < connection->payload_remaining) {
+        break;
+      }
+      embb_mtapi_network_finish_payload(connection);
+    } else {
+      int8_t operation;
+      int header_size;
+      int err;
 
-      embb_mtapi_network_buffer_clear(&buffer);
+      if (1 > available) {
+        break;
+      }
+      operation = buffer->data[buffer->position];
+      if (operation == EMBB_MTAPI_NETWORK_START_TASK) {
+        header_size = EMBB_MTAPI_NETWORK_START_TASK_HEADER_SIZE;
+      } else if (operation == EMBB_MTAPI_NETWORK_RETURN_RESULT) {
+        header_size = EMBB_MTAPI_NETWORK_RETURN_RESULT_HEADER_SIZE;
+      } else if (operation == EMBB_MTAPI_NETWORK_ATTACH_SHM) {
+        header_size = EMBB_MTAPI_NETWORK_ATTACH_SHM_HEADER_SIZE;
+      } else if (operation == EMBB_MTAPI_NETWORK_CREDIT) {
+        header_size = EMBB_MTAPI_NETWORK_CREDIT_HEADER_SIZE;
+      } else {
+        return 0;
+      }
+      if (available < 1 + header_size) {
+        break;
+      }
 
+      buffer->position++;
       if (operation == EMBB_MTAPI_NETWORK_START_TASK) {
-        int32_t arguments_size;
-        mtapi_uint_t priority = 0;
-        mtapi_job_hndl_t job_hndl;
-        mtapi_task_attributes_t task_attr;
-        void * arguments;
-        mtapi_task_complete_function_t func = embb_mtapi_network_task_complete;
-        void * func_void;
-        embb_mtapi_network_task_t * network_task =
-          (embb_mtapi_network_task_t*)embb_alloc(
-          sizeof(embb_mtapi_network_task_t));
-        mtapi_status_t local_status = MTAPI_ERR_UNKNOWN;
-
-        err = embb_mtapi_network_socket_recvbuffer_sized(
-          socket, &buffer, 28);
-        assert(err == 28);
-        // domain id
-        err = embb_mtapi_network_buffer_pop_front_int32(&buffer, &domain_id);
-        assert(err == 4);
-        // job id
-        err = embb_mtapi_network_buffer_pop_front_int32(&buffer, &job_id);
-        assert(err == 4);
-        // priority
-        err = embb_mtapi_network_buffer_pop_front_int32(
-          &buffer, (int32_t*)&priority);
-        assert(err == 4);
-        // remote task handle
-        err = embb_mtapi_network_buffer_pop_front_int32(
-          &buffer, &network_task->remote_task_id);
-        assert(err == 4);
-        err = embb_mtapi_network_buffer_pop_front_int32(
-          &buffer, &network_task->remote_task_tag);
-        assert(err == 4);
-        // result size
-        err = embb_mtapi_network_buffer_pop_front_int32(&buffer,
-          &results_size);
-        assert(err == 4);
-        results = embb_alloc((size_t)results_size);
-        assert(results != NULL);
-        // arguments size
-        embb_mtapi_network_buffer_pop_front_int32(&buffer, &arguments_size);
-        assert(err == 4);
-        arguments = embb_alloc((size_t)arguments_size);
-        assert(arguments != NULL);
-
-        embb_mtapi_network_buffer_clear(&buffer);
-
-        // arguments
-        err = embb_mtapi_network_socket_recvbuffer_sized(
-          socket, &buffer, arguments_size);
-        assert(err == arguments_size);
-        err = embb_mtapi_network_buffer_pop_front_rawdata(
-          &buffer, arguments_size, arguments);
-        assert(err == arguments_size);
-
-        embb_mtapi_network_buffer_clear(&buffer);
-
-        network_task->socket = *socket;
-        mtapi_taskattr_init(&task_attr, &local_status);
-        assert(local_status == MTAPI_SUCCESS);
-        mtapi_taskattr_set(&task_attr, MTAPI_TASK_USER_DATA,
-          (void*)network_task, 0, &local_status);
-        assert(local_status == MTAPI_SUCCESS);
-        mtapi_boolean_t task_detached = MTAPI_TRUE;
-        mtapi_taskattr_set(&task_attr, MTAPI_TASK_DETACHED,
-          (void*)&task_detached, sizeof(mtapi_boolean_t), &local_status);
-        assert(local_status == MTAPI_SUCCESS);
-        mtapi_taskattr_set(&task_attr, MTAPI_TASK_PRIORITY,
-          (void*)&priority, sizeof(mtapi_uint_t), &local_status);
-        assert(local_status == MTAPI_SUCCESS);
-        memcpy(&func_void, &func, sizeof(void*));
-        mtapi_taskattr_set(&task_attr, MTAPI_TASK_COMPLETE_FUNCTION,
-          func_void, 0, &local_status);
-        assert(local_status == MTAPI_SUCCESS);
-        job_hndl = mtapi_job_get((mtapi_job_id_t)job_id, (mtapi_domain_t)domain_id, &local_status);
-        assert(local_status == MTAPI_SUCCESS);
-        mtapi_task_start(
-          MTAPI_TASK_ID_NONE, job_hndl,
-          arguments, (mtapi_size_t)arguments_size,
-          results, (mtapi_size_t)results_size,
-          &task_attr, MTAPI_GROUP_NONE,
-          &local_status);
-        assert(local_status == MTAPI_SUCCESS);
-
-        // send back result of task creation
-        //embb_mtapi_network_buffer_push_back_int32(
-        //  &buffer, local_status);
-        //embb_mtapi_network_socket_sendbuffer(
-        //  socket, &buffer);
-
-        embb_mtapi_network_buffer_clear(&buffer);
+        err = embb_mtapi_network_receive_start_task(connection);
       } else if (operation == EMBB_MTAPI_NETWORK_RETURN_RESULT) {
-        int task_status;
-        int task_id;
-        int task_tag;
-
-        embb_mtapi_network_buffer_clear(&buffer);
-
-        if (embb_mtapi_node_is_initialized()) {
-          embb_mtapi_node_t * node = embb_mtapi_node_get_instance();
-          mtapi_task_hndl_t task;
-
-          err = embb_mtapi_network_socket_recvbuffer_sized(
-            socket, &buffer, 16);
-          assert(err == 16);
-          // local task id
-          err = embb_mtapi_network_buffer_pop_front_int32(&buffer, &task_id);
-          assert(err == 4);
-          err = embb_mtapi_network_buffer_pop_front_int32(&buffer, &task_tag);
-          assert(err == 4);
-          // task status
-          err = embb_mtapi_network_buffer_pop_front_int32(
-            &buffer, &task_status);
-          assert(err == 4);
-          // result size
-          err = embb_mtapi_network_buffer_pop_front_int32(
-            &buffer, &results_size);
-          assert(err == 4);
-
-          embb_mtapi_network_buffer_clear(&buffer);
-
-          err = embb_mtapi_network_socket_recvbuffer_sized(
-            socket, &buffer, results_size);
-          assert(err == results_size);
-
-          task.id = (mtapi_task_id_t)task_id;
-          task.tag = (mtapi_uint_t)task_tag;
-
-          if (embb_mtapi_task_pool_is_handle_valid(node->task_pool, task)) {
-            embb_mtapi_task_t * local_task =
-              embb_mtapi_task_pool_get_storage_for_handle(
-              node->task_pool, task);
-
-            if (embb_mtapi_action_pool_is_handle_valid(
-              node->action_pool, local_task->action)) {
-              embb_mtapi_action_t * local_action =
-                embb_mtapi_action_pool_get_storage_for_handle(
-                node->action_pool, local_task->action);
-
-              /* not needed right now
-              embb_mtapi_network_action_t * network_action =
-                (embb_mtapi_network_action_t*)local_action->plugin_data;*/
-
-              err = embb_mtapi_network_buffer_pop_front_rawdata(
-                &buffer, results_size, local_task->result_buffer);
-              assert(err == results_size);
-
-              local_task->error_code = (mtapi_status_t)task_status;
-              local_task->state = MTAPI_TASK_COMPLETED;
-              embb_atomic_fetch_and_add_int(&local_action->num_tasks, -1);
-
-              /* is task associated with a group? */
-              if (embb_mtapi_group_pool_is_handle_valid(
-                node->group_pool, local_task->group)) {
-                embb_mtapi_group_t* local_group =
-                  embb_mtapi_group_pool_get_storage_for_handle(
-                  node->group_pool, local_task->group);
-                embb_mtapi_task_queue_push(&local_group->queue, local_task);
-              }
-            }
-          }
+        err = embb_mtapi_network_receive_result(connection);
+      } else if (operation == EMBB_MTAPI_NETWORK_ATTACH_SHM) {
+        err = embb_mtapi_network_receive_attach_shm(connection);
+      } else {
+        err = embb_mtapi_network_receive_credit(connection);
+      }
+      if (0 == err) {
+        return 0;
+      }
+    }
+  }
+
+  if (0 < buffer->position) {
+    buffer->size -= buffer->position;
+    memmove(buffer->data, buffer->data + buffer->position,
+      (size_t)buffer->size);
+    buffer->position = 0;
+  }
+
+  return 1;
+}
+
+// Reads from the socket or the shared memory ring of the connection.
+// Returns the number of bytes read, 0 if nothing is available or -1 if the
+// connection was closed.
+static int embb_mtapi_network_connection_read(
+  embb_mtapi_network_connection_t * connection,
+  void * data,
+  int size) {
+  if (connection->shared) {
+    return embb_mtapi_network_shm_read(&connection->shm, data, size);
+  } else {
+    return embb_mtapi_network_socket_recv_some(
+      &connection->socket, data, size);
+  }
+}
+
+static void embb_mtapi_network_receive(
+  embb_mtapi_network_plugin_t * plugin,
+  embb_mtapi_network_connection_t * connection) {
+  embb_mtapi_network_buffer_t * buffer = &connection->buffer;
+  int err;
+
+  if (connection->shared) {
+    // drop the wake up bytes, this also notices the peer going away
+    char wake_up[64];
+    do {
+      err = embb_mtapi_network_socket_recv_some(
+        &connection->socket, wake_up, (int)sizeof(wake_up));
+    } while ((int)sizeof(wake_up) == err);
+    if (0 > err) {
+      embb_mtapi_network_close_connection(plugin, connection);
+      return;
+    }
+  }
+
+  // edge-triggered, so read until the socket would block
+  do {
+    if (connection->payload_pending && NULL != connection->payload &&
+      buffer->size == buffer->position) {
+      // read the rest of the payload into its final location
+      err = embb_mtapi_network_connection_read(connection,
+        connection->payload, connection->payload_remaining);
+      if (0 < err) {
+        connection->payload += err;
+        connection->payload_remaining -= err;
+        if (0 == connection->payload_remaining) {
+          embb_mtapi_network_finish_payload(connection);
         }
       }
+    } else {
+      err = embb_mtapi_network_connection_read(connection,
+        buffer->data + buffer->size, buffer->capacity - buffer->size);
+      if (0 < err) {
+        buffer->size += err;
+      }
+      if (0 <= err &&
+        0 == embb_mtapi_network_process_messages(connection)) {
+        err = -1;
+      }
+    }
+    if (0 > err) {
+      embb_mtapi_network_close_connection(plugin, connection);
+      return;
+    }
+    if (0 == err && connection->shared &&
+      0 == embb_mtapi_network_shm_wait(&connection->shm)) {
+      // the ring was filled while going to sleep
+      err = 1;
+    }
+  } while (0 < err);
+}
+
+static void embb_mtapi_network_grant_credits(
+  embb_mtapi_network_plugin_t * plugin,
+  embb_mtapi_network_connection_t * connection) {
+  int credits = plugin->credits;
+  char header_data[1 + EMBB_MTAPI_NETWORK_CREDIT_HEADER_SIZE];
+  embb_mtapi_network_buffer_t header;
+  embb_mtapi_network_iovec_t iov;
+  int err;
+  EMBB_UNUSED_IN_RELEASE(err);
+
+  if (0 == credits) {
+    // share the task pool among all possible connections
+    credits = (int)embb_mtapi_node_get_instance()->attributes.max_tasks /
+      plugin->connection_capacity;
+    if (0 == credits) {
+      credits = 1;
     }
   }
 
-  embb_mtapi_network_buffer_finalize(&buffer);
+  header.data = header_data;
+  header.capacity = (int)sizeof(header_data);
+  header.size = 0;
+  header.position = 0;
+  // operation is "credit"
+  err = embb_mtapi_network_buffer_push_back_int8(
+    &header, EMBB_MTAPI_NETWORK_CREDIT);
+  assert(err == 1);
+  err = embb_mtapi_network_buffer_push_back_int32(&header, credits);
+  assert(err == 4);
+  iov.data = header.data;
+  iov.size = header.size;
+  embb_mtapi_network_socket_sendv(&connection->socket, &iov, 1);
+}
+
+static int embb_mtapi_network_thread(void * args) {
+  embb_mtapi_network_plugin_t * plugin = &embb_mtapi_network_plugin;
+  void * events[EMBB_MTAPI_NETWORK_MAX_EVENTS];
+  int count;
+  int ii;
+
+  EMBB_UNUSED(args);
+
+  while (embb_atomic_load_int(&plugin->run)) {
+    count = embb_mtapi_network_poller_wait(&plugin->poller,
+      events, EMBB_MTAPI_NETWORK_MAX_EVENTS, 100);
+    for (ii = 0; ii < count; ii++) {
+      if (NULL == events[ii]) {
+        // listening socket, accept all pending connections
+        embb_mtapi_network_socket_t accept_socket;
+        while (embb_mtapi_network_socket_accept(
+          &plugin->listen_socket, &accept_socket)) {
+          embb_mtapi_network_connection_t * connection =
+            embb_mtapi_network_add_connection(
+              plugin, &accept_socket, NULL, 1);
+          if (NULL == connection) {
+            embb_mtapi_network_socket_finalize(&accept_socket);
+          } else {
+            embb_mtapi_network_grant_credits(plugin, connection);
+          }
+        }
+      } else {
+        embb_mtapi_network_receive(plugin,
+          (embb_mtapi_network_connection_t*)events[ii]);
+      }
+    }
+    if (0 < embb_atomic_load_int(&plugin->retired)) {
+      embb_mtapi_network_reclaim_connections(plugin);
+    }
+  }
 
   return EMBB_SUCCESS;
 }
@@ -409,27 +1320,42 @@ void mtapi_network_plugin_initialize(
   mtapi_status_t local_status = MTAPI_ERR_UNKNOWN;
   embb_mtapi_network_plugin_t * plugin = &embb_mtapi_network_plugin;
   int err;
+  int ii;
 
   err = embb_mtapi_network_initialize();
   if (err) {
     embb_atomic_store_int(&plugin->run, 1);
     plugin->buffer_size = buffer_size;
+    plugin->shared_memory = 1;
+
+    // max_connections connections (2 sockets each if local)
+    plugin->connection_capacity = max_connections * 2;
+    plugin->credits = 0;
+    plugin->connections = (embb_mtapi_network_connection_t*)embb_alloc(
+      sizeof(embb_mtapi_network_connection_t) *
+      (size_t)plugin->connection_capacity);
+    embb_mutex_init(&plugin->slot_mutex, EMBB_MUTEX_PLAIN);
+    embb_atomic_store_int(&plugin->retired, 0);
+    plugin->free_slot = -1;
+    if (NULL != plugin->connections) {
+      for (ii = plugin->connection_capacity - 1; ii >= 0; ii--) {
+        embb_atomic_store_int(&plugin->connections[ii].slot_state,
+          EMBB_MTAPI_NETWORK_SLOT_FREE);
+        plugin->connections[ii].next_free = plugin->free_slot;
+        plugin->free_slot = ii;
+      }
+    }
 
-    plugin->socket_count = 1;
-    // 1 listening socket and max_connections connections
-    // (2 sockets each if local)
-    plugin->sockets = (embb_mtapi_network_socket_t*)embb_alloc(
-      sizeof(embb_mtapi_network_socket_t) * (1 + max_connections * 2));
-
-    embb_mtapi_network_buffer_initialize(
-      &plugin->send_buffer, (int)plugin->buffer_size);
-    embb_mutex_init(&plugin->send_mutex, 0);
-
-    if (NULL != plugin->sockets) {
-      err = embb_mtapi_network_socket_initialize(&plugin->sockets[0]);
+    if (NULL != plugin->connections &&
+      embb_mtapi_network_poller_initialize(
+        &plugin->poller, plugin->connection_capacity + 1)) {
+      err = embb_mtapi_network_socket_initialize(&plugin->listen_socket);
       if (err) {
         err = embb_mtapi_network_socket_bind_and_listen(
-          &plugin->sockets[0], host, port, max_connections);
+          &plugin->listen_socket, host, port, max_connections) &&
+          embb_mtapi_network_socket_set_nonblocking(&plugin->listen_socket) &&
+          embb_mtapi_network_poller_add(
+            &plugin->poller, &plugin->listen_socket, NULL);
         if (err) {
           err = embb_thread_create(
             &plugin->thread, NULL, embb_mtapi_network_thread, NULL);
@@ -444,25 +1370,216 @@ void mtapi_network_plugin_initialize(
   mtapi_status_set(status, local_status);
 }
 
+void mtapi_network_plugin_set_shared_memory(
+  MTAPI_IN mtapi_boolean_t enable,
+  MTAPI_OUT mtapi_status_t* status) {
+  embb_mtapi_network_plugin.shared_memory = enable ? 1 : 0;
+  mtapi_status_set(status, MTAPI_SUCCESS);
+}
+
+void mtapi_network_plugin_set_credits(
+  MTAPI_IN mtapi_uint_t credits,
+  MTAPI_OUT mtapi_status_t* status) {
+  embb_mtapi_network_plugin.credits =
+    (EMBB_MTAPI_NETWORK_UNLIMITED_CREDITS < credits) ?
+    EMBB_MTAPI_NETWORK_UNLIMITED_CREDITS : (int)credits;
+  mtapi_status_set(status, MTAPI_SUCCESS);
+}
+
 void mtapi_network_plugin_finalize(
   MTAPI_OUT mtapi_status_t* status) {
   mtapi_status_t local_status = MTAPI_SUCCESS;
   embb_mtapi_network_plugin_t * plugin = &embb_mtapi_network_plugin;
   int err;
+  int ii;
 
   embb_atomic_store_int(&plugin->run, 0);
   embb_thread_join(&plugin->thread, &err);
 
-  embb_mutex_destroy(&plugin->send_mutex);
-  embb_mtapi_network_buffer_finalize(&plugin->send_buffer);
-
-  embb_mtapi_network_socket_finalize(&plugin->sockets[0]);
-  embb_free(plugin->sockets);
+  for (ii = 0; ii < plugin->connection_capacity; ii++) {
+    embb_mtapi_network_connection_t * connection = &plugin->connections[ii];
+    // slots still being set up are not looked at
+    if (EMBB_MTAPI_NETWORK_SLOT_FREE !=
+      embb_atomic_load_int(&connection->slot_state)) {
+      embb_mtapi_network_connection_finalize(connection);
+    }
+  }
+  embb_mutex_destroy(&plugin->slot_mutex);
+  embb_mtapi_network_poller_finalize(&plugin->poller);
+  embb_mtapi_network_socket_finalize(&plugin->listen_socket);
+  embb_free(plugin->connections);
   embb_mtapi_network_finalize();
 
   mtapi_status_set(status, local_status);
 }
 
+// Offers a shared memory segment to a peer on the same host over the still
+// blocking socket. Returns 1 if the peer attached to it, 0 if it declined
+// and -1 if the connection is lost.
+static int embb_mtapi_network_offer_shm(
+  embb_mtapi_network_socket_t * socket,
+  embb_mtapi_network_shm_t * shm) {
+  char header_data[1 + EMBB_MTAPI_NETWORK_ATTACH_SHM_HEADER_SIZE];
+  embb_mtapi_network_buffer_t header;
+  embb_mtapi_network_iovec_t iov[2];
+  char answer = 0;
+  int err;
+  EMBB_UNUSED_IN_RELEASE(err);
+
+  if (0 == embb_mtapi_network_shm_create(shm, socket)) {
+    return 0;
+  }
+
+  header.data = header_data;
+  header.capacity = (int)sizeof(header_data);
+  header.size = 0;
+  header.position = 0;
+  // operation is "attach shared memory"
+  err = embb_mtapi_network_buffer_push_back_int8(
+    &header, EMBB_MTAPI_NETWORK_ATTACH_SHM);
+  assert(err == 1);
+  err = embb_mtapi_network_buffer_push_back_int32(
+    &header, (int32_t)strlen(shm->name));
+  assert(err == 4);
+  iov[0].data = header.data;
+  iov[0].size = header.size;
+  iov[1].data = shm->name;
+  iov[1].size = (int)strlen(shm->name);
+
+  if (0 == embb_mtapi_network_socket_sendv(socket, iov, 2) ||
+    1 != embb_mtapi_network_socket_recv_some(socket, &answer, 1)) {
+    embb_mtapi_network_shm_finalize(shm);
+    return -1;
+  }
+  if (0 == answer) {
+    embb_mtapi_network_shm_finalize(shm);
+    return 0;
+  }
+  return 1;
+}
+
+// Reads the credits a peer grants right after accepting the connection
+// from the still blocking socket. Returns -1 if the connection is lost.
+static int embb_mtapi_network_receive_credits(
+  embb_mtapi_network_socket_t * socket) {
+  char data[1 + EMBB_MTAPI_NETWORK_CREDIT_HEADER_SIZE];
+  embb_mtapi_network_buffer_t buffer;
+  int8_t operation = 0;
+  int32_t credits = 0;
+
+  if (0 > embb_mtapi_network_socket_select(
+    socket, 1, EMBB_MTAPI_NETWORK_CREDIT_TIMEOUT)) {
+    // the peer does not limit the tasks in flight
+    return EMBB_MTAPI_NETWORK_UNLIMITED_CREDITS;
+  }
+  if ((int)sizeof(data) != embb_mtapi_network_socket_recv_some(
+    socket, data, (int)sizeof(data))) {
+    return -1;
+  }
+
+  buffer.data = data;
+  buffer.capacity = (int)sizeof(data);
+  buffer.size = (int)sizeof(data);
+  buffer.position = 0;
+  embb_mtapi_network_buffer_pop_front_int8(&buffer, &operation);
+  embb_mtapi_network_buffer_pop_front_int32(&buffer, &credits);
+  if (EMBB_MTAPI_NETWORK_CREDIT != operation || 0 > credits) {
+    return -1;
+  }
+  return credits;
+}
+
+// Takes one of the credits of a connection. Returns 0 if there are none.
+static int embb_mtapi_network_take_credit(
+  embb_mtapi_network_connection_t * connection) {
+  int credits = embb_atomic_load_int(&connection->credits);
+  while (0 < credits) {
+    if (embb_atomic_compare_and_swap_int(
+      &connection->credits, &credits, credits - 1)) {
+      return 1;
+    }
+  }
+  return 0;
+}
+
+// Picks a peer according to the dispatch strategy of the action and counts
+// the task as in flight there. Waits while all peers are at their limit or
+// out of credits, returns NULL if all peers went away.
+static embb_mtapi_network_peer_t * embb_mtapi_network_select_peer(
+  embb_mtapi_network_action_t * that) {
+  embb_mtapi_node_t * node = embb_mtapi_node_get_instance();
+  embb_mtapi_thread_context_t * context =
+    embb_mtapi_scheduler_get_current_thread_context(node->scheduler);
+
+  for (;;) {
+    embb_mtapi_network_peer_t * best = NULL;
+    long long best_cost = 0;
+    int best_in_flight = 0;
+    int num_open = 0;
+    int start = (int)((unsigned int)embb_atomic_fetch_and_add_int(
+      &that->next_peer, 1) % (unsigned int)that->num_peers);
+    int ii;
+
+    for (ii = 0; ii < that->num_peers; ii++) {
+      embb_mtapi_network_peer_t * peer =
+        &that->peers[(start + ii) % that->num_peers];
+      int in_flight;
+      long long cost;
+
+      if (embb_atomic_load_int(&peer->connection->closed)) {
+        continue;
+      }
+      num_open++;
+      in_flight = embb_atomic_load_int(&peer->in_flight);
+      if (0 < that->max_in_flight && in_flight >= that->max_in_flight) {
+        continue;
+      }
+      if (0 >= embb_atomic_load_int(&peer->connection->credits)) {
+        continue;
+      }
+      if (MTAPI_NETWORK_DISPATCH_LEAST_OUTSTANDING == that->dispatch) {
+        cost = in_flight;
+      } else if (MTAPI_NETWORK_DISPATCH_LATENCY_WEIGHTED == that->dispatch) {
+        // expected time until a new task would be done
+        int latency = embb_atomic_load_int(&peer->latency);
+        cost = (long long)(in_flight + 1) * ((0 < latency) ? latency : 1);
+      } else {
+        // round robin, the first peer with room after the start position
+        cost = 0;
+      }
+      if (NULL == best || cost < best_cost) {
+        best = peer;
+        best_cost = cost;
+        best_in_flight = in_flight;
+        if (MTAPI_NETWORK_DISPATCH_ROUND_ROBIN == that->dispatch) {
+          break;
+        }
+      }
+    }
+
+    if (NULL != best) {
+      if (embb_mtapi_network_take_credit(best->connection)) {
+        if (0 == that->max_in_flight) {
+          embb_atomic_fetch_and_add_int(&best->in_flight, 1);
+          return best;
+        }
+        if (embb_atomic_compare_and_swap_int(
+          &best->in_flight, &best_in_flight, best_in_flight + 1)) {
+          return best;
+        }
+        embb_atomic_fetch_and_add_int(&best->connection->credits, 1);
+      }
+      // someone else took the slot, look again
+    } else if (0 == num_open) {
+      return NULL;
+    } else {
+      // all peers are busy, do other work until a result comes in
+      embb_mtapi_scheduler_execute_task_or_yield(
+        node->scheduler, node, context);
+    }
+  }
+}
+
 static void network_task_start(
   MTAPI_IN mtapi_task_hndl_t task,
   MTAPI_OUT mtapi_status_t* status) {
@@ -485,56 +1602,68 @@ static void network_task_start(
 
         embb_mtapi_network_action_t * network_action =
           (embb_mtapi_network_action_t*)local_action->plugin_data;
-        embb_mtapi_network_buffer_t * send_buf = &network_action->send_buffer;
+        embb_mtapi_network_peer_t * peer =
+          embb_mtapi_network_select_peer(network_action);
+        embb_mtapi_network_dispatch_t * dispatched =
+          &network_action->dispatched[local_task->handle.id];
+        embb_mtapi_network_message_t message;
+        embb_mtapi_network_buffer_t header;
+
+        if (NULL == peer) {
+          // no peer left to send the task to
+          mtapi_status_set(status, local_status);
+          return;
+        }
 
-        // serialize sending
-        embb_mutex_lock(&network_action->send_mutex);
+        embb_mtapi_network_message_initialize(&message, &header);
 
         // operation is "start task"
         err = embb_mtapi_network_buffer_push_back_int8(
-          send_buf, EMBB_MTAPI_NETWORK_START_TASK);
+          &header, EMBB_MTAPI_NETWORK_START_TASK);
         assert(err == 1);
 
         err = embb_mtapi_network_buffer_push_back_int32(
-          send_buf, (int32_t)network_action->domain_id);
+          &header, (int32_t)network_action->domain_id);
         assert(err == 4);
 
         err = embb_mtapi_network_buffer_push_back_int32(
-          send_buf, (int32_t)network_action->job_id);
+          &header, (int32_t)network_action->job_id);
         assert(err == 4);
 
         err = embb_mtapi_network_buffer_push_back_int32(
-          send_buf, (int32_t)local_task->attributes.priority);
+          &header, (int32_t)local_task->attributes.priority);
         assert(err == 4);
 
         err = embb_mtapi_network_buffer_push_back_int32(
-          send_buf, (int32_t)local_task->handle.id);
+          &header, (int32_t)local_task->handle.id);
         assert(err == 4);
         err = embb_mtapi_network_buffer_push_back_int32(
-          send_buf, (int32_t)local_task->handle.tag);
+          &header, (int32_t)local_task->handle.tag);
         assert(err == 4);
 
         err = embb_mtapi_network_buffer_push_back_int32(
-          send_buf, (int32_t)local_task->result_size);
+          &header, (int32_t)local_task->result_size);
         assert(err == 4);
 
         err = embb_mtapi_network_buffer_push_back_int32(
-          send_buf, (int32_t)local_task->arguments_size);
+          &header, (int32_t)local_task->arguments_size);
         assert(err == 4);
-        err = embb_mtapi_network_buffer_push_back_rawdata(
-          send_buf, (int32_t)local_task->arguments_size, local_task->arguments);
-        assert(err == (int)local_task->arguments_size);
-
-        err = embb_mtapi_network_socket_sendbuffer(
-          &network_action->socket, send_buf);
-        assert(err == send_buf->size);
-
+        message.header_size = header.size;
+        // arguments stay valid until the task completes
+        message.payload = local_task->arguments;
+        message.payload_size = (int)local_task->arguments_size;
+        message.task = local_task;
+
+        // the result may arrive before the send returns
+        dispatched->peer = peer;
+        embb_time_now(&dispatched->sent);
         embb_atomic_fetch_and_add_int(&local_action->num_tasks, 1);
         local_task->state = MTAPI_TASK_RUNNING;
+        embb_atomic_store_int(
+          &peer->connection->outstanding[local_task->handle.id],
+          embb_mtapi_network_task_mark(local_task));
 
-        embb_mtapi_network_buffer_clear(send_buf);
-
-        embb_mutex_unlock(&network_action->send_mutex);
+        embb_mtapi_network_connection_send(peer->connection, &message);
 
         local_status = MTAPI_SUCCESS;
       }
@@ -554,6 +1683,29 @@ static void network_task_cancel(
   mtapi_status_set(status, local_status);
 }
 
+static void embb_mtapi_network_action_free(
+  embb_mtapi_network_action_t * that) {
+  int ii;
+  for (ii = 0; ii < that->num_peers; ii++) {
+    embb_mtapi_network_peer_t * peer = &that->peers[ii];
+    embb_mtapi_network_poller_remove(
+      &embb_mtapi_network_plugin.poller, &peer->socket);
+    embb_mtapi_network_socket_finalize(&peer->socket);
+    if (NULL != peer->connection) {
+      // nothing is sent on the connection anymore, its slot can be reused
+      embb_atomic_store_int(&peer->connection->closed, 1);
+      embb_mtapi_network_connection_release(peer->connection);
+    }
+  }
+  if (NULL != that->dispatched) {
+    embb_free(that->dispatched);
+  }
+  if (NULL != that->peers) {
+    embb_free(that->peers);
+  }
+  embb_free(that);
+}
+
 static void network_action_finalize(
   MTAPI_IN mtapi_action_hndl_t action,
   MTAPI_OUT mtapi_status_t* status
@@ -566,14 +1718,8 @@ static void network_action_finalize(
       embb_mtapi_action_t * local_action =
         embb_mtapi_action_pool_get_storage_for_handle(
           node->action_pool, action);
-      embb_mtapi_network_action_t * network_action =
-        (embb_mtapi_network_action_t *)local_action->plugin_data;
-
-      embb_mutex_destroy(&network_action->send_mutex);
-      embb_mtapi_network_buffer_finalize(&network_action->send_buffer);
-      embb_mtapi_network_socket_finalize(&network_action->socket);
-
-      embb_free(network_action);
+      embb_mtapi_network_action_free(
+        (embb_mtapi_network_action_t *)local_action->plugin_data);
       local_status = MTAPI_SUCCESS;
     }
   }
@@ -581,39 +1727,114 @@ static void network_action_finalize(
   mtapi_status_set(status, local_status);
 }
 
-mtapi_action_hndl_t mtapi_network_action_create(
+// Connects to a peer, through shared memory if it runs on the same host.
+static int embb_mtapi_network_peer_connect(
+  embb_mtapi_network_plugin_t * plugin,
+  embb_mtapi_network_peer_t * peer) {
+  embb_mtapi_network_shm_t shm;
+  int shared = 0;
+  int credits = 0;
+  int err;
+
+  embb_atomic_store_int(&peer->in_flight, 0);
+  embb_atomic_store_int(&peer->latency, 0);
+  peer->connection = NULL;
+  embb_mtapi_network_socket_initialize(&peer->socket);
+  err = embb_mtapi_network_socket_connect(&peer->socket, peer->host,
+    peer->port);
+  if (0 != err) {
+    credits = embb_mtapi_network_receive_credits(&peer->socket);
+    err = (0 <= credits);
+  }
+
+  if (0 != err && plugin->shared_memory &&
+    embb_mtapi_network_socket_is_local_peer(&peer->socket)) {
+    shared = embb_mtapi_network_offer_shm(&peer->socket, &shm);
+    if (0 > shared) {
+      // a peer that does not know shared memory drops the connection
+      embb_mtapi_network_socket_finalize(&peer->socket);
+      embb_mtapi_network_socket_initialize(&peer->socket);
+      err = embb_mtapi_network_socket_connect(
+        &peer->socket, peer->host, peer->port);
+      if (0 != err) {
+        credits = embb_mtapi_network_receive_credits(&peer->socket);
+        err = (0 <= credits);
+      }
+      shared = 0;
+    }
+  }
+
+  if (0 != err) {
+    // tasks are sent and results arrive on this connection
+    peer->connection = embb_mtapi_network_add_connection(
+      plugin, &peer->socket, (1 == shared) ? &shm : NULL, 0);
+    err = (NULL != peer->connection);
+  }
+  if (0 != err) {
+    embb_atomic_store_int(&peer->connection->credits, credits);
+  }
+  return err;
+}
+
+mtapi_action_hndl_t mtapi_network_action_create_balanced(
   MTAPI_IN mtapi_domain_t domain_id,
   MTAPI_IN mtapi_job_id_t local_job_id,
   MTAPI_IN mtapi_job_id_t remote_job_id,
-  MTAPI_IN char * host,
-  MTAPI_IN mtapi_uint16_t port,
+  MTAPI_IN char ** hosts,
+  MTAPI_IN mtapi_uint16_t * ports,
+  MTAPI_IN mtapi_uint_t num_peers,
+  MTAPI_IN mtapi_uint_t dispatch,
+  MTAPI_IN mtapi_uint_t max_tasks_per_peer,
   MTAPI_OUT mtapi_status_t* status) {
   mtapi_status_t local_status = MTAPI_ERR_UNKNOWN;
   embb_mtapi_network_plugin_t * plugin = &embb_mtapi_network_plugin;
-  embb_mtapi_network_action_t * action =
-    (embb_mtapi_network_action_t*)embb_alloc(
-      sizeof(embb_mtapi_network_action_t));
+  embb_mtapi_network_action_t * action;
   mtapi_action_hndl_t action_hndl = { 0, 0 };
   int err;
+  int ii;
+
+  if (!embb_mtapi_node_is_initialized()) {
+    mtapi_status_set(status, MTAPI_ERR_NODE_NOTINIT);
+    return action_hndl;
+  }
+  if (0 == num_peers || MTAPI_NULL == hosts || MTAPI_NULL == ports ||
+    MTAPI_NETWORK_DISPATCH_LATENCY_WEIGHTED < dispatch) {
+    mtapi_status_set(status, MTAPI_ERR_PARAMETER);
+    return action_hndl;
+  }
 
+  action = (embb_mtapi_network_action_t*)embb_alloc(
+    sizeof(embb_mtapi_network_action_t));
   if (NULL != action) {
     action->domain_id = domain_id;
     action->job_id = remote_job_id;
-
-    embb_mtapi_network_buffer_initialize(
-      &action->send_buffer, (int)plugin->buffer_size);
-    embb_mutex_init(&action->send_mutex, 0);
-
-    action->host = host;
-    action->port = port;
-    embb_mtapi_network_socket_initialize(&action->socket);
-    err = embb_mtapi_network_socket_connect(&action->socket, host, port);
+    action->num_peers = 0;
+    action->dispatch = dispatch;
+    action->max_in_flight = (int)max_tasks_per_peer;
+    embb_atomic_store_int(&action->next_peer, 0);
+    action->max_tasks =
+      embb_mtapi_node_get_instance()->attributes.max_tasks;
+    action->dispatched = (embb_mtapi_network_dispatch_t*)embb_alloc(
+      sizeof(embb_mtapi_network_dispatch_t) * (action->max_tasks + 1));
+    action->peers = (embb_mtapi_network_peer_t*)embb_alloc(
+      sizeof(embb_mtapi_network_peer_t) * num_peers);
+    err = (NULL != action->dispatched && NULL != action->peers);
 
     if (0 != err) {
-      // store socket for select
-      plugin->sockets[plugin->socket_count] = action->socket;
-      plugin->socket_count++;
+      for (ii = 0; ii <= (int)action->max_tasks; ii++) {
+        action->dispatched[ii].peer = NULL;
+      }
+      for (ii = 0; ii < (int)num_peers && 0 != err; ii++) {
+        embb_mtapi_network_peer_t * peer = &action->peers[ii];
+        peer->host = hosts[ii];
+        peer->port = ports[ii];
+        err = embb_mtapi_network_peer_connect(plugin, peer);
+        // also clean up the socket of a failed peer
+        action->num_peers++;
+      }
+    }
 
+    if (0 != err) {
       action_hndl = mtapi_ext_plugin_action_create(
         local_job_id,
         network_task_start,
@@ -623,14 +1844,24 @@ mtapi_action_hndl_t mtapi_network_action_create(
         NULL, 0, // no node local data obviously
         MTAPI_NULL,
         &local_status);
-    } else {
-      embb_mutex_destroy(&action->send_mutex);
-      embb_mtapi_network_buffer_finalize(&action->send_buffer);
-      embb_mtapi_network_socket_finalize(&action->socket);
-      embb_free(action);
+    }
+    if (MTAPI_SUCCESS != local_status) {
+      embb_mtapi_network_action_free(action);
     }
   }
 
   mtapi_status_set(status, local_status);
   return action_hndl;
 }
+
+mtapi_action_hndl_t mtapi_network_action_create(
+  MTAPI_IN mtapi_domain_t domain_id,
+  MTAPI_IN mtapi_job_id_t local_job_id,
+  MTAPI_IN mtapi_job_id_t remote_job_id,
+  MTAPI_IN char * host,
+  MTAPI_IN mtapi_uint16_t port,
+  MTAPI_OUT mtapi_status_t* status) {
+  return mtapi_network_action_create_balanced(domain_id, local_job_id,
+    remote_job_id, &host, &port, 1, MTAPI_NETWORK_DISPATCH_ROUND_ROBIN, 0,
+    status);
+}
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2014, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <embb_mtapi_network_poller.h>
+#include <embb/base/c/memory_allocation.h>
+#include <string.h>
+#ifdef _WIN32
+#include <WinSock2.h>
+#else
+#include <sys/time.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+#ifdef EMBB_PLATFORM_HAS_HEADER_EPOLL
+#include <sys/epoll.h>
+#endif
+
+#ifdef EMBB_PLATFORM_HAS_HEADER_EPOLL
+
+int embb_mtapi_network_poller_initialize(
+  embb_mtapi_network_poller_t * that,
+  int capacity) {
+  that->handle = epoll_create((0 < capacity) ? capacity : 1);
+  return (-1 == that->handle) ? 0 : 1;
+}
+
+void embb_mtapi_network_poller_finalize(
+  embb_mtapi_network_poller_t * that) {
+  if (-1 != that->handle) {
+    close(that->handle);
+    that->handle = -1;
+  }
+}
+
+int embb_mtapi_network_poller_add(
+  embb_mtapi_network_poller_t * that,
+  embb_mtapi_network_socket_t * socket,
+  void * data) {
+  struct epoll_event event;
+  memset(&event, 0, sizeof(event));
+  event.events = EPOLLIN | EPOLLRDHUP | EPOLLET;
+  event.data.ptr = data;
+  if (0 != epoll_ctl(that->handle, EPOLL_CTL_ADD, socket->handle, &event)) {
+    return 0;
+  }
+  return 1;
+}
+
+void embb_mtapi_network_poller_remove(
+  embb_mtapi_network_poller_t * that,
+  embb_mtapi_network_socket_t * socket) {
+  struct epoll_event event;
+  /* event is ignored, but needs to be non-NULL for older kernels */
+  memset(&event, 0, sizeof(event));
+  epoll_ctl(that->handle, EPOLL_CTL_DEL, socket->handle, &event);
+}
+
+int embb_mtapi_network_poller_wait(
+  embb_mtapi_network_poller_t * that,
+  void ** data,
+  int max_events,
+  int timeout) {
+  struct epoll_event events[64];
+  int count;
+  int ii;
+
+  if (max_events > 64) {
+    max_events = 64;
+  }
+  count = epoll_wait(that->handle, events, max_events, timeout);
+  if (0 > count) {
+    /* interrupted by a signal counts as timeout */
+    return (EINTR == errno) ? 0 : -1;
+  }
+  for (ii = 0; ii < count; ii++) {
+    data[ii] = events[ii].data.ptr;
+  }
+  return count;
+}
+
+#else /* EMBB_PLATFORM_HAS_HEADER_EPOLL */
+
+int embb_mtapi_network_poller_initialize(
+  embb_mtapi_network_poller_t * that,
+  int capacity) {
+  that->count = 0;
+  that->capacity = 0;
+  that->sockets = (embb_mtapi_network_socket_t*)embb_alloc(
+    sizeof(embb_mtapi_network_socket_t) * (size_t)capacity);
+  that->data = (void**)embb_alloc(sizeof(void*) * (size_t)capacity);
+  if (NULL == that->sockets || NULL == that->data) {
+    embb_free(that->sockets);
+    embb_free(that->data);
+    that->sockets = NULL;
+    that->data = NULL;
+    return 0;
+  }
+  that->capacity = capacity;
+  embb_mutex_init(&that->mutex, EMBB_MUTEX_PLAIN);
+  return 1;
+}
+
+void embb_mtapi_network_poller_finalize(
+  embb_mtapi_network_poller_t * that) {
+  if (NULL != that->sockets) {
+    embb_mutex_destroy(&that->mutex);
+    embb_free(that->sockets);
+    embb_free(that->data);
+    that->sockets = NULL;
+    that->data = NULL;
+  }
+  that->count = 0;
+  that->capacity = 0;
+}
+
+int embb_mtapi_network_poller_add(
+  embb_mtapi_network_poller_t * that,
+  embb_mtapi_network_socket_t * socket,
+  void * data) {
+  int result = 0;
+  embb_mutex_lock(&that->mutex);
+  if (that->count < that->capacity) {
+    that->sockets[that->count] = *socket;
+    that->data[that->count] = data;
+    that->count++;
+    result = 1;
+  }
+  embb_mutex_unlock(&that->mutex);
+  return result;
+}
+
+void embb_mtapi_network_poller_remove(
+  embb_mtapi_network_poller_t * that,
+  embb_mtapi_network_socket_t * socket) {
+  int ii;
+  embb_mutex_lock(&that->mutex);
+  for (ii = 0; ii < that->count; ii++) {
+    if (that->sockets[ii].handle == socket->handle) {
+      that->count--;
+      that->sockets[ii] = that->sockets[that->count];
+      that->data[ii] = that->data[that->count];
+      break;
+    }
+  }
+  embb_mutex_unlock(&that->mutex);
+}
+
+int embb_mtapi_network_poller_wait(
+  embb_mtapi_network_poller_t * that,
+  void ** data,
+  int max_events,
+  int timeout) {
+  fd_set read_set;
+  embb_mtapi_network_socket_t max_fd = { 0 };
+  int count = 0;
+  int err;
+  int ii;
+  struct timeval tv;
+  tv.tv_sec = timeout / 1000;
+  tv.tv_usec = (timeout % 1000) * 1000;
+
+  FD_ZERO(&read_set);
+  embb_mutex_lock(&that->mutex);
+  for (ii = 0; ii < that->count; ii++) {
+#ifdef EMBB_PLATFORM_COMPILER_MSVC
+#pragma warning(push)
+#pragma warning(disable: 4548)
+#endif
+    FD_SET(that->sockets[ii].handle, &read_set);
+#ifdef EMBB_PLATFORM_COMPILER_MSVC
+#pragma warning(pop)
+#endif
+    if (that->sockets[ii].handle > max_fd.handle)
+      max_fd.handle = that->sockets[ii].handle;
+  }
+  embb_mutex_unlock(&that->mutex);
+
+  err = select((int)max_fd.handle + 1, &read_set, NULL, NULL,
+    (timeout >= 0) ? &tv : NULL);
+  if (0 >= err) {
+    return err;
+  }
+
+  embb_mutex_lock(&that->mutex);
+  for (ii = 0; ii < that->count && count < max_events; ii++) {
+    if (FD_ISSET(that->sockets[ii].handle, &read_set)) {
+      data[count] = that->data[ii];
+      count++;
+    }
+  }
+  embb_mutex_unlock(&that->mutex);
+
+  return count;
+}
+
+#endif /* EMBB_PLATFORM_HAS_HEADER_EPOLL */
@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2014, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef MTAPI_NETWORK_C_SRC_EMBB_MTAPI_NETWORK_POLLER_H_
+#define MTAPI_NETWORK_C_SRC_EMBB_MTAPI_NETWORK_POLLER_H_
+
+#include <embb/base/c/internal/config.h>
+#include <embb/base/c/mutex.h>
+#include <embb_mtapi_network_socket.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+/*
+ * Waits for incoming data on a set of sockets. Uses edge-triggered epoll
+ * where available and falls back to select otherwise. In both cases a socket
+ * has to be read until it would block before it is reported again.
+ */
+struct embb_mtapi_network_poller_struct {
+#ifdef EMBB_PLATFORM_HAS_HEADER_EPOLL
+  int handle;
+#else
+  embb_mutex_t mutex;
+  embb_mtapi_network_socket_t * sockets;
+  void ** data;
+  int count;
+  int capacity;
+#endif
+};
+
+typedef struct embb_mtapi_network_poller_struct embb_mtapi_network_poller_t;
+
+int embb_mtapi_network_poller_initialize(
+  embb_mtapi_network_poller_t * that,
+  int capacity
+);
+
+void embb_mtapi_network_poller_finalize(
+  embb_mtapi_network_poller_t * that
+);
+
+int embb_mtapi_network_poller_add(
+  embb_mtapi_network_poller_t * that,
+  embb_mtapi_network_socket_t * socket,
+  void * data
+);
+
+void embb_mtapi_network_poller_remove(
+  embb_mtapi_network_poller_t * that,
+  embb_mtapi_network_socket_t * socket
+);
+
+/*
+ * Stores the data pointers of up to max_events ready sockets in data and
+ * returns their number, 0 on timeout or -1 on error.
+ */
+int embb_mtapi_network_poller_wait(
+  embb_mtapi_network_poller_t * that,
+  void ** data,
+  int max_events,
+  int timeout
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MTAPI_NETWORK_C_SRC_EMBB_MTAPI_NETWORK_POLLER_H_
@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2014, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <embb_mtapi_network_shm.h>
+#include <embb/base/c/thread.h>
+#include <embb/base/c/time.h>
+#include <embb/base/c/internal/unused.h>
+#include <string.h>
+#include <stdio.h>
+#ifdef EMBB_PLATFORM_HAS_HEADER_MMAN
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+/* capacity of each direction, needs to be a power of two */
+#define EMBB_MTAPI_NETWORK_SHM_RING_SIZE (1u << 18)
+
+/* default time in milliseconds a writer waits for room in a full ring */
+#define EMBB_MTAPI_NETWORK_SHM_WRITE_TIMEOUT 10000
+
+#ifdef EMBB_PLATFORM_HAS_HEADER_MMAN
+
+static embb_atomic_int embb_mtapi_network_shm_counter = { 0 };
+
+static void embb_mtapi_network_shm_setup(
+  embb_mtapi_network_shm_t * that,
+  embb_mtapi_network_socket_t * socket,
+  int created) {
+  embb_mtapi_network_shm_ring_t * rings =
+    (embb_mtapi_network_shm_ring_t *)that->base;
+  char * data = (char*)(rings + 2);
+  // the creator writes into the first ring and reads from the second
+  that->tx = rings + (created ? 0 : 1);
+  that->tx_data = data + (created ? 0 : EMBB_MTAPI_NETWORK_SHM_RING_SIZE);
+  that->rx = rings + (created ? 1 : 0);
+  that->rx_data = data + (created ? EMBB_MTAPI_NETWORK_SHM_RING_SIZE : 0);
+  that->socket = socket;
+  that->closed = NULL;
+  that->write_timeout = EMBB_MTAPI_NETWORK_SHM_WRITE_TIMEOUT;
+  that->created = created;
+}
+
+int embb_mtapi_network_shm_create(
+  embb_mtapi_network_shm_t * that,
+  embb_mtapi_network_socket_t * socket) {
+  embb_mtapi_network_shm_ring_t * rings;
+  int fd;
+  int ii;
+
+  that->size = (unsigned int)(2 * sizeof(embb_mtapi_network_shm_ring_t) +
+    2 * EMBB_MTAPI_NETWORK_SHM_RING_SIZE);
+  snprintf(that->name, EMBB_MTAPI_NETWORK_SHM_NAME_SIZE,
+    "/embb_mtapi_network_%d_%d", (int)getpid(),
+    embb_atomic_fetch_and_add_int(&embb_mtapi_network_shm_counter, 1));
+
+  fd = shm_open(that->name, O_RDWR | O_CREAT | O_EXCL, S_IRUSR | S_IWUSR);
+  if (-1 == fd) {
+    return 0;
+  }
+  if (0 != ftruncate(fd, (off_t)that->size)) {
+    close(fd);
+    shm_unlink(that->name);
+    return 0;
+  }
+  that->base = mmap(NULL, that->size, PROT_READ | PROT_WRITE, MAP_SHARED,
+    fd, 0);
+  close(fd);
+  if (MAP_FAILED == that->base) {
+    shm_unlink(that->name);
+    return 0;
+  }
+
+  rings = (embb_mtapi_network_shm_ring_t *)that->base;
+  for (ii = 0; ii < 2; ii++) {
+    embb_atomic_store_unsigned_int(&rings[ii].head, 0);
+    embb_atomic_store_unsigned_int(&rings[ii].tail, 0);
+    // nobody reads yet, so the first write has to wake up the reader
+    embb_atomic_store_int(&rings[ii].waiting, 1);
+  }
+  embb_mtapi_network_shm_setup(that, socket, 1);
+  return 1;
+}
+
+int embb_mtapi_network_shm_attach(
+  embb_mtapi_network_shm_t * that,
+  embb_mtapi_network_socket_t * socket,
+  char const * name) {
+  struct stat info;
+  int fd;
+
+  that->size = (unsigned int)(2 * sizeof(embb_mtapi_network_shm_ring_t) +
+    2 * EMBB_MTAPI_NETWORK_SHM_RING_SIZE);
+  strncpy(that->name, name, EMBB_MTAPI_NETWORK_SHM_NAME_SIZE - 1);
+  that->name[EMBB_MTAPI_NETWORK_SHM_NAME_SIZE - 1] = '\0';
+
+  fd = shm_open(that->name, O_RDWR, 0);
+  if (-1 == fd) {
+    return 0;
+  }
+  // the peer might use a different ring size
+  if (0 != fstat(fd, &info) || (off_t)that->size != info.st_size) {
+    close(fd);
+    return 0;
+  }
+  that->base = mmap(NULL, that->size, PROT_READ | PROT_WRITE, MAP_SHARED,
+    fd, 0);
+  close(fd);
+  if (MAP_FAILED == that->base) {
+    return 0;
+  }
+  shm_unlink(that->name);
+  embb_mtapi_network_shm_setup(that, socket, 0);
+  return 1;
+}
+
+void embb_mtapi_network_shm_finalize(
+  embb_mtapi_network_shm_t * that) {
+  if (that->created) {
+    // in case the peer never attached
+    shm_unlink(that->name);
+  }
+  munmap(that->base, that->size);
+  that->base = NULL;
+}
+
+#else
+
+int embb_mtapi_network_shm_create(
+  embb_mtapi_network_shm_t * that,
+  embb_mtapi_network_socket_t * socket) {
+  EMBB_UNUSED(that);
+  EMBB_UNUSED(socket);
+  return 0;
+}
+
+int embb_mtapi_network_shm_attach(
+  embb_mtapi_network_shm_t * that,
+  embb_mtapi_network_socket_t * socket,
+  char const * name) {
+  EMBB_UNUSED(that);
+  EMBB_UNUSED(socket);
+  EMBB_UNUSED(name);
+  return 0;
+}
+
+void embb_mtapi_network_shm_finalize(
+  embb_mtapi_network_shm_t * that) {
+  EMBB_UNUSED(that);
+}
+
+#endif
+
+static int embb_mtapi_network_shm_wake_reader(
+  embb_mtapi_network_shm_t * that) {
+  // the swap orders the reader flag after the published tail
+  if (0 != embb_atomic_swap_int(&that->tx->waiting, 0)) {
+    char wake_up = 0;
+    embb_mtapi_network_iovec_t iov;
+    iov.data = &wake_up;
+    iov.size = 1;
+    return embb_mtapi_network_socket_sendv(that->socket, &iov, 1);
+  }
+  return 1;
+}
+
+int embb_mtapi_network_shm_writev(
+  embb_mtapi_network_shm_t * that,
+  embb_mtapi_network_iovec_t const * iov,
+  int count) {
+  embb_mtapi_network_shm_ring_t * ring = that->tx;
+  unsigned int tail = embb_atomic_load_unsigned_int(&ring->tail);
+  int total = 0;
+  int waiting = 0;
+  embb_time_t deadline;
+  embb_time_t now;
+  int ii;
+
+  for (ii = 0; ii < count; ii++) {
+    char const * data = (char const *)iov[ii].data;
+    unsigned int remaining = (unsigned int)iov[ii].size;
+    while (0 < remaining) {
+      unsigned int head = embb_atomic_load_unsigned_int(&ring->head);
+      unsigned int space = EMBB_MTAPI_NETWORK_SHM_RING_SIZE - (tail - head);
+      unsigned int offset = tail & (EMBB_MTAPI_NETWORK_SHM_RING_SIZE - 1);
+      unsigned int num;
+      if (0 == space) {
+        // the reader has been woken up already when the data was published,
+        // give up if it is gone or stuck instead of waiting forever
+        if (NULL != that->closed &&
+          0 != embb_atomic_load_int(that->closed)) {
+          return 0;
+        }
+        if (!waiting) {
+          embb_duration_t timeout;
+          embb_duration_set_milliseconds(&timeout, that->write_timeout);
+          embb_time_in(&deadline, &timeout);
+          waiting = 1;
+        } else {
+          embb_time_now(&now);
+          if (0 < embb_time_compare(&now, &deadline)) {
+            return 0;
+          }
+        }
+        embb_thread_yield();
+        continue;
+      }
+      // the reader made progress, restart the timeout on the next wait
+      waiting = 0;
+      num = (remaining < space) ? remaining : space;
+      if (num > EMBB_MTAPI_NETWORK_SHM_RING_SIZE - offset) {
+        num = EMBB_MTAPI_NETWORK_SHM_RING_SIZE - offset;
+      }
+      memcpy(that->tx_data + offset, data, num);
+      data += num;
+      remaining -= num;
+      tail += num;
+      total += (int)num;
+      embb_atomic_store_unsigned_int(&ring->tail, tail);
+      if (0 == embb_mtapi_network_shm_wake_reader(that)) {
+        return 0;
+      }
+    }
+  }
+  return total;
+}
+
+int embb_mtapi_network_shm_read(
+  embb_mtapi_network_shm_t * that,
+  void * data,
+  int size) {
+  embb_mtapi_network_shm_ring_t * ring = that->rx;
+  unsigned int head = embb_atomic_load_unsigned_int(&ring->head);
+  unsigned int available = embb_atomic_load_unsigned_int(&ring->tail) - head;
+  unsigned int num = ((unsigned int)size < available) ?
+    (unsigned int)size : available;
+  unsigned int offset = head & (EMBB_MTAPI_NETWORK_SHM_RING_SIZE - 1);
+  unsigned int first = EMBB_MTAPI_NETWORK_SHM_RING_SIZE - offset;
+
+  if (0 == num) {
+    return 0;
+  }
+  if (first > num) {
+    first = num;
+  }
+  memcpy(data, that->rx_data + offset, first);
+  memcpy((char*)data + first, that->rx_data, num - first);
+  embb_atomic_store_unsigned_int(&ring->head, head + num);
+  return (int)num;
+}
+
+int embb_mtapi_network_shm_wait(
+  embb_mtapi_network_shm_t * that) {
+  embb_mtapi_network_shm_ring_t * ring = that->rx;
+  embb_atomic_swap_int(&ring->waiting, 1);
+  if (embb_atomic_load_unsigned_int(&ring->tail) !=
+    embb_atomic_load_unsigned_int(&ring->head)) {
+    // the writer might have missed the flag, so take it back
+    embb_atomic_swap_int(&ring->waiting, 0);
+    return 0;
+  }
+  return 1;
+}
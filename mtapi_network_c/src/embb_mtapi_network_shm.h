@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2014, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef MTAPI_NETWORK_C_SRC_EMBB_MTAPI_NETWORK_SHM_H_
+#define MTAPI_NETWORK_C_SRC_EMBB_MTAPI_NETWORK_SHM_H_
+
+#include <embb/base/c/internal/config.h>
+#include <embb/base/c/atomic.h>
+#include <embb_mtapi_network_socket.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#define EMBB_MTAPI_NETWORK_SHM_NAME_SIZE 64
+
+/*
+ * One direction of a shared memory channel, a single producer single
+ * consumer byte ring. Positions count bytes and wrap around.
+ */
+struct embb_mtapi_network_shm_ring_struct {
+  embb_atomic_unsigned_int head;
+  char head_padding[EMBB_PLATFORM_CACHE_LINE_SIZE -
+    sizeof(embb_atomic_unsigned_int)];
+  embb_atomic_unsigned_int tail;
+  char tail_padding[EMBB_PLATFORM_CACHE_LINE_SIZE -
+    sizeof(embb_atomic_unsigned_int)];
+  // set by the reader before it waits for a wake up byte on the socket
+  embb_atomic_int waiting;
+  char waiting_padding[EMBB_PLATFORM_CACHE_LINE_SIZE - sizeof(embb_atomic_int)];
+};
+
+typedef struct embb_mtapi_network_shm_ring_struct
+  embb_mtapi_network_shm_ring_t;
+
+/*
+ * Carries the message stream of a connection between two processes on the
+ * same host. The socket of the connection stays open, it tells about the
+ * peer going away and carries a single byte to wake up a waiting reader.
+ */
+struct embb_mtapi_network_shm_struct {
+  void * base;
+  unsigned int size;
+  embb_mtapi_network_shm_ring_t * rx;
+  char * rx_data;
+  embb_mtapi_network_shm_ring_t * tx;
+  char * tx_data;
+  embb_mtapi_network_socket_t * socket;
+  /* set once the connection goes away, may be NULL */
+  embb_atomic_int * closed;
+  /* milliseconds a writer waits for the reader to make room */
+  unsigned int write_timeout;
+  int created;
+  char name[EMBB_MTAPI_NETWORK_SHM_NAME_SIZE];
+};
+
+typedef struct embb_mtapi_network_shm_struct embb_mtapi_network_shm_t;
+
+/*
+ * Creates a new named shared memory segment. Returns 0 if shared memory
+ * is not available.
+ */
+int embb_mtapi_network_shm_create(
+  embb_mtapi_network_shm_t * that,
+  embb_mtapi_network_socket_t * socket
+);
+
+/*
+ * Maps a segment created by the peer and removes its name, so the memory
+ * goes away with the last of both processes. Returns 0 on failure.
+ */
+int embb_mtapi_network_shm_attach(
+  embb_mtapi_network_shm_t * that,
+  embb_mtapi_network_socket_t * socket,
+  char const * name
+);
+
+void embb_mtapi_network_shm_finalize(
+  embb_mtapi_network_shm_t * that
+);
+
+/*
+ * Writes all given memory areas, waits while the ring is full. Only one
+ * thread may write at a time. Returns the number of bytes written or 0 if
+ * the wake up byte could not be sent, the closed flag got set or the reader
+ * made no room within the write timeout. The stream is unusable then.
+ */
+int embb_mtapi_network_shm_writev(
+  embb_mtapi_network_shm_t * that,
+  embb_mtapi_network_iovec_t const * iov,
+  int count
+);
+
+/*
+ * Reads up to size bytes, returns the number of bytes read, 0 if the ring
+ * is empty.
+ */
+int embb_mtapi_network_shm_read(
+  embb_mtapi_network_shm_t * that,
+  void * data,
+  int size
+);
+
+/*
+ * Announces that the reader is going to wait on the socket. Returns 0 if
+ * data arrived in between and the reader has to go on reading.
+ */
+int embb_mtapi_network_shm_wait(
+  embb_mtapi_network_shm_t * that
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // MTAPI_NETWORK_C_SRC_EMBB_MTAPI_NETWORK_SHM_H_
@@ -37,12 +37,18 @@
 #include <sys/time.h>
 #include <sys/socket.h>
 #include <sys/ioctl.h>
+#include <sys/uio.h>
+#include <poll.h>
+#include <fcntl.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include <unistd.h>
 #include <errno.h>
 #endif
 
+/* maximum number of memory areas handed to the system at once */
+#define EMBB_MTAPI_NETWORK_SOCKET_MAX_IOV 64
+
 int embb_mtapi_network_socket_initialize(
   embb_mtapi_network_socket_t * that) {
   that->handle = socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
@@ -65,6 +71,17 @@ void embb_mtapi_network_socket_finalize(
   }
 }
 
+void embb_mtapi_network_socket_shutdown(
+  embb_mtapi_network_socket_t * that) {
+  if (INVALID_SOCKET != that->handle) {
+#ifdef _WIN32
+    shutdown(that->handle, SD_BOTH);
+#else
+    shutdown(that->handle, SHUT_RDWR);
+#endif
+  }
+}
+
 int embb_mtapi_network_socket_bind_and_listen(
   embb_mtapi_network_socket_t * that,
   char const * host,
@@ -133,6 +150,75 @@ int embb_mtapi_network_socket_connect(
   return 1;
 }
 
+int embb_mtapi_network_socket_set_nonblocking(
+  embb_mtapi_network_socket_t * that) {
+#ifdef _WIN32
+  u_long mode = 1;
+  if (0 != ioctlsocket(that->handle, FIONBIO, &mode))
+    return 0;
+#else
+  int flags = fcntl(that->handle, F_GETFL, 0);
+  if (-1 == flags || -1 == fcntl(that->handle, F_SETFL, flags | O_NONBLOCK))
+    return 0;
+#endif
+  return 1;
+}
+
+int embb_mtapi_network_socket_is_local_peer(
+  embb_mtapi_network_socket_t * that) {
+  struct sockaddr_in local_addr;
+  struct sockaddr_in peer_addr;
+#ifdef _WIN32
+  int len;
+#else
+  socklen_t len;
+#endif
+
+  len = sizeof(local_addr);
+  if (SOCKET_ERROR == getsockname(that->handle,
+    (struct sockaddr *)&local_addr, &len)) {
+    return 0;
+  }
+  len = sizeof(peer_addr);
+  if (SOCKET_ERROR == getpeername(that->handle,
+    (struct sockaddr *)&peer_addr, &len)) {
+    return 0;
+  }
+  // loopback or one of our own interfaces
+  return (local_addr.sin_addr.s_addr == peer_addr.sin_addr.s_addr) ? 1 : 0;
+}
+
+static int embb_mtapi_network_socket_would_block() {
+#ifdef _WIN32
+  return (WSAEWOULDBLOCK == WSAGetLastError()) ? 1 : 0;
+#else
+  return (EAGAIN == errno || EWOULDBLOCK == errno) ? 1 : 0;
+#endif
+}
+
+static void embb_mtapi_network_socket_wait_writable(
+  embb_mtapi_network_socket_t * that) {
+#ifdef _WIN32
+  fd_set write_set;
+  FD_ZERO(&write_set);
+#ifdef EMBB_PLATFORM_COMPILER_MSVC
+#pragma warning(push)
+#pragma warning(disable: 4548)
+#endif
+  FD_SET(that->handle, &write_set);
+#ifdef EMBB_PLATFORM_COMPILER_MSVC
+#pragma warning(pop)
+#endif
+  select((int)that->handle + 1, NULL, &write_set, NULL, NULL);
+#else
+  struct pollfd fd;
+  fd.fd = that->handle;
+  fd.events = POLLOUT;
+  fd.revents = 0;
+  poll(&fd, 1, -1);
+#endif
+}
+
 int embb_mtapi_network_socket_select(
   embb_mtapi_network_socket_t * sockets,
   int count,
@@ -144,7 +230,7 @@ int embb_mtapi_network_socket_select(
   int ii;
   struct timeval tv;
   tv.tv_sec = timeout / 1000;
-  tv.tv_usec = timeout % 1000;
+  tv.tv_usec = (timeout % 1000) * 1000;
 
   FD_ZERO(&read_set);
   for (ii = 0; ii < count; ii++) {
@@ -188,11 +274,17 @@ int embb_mtapi_network_socket_sendbuffer(
   char * buf = (char*)(buffer->data);
   int cnt = 0;
   int result = send(that->handle, buf, buffer->size, 0);
-  while (result > 0) {
-    buf += result;
-    cnt += result;
-    if (cnt == buffer->size)
-      break;
+  while (result > 0 ||
+    (SOCKET_ERROR == result && embb_mtapi_network_socket_would_block())) {
+    if (result > 0) {
+      buf += result;
+      cnt += result;
+      if (cnt == buffer->size)
+        break;
+    } else {
+      /* non-blocking socket is full, wait until the peer catches up */
+      embb_mtapi_network_socket_wait_writable(that);
+    }
     result = send(that->handle, buf, buffer->size - cnt, 0);
   }
   if (cnt == buffer->size) {
@@ -202,6 +294,76 @@ int embb_mtapi_network_socket_sendbuffer(
   }
 }
 
+int embb_mtapi_network_socket_sendv(
+  embb_mtapi_network_socket_t * that,
+  embb_mtapi_network_iovec_t * iov,
+  int count) {
+#ifdef _WIN32
+  WSABUF vec[EMBB_MTAPI_NETWORK_SOCKET_MAX_IOV];
+  DWORD sent_bytes;
+#else
+  struct iovec vec[EMBB_MTAPI_NETWORK_SOCKET_MAX_IOV];
+  struct msghdr msg;
+#endif
+  int first = 0;
+  int cnt = 0;
+  int num;
+  int ii;
+  int result;
+
+  while (first < count) {
+    /* skip empty and completely sent areas */
+    if (0 == iov[first].size) {
+      first++;
+      continue;
+    }
+    num = count - first;
+    if (num > EMBB_MTAPI_NETWORK_SOCKET_MAX_IOV)
+      num = EMBB_MTAPI_NETWORK_SOCKET_MAX_IOV;
+#ifdef _WIN32
+    for (ii = 0; ii < num; ii++) {
+      vec[ii].buf = (char*)iov[first + ii].data;
+      vec[ii].len = (ULONG)iov[first + ii].size;
+    }
+    result = (0 == WSASend(that->handle, vec, (DWORD)num, &sent_bytes,
+      0, NULL, NULL)) ? (int)sent_bytes : SOCKET_ERROR;
+#else
+    for (ii = 0; ii < num; ii++) {
+      vec[ii].iov_base = (void*)iov[first + ii].data;
+      vec[ii].iov_len = (size_t)iov[first + ii].size;
+    }
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = vec;
+    msg.msg_iovlen = (size_t)num;
+#ifdef MSG_NOSIGNAL
+    result = (int)sendmsg(that->handle, &msg, MSG_NOSIGNAL);
+#else
+    result = (int)sendmsg(that->handle, &msg, 0);
+#endif
+#endif
+    if (result > 0) {
+      cnt += result;
+      /* consume what was sent */
+      while (first < count && result >= iov[first].size) {
+        result -= iov[first].size;
+        iov[first].size = 0;
+        first++;
+      }
+      if (first < count) {
+        iov[first].data = (char const*)iov[first].data + result;
+        iov[first].size -= result;
+      }
+    } else if (SOCKET_ERROR == result &&
+      embb_mtapi_network_socket_would_block()) {
+      embb_mtapi_network_socket_wait_writable(that);
+    } else {
+      return 0;
+    }
+  }
+
+  return cnt;
+}
+
 int embb_mtapi_network_socket_recvbuffer_sized(
   embb_mtapi_network_socket_t * that,
   embb_mtapi_network_buffer_t * buffer,
@@ -245,6 +407,37 @@ int embb_mtapi_network_socket_recvbuffer_sized(
   return buffer->size;
 }
 
+int embb_mtapi_network_socket_recv_some(
+  embb_mtapi_network_socket_t * that,
+  void * data,
+  int size) {
+  char * buf = (char*)data;
+  int cnt = 0;
+  while (cnt < size) {
+    int err = recv(that->handle, buf + cnt, size - cnt, 0);
+    if (err > 0) {
+      cnt += err;
+    } else if (SOCKET_ERROR == err && embb_mtapi_network_socket_would_block()) {
+      break;
+    } else {
+      /* connection closed by peer or failed, report data received so far */
+      return (cnt > 0) ? cnt : -1;
+    }
+  }
+  return cnt;
+}
+
+int embb_mtapi_network_socket_recv_available(
+  embb_mtapi_network_socket_t * that,
+  embb_mtapi_network_buffer_t * buffer) {
+  int cnt = embb_mtapi_network_socket_recv_some(that,
+    buffer->data + buffer->size, buffer->capacity - buffer->size);
+  if (cnt > 0) {
+    buffer->size += cnt;
+  }
+  return cnt;
+}
+
 int embb_mtapi_network_socket_recvbuffer(
   embb_mtapi_network_socket_t * that,
   embb_mtapi_network_buffer_t * buffer) {
@@ -49,6 +49,13 @@ struct embb_mtapi_network_socket_struct {
 
 typedef struct embb_mtapi_network_socket_struct embb_mtapi_network_socket_t;
 
+struct embb_mtapi_network_iovec_struct {
+  void const * data;
+  int size;
+};
+
+typedef struct embb_mtapi_network_iovec_struct embb_mtapi_network_iovec_t;
+
 int embb_mtapi_network_socket_initialize(
   embb_mtapi_network_socket_t * that
 );
@@ -57,6 +64,12 @@ void embb_mtapi_network_socket_finalize(
   embb_mtapi_network_socket_t * that
 );
 
+// Stops both directions without releasing the socket, the peer and the
+// poller see the connection closed.
+void embb_mtapi_network_socket_shutdown(
+  embb_mtapi_network_socket_t * that
+);
+
 int embb_mtapi_network_socket_bind_and_listen(
   embb_mtapi_network_socket_t * that,
   char const * host,
@@ -75,6 +88,17 @@ int embb_mtapi_network_socket_connect(
   uint16_t port
 );
 
+int embb_mtapi_network_socket_set_nonblocking(
+  embb_mtapi_network_socket_t * that
+);
+
+/*
+ * Returns 1 if a connected socket leads to a peer on the same host.
+ */
+int embb_mtapi_network_socket_is_local_peer(
+  embb_mtapi_network_socket_t * that
+);
+
 int embb_mtapi_network_socket_select(
   embb_mtapi_network_socket_t * sockets,
   int count,
@@ -86,6 +110,17 @@ int embb_mtapi_network_socket_sendbuffer(
   embb_mtapi_network_buffer_t * buffer
 );
 
+/*
+ * Sends all given memory areas with as few system calls as possible.
+ * The entries of iov are consumed while sending. Returns the number of bytes
+ * sent or 0 on error.
+ */
+int embb_mtapi_network_socket_sendv(
+  embb_mtapi_network_socket_t * that,
+  embb_mtapi_network_iovec_t * iov,
+  int count
+);
+
 int embb_mtapi_network_socket_recvbuffer(
   embb_mtapi_network_socket_t * that,
   embb_mtapi_network_buffer_t * buffer
@@ -97,6 +132,27 @@ int embb_mtapi_network_socket_recvbuffer_sized(
   int size
 );
 
+/*
+ * Reads up to size bytes from a non-blocking socket into data until the
+ * socket would block. Returns the number of bytes read or -1 if the
+ * connection was closed or failed.
+ */
+int embb_mtapi_network_socket_recv_some(
+  embb_mtapi_network_socket_t * that,
+  void * data,
+  int size
+);
+
+/*
+ * Appends whatever is available on a non-blocking socket to the buffer
+ * until the socket would block or the buffer is full. Returns the number of
+ * bytes appended or -1 if the connection was closed or failed.
+ */
+int embb_mtapi_network_socket_recv_available(
+  embb_mtapi_network_socket_t * that,
+  embb_mtapi_network_buffer_t * buffer
+);
+
 #ifdef __cplusplus
 }
 #endif
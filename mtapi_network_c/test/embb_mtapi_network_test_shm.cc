@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2014, Siemens AG. All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ * this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ * this list of conditions and the following disclaimer in the documentation
+ * and/or other materials provided with the distribution.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <embb_mtapi_network_test_shm.h>
+
+#include <embb_mtapi_network.h>
+#include <embb_mtapi_network_socket.h>
+#include <embb_mtapi_network_shm.h>
+
+#include <embb/base/c/internal/config.h>
+
+#include <cstring>
+#include <vector>
+
+
+NetworkShmTest::NetworkShmTest() {
+  CreateUnit("mtapi network shared memory test").Add(
+    &NetworkShmTest::TestBasic, this);
+}
+
+void NetworkShmTest::TestBasic() {
+#ifdef EMBB_PLATFORM_HAS_HEADER_MMAN
+  int err;
+  char wake_up;
+  char data[16];
+  embb_mtapi_network_iovec_t iov[2];
+  embb_mtapi_network_shm_t client_shm;
+  embb_mtapi_network_shm_t server_shm;
+  embb_mtapi_network_socket_t server_sock;
+  embb_mtapi_network_socket_t accept_sock;
+  embb_mtapi_network_socket_t client_sock;
+
+  err = embb_mtapi_network_initialize();
+  PT_EXPECT(err != 0);
+
+  err = embb_mtapi_network_socket_initialize(&server_sock);
+  PT_EXPECT(err != 0);
+  err = embb_mtapi_network_socket_bind_and_listen(
+    &server_sock, "127.0.0.1", 4713, 5);
+  PT_EXPECT(err != 0);
+  err = embb_mtapi_network_socket_initialize(&client_sock);
+  PT_EXPECT(err != 0);
+  err = embb_mtapi_network_socket_connect(&client_sock, "127.0.0.1", 4713);
+  PT_EXPECT(err != 0);
+  err = embb_mtapi_network_socket_accept(&server_sock, &accept_sock);
+  PT_EXPECT(err != 0);
+
+  err = embb_mtapi_network_socket_is_local_peer(&client_sock);
+  PT_EXPECT(err == 1);
+
+  err = embb_mtapi_network_shm_create(&client_shm, &client_sock);
+  PT_EXPECT(err != 0);
+  err = embb_mtapi_network_shm_attach(
+    &server_shm, &accept_sock, client_shm.name);
+  PT_EXPECT(err != 0);
+  // the name is gone once the peer attached
+  err = embb_mtapi_network_shm_attach(
+    &server_shm, &accept_sock, client_shm.name);
+  PT_EXPECT(err == 0);
+
+  // nobody read yet, so the first write wakes up the reader
+  iov[0].data = "hello";
+  iov[0].size = 5;
+  iov[1].data = " world";
+  iov[1].size = 6;
+  err = embb_mtapi_network_shm_writev(&client_shm, iov, 2);
+  PT_EXPECT(err == 11);
+  err = embb_mtapi_network_socket_recv_some(&accept_sock, &wake_up, 1);
+  PT_EXPECT(err == 1);
+
+  err = embb_mtapi_network_shm_read(&server_shm, data, 5);
+  PT_EXPECT(err == 5);
+  err = embb_mtapi_network_shm_read(&server_shm, data + 5, 16);
+  PT_EXPECT(err == 6);
+  PT_EXPECT(0 == memcmp(data, "hello world", 11));
+  err = embb_mtapi_network_shm_read(&server_shm, data, 16);
+  PT_EXPECT(err == 0);
+
+  // a busy reader is not woken up
+  err = embb_mtapi_network_socket_set_nonblocking(&accept_sock);
+  PT_EXPECT(err != 0);
+  err = embb_mtapi_network_shm_writev(&client_shm, iov, 1);
+  PT_EXPECT(err == 5);
+  err = embb_mtapi_network_socket_recv_some(&accept_sock, &wake_up, 1);
+  PT_EXPECT(err == 0);
+
+  // the reader may only wait once it has seen everything
+  err = embb_mtapi_network_shm_wait(&server_shm);
+  PT_EXPECT(err == 0);
+  err = embb_mtapi_network_shm_read(&server_shm, data, 16);
+  PT_EXPECT(err == 5);
+  err = embb_mtapi_network_shm_wait(&server_shm);
+  PT_EXPECT(err == 1);
+  err = embb_mtapi_network_shm_writev(&client_shm, iov + 1, 1);
+  PT_EXPECT(err == 6);
+  err = embb_mtapi_network_socket_recv_some(&accept_sock, &wake_up, 1);
+  PT_EXPECT(err == 1);
+  err = embb_mtapi_network_shm_read(&server_shm, data, 16);
+  PT_EXPECT(err == 6);
+
+  // stream enough data through the other direction to wrap around
+  std::vector<char> out(100000);
+  std::vector<char> in(out.size());
+  for (size_t ii = 0; ii < out.size(); ii++) {
+    out[ii] = static_cast<char>(ii * 7);
+  }
+  for (int round = 0; round < 8; round++) {
+    iov[0].data = &out[0];
+    iov[0].size = static_cast<int>(out.size());
+    err = embb_mtapi_network_shm_writev(&server_shm, iov, 1);
+    PT_EXPECT(err == static_cast<int>(out.size()));
+    int cnt = 0;
+    while (cnt < static_cast<int>(in.size())) {
+      err = embb_mtapi_network_shm_read(&client_shm, &in[cnt], 30000);
+      PT_EXPECT(err > 0);
+      if (err <= 0) break;
+      cnt += err;
+    }
+    PT_EXPECT(in == out);
+  }
+
+  // a writer does not wait forever for a reader that makes no room
+  std::vector<char> fill(1 << 19);
+  embb_atomic_int closed;
+  embb_atomic_store_int(&closed, 1);
+  iov[0].data = &fill[0];
+  iov[0].size = static_cast<int>(fill.size());
+  server_shm.closed = &closed;
+  err = embb_mtapi_network_shm_writev(&server_shm, iov, 1);
+  PT_EXPECT(err == 0);
+  embb_atomic_store_int(&closed, 0);
+  server_shm.write_timeout = 10;
+  err = embb_mtapi_network_shm_writev(&server_shm, iov, 1);
+  PT_EXPECT(err == 0);
+
+  embb_mtapi_network_shm_finalize(&server_shm);
+  embb_mtapi_network_shm_finalize(&client_shm);
+  embb_mtapi_network_socket_finalize(&client_sock);
+  embb_mtapi_network_socket_finalize(&accept_sock);
+  embb_mtapi_network_socket_finalize(&server_sock);
+
+  embb_mtapi_network_finalize();
+#endif
+}
@@ -89,6 +89,26 @@ void NetworkSocketTest::TestBasic() {
   PT_EXPECT(err == 4);
   PT_EXPECT(result == 0x12345678);
 
+  // scatter-gather send of several areas, the empty one is skipped
+  int16_t low = 0x4321;
+  int16_t high = 0x0765;
+  embb_mtapi_network_iovec_t iov[3];
+  iov[0].data = &low;
+  iov[0].size = 2;
+  iov[1].data = &low;
+  iov[1].size = 0;
+  iov[2].data = &high;
+  iov[2].size = 2;
+  err = embb_mtapi_network_socket_sendv(&client_sock, iov, 3);
+  PT_EXPECT(err == 4);
+
+  embb_mtapi_network_buffer_clear(&recv_buffer);
+  err = embb_mtapi_network_socket_recvbuffer(&accept_sock, &recv_buffer);
+  PT_EXPECT(err == 4);
+  err = embb_mtapi_network_buffer_pop_front_int32(&recv_buffer, &result);
+  PT_EXPECT(err == 4);
+  PT_EXPECT(result == 0x07654321);
+
   embb_mtapi_network_socket_finalize(&accept_sock);
   embb_mtapi_network_socket_finalize(&client_sock);
   embb_mtapi_network_socket_finalize(&server_sock);
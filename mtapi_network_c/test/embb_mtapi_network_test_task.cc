@@ -30,6 +30,8 @@
 #include <embb/mtapi/c/mtapi_network.h>
 #include <embb/base/c/internal/unused.h>
 
+#include <embb_mtapi_network_socket.h>
+
 
 #define MTAPI_CHECK_STATUS(status) PT_ASSERT(MTAPI_SUCCESS == status)
 
@@ -38,6 +40,8 @@
 #define NETWORK_LOCAL_JOB 3
 #define NETWORK_REMOTE_NODE 3
 #define NETWORK_REMOTE_JOB 4
+#define NETWORK_LOCAL_FAILING_JOB 5
+#define NETWORK_REMOTE_EMPTY_JOB 6
 
 
 static void test(
@@ -64,9 +68,45 @@ static void test(
 
 NetworkTaskTest::NetworkTaskTest() {
   CreateUnit("mtapi network task test").Add(&NetworkTaskTest::TestBasic, this);
+  CreateUnit("mtapi network shared memory task test")
+    .Add(&NetworkTaskTest::TestBasicSharedMemory, this);
+  CreateUnit("mtapi network credit test")
+    .Add(&NetworkTaskTest::TestCredits, this);
+  CreateUnit("mtapi network balanced task test")
+    .Add(&NetworkTaskTest::TestBalanced, this);
+  CreateUnit("mtapi network lost peer test")
+    .Add(&NetworkTaskTest::TestLostPeer, this);
+  CreateUnit("mtapi network reconnect test")
+    .Add(&NetworkTaskTest::TestReconnect, this);
+  CreateUnit("mtapi network throughput test")
+    .Add(&NetworkTaskTest::TestThroughput, this);
+  CreateUnit("mtapi network shared memory throughput test")
+    .Add(&NetworkTaskTest::TestThroughputSharedMemory, this);
 }
 
 void NetworkTaskTest::TestBasic() {
+  RunBasic(MTAPI_FALSE, 0);
+}
+
+void NetworkTaskTest::TestBasicSharedMemory() {
+  RunBasic(MTAPI_TRUE, 0);
+}
+
+void NetworkTaskTest::TestCredits() {
+  // more tasks are started than the peer accepts at once
+  RunBasic(MTAPI_FALSE, 2);
+}
+
+void NetworkTaskTest::TestThroughput() {
+  RunThroughput(MTAPI_FALSE);
+}
+
+void NetworkTaskTest::TestThroughputSharedMemory() {
+  RunThroughput(MTAPI_TRUE);
+}
+
+void NetworkTaskTest::RunBasic(mtapi_boolean_t shared_memory,
+  mtapi_uint_t credits) {
   mtapi_status_t status;
   mtapi_job_hndl_t job;
   mtapi_task_hndl_t task;
@@ -93,6 +133,13 @@ void NetworkTaskTest::TestBasic() {
     kElements * 4 * 3 + 32, &status);
   MTAPI_CHECK_STATUS(status);
 
+  // local peers talk through shared memory unless told otherwise
+  mtapi_network_plugin_set_shared_memory(shared_memory, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_network_plugin_set_credits(credits, &status);
+  MTAPI_CHECK_STATUS(status);
+
   float node_remote = 1.0f;
   local_action = mtapi_action_create(
     NETWORK_REMOTE_JOB,
@@ -131,6 +178,342 @@ void NetworkTaskTest::TestBasic() {
     PT_EXPECT_EQ(results[ii], ii * 2 + 1);
   }
 
+  // several requests in flight at once arrive back to back on one
+  // connection and have to be split up by the receiver
+  const int kTasks = 16;
+  float many_results[kTasks][kElements];
+  mtapi_task_hndl_t tasks[kTasks];
+  for (int tt = 0; tt < kTasks; tt++) {
+    tasks[tt] = mtapi_task_start(
+      MTAPI_TASK_ID_NONE,
+      job,
+      arguments, kElements * 2 * sizeof(float),
+      many_results[tt], kElements*sizeof(float),
+      MTAPI_DEFAULT_TASK_ATTRIBUTES,
+      MTAPI_GROUP_NONE,
+      &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+  for (int tt = 0; tt < kTasks; tt++) {
+    mtapi_task_wait(tasks[tt], MTAPI_INFINITE, &status);
+    MTAPI_CHECK_STATUS(status);
+    for (int ii = 0; ii < kElements; ii++) {
+      PT_EXPECT_EQ(many_results[tt][ii], ii * 2 + 1);
+    }
+  }
+
+  // the remote job has no action, so the peer cannot start the task and
+  // has to report the failure instead of leaving the task pending
+  mtapi_action_hndl_t failing_action = mtapi_network_action_create(
+    NETWORK_DOMAIN,
+    NETWORK_LOCAL_FAILING_JOB,
+    NETWORK_REMOTE_EMPTY_JOB,
+    "127.0.0.1", 12345,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_job_hndl_t failing_job = mtapi_job_get(
+    NETWORK_LOCAL_FAILING_JOB, NETWORK_DOMAIN, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  for (int tt = 0; tt < 2; tt++) {
+    task = mtapi_task_start(
+      MTAPI_TASK_ID_NONE,
+      failing_job,
+      arguments, kElements * 2 * sizeof(float),
+      results, kElements*sizeof(float),
+      MTAPI_DEFAULT_TASK_ATTRIBUTES,
+      MTAPI_GROUP_NONE,
+      &status);
+    MTAPI_CHECK_STATUS(status);
+
+    mtapi_task_wait(task, MTAPI_INFINITE, &status);
+    PT_EXPECT_EQ(status, MTAPI_ERR_ACTION_INVALID);
+  }
+
+  mtapi_action_delete(failing_action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_action_delete(network_action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_action_delete(local_action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_network_plugin_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+}
+
+void NetworkTaskTest::TestBalanced() {
+  mtapi_status_t status;
+  mtapi_job_hndl_t job;
+  mtapi_action_hndl_t network_action, local_action;
+
+  const int kElements = 64;
+  const int kPeers = 3;
+  const int kTasks = 24;
+  float arguments[kElements * 2];
+  float results[kTasks][kElements];
+  mtapi_task_hndl_t tasks[kTasks];
+  // all peers lead to this node, each over its own connection
+  char const * hosts[kPeers];
+  mtapi_uint16_t ports[kPeers];
+  for (int pp = 0; pp < kPeers; pp++) {
+    hosts[pp] = "127.0.0.1";
+    ports[pp] = 12347;
+  }
+
+  for (int ii = 0; ii < kElements; ii++) {
+    arguments[ii] = static_cast<float>(ii);
+    arguments[ii + kElements] = static_cast<float>(ii);
+  }
+
+  mtapi_initialize(
+    NETWORK_DOMAIN,
+    NETWORK_LOCAL_NODE,
+    MTAPI_NULL,
+    MTAPI_NULL,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_network_plugin_initialize("127.0.0.1", 12347, 16,
+    kElements * 4 * 3 + 32, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  float node_remote = 1.0f;
+  local_action = mtapi_action_create(
+    NETWORK_REMOTE_JOB,
+    test,
+    &node_remote, sizeof(float),
+    MTAPI_DEFAULT_ACTION_ATTRIBUTES,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  network_action = mtapi_network_action_create_balanced(
+    NETWORK_DOMAIN,
+    NETWORK_LOCAL_JOB,
+    NETWORK_REMOTE_JOB,
+    hosts, ports, 0,
+    MTAPI_NETWORK_DISPATCH_ROUND_ROBIN, 0,
+    &status);
+  PT_EXPECT_EQ(status, MTAPI_ERR_PARAMETER);
+
+  network_action = mtapi_network_action_create_balanced(
+    NETWORK_DOMAIN,
+    NETWORK_LOCAL_JOB,
+    NETWORK_REMOTE_JOB,
+    hosts, ports, kPeers,
+    MTAPI_NETWORK_DISPATCH_LATENCY_WEIGHTED + 1, 0,
+    &status);
+  PT_EXPECT_EQ(status, MTAPI_ERR_PARAMETER);
+
+  for (mtapi_uint_t dispatch = MTAPI_NETWORK_DISPATCH_ROUND_ROBIN;
+    dispatch <= MTAPI_NETWORK_DISPATCH_LATENCY_WEIGHTED; dispatch++) {
+    // at most 2 tasks per peer, so starting blocks now and then
+    network_action = mtapi_network_action_create_balanced(
+      NETWORK_DOMAIN,
+      NETWORK_LOCAL_JOB,
+      NETWORK_REMOTE_JOB,
+      hosts, ports, kPeers,
+      dispatch, 2,
+      &status);
+    MTAPI_CHECK_STATUS(status);
+
+    job = mtapi_job_get(NETWORK_LOCAL_JOB, NETWORK_DOMAIN, &status);
+    MTAPI_CHECK_STATUS(status);
+
+    for (int tt = 0; tt < kTasks; tt++) {
+      tasks[tt] = mtapi_task_start(
+        MTAPI_TASK_ID_NONE,
+        job,
+        arguments, kElements * 2 * sizeof(float),
+        results[tt], kElements * sizeof(float),
+        MTAPI_DEFAULT_TASK_ATTRIBUTES,
+        MTAPI_GROUP_NONE,
+        &status);
+      MTAPI_CHECK_STATUS(status);
+    }
+    for (int tt = 0; tt < kTasks; tt++) {
+      mtapi_task_wait(tasks[tt], MTAPI_INFINITE, &status);
+      MTAPI_CHECK_STATUS(status);
+      for (int ii = 0; ii < kElements; ii++) {
+        PT_EXPECT_EQ(results[tt][ii], ii * 2 + 1);
+      }
+    }
+
+    mtapi_action_delete(network_action, MTAPI_INFINITE, &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+
+  mtapi_action_delete(local_action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_network_plugin_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+}
+
+void NetworkTaskTest::TestReconnect() {
+  mtapi_status_t status;
+  mtapi_job_hndl_t job;
+  mtapi_task_hndl_t task;
+  mtapi_action_hndl_t network_action, local_action;
+
+  const int kElements = 64;
+  // more connections than the plugin has slots for over time
+  const int kRounds = 10;
+  float arguments[kElements * 2];
+  float results[kElements];
+
+  for (int ii = 0; ii < kElements; ii++) {
+    arguments[ii] = static_cast<float>(ii);
+    arguments[ii + kElements] = static_cast<float>(ii);
+  }
+
+  mtapi_initialize(
+    NETWORK_DOMAIN,
+    NETWORK_LOCAL_NODE,
+    MTAPI_NULL,
+    MTAPI_NULL,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_network_plugin_initialize("127.0.0.1", 12350, 2,
+    kElements * 4 * 3 + 32, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  float node_remote = 1.0f;
+  local_action = mtapi_action_create(
+    NETWORK_REMOTE_JOB,
+    test,
+    &node_remote, sizeof(float),
+    MTAPI_DEFAULT_ACTION_ATTRIBUTES,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  for (int rr = 0; rr < kRounds; rr++) {
+    // slots of the connections of the previous round are reused
+    network_action = mtapi_network_action_create(
+      NETWORK_DOMAIN,
+      NETWORK_LOCAL_JOB,
+      NETWORK_REMOTE_JOB,
+      "127.0.0.1", 12350,
+      &status);
+    MTAPI_CHECK_STATUS(status);
+
+    job = mtapi_job_get(NETWORK_LOCAL_JOB, NETWORK_DOMAIN, &status);
+    MTAPI_CHECK_STATUS(status);
+
+    task = mtapi_task_start(
+      MTAPI_TASK_ID_NONE,
+      job,
+      arguments, kElements * 2 * sizeof(float),
+      results, kElements * sizeof(float),
+      MTAPI_DEFAULT_TASK_ATTRIBUTES,
+      MTAPI_GROUP_NONE,
+      &status);
+    MTAPI_CHECK_STATUS(status);
+
+    mtapi_task_wait(task, MTAPI_INFINITE, &status);
+    MTAPI_CHECK_STATUS(status);
+
+    for (int ii = 0; ii < kElements; ii++) {
+      PT_EXPECT_EQ(results[ii], ii * 2 + 1);
+    }
+
+    mtapi_action_delete(network_action, MTAPI_INFINITE, &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+
+  mtapi_action_delete(local_action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_network_plugin_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+}
+
+void NetworkTaskTest::RunThroughput(mtapi_boolean_t shared_memory) {
+  mtapi_status_t status;
+  mtapi_job_hndl_t job;
+  mtapi_action_hndl_t network_action, local_action;
+
+  // loopback round trips with medium sized payloads, run this unit alone
+  // to compare the cost of the receive path
+  const int kElements = 1024;
+  const int kTasks = 2000;
+  const int kInFlight = 16;
+  float * arguments = new float[kElements * 2];
+  float * results = new float[kElements * kInFlight];
+  mtapi_task_hndl_t tasks[kInFlight];
+
+  for (int ii = 0; ii < kElements; ii++) {
+    arguments[ii] = static_cast<float>(ii);
+    arguments[ii + kElements] = static_cast<float>(ii);
+  }
+
+  mtapi_initialize(
+    NETWORK_DOMAIN,
+    NETWORK_LOCAL_NODE,
+    MTAPI_NULL,
+    MTAPI_NULL,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_network_plugin_initialize("127.0.0.1", 12346, 5,
+    kElements * 4 * 3 + 32, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_network_plugin_set_shared_memory(shared_memory, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  float node_remote = 1.0f;
+  local_action = mtapi_action_create(
+    NETWORK_REMOTE_JOB,
+    test,
+    &node_remote, sizeof(float),
+    MTAPI_DEFAULT_ACTION_ATTRIBUTES,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  network_action = mtapi_network_action_create(
+    NETWORK_DOMAIN,
+    NETWORK_LOCAL_JOB,
+    NETWORK_REMOTE_JOB,
+    "127.0.0.1", 12346,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  job = mtapi_job_get(NETWORK_LOCAL_JOB, NETWORK_DOMAIN, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  for (int tt = 0; tt < kTasks; tt += kInFlight) {
+    for (int ff = 0; ff < kInFlight; ff++) {
+      tasks[ff] = mtapi_task_start(
+        MTAPI_TASK_ID_NONE,
+        job,
+        arguments, kElements * 2 * sizeof(float),
+        results + ff * kElements, kElements * sizeof(float),
+        MTAPI_DEFAULT_TASK_ATTRIBUTES,
+        MTAPI_GROUP_NONE,
+        &status);
+      MTAPI_CHECK_STATUS(status);
+    }
+    for (int ff = 0; ff < kInFlight; ff++) {
+      mtapi_task_wait(tasks[ff], MTAPI_INFINITE, &status);
+      MTAPI_CHECK_STATUS(status);
+      PT_EXPECT_EQ(results[ff * kElements + kElements - 1],
+        (kElements - 1) * 2 + 1);
+    }
+  }
+
   mtapi_action_delete(network_action, MTAPI_INFINITE, &status);
   MTAPI_CHECK_STATUS(status);
 
@@ -142,4 +525,126 @@ void NetworkTaskTest::TestBasic() {
 
   mtapi_finalize(&status);
   MTAPI_CHECK_STATUS(status);
+
+  delete[] arguments;
+  delete[] results;
+}
+
+void NetworkTaskTest::TestLostPeer() {
+  mtapi_status_t status;
+  mtapi_job_hndl_t job;
+  mtapi_action_hndl_t network_action;
+  embb_mtapi_network_socket_t server_sock;
+  embb_mtapi_network_socket_t peer_sock;
+  int err;
+
+  const int kElements = 64;
+  const int kTasks = 8;
+  const int kLateTasks = 8;
+  float arguments[kElements * 2];
+  float results[kTasks + kLateTasks][kElements];
+  mtapi_task_hndl_t tasks[kTasks + kLateTasks];
+  bool started[kTasks + kLateTasks];
+
+  for (int ii = 0; ii < kElements * 2; ii++) {
+    arguments[ii] = static_cast<float>(ii);
+  }
+
+  mtapi_initialize(
+    NETWORK_DOMAIN,
+    NETWORK_LOCAL_NODE,
+    MTAPI_NULL,
+    MTAPI_NULL,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_network_plugin_initialize("127.0.0.1", 12348, 5,
+    kElements * 4 * 3 + 32, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  // the peer below does not speak shared memory
+  mtapi_network_plugin_set_shared_memory(MTAPI_FALSE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  // a peer that accepts tasks, but goes away without answering them
+  err = embb_mtapi_network_socket_initialize(&server_sock);
+  PT_ASSERT(err != 0);
+  err = embb_mtapi_network_socket_bind_and_listen(
+    &server_sock, "127.0.0.1", 12349, 5);
+  PT_ASSERT(err != 0);
+
+  // the peer grants no credits, so all tasks are sent right away
+  network_action = mtapi_network_action_create(
+    NETWORK_DOMAIN,
+    NETWORK_LOCAL_JOB,
+    NETWORK_REMOTE_JOB,
+    "127.0.0.1", 12349,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  err = embb_mtapi_network_socket_accept(&server_sock, &peer_sock);
+  PT_ASSERT(err != 0);
+
+  job = mtapi_job_get(NETWORK_LOCAL_JOB, NETWORK_DOMAIN, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  for (int tt = 0; tt < kTasks; tt++) {
+    tasks[tt] = mtapi_task_start(
+      MTAPI_TASK_ID_NONE,
+      job,
+      arguments, kElements * 2 * sizeof(float),
+      results[tt], kElements * sizeof(float),
+      MTAPI_DEFAULT_TASK_ATTRIBUTES,
+      MTAPI_GROUP_NONE,
+      &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+
+  // wait until the first task arrived, then drop the connection
+  err = embb_mtapi_network_socket_select(&peer_sock, 1, 10000);
+  PT_EXPECT_EQ(err, 0);
+  embb_mtapi_network_socket_finalize(&peer_sock);
+  embb_mtapi_network_socket_finalize(&server_sock);
+
+  // tasks started while the connection goes down either fail to start,
+  // fail to be sent or are failed when the connection is closed
+  for (int tt = kTasks; tt < kTasks + kLateTasks; tt++) {
+    tasks[tt] = mtapi_task_start(
+      MTAPI_TASK_ID_NONE,
+      job,
+      arguments, kElements * 2 * sizeof(float),
+      results[tt], kElements * sizeof(float),
+      MTAPI_DEFAULT_TASK_ATTRIBUTES,
+      MTAPI_GROUP_NONE,
+      &status);
+    started[tt] = (MTAPI_SUCCESS == status);
+  }
+
+  // none of the tasks can complete, but all waits have to return
+  for (int tt = 0; tt < kTasks + kLateTasks; tt++) {
+    if (tt < kTasks || started[tt]) {
+      mtapi_task_wait(tasks[tt], 10000, &status);
+      PT_EXPECT_EQ(status, MTAPI_ERR_ACTION_FAILED);
+    }
+  }
+
+  // there is no peer left to send new tasks to
+  mtapi_task_start(
+    MTAPI_TASK_ID_NONE,
+    job,
+    arguments, kElements * 2 * sizeof(float),
+    results[0], kElements * sizeof(float),
+    MTAPI_DEFAULT_TASK_ATTRIBUTES,
+    MTAPI_GROUP_NONE,
+    &status);
+  PT_EXPECT_NE(status, MTAPI_SUCCESS);
+
+  mtapi_action_delete(network_action, 10000, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_network_plugin_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
 }
@@ -28,6 +28,7 @@
 #define MTAPI_NETWORK_C_TEST_EMBB_MTAPI_NETWORK_TEST_TASK_H_
 
 #include <partest/partest.h>
+#include <embb/mtapi/c/mtapi.h>
 
 class NetworkTaskTest : public partest::TestCase {
  public:
@@ -35,6 +36,16 @@ class NetworkTaskTest : public partest::TestCase {
 
  private:
   void TestBasic();
+  void TestBasicSharedMemory();
+  void TestCredits();
+  void TestBalanced();
+  void TestLostPeer();
+  void TestReconnect();
+  void TestThroughput();
+  void TestThroughputSharedMemory();
+
+  void RunBasic(mtapi_boolean_t shared_memory, mtapi_uint_t credits);
+  void RunThroughput(mtapi_boolean_t shared_memory);
 };
 
 #endif // MTAPI_NETWORK_C_TEST_EMBB_MTAPI_NETWORK_TEST_TASK_H_
@@ -28,10 +28,14 @@
 
 #include <embb_mtapi_network_test_buffer.h>
 #include <embb_mtapi_network_test_socket.h>
+#include <embb_mtapi_network_test_poller.h>
+#include <embb_mtapi_network_test_shm.h>
 #include <embb_mtapi_network_test_task.h>
 
 PT_MAIN("MTAPI NETWORK") {
   PT_RUN(NetworkBufferTest);
   PT_RUN(NetworkSocketTest);
+  PT_RUN(NetworkPollerTest);
+  PT_RUN(NetworkShmTest);
   PT_RUN(NetworkTaskTest);
 }
@@ -73,6 +73,31 @@ void mtapi_opencl_plugin_initialize(
                                             may be \c MTAPI_NULL */
 );
 
+/**
+ * Enables or disables zero-copy task buffers for OpenCL actions created
+ * afterwards.
+ *
+ * By default, the arguments and results of a task are copied between the
+ * task's buffers and device buffers, which are taken from a pool per action
+ * and reused by later tasks. If enabled and the device shares memory with
+ * the host, e.g. a CPU device, the device works directly on the task's
+ * buffers and the results are mapped instead of copied. On other devices,
+ * the setting has no effect.
+ *
+ * On success, \c *status is set to \c MTAPI_SUCCESS.
+ *
+ * \see mtapi_opencl_action_create()
+ *
+ * \notthreadsafe
+ * \ingroup C_MTAPI_OPENCL
+ */
+void mtapi_opencl_plugin_set_host_memory(
+  MTAPI_IN mtapi_boolean_t enable,     /**< [in] \c MTAPI_TRUE to work on
+                                            host memory if possible */
+  MTAPI_OUT mtapi_status_t* status     /**< [out] Pointer to error code,
+                                            may be \c MTAPI_NULL */
+);
+
 /**
  * Finalizes the MTAPI OpenCL environment on the local MTAPI node.
  *
@@ -189,6 +214,58 @@ mtapi_action_hndl_t mtapi_opencl_action_create(
                                             may be \c MTAPI_NULL */
 );
 
+/**
+ * This function creates an OpenCL action that launches several tasks with
+ * one kernel invocation.
+ *
+ * It behaves like mtapi_opencl_action_create(), but collects tasks with
+ * equal argument and result sizes into batches of up to \c max_batch_size
+ * tasks. The arguments of a batch are copied to the device at once. The
+ * kernel runs on a two dimensional range with one row per task, and all
+ * results are read back at once. The tasks of a batch complete together.
+ *
+ * The kernel receives the packed buffers of the whole batch. The arguments
+ * and result sizes passed to it are those of a single task, and task
+ * \c get_global_id(1) works on the data at that many times these sizes.
+ * Such a kernel also works unbatched, where \c get_global_id(1) is 0.
+ *
+ * A batch is launched as soon as it is full or no other batch of the
+ * action is running. Otherwise it waits for a running batch to complete,
+ * or for another task arriving more than \c max_batch_delay microseconds
+ * after its first task. A \c max_batch_delay of 0 disables the time limit.
+ * A \c max_batch_size below 2 disables batching.
+ *
+ * On success, an action handle is returned and \c *status is set to
+ * \c MTAPI_SUCCESS. On error, \c *status is set to the error codes
+ * described for mtapi_opencl_action_create().
+ *
+ * \see mtapi_opencl_action_create(), mtapi_action_delete()
+ *
+ * \returns Handle to newly created OpenCL action, invalid handle on error
+ * \threadsafe
+ * \ingroup C_MTAPI_OPENCL
+ */
+mtapi_action_hndl_t mtapi_opencl_action_create_batched(
+  MTAPI_IN mtapi_job_id_t job_id,      /**< [in] Job id */
+  MTAPI_IN char* kernel_source,        /**< [in] Pointer to kernel source */
+  MTAPI_IN char* kernel_name,          /**< [in] Name of the kernel function */
+  MTAPI_IN mtapi_size_t local_work_size,
+                                       /**< [in] Size of local work group */
+  MTAPI_IN mtapi_size_t element_size,  /**< [in] Size of one element in the
+                                            result buffer */
+  MTAPI_IN void* node_local_data,      /**< [in] Data shared across tasks */
+  MTAPI_IN mtapi_size_t node_local_data_size,
+                                       /**< [in] Size of shared data */
+  MTAPI_IN mtapi_uint_t max_batch_size,
+                                       /**< [in] Maximum tasks per kernel
+                                            launch */
+  MTAPI_IN mtapi_uint_t max_batch_delay,
+                                       /**< [in] Maximum time in microseconds
+                                            a task waits for more tasks */
+  MTAPI_OUT mtapi_status_t* status     /**< [out] Pointer to error code,
+                                            may be \c MTAPI_NULL */
+);
+
 
 #ifdef __cplusplus
 }
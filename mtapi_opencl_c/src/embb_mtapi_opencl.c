@@ -29,6 +29,9 @@
 #include <assert.h>
 
 #include <embb/base/c/memory_allocation.h>
+#include <embb/base/c/core_set.h>
+#include <embb/base/c/atomic.h>
+#include <embb/base/c/time.h>
 #include <embb/mtapi/c/mtapi_ext.h>
 #include <embb/base/c/internal/unused.h>
 
@@ -39,39 +42,130 @@
 #include <embb_mtapi_task_t.h>
 #include <embb_mtapi_action_t.h>
 #include <embb_mtapi_node_t.h>
+#include <embb_mtapi_spinlock_t.h>
 #include <mtapi_status_t.h>
 
+// buffers are pooled in power of two size classes starting at 64 bytes
+#define EMBB_MTAPI_OPENCL_POOL_MIN_CLASS 6
+#define EMBB_MTAPI_OPENCL_POOL_CLASSES 32
+
+// tasks are submitted round robin to one command queue per core
+#define EMBB_MTAPI_OPENCL_MAX_COMMAND_QUEUES 8
+
 struct embb_mtapi_opencl_plugin_struct {
   cl_platform_id platform_id;
   cl_device_id device_id;
   cl_context context;
-  cl_command_queue command_queue;
+  cl_command_queue command_queues[EMBB_MTAPI_OPENCL_MAX_COMMAND_QUEUES];
+  int num_command_queues;
+  embb_atomic_int next_command_queue;
   size_t work_group_size;
   size_t work_item_sizes[3];
+  // device works on host memory, e.g. a CPU device
+  cl_bool unified_memory;
+  // wrap task buffers instead of copying them, if possible
+  mtapi_boolean_t use_host_memory;
 };
 
 typedef struct embb_mtapi_opencl_plugin_struct embb_mtapi_opencl_plugin_t;
 
 static embb_mtapi_opencl_plugin_t embb_mtapi_opencl_plugin;
 
+struct embb_mtapi_opencl_buffer_struct {
+  cl_mem mem;
+  int size_class;
+  struct embb_mtapi_opencl_buffer_struct * next;
+};
+
+typedef struct embb_mtapi_opencl_buffer_struct embb_mtapi_opencl_buffer_t;
+
+struct embb_mtapi_opencl_buffer_pool_struct {
+  embb_mtapi_spinlock_t lock;
+  cl_mem_flags flags;
+  embb_mtapi_opencl_buffer_t * free_list[EMBB_MTAPI_OPENCL_POOL_CLASSES];
+};
+
+typedef struct embb_mtapi_opencl_buffer_pool_struct
+  embb_mtapi_opencl_buffer_pool_t;
+
+struct embb_mtapi_opencl_kernel_struct {
+  cl_kernel kernel;
+  struct embb_mtapi_opencl_kernel_struct * next;
+};
+
+typedef struct embb_mtapi_opencl_kernel_struct embb_mtapi_opencl_kernel_t;
+
+struct embb_mtapi_opencl_batch_struct;
+
 struct embb_mtapi_opencl_action_struct {
   cl_program program;
-  cl_kernel kernel;
+  char * kernel_name;
+  // kernel objects not used by a starting task, each holds its own
+  // arguments
+  embb_mtapi_spinlock_t kernel_lock;
+  embb_mtapi_opencl_kernel_t * free_kernels;
   cl_mem node_local_data;
   int node_local_data_size;
   size_t local_work_size;
   size_t element_size;
+  mtapi_boolean_t use_host_memory;
+  embb_mtapi_opencl_buffer_pool_t arguments_pool;
+  embb_mtapi_opencl_buffer_pool_t results_pool;
+  // tasks per kernel launch, 0 launches each task on its own
+  int max_batch_size;
+  // microseconds a task may wait for more tasks while others run
+  int max_batch_delay;
+  embb_mtapi_spinlock_t batch_lock;
+  // collects tasks until it is launched
+  struct embb_mtapi_opencl_batch_struct * pending_batch;
+  int running_batches;
 };
 
 typedef struct embb_mtapi_opencl_action_struct embb_mtapi_opencl_action_t;
 
+// Tasks of equal argument and result sizes launched as one kernel, task ii
+// works on the data at ii times the sizes.
+struct embb_mtapi_opencl_batch_struct {
+  embb_mtapi_opencl_action_t * action;
+  int count;
+  int arguments_size;
+  int result_size;
+  // arrival of the first task
+  embb_time_t started;
+  // hand over of the batch to a command queue
+  embb_time_t launched;
+  // packed host copies of all arguments and results
+  char * arguments;
+  char * results;
+  embb_mtapi_opencl_buffer_t * device_arguments;
+  embb_mtapi_opencl_buffer_t * device_results;
+  cl_event finish_event;
+  // action accounting the tasks, valid until they all finished
+  mtapi_action_hndl_t local_action;
+  mtapi_task_hndl_t * tasks;
+  void ** result_buffers;
+};
+
+typedef struct embb_mtapi_opencl_batch_struct embb_mtapi_opencl_batch_t;
+
 struct embb_mtapi_opencl_task_struct {
   cl_mem arguments;
   int arguments_size;
   cl_mem result_buffer;
   int result_buffer_size;
+  // pool entries backing the buffers, NULL when using host memory
+  embb_mtapi_opencl_buffer_t * pooled_arguments;
+  embb_mtapi_opencl_buffer_t * pooled_result_buffer;
+  // result buffer mapped into host memory until the task completes
+  void * mapped_result_buffer;
   cl_event kernel_finish_event;
+  cl_command_queue command_queue;
+  // hand over of the task to the command queue
+  embb_time_t launched;
   mtapi_task_hndl_t task;
+  // action accounting the task, valid until it finished
+  mtapi_action_hndl_t local_action;
+  embb_mtapi_opencl_action_t * action;
 };
 
 typedef struct embb_mtapi_opencl_task_struct embb_mtapi_opencl_task_t;
@@ -85,46 +179,695 @@ static size_t round_up(size_t group_size, size_t global_size) {
   }
 }
 
-static void CL_API_CALL opencl_task_complete(
-  cl_event ev, cl_int status, void * data) {
-  EMBB_UNUSED(ev);
-  EMBB_UNUSED(status);
+static void embb_mtapi_opencl_buffer_pool_initialize(
+  embb_mtapi_opencl_buffer_pool_t * that,
+  cl_mem_flags flags) {
+  int ii;
+  embb_mtapi_spinlock_initialize(&that->lock);
+  that->flags = flags;
+  for (ii = 0; ii < EMBB_MTAPI_OPENCL_POOL_CLASSES; ii++) {
+    that->free_list[ii] = NULL;
+  }
+}
+
+static void embb_mtapi_opencl_buffer_pool_finalize(
+  embb_mtapi_opencl_buffer_pool_t * that) {
+  cl_int err;
+  int ii;
+  EMBB_UNUSED_IN_RELEASE(err);
+
+  for (ii = 0; ii < EMBB_MTAPI_OPENCL_POOL_CLASSES; ii++) {
+    while (NULL != that->free_list[ii]) {
+      embb_mtapi_opencl_buffer_t * buffer = that->free_list[ii];
+      that->free_list[ii] = buffer->next;
+      err = clReleaseMemObject(buffer->mem);
+      assert(CL_SUCCESS == err);
+      embb_free(buffer);
+    }
+  }
+  embb_mtapi_spinlock_finalize(&that->lock);
+}
+
+// Returns a device buffer holding at least size bytes, reusing one of a
+// previous task if possible. Returns NULL if no buffer could be created.
+static embb_mtapi_opencl_buffer_t * embb_mtapi_opencl_buffer_pool_get(
+  embb_mtapi_opencl_buffer_pool_t * that,
+  size_t size) {
+  embb_mtapi_opencl_buffer_t * buffer;
+  int size_class = EMBB_MTAPI_OPENCL_POOL_MIN_CLASS;
+  cl_int err;
+
+  while (((size_t)1 << size_class) < size) {
+    size_class++;
+  }
+  if (EMBB_MTAPI_OPENCL_POOL_CLASSES <= size_class) {
+    return NULL;
+  }
+
+  embb_mtapi_spinlock_acquire(&that->lock);
+  buffer = that->free_list[size_class];
+  if (NULL != buffer) {
+    that->free_list[size_class] = buffer->next;
+  }
+  embb_mtapi_spinlock_release(&that->lock);
+
+  if (NULL == buffer) {
+    buffer = (embb_mtapi_opencl_buffer_t*)embb_alloc(
+      sizeof(embb_mtapi_opencl_buffer_t));
+    if (NULL == buffer) {
+      return NULL;
+    }
+    buffer->size_class = size_class;
+    buffer->mem = clCreateBuffer(embb_mtapi_opencl_plugin.context,
+      that->flags, (size_t)1 << size_class, NULL, &err);
+    if (CL_SUCCESS != err) {
+      embb_free(buffer);
+      return NULL;
+    }
+  }
+  return buffer;
+}
+
+static void embb_mtapi_opencl_buffer_pool_put(
+  embb_mtapi_opencl_buffer_pool_t * that,
+  embb_mtapi_opencl_buffer_t * buffer) {
+  embb_mtapi_spinlock_acquire(&that->lock);
+  buffer->next = that->free_list[buffer->size_class];
+  that->free_list[buffer->size_class] = buffer;
+  embb_mtapi_spinlock_release(&that->lock);
+}
+
+// Returns the buffers of a task to the pool of its action or releases them.
+static void embb_mtapi_opencl_task_release_buffers(
+  embb_mtapi_opencl_task_t * opencl_task) {
+  embb_mtapi_opencl_action_t * opencl_action = opencl_task->action;
+  cl_int err;
+  EMBB_UNUSED_IN_RELEASE(err);
+
+  if (NULL != opencl_task->mapped_result_buffer) {
+    // the result is already in place, the unmap only ends the mapping
+    err = clEnqueueUnmapMemObject(opencl_task->command_queue,
+      opencl_task->result_buffer, opencl_task->mapped_result_buffer,
+      0, NULL, NULL);
+    assert(CL_SUCCESS == err);
+    err = clFlush(opencl_task->command_queue);
+    assert(CL_SUCCESS == err);
+  }
+
+  if (NULL != opencl_task->pooled_result_buffer) {
+    embb_mtapi_opencl_buffer_pool_put(&opencl_action->results_pool,
+      opencl_task->pooled_result_buffer);
+  } else if (NULL != opencl_task->result_buffer) {
+    err = clReleaseMemObject(opencl_task->result_buffer);
+    assert(CL_SUCCESS == err);
+  }
+  if (NULL != opencl_task->pooled_arguments) {
+    embb_mtapi_opencl_buffer_pool_put(&opencl_action->arguments_pool,
+      opencl_task->pooled_arguments);
+  } else if (NULL != opencl_task->arguments) {
+    err = clReleaseMemObject(opencl_task->arguments);
+    assert(CL_SUCCESS == err);
+  }
+}
+
+// Returns a kernel object of the action no other task is setting arguments
+// on, creating a new one if all are in use. Returns NULL on error.
+static embb_mtapi_opencl_kernel_t * embb_mtapi_opencl_action_get_kernel(
+  embb_mtapi_opencl_action_t * that) {
+  embb_mtapi_opencl_kernel_t * kernel;
+  cl_int err;
+
+  embb_mtapi_spinlock_acquire(&that->kernel_lock);
+  kernel = that->free_kernels;
+  if (NULL != kernel) {
+    that->free_kernels = kernel->next;
+  }
+  embb_mtapi_spinlock_release(&that->kernel_lock);
+
+  if (NULL == kernel) {
+    kernel = (embb_mtapi_opencl_kernel_t*)embb_alloc(
+      sizeof(embb_mtapi_opencl_kernel_t));
+    if (NULL == kernel) {
+      return NULL;
+    }
+    kernel->kernel = clCreateKernel(that->program, that->kernel_name, &err);
+    if (CL_SUCCESS != err) {
+      embb_free(kernel);
+      return NULL;
+    }
+    err = clSetKernelArg(kernel->kernel, 4, sizeof(cl_mem),
+      (const void*)&that->node_local_data);
+    if (CL_SUCCESS == err) {
+      err = clSetKernelArg(kernel->kernel, 5, sizeof(cl_int),
+        (const void*)&that->node_local_data_size);
+    }
+    if (CL_SUCCESS != err) {
+      clReleaseKernel(kernel->kernel);
+      embb_free(kernel);
+      return NULL;
+    }
+  }
+  return kernel;
+}
+
+// Arguments are captured when a kernel is enqueued, so the kernel object
+// can be put back right after.
+static void embb_mtapi_opencl_action_put_kernel(
+  embb_mtapi_opencl_action_t * that,
+  embb_mtapi_opencl_kernel_t * kernel) {
+  embb_mtapi_spinlock_acquire(&that->kernel_lock);
+  kernel->next = that->free_kernels;
+  that->free_kernels = kernel;
+  embb_mtapi_spinlock_release(&that->kernel_lock);
+}
 
+static void embb_mtapi_opencl_action_release_kernels(
+  embb_mtapi_opencl_action_t * that) {
   cl_int err;
   EMBB_UNUSED_IN_RELEASE(err);
+
+  while (NULL != that->free_kernels) {
+    embb_mtapi_opencl_kernel_t * kernel = that->free_kernels;
+    that->free_kernels = kernel->next;
+    err = clReleaseKernel(kernel->kernel);
+    assert(CL_SUCCESS == err);
+    embb_free(kernel);
+  }
+}
+
+// Provides device buffers for the arguments and results of a task, either
+// from the pools of its action or wrapping the task's own buffers.
+static int embb_mtapi_opencl_task_acquire_buffers(
+  embb_mtapi_opencl_task_t * opencl_task,
+  embb_mtapi_task_t * local_task) {
+  embb_mtapi_opencl_plugin_t * plugin = &embb_mtapi_opencl_plugin;
+  embb_mtapi_opencl_action_t * opencl_action = opencl_task->action;
+  cl_int err = CL_SUCCESS;
+
+  opencl_task->arguments = NULL;
+  opencl_task->arguments_size = (int)local_task->arguments_size;
+  opencl_task->result_buffer = NULL;
+  opencl_task->result_buffer_size = (int)local_task->result_size;
+  opencl_task->pooled_arguments = NULL;
+  opencl_task->pooled_result_buffer = NULL;
+  opencl_task->mapped_result_buffer = NULL;
+
+  if (opencl_action->use_host_memory) {
+    // the device works directly on the memory of the task
+    if (0 < local_task->arguments_size) {
+      opencl_task->arguments = clCreateBuffer(plugin->context,
+        CL_MEM_READ_ONLY | CL_MEM_USE_HOST_PTR, local_task->arguments_size,
+        (void*)local_task->arguments, &err);
+    }
+    if (CL_SUCCESS == err && 0 < local_task->result_size) {
+      opencl_task->result_buffer = clCreateBuffer(plugin->context,
+        CL_MEM_WRITE_ONLY | CL_MEM_USE_HOST_PTR, local_task->result_size,
+        local_task->result_buffer, &err);
+    }
+  } else {
+    if (0 < local_task->arguments_size) {
+      opencl_task->pooled_arguments = embb_mtapi_opencl_buffer_pool_get(
+        &opencl_action->arguments_pool, local_task->arguments_size);
+      if (NULL == opencl_task->pooled_arguments) {
+        err = CL_MEM_OBJECT_ALLOCATION_FAILURE;
+      } else {
+        opencl_task->arguments = opencl_task->pooled_arguments->mem;
+      }
+    }
+    if (CL_SUCCESS == err && 0 < local_task->result_size) {
+      opencl_task->pooled_result_buffer = embb_mtapi_opencl_buffer_pool_get(
+        &opencl_action->results_pool, local_task->result_size);
+      if (NULL == opencl_task->pooled_result_buffer) {
+        err = CL_MEM_OBJECT_ALLOCATION_FAILURE;
+      } else {
+        opencl_task->result_buffer = opencl_task->pooled_result_buffer->mem;
+      }
+    }
+  }
+
+  if (CL_SUCCESS != err) {
+    embb_mtapi_opencl_task_release_buffers(opencl_task);
+    return 0;
+  }
+  return 1;
+}
+
+// Accounts the device time of a finished task in its action, which lets
+// jobs with CPU and OpenCL actions choose the one that finishes first.
+// Failed launches pass NULL and only leave the action.
+static void embb_mtapi_opencl_task_finished(
+  embb_mtapi_node_t * node,
+  mtapi_action_hndl_t action,
+  embb_time_t const * launched,
+  int tasks_launched) {
+  if (embb_mtapi_action_pool_is_handle_valid(node->action_pool, action)) {
+    embb_mtapi_action_t * local_action =
+      embb_mtapi_action_pool_get_storage_for_handle(
+        node->action_pool, action);
+    if (NULL != launched) {
+      embb_mtapi_action_account_cost(
+        local_action, launched, (mtapi_uint_t)tasks_launched);
+    }
+    embb_atomic_fetch_and_add_int(&local_action->num_tasks, -1);
+  }
+}
+
+// Runs once the device is done with the task, so its buffers go back even
+// if the task itself is gone already.
+static void CL_API_CALL opencl_task_complete(
+  cl_event ev, cl_int status, void * data) {
   embb_mtapi_opencl_task_t * opencl_task = (embb_mtapi_opencl_task_t*)data;
+  cl_int err;
+  EMBB_UNUSED(ev);
+  EMBB_UNUSED_IN_RELEASE(err);
+
+  embb_mtapi_opencl_task_release_buffers(opencl_task);
 
   if (embb_mtapi_node_is_initialized()) {
     embb_mtapi_node_t * node = embb_mtapi_node_get_instance();
 
+    embb_mtapi_opencl_task_finished(node, opencl_task->local_action,
+      (CL_COMPLETE == status) ? &opencl_task->launched : NULL, 1);
     if (embb_mtapi_task_pool_is_handle_valid(
       node->task_pool, opencl_task->task)) {
       embb_mtapi_task_t * local_task =
         embb_mtapi_task_pool_get_storage_for_handle(
           node->task_pool, opencl_task->task);
+      if (CL_COMPLETE == status) {
+        embb_mtapi_task_set_state(local_task, MTAPI_TASK_COMPLETED);
+      } else {
+        local_task->error_code = MTAPI_ERR_ACTION_FAILED;
+        embb_mtapi_task_set_state(local_task, MTAPI_TASK_ERROR);
+      }
+    }
+  }
 
-      err = clWaitForEvents(1, &opencl_task->kernel_finish_event);
-      assert(CL_SUCCESS == err);
+  err = clReleaseEvent(opencl_task->kernel_finish_event);
+  assert(CL_SUCCESS == err);
+  embb_free(opencl_task);
+}
 
-      if (NULL != opencl_task->result_buffer) {
-        err = clReleaseMemObject(opencl_task->result_buffer);
-        assert(CL_SUCCESS == err);
-      }
-      if (NULL != opencl_task->arguments) {
-        err = clReleaseMemObject(opencl_task->arguments);
-        assert(CL_SUCCESS == err);
+// Spreads concurrently starting tasks across the command queues.
+static cl_command_queue embb_mtapi_opencl_next_command_queue() {
+  embb_mtapi_opencl_plugin_t * plugin = &embb_mtapi_opencl_plugin;
+  unsigned int index = (unsigned int)embb_atomic_fetch_and_add_int(
+    &plugin->next_command_queue, 1);
+  return plugin->command_queues[
+    index % (unsigned int)plugin->num_command_queues];
+}
+
+// Launches a task on its own. On failure the task leaves its action and
+// the caller gets an error.
+static mtapi_status_t embb_mtapi_opencl_task_launch(
+  embb_mtapi_opencl_action_t * opencl_action,
+  mtapi_task_hndl_t task,
+  embb_mtapi_task_t * local_task) {
+  embb_mtapi_opencl_task_t * opencl_task =
+    (embb_mtapi_opencl_task_t*)embb_alloc(
+      sizeof(embb_mtapi_opencl_task_t));
+
+  size_t elements = local_task->result_size / opencl_action->element_size;
+  size_t global_work_size;
+  embb_mtapi_opencl_kernel_t * kernel = NULL;
+  cl_int err = CL_SUCCESS;
+
+  if (NULL == opencl_task) {
+    embb_mtapi_opencl_task_finished(
+      embb_mtapi_node_get_instance(), local_task->action, NULL, 0);
+    return MTAPI_ERR_UNKNOWN;
+  }
+  if (0 == elements)
+    elements = 1;
+  global_work_size = round_up(opencl_action->local_work_size, elements);
+
+  opencl_task->task = task;
+  opencl_task->local_action = local_task->action;
+  opencl_task->action = opencl_action;
+  opencl_task->command_queue = embb_mtapi_opencl_next_command_queue();
+  opencl_task->kernel_finish_event = NULL;
+  embb_time_now(&opencl_task->launched);
+
+  if (!embb_mtapi_opencl_task_acquire_buffers(opencl_task, local_task)) {
+    embb_mtapi_opencl_task_finished(
+      embb_mtapi_node_get_instance(), local_task->action, NULL, 0);
+    embb_free(opencl_task);
+    return MTAPI_ERR_UNKNOWN;
+  }
+  kernel = embb_mtapi_opencl_action_get_kernel(opencl_action);
+
+  if (NULL != kernel) {
+    err = clSetKernelArg(kernel->kernel, 0, sizeof(cl_mem),
+      (const void*)&opencl_task->arguments);
+    if (CL_SUCCESS == err) {
+      err = clSetKernelArg(kernel->kernel, 1, sizeof(cl_int),
+        (const void*)&opencl_task->arguments_size);
+    }
+    if (CL_SUCCESS == err) {
+      err = clSetKernelArg(kernel->kernel, 2, sizeof(cl_mem),
+        (const void*)&opencl_task->result_buffer);
+    }
+    if (CL_SUCCESS == err) {
+      err = clSetKernelArg(kernel->kernel, 3, sizeof(cl_int),
+        (const void*)&opencl_task->result_buffer_size);
+    }
+    if (CL_SUCCESS == err && NULL != opencl_task->pooled_arguments) {
+      err = clEnqueueWriteBuffer(opencl_task->command_queue,
+        opencl_task->arguments, CL_FALSE, 0,
+        (size_t)opencl_task->arguments_size, local_task->arguments,
+        0, NULL, NULL);
+    }
+    if (CL_SUCCESS == err) {
+      err = clEnqueueNDRangeKernel(opencl_task->command_queue,
+        kernel->kernel, 1, NULL,
+        &global_work_size, &opencl_action->local_work_size, 0, NULL,
+        (NULL == opencl_task->result_buffer) ?
+        &opencl_task->kernel_finish_event : NULL);
+    }
+    embb_mtapi_opencl_action_put_kernel(opencl_action, kernel);
+
+    if (CL_SUCCESS == err && NULL != opencl_task->pooled_result_buffer) {
+      err = clEnqueueReadBuffer(opencl_task->command_queue,
+        opencl_task->result_buffer, CL_FALSE, 0,
+        (size_t)opencl_task->result_buffer_size,
+        local_task->result_buffer,
+        0, NULL, &opencl_task->kernel_finish_event);
+    } else if (CL_SUCCESS == err && NULL != opencl_task->result_buffer) {
+      // mapping makes the result visible in the task's buffer
+      opencl_task->mapped_result_buffer = clEnqueueMapBuffer(
+        opencl_task->command_queue, opencl_task->result_buffer,
+        CL_FALSE, CL_MAP_READ, 0,
+        (size_t)opencl_task->result_buffer_size,
+        0, NULL, &opencl_task->kernel_finish_event, &err);
+    }
+    if (CL_SUCCESS == err) {
+      // the callback may run before this function returns
+      embb_mtapi_task_set_state(local_task, MTAPI_TASK_RUNNING);
+      err = clSetEventCallback(opencl_task->kernel_finish_event,
+        CL_COMPLETE, opencl_task_complete, opencl_task);
+    }
+    if (CL_SUCCESS == err) {
+      clFlush(opencl_task->command_queue);
+      return MTAPI_SUCCESS;
+    }
+    // the buffers go back to the pools, wait until the device is done
+    clFinish(opencl_task->command_queue);
+    if (NULL != opencl_task->kernel_finish_event) {
+      clReleaseEvent(opencl_task->kernel_finish_event);
+    }
+  }
+
+  embb_mtapi_opencl_task_release_buffers(opencl_task);
+  embb_mtapi_opencl_task_finished(
+    embb_mtapi_node_get_instance(), local_task->action, NULL, 0);
+  embb_free(opencl_task);
+  return MTAPI_ERR_UNKNOWN;
+}
+
+static int embb_mtapi_opencl_elapsed_microseconds(
+  embb_time_t const * since) {
+  embb_time_t now;
+  long long elapsed;
+  embb_time_now(&now);
+  elapsed = (long long)(now.seconds - since->seconds) * 1000000 +
+    ((long long)now.nanoseconds - (long long)since->nanoseconds) / 1000;
+  if (elapsed < 0) {
+    return 0;
+  } else if (elapsed > 0x7fffffff) {
+    return 0x7fffffff;
+  } else {
+    return (int)elapsed;
+  }
+}
+
+static embb_mtapi_opencl_batch_t * embb_mtapi_opencl_batch_create(
+  embb_mtapi_opencl_action_t * action,
+  embb_mtapi_task_t * local_task) {
+  int max = action->max_batch_size;
+  // the task arrays follow the batch in the same allocation
+  embb_mtapi_opencl_batch_t * that = (embb_mtapi_opencl_batch_t*)embb_alloc(
+    sizeof(embb_mtapi_opencl_batch_t) +
+    (size_t)max * (sizeof(void*) + sizeof(mtapi_task_hndl_t)));
+  if (NULL == that) {
+    return NULL;
+  }
+  that->result_buffers = (void**)(that + 1);
+  that->tasks = (mtapi_task_hndl_t*)(that->result_buffers + max);
+  that->action = action;
+  that->local_action = local_task->action;
+  that->count = 0;
+  that->arguments_size = (int)local_task->arguments_size;
+  that->result_size = (int)local_task->result_size;
+  embb_time_now(&that->started);
+  that->device_arguments = NULL;
+  that->device_results = NULL;
+  that->finish_event = NULL;
+  that->arguments = (char*)embb_alloc(
+    (size_t)max * (local_task->arguments_size + local_task->result_size) + 1);
+  if (NULL == that->arguments) {
+    embb_free(that);
+    return NULL;
+  }
+  that->results = that->arguments +
+    (size_t)max * local_task->arguments_size;
+  return that;
+}
+
+static void embb_mtapi_opencl_batch_add(
+  embb_mtapi_opencl_batch_t * that,
+  mtapi_task_hndl_t task,
+  embb_mtapi_task_t * local_task) {
+  if (0 < that->arguments_size) {
+    memcpy(that->arguments + that->count * that->arguments_size,
+      local_task->arguments, (size_t)that->arguments_size);
+  }
+  that->tasks[that->count] = task;
+  that->result_buffers[that->count] = local_task->result_buffer;
+  that->count++;
+}
+
+static void embb_mtapi_opencl_batch_launch(embb_mtapi_opencl_batch_t * that);
+
+// Hands the results to the tasks of a batch, frees it and launches the
+// tasks that gathered in the meantime.
+static void embb_mtapi_opencl_batch_complete(
+  embb_mtapi_opencl_batch_t * that,
+  mtapi_status_t batch_status) {
+  embb_mtapi_opencl_action_t * action = that->action;
+  embb_mtapi_opencl_batch_t * pending;
+  int ii;
+
+  if (embb_mtapi_node_is_initialized()) {
+    embb_mtapi_node_t * node = embb_mtapi_node_get_instance();
+    for (ii = 0; ii < that->count; ii++) {
+      // the tasks of a batch share the time of its launch
+      embb_mtapi_opencl_task_finished(node, that->local_action,
+        (MTAPI_SUCCESS == batch_status) ? &that->launched : NULL,
+        that->count);
+      if (embb_mtapi_task_pool_is_handle_valid(
+        node->task_pool, that->tasks[ii])) {
+        embb_mtapi_task_t * local_task =
+          embb_mtapi_task_pool_get_storage_for_handle(
+            node->task_pool, that->tasks[ii]);
+        if (MTAPI_SUCCESS == batch_status) {
+          if (0 < that->result_size) {
+            memcpy(that->result_buffers[ii],
+              that->results + ii * that->result_size,
+              (size_t)that->result_size);
+          }
+          embb_mtapi_task_set_state(local_task, MTAPI_TASK_COMPLETED);
+        } else {
+          local_task->error_code = batch_status;
+          embb_mtapi_task_set_state(local_task, MTAPI_TASK_ERROR);
+        }
       }
+    }
+  }
 
-      embb_mtapi_task_set_state(local_task, MTAPI_TASK_COMPLETED);
+  if (NULL != that->device_arguments) {
+    embb_mtapi_opencl_buffer_pool_put(
+      &action->arguments_pool, that->device_arguments);
+  }
+  if (NULL != that->device_results) {
+    embb_mtapi_opencl_buffer_pool_put(
+      &action->results_pool, that->device_results);
+  }
+  embb_free(that->arguments);
+  embb_free(that);
+
+  embb_mtapi_spinlock_acquire(&action->batch_lock);
+  action->running_batches--;
+  pending = action->pending_batch;
+  if (NULL != pending) {
+    action->pending_batch = NULL;
+    action->running_batches++;
+  }
+  embb_mtapi_spinlock_release(&action->batch_lock);
+
+  if (NULL != pending) {
+    embb_mtapi_opencl_batch_launch(pending);
+  }
+}
+
+static void CL_API_CALL opencl_batch_complete(
+  cl_event ev, cl_int status, void * data) {
+  embb_mtapi_opencl_batch_t * that = (embb_mtapi_opencl_batch_t*)data;
+  cl_int err;
+  EMBB_UNUSED(ev);
+  EMBB_UNUSED_IN_RELEASE(err);
+
+  err = clReleaseEvent(that->finish_event);
+  assert(CL_SUCCESS == err);
+  embb_mtapi_opencl_batch_complete(that,
+    (CL_COMPLETE == status) ? MTAPI_SUCCESS : MTAPI_ERR_ACTION_FAILED);
+}
+
+// Copies the arguments of all tasks of a batch to the device at once, runs
+// the kernel on a two dimensional range with one row per task and reads all
+// results back at once.
+static void embb_mtapi_opencl_batch_launch(embb_mtapi_opencl_batch_t * that) {
+  embb_mtapi_opencl_action_t * action = that->action;
+  cl_command_queue command_queue = embb_mtapi_opencl_next_command_queue();
+  embb_mtapi_opencl_kernel_t * kernel;
+  size_t elements = (size_t)that->result_size / action->element_size;
+  size_t global_work_size[2];
+  size_t local_work_size[2];
+  cl_mem arguments = NULL;
+  cl_mem results = NULL;
+  cl_int err = CL_SUCCESS;
+
+  if (0 == elements)
+    elements = 1;
+  embb_time_now(&that->launched);
+  global_work_size[0] = round_up(action->local_work_size, elements);
+  global_work_size[1] = (size_t)that->count;
+  local_work_size[0] = action->local_work_size;
+  local_work_size[1] = 1;
+
+  if (0 < that->arguments_size) {
+    that->device_arguments = embb_mtapi_opencl_buffer_pool_get(
+      &action->arguments_pool, (size_t)(that->count * that->arguments_size));
+    if (NULL == that->device_arguments) {
+      err = CL_MEM_OBJECT_ALLOCATION_FAILURE;
+    } else {
+      arguments = that->device_arguments->mem;
+    }
+  }
+  if (CL_SUCCESS == err && 0 < that->result_size) {
+    that->device_results = embb_mtapi_opencl_buffer_pool_get(
+      &action->results_pool, (size_t)(that->count * that->result_size));
+    if (NULL == that->device_results) {
+      err = CL_MEM_OBJECT_ALLOCATION_FAILURE;
+    } else {
+      results = that->device_results->mem;
     }
   }
+  kernel = (CL_SUCCESS == err) ?
+    embb_mtapi_opencl_action_get_kernel(action) : NULL;
+
+  if (NULL != kernel) {
+    err = clSetKernelArg(kernel->kernel, 0, sizeof(cl_mem),
+      (const void*)&arguments);
+    if (CL_SUCCESS == err) {
+      err = clSetKernelArg(kernel->kernel, 1, sizeof(cl_int),
+        (const void*)&that->arguments_size);
+    }
+    if (CL_SUCCESS == err) {
+      err = clSetKernelArg(kernel->kernel, 2, sizeof(cl_mem),
+        (const void*)&results);
+    }
+    if (CL_SUCCESS == err) {
+      err = clSetKernelArg(kernel->kernel, 3, sizeof(cl_int),
+        (const void*)&that->result_size);
+    }
+    if (CL_SUCCESS == err && NULL != arguments) {
+      err = clEnqueueWriteBuffer(command_queue, arguments, CL_FALSE, 0,
+        (size_t)(that->count * that->arguments_size), that->arguments,
+        0, NULL, NULL);
+    }
+    if (CL_SUCCESS == err) {
+      err = clEnqueueNDRangeKernel(command_queue, kernel->kernel, 2, NULL,
+        global_work_size, local_work_size, 0, NULL,
+        (NULL == results) ? &that->finish_event : NULL);
+    }
+    embb_mtapi_opencl_action_put_kernel(action, kernel);
+    if (CL_SUCCESS == err && NULL != results) {
+      err = clEnqueueReadBuffer(command_queue, results, CL_FALSE, 0,
+        (size_t)(that->count * that->result_size), that->results,
+        0, NULL, &that->finish_event);
+    }
+    if (CL_SUCCESS == err) {
+      // all tasks of the batch complete through this one callback
+      err = clSetEventCallback(that->finish_event,
+        CL_COMPLETE, opencl_batch_complete, that);
+    }
+    if (CL_SUCCESS == err) {
+      clFlush(command_queue);
+      return;
+    }
+    // the buffers go back to the pools, wait until the device is done
+    clFinish(command_queue);
+    if (NULL != that->finish_event) {
+      clReleaseEvent(that->finish_event);
+    }
+  }
+
+  embb_mtapi_opencl_batch_complete(that, MTAPI_ERR_ACTION_FAILED);
+}
+
+// Adds a task to the batch collecting tasks of its action. The batch is
+// launched once it is full, if no batch of the action is running or if its
+// first task waited too long. Otherwise it is launched as soon as a running
+// batch completes.
+static mtapi_status_t embb_mtapi_opencl_batch_task(
+  embb_mtapi_opencl_action_t * action,
+  mtapi_task_hndl_t task,
+  embb_mtapi_task_t * local_task) {
+  embb_mtapi_opencl_batch_t * other = NULL;
+  embb_mtapi_opencl_batch_t * batch;
+  embb_mtapi_opencl_batch_t * launch = NULL;
+
+  embb_mtapi_spinlock_acquire(&action->batch_lock);
+  batch = action->pending_batch;
+  if (NULL != batch &&
+    (batch->arguments_size != (int)local_task->arguments_size ||
+    batch->result_size != (int)local_task->result_size)) {
+    // tasks of one batch share their sizes
+    other = batch;
+    action->running_batches++;
+    batch = NULL;
+  }
+  if (NULL == batch) {
+    batch = embb_mtapi_opencl_batch_create(action, local_task);
+  }
+  action->pending_batch = batch;
+  if (NULL != batch) {
+    embb_mtapi_opencl_batch_add(batch, task, local_task);
+    embb_mtapi_task_set_state(local_task, MTAPI_TASK_RUNNING);
+    if (batch->count == action->max_batch_size ||
+      0 == action->running_batches ||
+      (0 < action->max_batch_delay &&
+      embb_mtapi_opencl_elapsed_microseconds(&batch->started) >=
+      action->max_batch_delay)) {
+      launch = batch;
+      action->pending_batch = NULL;
+      action->running_batches++;
+    }
+  }
+  embb_mtapi_spinlock_release(&action->batch_lock);
+
+  if (NULL != other) {
+    embb_mtapi_opencl_batch_launch(other);
+  }
+  if (NULL != launch) {
+    embb_mtapi_opencl_batch_launch(launch);
+  }
+  return (NULL != batch) ? MTAPI_SUCCESS : MTAPI_ERR_UNKNOWN;
 }
 
 static void opencl_task_start(
   MTAPI_IN mtapi_task_hndl_t task,
   MTAPI_OUT mtapi_status_t* status) {
   mtapi_status_t local_status = MTAPI_ERR_UNKNOWN;
-  cl_int err;
 
   if (embb_mtapi_node_is_initialized()) {
     embb_mtapi_node_t * node = embb_mtapi_node_get_instance();
@@ -139,65 +882,22 @@ static void opencl_task_start(
           embb_mtapi_action_pool_get_storage_for_handle(
           node->action_pool, local_task->action);
 
-        embb_mtapi_opencl_plugin_t * plugin = &embb_mtapi_opencl_plugin;
         embb_mtapi_opencl_action_t * opencl_action =
           (embb_mtapi_opencl_action_t*)local_action->plugin_data;
-        embb_mtapi_opencl_task_t * opencl_task =
-          (embb_mtapi_opencl_task_t*)embb_alloc(
-            sizeof(embb_mtapi_opencl_task_t));
-
-        size_t elements = local_task->result_size /
-          opencl_action->element_size;
-        size_t global_work_size;
-
-        if (0 == elements)
-          elements = 1;
-        global_work_size =
-          round_up(opencl_action->local_work_size, elements);
 
-        opencl_task->task = task;
-
-        opencl_task->arguments_size = (int)local_task->arguments_size;
-        if (0 < local_task->arguments_size) {
-          opencl_task->arguments = clCreateBuffer(plugin->context,
-            CL_MEM_READ_ONLY, local_task->arguments_size, NULL, &err);
-        } else {
-          opencl_task->arguments = NULL;
-        }
-        opencl_task->result_buffer_size = (int)local_task->result_size;
-        if (0 < local_task->result_size) {
-          opencl_task->result_buffer = clCreateBuffer(plugin->context,
-            CL_MEM_WRITE_ONLY, local_task->result_size, NULL, &err);
+        // the task may complete before the launch returns
+        embb_atomic_fetch_and_add_int(&local_action->num_tasks, 1);
+        if (0 < opencl_action->max_batch_size) {
+          local_status = embb_mtapi_opencl_batch_task(
+            opencl_action, task, local_task);
+          if (MTAPI_SUCCESS != local_status) {
+            embb_atomic_fetch_and_add_int(&local_action->num_tasks, -1);
+          }
         } else {
-          opencl_task->result_buffer = NULL;
+          // a failed launch leaves the action by itself
+          local_status = embb_mtapi_opencl_task_launch(
+            opencl_action, task, local_task);
         }
-
-        err = clSetKernelArg(opencl_action->kernel, 0, sizeof(cl_mem),
-          (const void*)&opencl_task->arguments);
-        err = clSetKernelArg(opencl_action->kernel, 1, sizeof(cl_int),
-          (const void*)&opencl_task->arguments_size);
-
-        err = clSetKernelArg(opencl_action->kernel, 2, sizeof(cl_mem),
-          (const void*)&opencl_task->result_buffer);
-        err = clSetKernelArg(opencl_action->kernel, 3, sizeof(cl_int),
-          (const void*)&opencl_task->result_buffer_size);
-
-        err = clEnqueueWriteBuffer(plugin->command_queue,
-          opencl_task->arguments, CL_FALSE, 0,
-          (size_t)opencl_task->arguments_size, local_task->arguments, 0, NULL, NULL);
-        err = clEnqueueNDRangeKernel(plugin->command_queue,
-          opencl_action->kernel, 1, NULL,
-          &global_work_size, &opencl_action->local_work_size, 0, NULL, NULL);
-        err = clEnqueueReadBuffer(plugin->command_queue,
-          opencl_task->result_buffer, CL_FALSE, 0,
-          (size_t)opencl_task->result_buffer_size, local_task->result_buffer,
-          0, NULL, &opencl_task->kernel_finish_event);
-        err = clSetEventCallback(opencl_task->kernel_finish_event,
-          CL_COMPLETE, opencl_task_complete, opencl_task);
-        err = clFlush(plugin->command_queue);
-
-        embb_mtapi_task_set_state(local_task, MTAPI_TASK_RUNNING);
-        local_status = MTAPI_SUCCESS;
       }
     }
   }
@@ -237,11 +937,18 @@ static void opencl_action_finalize(
         assert(CL_SUCCESS == err);
       }
 
-      err = clReleaseKernel(opencl_action->kernel);
-      assert(CL_SUCCESS == err);
+      embb_mtapi_opencl_buffer_pool_finalize(&opencl_action->arguments_pool);
+      embb_mtapi_opencl_buffer_pool_finalize(&opencl_action->results_pool);
+
+      // all tasks are done, so no batch is left
+      assert(NULL == opencl_action->pending_batch);
+      embb_mtapi_opencl_action_release_kernels(opencl_action);
+      embb_mtapi_spinlock_finalize(&opencl_action->kernel_lock);
+      embb_mtapi_spinlock_finalize(&opencl_action->batch_lock);
       err = clReleaseProgram(opencl_action->program);
       assert(CL_SUCCESS == err);
 
+      embb_free(opencl_action->kernel_name);
       embb_free(opencl_action);
       local_status = MTAPI_SUCCESS;
     }
@@ -256,6 +963,7 @@ void mtapi_opencl_plugin_initialize(
   MTAPI_OUT mtapi_status_t* status) {
   mtapi_status_t local_status = MTAPI_ERR_UNKNOWN;
   cl_int err;
+  int ii;
   embb_mtapi_opencl_plugin_t * plugin = &embb_mtapi_opencl_plugin;
 
   err = embb_mtapi_opencl_link_at_runtime();
@@ -278,8 +986,34 @@ void mtapi_opencl_plugin_initialize(
         3 * sizeof(size_t), &plugin->work_item_sizes[0], NULL);
     }
     if (CL_SUCCESS == err) {
-      plugin->command_queue = clCreateCommandQueue(plugin->context,
-        plugin->device_id, 0, &err);
+      // only known from OpenCL 1.1 on
+      if (CL_SUCCESS != clGetDeviceInfo(plugin->device_id,
+        CL_DEVICE_HOST_UNIFIED_MEMORY, sizeof(cl_bool),
+        &plugin->unified_memory, NULL)) {
+        plugin->unified_memory = CL_FALSE;
+      }
+      plugin->use_host_memory = MTAPI_FALSE;
+
+      plugin->num_command_queues = (int)embb_core_count_available();
+      if (EMBB_MTAPI_OPENCL_MAX_COMMAND_QUEUES < plugin->num_command_queues) {
+        plugin->num_command_queues = EMBB_MTAPI_OPENCL_MAX_COMMAND_QUEUES;
+      }
+      if (1 > plugin->num_command_queues) {
+        plugin->num_command_queues = 1;
+      }
+      embb_atomic_store_int(&plugin->next_command_queue, 0);
+      for (ii = 0; ii < plugin->num_command_queues; ii++) {
+        plugin->command_queues[ii] = clCreateCommandQueue(plugin->context,
+          plugin->device_id, 0, &err);
+        if (CL_SUCCESS != err) {
+          // work with the queues created so far
+          plugin->num_command_queues = ii;
+          break;
+        }
+      }
+      if (0 < plugin->num_command_queues) {
+        err = CL_SUCCESS;
+      }
     }
     if (CL_SUCCESS == err) {
       local_status = MTAPI_SUCCESS;
@@ -289,17 +1023,27 @@ void mtapi_opencl_plugin_initialize(
   mtapi_status_set(status, local_status);
 }
 
+void mtapi_opencl_plugin_set_host_memory(
+  MTAPI_IN mtapi_boolean_t enable,
+  MTAPI_OUT mtapi_status_t* status) {
+  embb_mtapi_opencl_plugin.use_host_memory = enable;
+  mtapi_status_set(status, MTAPI_SUCCESS);
+}
+
 void mtapi_opencl_plugin_finalize(
   MTAPI_OUT mtapi_status_t* status) {
   mtapi_status_t local_status = MTAPI_ERR_UNKNOWN;
 
   cl_int err;
+  int ii;
   EMBB_UNUSED_IN_RELEASE(err);
   embb_mtapi_opencl_plugin_t * plugin = &embb_mtapi_opencl_plugin;
 
   /* finalization */
-  err = clReleaseCommandQueue(plugin->command_queue);
-  assert(CL_SUCCESS == err);
+  for (ii = 0; ii < plugin->num_command_queues; ii++) {
+    err = clReleaseCommandQueue(plugin->command_queues[ii]);
+    assert(CL_SUCCESS == err);
+  }
   err = clReleaseContext(plugin->context);
   assert(CL_SUCCESS == err);
 
@@ -316,6 +1060,22 @@ mtapi_action_hndl_t mtapi_opencl_action_create(
   MTAPI_IN void* node_local_data,
   MTAPI_IN mtapi_size_t node_local_data_size,
   MTAPI_OUT mtapi_status_t* status) {
+  return mtapi_opencl_action_create_batched(job_id, kernel_source,
+    kernel_name, local_work_size, element_size,
+    node_local_data, node_local_data_size, 0, 0, status);
+}
+
+mtapi_action_hndl_t mtapi_opencl_action_create_batched(
+  MTAPI_IN mtapi_job_id_t job_id,
+  MTAPI_IN char* kernel_source,
+  MTAPI_IN char* kernel_name,
+  MTAPI_IN mtapi_size_t local_work_size,
+  MTAPI_IN mtapi_size_t element_size,
+  MTAPI_IN void* node_local_data,
+  MTAPI_IN mtapi_size_t node_local_data_size,
+  MTAPI_IN mtapi_uint_t max_batch_size,
+  MTAPI_IN mtapi_uint_t max_batch_delay,
+  MTAPI_OUT mtapi_status_t* status) {
   mtapi_status_t local_status = MTAPI_ERR_UNKNOWN;
 
   cl_int err;
@@ -325,12 +1085,30 @@ mtapi_action_hndl_t mtapi_opencl_action_create(
       sizeof(embb_mtapi_opencl_action_t));
   mtapi_action_hndl_t action_hndl = { 0, 0 }; // invalid handle
   size_t kernel_length = strlen(kernel_source);
+  size_t kernel_name_length = strlen(kernel_name);
+  embb_mtapi_opencl_kernel_t * kernel = NULL;
   mtapi_boolean_t free_program_on_error = MTAPI_FALSE;
-  mtapi_boolean_t free_kernel_on_error = MTAPI_FALSE;
   mtapi_boolean_t free_node_local_data_on_error = MTAPI_FALSE;
 
   action->local_work_size = local_work_size;
   action->element_size = element_size;
+  action->use_host_memory = (plugin->use_host_memory &&
+    CL_TRUE == plugin->unified_memory) ? MTAPI_TRUE : MTAPI_FALSE;
+  embb_mtapi_opencl_buffer_pool_initialize(
+    &action->arguments_pool, CL_MEM_READ_ONLY);
+  embb_mtapi_opencl_buffer_pool_initialize(
+    &action->results_pool, CL_MEM_WRITE_ONLY);
+  embb_mtapi_spinlock_initialize(&action->kernel_lock);
+  action->free_kernels = NULL;
+  // a batch of one is no batch
+  action->max_batch_size = (1 < max_batch_size) ? (int)max_batch_size : 0;
+  action->max_batch_delay = (int)max_batch_delay;
+  embb_mtapi_spinlock_initialize(&action->batch_lock);
+  action->pending_batch = NULL;
+  action->running_batches = 0;
+  // further kernel objects are created on demand
+  action->kernel_name = (char*)embb_alloc(kernel_name_length + 1);
+  memcpy(action->kernel_name, kernel_name, kernel_name_length + 1);
 
   /* initialization */
   action->program = clCreateProgramWithSource(plugin->context,
@@ -345,36 +1123,33 @@ mtapi_action_hndl_t mtapi_opencl_action_create(
   }
 
   if (CL_SUCCESS == err) {
-    action->kernel = clCreateKernel(action->program, kernel_name, &err);
-    if (CL_SUCCESS == err) {
-      free_kernel_on_error = MTAPI_TRUE;
-    }
-  }
-
-  if (0 < node_local_data_size) {
-    action->node_local_data = clCreateBuffer(plugin->context, CL_MEM_READ_ONLY,
-      node_local_data_size, NULL, &err);
-    if (CL_SUCCESS == err) {
-      free_node_local_data_on_error = MTAPI_TRUE;
-    }
-    action->node_local_data_size = (int)node_local_data_size;
-    if (CL_SUCCESS == err) {
-      err = clEnqueueWriteBuffer(plugin->command_queue,
-        action->node_local_data, CL_TRUE, 0,
-        (size_t)action->node_local_data_size, node_local_data, 0, NULL, NULL);
+    if (0 < node_local_data_size) {
+      action->node_local_data = clCreateBuffer(plugin->context,
+        CL_MEM_READ_ONLY, node_local_data_size, NULL, &err);
+      if (CL_SUCCESS == err) {
+        free_node_local_data_on_error = MTAPI_TRUE;
+      }
+      action->node_local_data_size = (int)node_local_data_size;
+      if (CL_SUCCESS == err) {
+        err = clEnqueueWriteBuffer(plugin->command_queues[0],
+          action->node_local_data, CL_TRUE, 0,
+          (size_t)action->node_local_data_size, node_local_data,
+          0, NULL, NULL);
+      }
+    } else {
+      action->node_local_data = NULL;
+      action->node_local_data_size = 0;
     }
-  } else {
-    action->node_local_data = NULL;
-    action->node_local_data_size = 0;
   }
 
   if (CL_SUCCESS == err) {
-    err = clSetKernelArg(action->kernel, 4, sizeof(cl_mem),
-      (const void*)&action->node_local_data);
-  }
-  if (CL_SUCCESS == err) {
-    err = clSetKernelArg(action->kernel, 5, sizeof(cl_int),
-      (const void*)&action->node_local_data_size);
+    // the first kernel object checks the kernel name
+    kernel = embb_mtapi_opencl_action_get_kernel(action);
+    if (NULL == kernel) {
+      err = CL_INVALID_KERNEL_NAME;
+    } else {
+      embb_mtapi_opencl_action_put_kernel(action, kernel);
+    }
   }
 
   if (CL_SUCCESS == err) {
@@ -392,12 +1167,15 @@ mtapi_action_hndl_t mtapi_opencl_action_create(
     if (free_node_local_data_on_error) {
       clReleaseMemObject(action->node_local_data);
     }
-    if (free_kernel_on_error) {
-      clReleaseKernel(action->kernel);
-    }
+    embb_mtapi_opencl_action_release_kernels(action);
+    embb_mtapi_spinlock_finalize(&action->kernel_lock);
+    embb_mtapi_spinlock_finalize(&action->batch_lock);
     if (free_program_on_error) {
       clReleaseProgram(action->program);
     }
+    embb_mtapi_opencl_buffer_pool_finalize(&action->arguments_pool);
+    embb_mtapi_opencl_buffer_pool_finalize(&action->results_pool);
+    embb_free(action->kernel_name);
     embb_free(action);
   }
 
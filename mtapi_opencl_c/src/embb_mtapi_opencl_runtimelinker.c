@@ -141,6 +141,23 @@ DECLARECLFUNC(cl_int, clEnqueueReadBuffer, (cl_command_queue command_queue,
     offset, cb, ptr, num_events_in_wait_list, event_wait_list, event);
 }
 
+DECLARECLFUNC(void *, clEnqueueMapBuffer, (cl_command_queue command_queue,
+  cl_mem buffer, cl_bool blocking_map, cl_map_flags map_flags, size_t offset,
+  size_t cb, cl_uint num_events_in_wait_list, const cl_event * event_wait_list,
+  cl_event * event, cl_int * errcode_ret)) {
+  return clEnqueueMapBuffer_Dynamic(command_queue, buffer, blocking_map,
+    map_flags, offset, cb, num_events_in_wait_list, event_wait_list, event,
+    errcode_ret);
+}
+
+DECLARECLFUNC(cl_int, clEnqueueUnmapMemObject,
+  (cl_command_queue command_queue, cl_mem memobj, void * mapped_ptr,
+  cl_uint num_events_in_wait_list, const cl_event * event_wait_list,
+  cl_event * event)) {
+  return clEnqueueUnmapMemObject_Dynamic(command_queue, memobj, mapped_ptr,
+    num_events_in_wait_list, event_wait_list, event);
+}
+
 DECLARECLFUNC(cl_int, clSetEventCallback, (cl_event event,
   cl_int command_exec_callback_type,
   void (CL_CALLBACK * pfn_notify)(cl_event, cl_int, void *),
@@ -154,6 +171,10 @@ DECLARECLFUNC(cl_int, clWaitForEvents, (cl_uint num_events,
   return clWaitForEvents_Dynamic(num_events, event_list);
 }
 
+DECLARECLFUNC(cl_int, clReleaseEvent, (cl_event event)) {
+  return clReleaseEvent_Dynamic(event);
+}
+
 DECLARECLFUNC(cl_int, clReleaseKernel, (cl_kernel kernel)) {
   return clReleaseKernel_Dynamic(kernel);
 }
@@ -284,8 +305,11 @@ int embb_mtapi_opencl_link_at_runtime() {
   CHECKEDIMPORT(clEnqueueWriteBuffer);
   CHECKEDIMPORT(clEnqueueNDRangeKernel);
   CHECKEDIMPORT(clEnqueueReadBuffer);
+  CHECKEDIMPORT(clEnqueueMapBuffer);
+  CHECKEDIMPORT(clEnqueueUnmapMemObject);
   CHECKEDIMPORT(clSetEventCallback);
   CHECKEDIMPORT(clWaitForEvents);
+  CHECKEDIMPORT(clReleaseEvent);
   CHECKEDIMPORT(clReleaseKernel);
   CHECKEDIMPORT(clReleaseProgram);
   CHECKEDIMPORT(clReleaseCommandQueue);
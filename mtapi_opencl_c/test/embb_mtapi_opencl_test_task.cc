@@ -27,6 +27,7 @@
 #include <embb_mtapi_opencl_test_task.h>
 
 #include <embb/mtapi/c/mtapi_opencl.h>
+#include <embb/base/c/atomic.h>
 
 #define MTAPI_CHECK_STATUS(status) \
 PT_ASSERT(MTAPI_SUCCESS == status)
@@ -34,6 +35,7 @@ PT_ASSERT(MTAPI_SUCCESS == status)
 #define OPENCL_DOMAIN 1
 #define OPENCL_NODE 2
 #define OPENCL_JOB 2
+#define STARTER_JOB 3
 
 // OpenCL Kernel Function for element by element vector addition
 const char * kernel =
@@ -55,11 +57,127 @@ const char * kernel =
 "  c[ii] = a[ii] + b[ii] + d[0];\n"
 "}\n";
 
+// The same for a batch of tasks, task get_global_id(1) works on the
+// arguments and results at that many times their sizes
+const char * batched_kernel =
+"__kernel void batched(\n"
+"  __global void* arguments,\n"
+"  int arguments_size,\n"
+"  __global void* result_buffer,\n"
+"  int result_buffer_size,\n"
+"  __global void* node_local_data,\n"
+"  int node_local_data_size) {\n"
+"  int ii = get_global_id(0);\n"
+"  int task = get_global_id(1);\n"
+"  int elements = arguments_size / sizeof(float) / 2;\n"
+"  if (ii >= elements)"
+"    return;"
+"  __global float* a = (__global float*)\n"
+"    ((__global char*)arguments + task * arguments_size);\n"
+"  __global float* b = a + elements;\n"
+"  __global float* c = (__global float*)\n"
+"    ((__global char*)result_buffer + task * result_buffer_size);\n"
+"  __global float* d = (__global float*)node_local_data;\n"
+"  c[ii] = a[ii] + b[ii] + d[0];\n"
+"}\n";
+
+// Starts an OpenCL task from a worker thread and checks its result
+static void StartOpenCLTask(
+  const void* args,
+  mtapi_size_t /*args_size*/,
+  void* results,
+  mtapi_size_t /*results_size*/,
+  const void* /*node_local_data*/,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t* /*context*/) {
+  const int kElements = 64;
+  float arguments[kElements * 2];
+  float opencl_results[kElements];
+  float offset = *static_cast<const float*>(args);
+  mtapi_status_t status;
+
+  for (int ii = 0; ii < kElements; ii++) {
+    arguments[ii] = static_cast<float>(ii);
+    arguments[ii + kElements] = offset;
+  }
+
+  mtapi_job_hndl_t job = mtapi_job_get(OPENCL_JOB, OPENCL_DOMAIN, &status);
+  mtapi_task_hndl_t task = mtapi_task_start(
+    MTAPI_TASK_ID_NONE,
+    job,
+    arguments, kElements * 2 * sizeof(float),
+    opencl_results, kElements * sizeof(float),
+    MTAPI_DEFAULT_TASK_ATTRIBUTES,
+    MTAPI_GROUP_NONE,
+    &status);
+  if (MTAPI_SUCCESS == status) {
+    mtapi_task_wait(task, MTAPI_INFINITE, &status);
+  }
+
+  int * errors = static_cast<int*>(results);
+  *errors = (MTAPI_SUCCESS == status) ? 0 : 1;
+  for (int ii = 0; ii < kElements; ii++) {
+    if (opencl_results[ii] != ii + offset + 1) {
+      (*errors)++;
+    }
+  }
+}
+
+static embb_atomic_int cpu_tasks;
+
+// The CPU implementation of the test kernel
+static void AddOnCPU(
+  const void* args,
+  mtapi_size_t args_size,
+  void* results,
+  mtapi_size_t /*results_size*/,
+  const void* node_local_data,
+  mtapi_size_t /*node_local_data_size*/,
+  mtapi_task_context_t* /*context*/) {
+  int elements = static_cast<int>(args_size / sizeof(float) / 2);
+  const float * a = static_cast<const float*>(args);
+  const float * b = a + elements;
+  float * c = static_cast<float*>(results);
+  const float * d = static_cast<const float*>(node_local_data);
+  for (int ii = 0; ii < elements; ii++) {
+    c[ii] = a[ii] + b[ii] + d[0];
+  }
+  embb_atomic_fetch_and_add_int(&cpu_tasks, 1);
+}
+
 TaskTest::TaskTest() {
   CreateUnit("mtapi opencl task test").Add(&TaskTest::TestBasic, this);
+  CreateUnit("mtapi opencl host memory task test")
+    .Add(&TaskTest::TestBasicHostMemory, this);
+  CreateUnit("mtapi opencl throughput test")
+    .Add(&TaskTest::TestThroughput, this);
+  CreateUnit("mtapi opencl host memory throughput test")
+    .Add(&TaskTest::TestThroughputHostMemory, this);
+  CreateUnit("mtapi opencl concurrent start test")
+    .Add(&TaskTest::TestConcurrentStart, this);
+  CreateUnit("mtapi opencl batched task test")
+    .Add(&TaskTest::TestBatched, this);
+  CreateUnit("mtapi opencl heterogeneous task test")
+    .Add(&TaskTest::TestHeterogeneous, this);
 }
 
 void TaskTest::TestBasic() {
+  RunBasic(MTAPI_FALSE);
+}
+
+void TaskTest::TestBasicHostMemory() {
+  RunBasic(MTAPI_TRUE);
+}
+
+void TaskTest::TestThroughput() {
+  RunThroughput(MTAPI_FALSE);
+}
+
+void TaskTest::TestThroughputHostMemory() {
+  RunThroughput(MTAPI_TRUE);
+}
+
+void TaskTest::RunBasic(mtapi_boolean_t host_memory) {
   mtapi_status_t status;
   mtapi_job_hndl_t job;
   mtapi_task_hndl_t task;
@@ -77,6 +195,9 @@ void TaskTest::TestBasic() {
   mtapi_opencl_plugin_initialize(&status);
   MTAPI_CHECK_STATUS(status);
 
+  mtapi_opencl_plugin_set_host_memory(host_memory, &status);
+  MTAPI_CHECK_STATUS(status);
+
   mtapi_initialize(
     OPENCL_DOMAIN,
     OPENCL_NODE,
@@ -114,6 +235,260 @@ void TaskTest::TestBasic() {
     PT_EXPECT_EQ(results[ii], ii * 2 + 1);
   }
 
+  // tasks of different sizes share the pooled device buffers of the action
+  const int kTasks = 8;
+  float many_arguments[kTasks][kElements * 2];
+  float many_results[kTasks][kElements];
+  mtapi_task_hndl_t tasks[kTasks];
+  for (int round = 0; round < 3; round++) {
+    for (int tt = 0; tt < kTasks; tt++) {
+      int elements = kElements >> (tt % 4);
+      for (int ii = 0; ii < elements; ii++) {
+        many_arguments[tt][ii] = static_cast<float>(ii);
+        many_arguments[tt][ii + elements] = static_cast<float>(round);
+      }
+      tasks[tt] = mtapi_task_start(
+        MTAPI_TASK_ID_NONE,
+        job,
+        many_arguments[tt], elements * 2 * sizeof(float),
+        many_results[tt], elements * sizeof(float),
+        MTAPI_DEFAULT_TASK_ATTRIBUTES,
+        MTAPI_GROUP_NONE,
+        &status);
+      MTAPI_CHECK_STATUS(status);
+    }
+    for (int tt = 0; tt < kTasks; tt++) {
+      int elements = kElements >> (tt % 4);
+      mtapi_task_wait(tasks[tt], MTAPI_INFINITE, &status);
+      MTAPI_CHECK_STATUS(status);
+      for (int ii = 0; ii < elements; ii++) {
+        PT_EXPECT_EQ(many_results[tt][ii], ii + round + 1);
+      }
+    }
+  }
+
+  mtapi_action_delete(action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_opencl_plugin_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+}
+
+void TaskTest::RunThroughput(mtapi_boolean_t host_memory) {
+  mtapi_status_t status;
+  mtapi_job_hndl_t job;
+  mtapi_action_hndl_t action;
+
+  // many small kernels, run this unit alone to compare the cost of
+  // providing the device buffers
+  const int kElements = 256;
+  const int kTasks = 2000;
+  const int kInFlight = 16;
+  float * arguments = new float[kElements * 2];
+  float * results = new float[kElements * kInFlight];
+  mtapi_task_hndl_t tasks[kInFlight];
+
+  for (int ii = 0; ii < kElements; ii++) {
+    arguments[ii] = static_cast<float>(ii);
+    arguments[ii + kElements] = static_cast<float>(ii);
+  }
+
+  mtapi_opencl_plugin_initialize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_opencl_plugin_set_host_memory(host_memory, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_initialize(
+    OPENCL_DOMAIN,
+    OPENCL_NODE,
+    MTAPI_NULL,
+    MTAPI_NULL,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  float node_local = 1.0f;
+  action = mtapi_opencl_action_create(
+    OPENCL_JOB,
+    kernel, "test", 32, 4,
+    &node_local, sizeof(float),
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  job = mtapi_job_get(OPENCL_JOB, OPENCL_DOMAIN, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  for (int tt = 0; tt < kTasks; tt += kInFlight) {
+    for (int ff = 0; ff < kInFlight; ff++) {
+      tasks[ff] = mtapi_task_start(
+        MTAPI_TASK_ID_NONE,
+        job,
+        arguments, kElements * 2 * sizeof(float),
+        results + ff * kElements, kElements * sizeof(float),
+        MTAPI_DEFAULT_TASK_ATTRIBUTES,
+        MTAPI_GROUP_NONE,
+        &status);
+      MTAPI_CHECK_STATUS(status);
+    }
+    for (int ff = 0; ff < kInFlight; ff++) {
+      mtapi_task_wait(tasks[ff], MTAPI_INFINITE, &status);
+      MTAPI_CHECK_STATUS(status);
+      PT_EXPECT_EQ(results[ff * kElements + kElements - 1],
+        (kElements - 1) * 2 + 1);
+    }
+  }
+
+  mtapi_action_delete(action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_opencl_plugin_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  delete[] arguments;
+  delete[] results;
+}
+
+void TaskTest::TestConcurrentStart() {
+  mtapi_status_t status;
+  mtapi_job_hndl_t job;
+  mtapi_action_hndl_t opencl_action, starter_action;
+
+  // workers start OpenCL tasks at the same time, each needs its own
+  // kernel arguments
+  const int kTasks = 32;
+  float offsets[kTasks];
+  int errors[kTasks];
+  mtapi_task_hndl_t tasks[kTasks];
+
+  mtapi_opencl_plugin_initialize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_initialize(
+    OPENCL_DOMAIN,
+    OPENCL_NODE,
+    MTAPI_NULL,
+    MTAPI_NULL,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  float node_local = 1.0f;
+  opencl_action = mtapi_opencl_action_create(
+    OPENCL_JOB,
+    kernel, "test", 32, 4,
+    &node_local, sizeof(float),
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  starter_action = mtapi_action_create(
+    STARTER_JOB,
+    StartOpenCLTask,
+    MTAPI_NULL, 0,
+    MTAPI_DEFAULT_ACTION_ATTRIBUTES,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  job = mtapi_job_get(STARTER_JOB, OPENCL_DOMAIN, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  for (int tt = 0; tt < kTasks; tt++) {
+    offsets[tt] = static_cast<float>(tt);
+    errors[tt] = -1;
+    tasks[tt] = mtapi_task_start(
+      MTAPI_TASK_ID_NONE,
+      job,
+      &offsets[tt], sizeof(float),
+      &errors[tt], sizeof(int),
+      MTAPI_DEFAULT_TASK_ATTRIBUTES,
+      MTAPI_GROUP_NONE,
+      &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+  for (int tt = 0; tt < kTasks; tt++) {
+    mtapi_task_wait(tasks[tt], MTAPI_INFINITE, &status);
+    MTAPI_CHECK_STATUS(status);
+    PT_EXPECT_EQ(errors[tt], 0);
+  }
+
+  mtapi_action_delete(starter_action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_action_delete(opencl_action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_opencl_plugin_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+}
+
+void TaskTest::TestBatched() {
+  mtapi_status_t status;
+  mtapi_job_hndl_t job;
+  mtapi_action_hndl_t action;
+
+  // tasks started back to back gather while a batch runs, the sizes
+  // change now and then to split batches
+  const int kElements = 64;
+  const int kTasks = 100;
+  float arguments[kTasks][kElements * 2];
+  float results[kTasks][kElements];
+  mtapi_task_hndl_t tasks[kTasks];
+
+  mtapi_opencl_plugin_initialize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_initialize(
+    OPENCL_DOMAIN,
+    OPENCL_NODE,
+    MTAPI_NULL,
+    MTAPI_NULL,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  float node_local = 1.0f;
+  action = mtapi_opencl_action_create_batched(
+    OPENCL_JOB,
+    batched_kernel, "batched", 32, 4,
+    &node_local, sizeof(float),
+    16, 1000,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  job = mtapi_job_get(OPENCL_JOB, OPENCL_DOMAIN, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  for (int tt = 0; tt < kTasks; tt++) {
+    int elements = (tt % 30 < 20) ? kElements : kElements / 2;
+    for (int ii = 0; ii < elements; ii++) {
+      arguments[tt][ii] = static_cast<float>(ii);
+      arguments[tt][ii + elements] = static_cast<float>(tt);
+    }
+    tasks[tt] = mtapi_task_start(
+      MTAPI_TASK_ID_NONE,
+      job,
+      arguments[tt], elements * 2 * sizeof(float),
+      results[tt], elements * sizeof(float),
+      MTAPI_DEFAULT_TASK_ATTRIBUTES,
+      MTAPI_GROUP_NONE,
+      &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+  for (int tt = 0; tt < kTasks; tt++) {
+    int elements = (tt % 30 < 20) ? kElements : kElements / 2;
+    mtapi_task_wait(tasks[tt], MTAPI_INFINITE, &status);
+    MTAPI_CHECK_STATUS(status);
+    for (int ii = 0; ii < elements; ii++) {
+      PT_EXPECT_EQ(results[tt][ii], ii + tt + 1);
+    }
+  }
+
   mtapi_action_delete(action, MTAPI_INFINITE, &status);
   MTAPI_CHECK_STATUS(status);
 
@@ -123,3 +498,88 @@ void TaskTest::TestBasic() {
   mtapi_opencl_plugin_finalize(&status);
   MTAPI_CHECK_STATUS(status);
 }
+
+void TaskTest::TestHeterogeneous() {
+  mtapi_status_t status;
+  mtapi_job_hndl_t job;
+  mtapi_action_hndl_t opencl_action;
+  mtapi_action_hndl_t cpu_action;
+
+  // the job runs on the device or the CPU, whichever finishes first
+  const int kElements = 64;
+  const int kTasks = 200;
+  float arguments[kTasks][kElements * 2];
+  float results[kTasks][kElements];
+  mtapi_task_hndl_t tasks[kTasks];
+
+  embb_atomic_store_int(&cpu_tasks, 0);
+
+  mtapi_opencl_plugin_initialize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_initialize(
+    OPENCL_DOMAIN,
+    OPENCL_NODE,
+    MTAPI_NULL,
+    MTAPI_NULL,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  float node_local = 1.0f;
+  opencl_action = mtapi_opencl_action_create(
+    OPENCL_JOB,
+    kernel, "test", 32, 4,
+    &node_local, sizeof(float),
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  cpu_action = mtapi_action_create(
+    OPENCL_JOB,
+    AddOnCPU,
+    &node_local, sizeof(float),
+    MTAPI_DEFAULT_ACTION_ATTRIBUTES,
+    &status);
+  MTAPI_CHECK_STATUS(status);
+
+  job = mtapi_job_get(OPENCL_JOB, OPENCL_DOMAIN, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  for (int tt = 0; tt < kTasks; tt++) {
+    for (int ii = 0; ii < kElements; ii++) {
+      arguments[tt][ii] = static_cast<float>(ii);
+      arguments[tt][ii + kElements] = static_cast<float>(tt);
+    }
+    tasks[tt] = mtapi_task_start(
+      MTAPI_TASK_ID_NONE,
+      job,
+      arguments[tt], kElements * 2 * sizeof(float),
+      results[tt], kElements * sizeof(float),
+      MTAPI_DEFAULT_TASK_ATTRIBUTES,
+      MTAPI_GROUP_NONE,
+      &status);
+    MTAPI_CHECK_STATUS(status);
+  }
+  for (int tt = 0; tt < kTasks; tt++) {
+    mtapi_task_wait(tasks[tt], MTAPI_INFINITE, &status);
+    MTAPI_CHECK_STATUS(status);
+    for (int ii = 0; ii < kElements; ii++) {
+      PT_EXPECT_EQ(results[tt][ii], ii + tt + 1);
+    }
+  }
+
+  // both implementations get measured at least once
+  PT_EXPECT_GT(embb_atomic_load_int(&cpu_tasks), 0);
+  PT_EXPECT_LT(embb_atomic_load_int(&cpu_tasks), kTasks);
+
+  mtapi_action_delete(cpu_action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_action_delete(opencl_action, MTAPI_INFINITE, &status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+
+  mtapi_opencl_plugin_finalize(&status);
+  MTAPI_CHECK_STATUS(status);
+}
@@ -28,6 +28,7 @@
 #define MTAPI_OPENCL_C_TEST_EMBB_MTAPI_OPENCL_TEST_TASK_H_
 
 #include <partest/partest.h>
+#include <embb/mtapi/c/mtapi.h>
 
 class TaskTest : public partest::TestCase {
  public:
@@ -35,6 +36,15 @@ class TaskTest : public partest::TestCase {
 
  private:
   void TestBasic();
+  void TestBasicHostMemory();
+  void TestThroughput();
+  void TestThroughputHostMemory();
+  void TestConcurrentStart();
+  void TestBatched();
+  void TestHeterogeneous();
+
+  void RunBasic(mtapi_boolean_t host_memory);
+  void RunThroughput(mtapi_boolean_t host_memory);
 };
 
 #endif // MTAPI_OPENCL_C_TEST_EMBB_MTAPI_OPENCL_TEST_TASK_H_
@@ -234,32 +234,42 @@ void Node::Finalize() {
 
 Group & Node::CreateGroup() {
   Group * group = embb::base::Allocation::New<Group>();
+  embb::base::LockGuard<embb::base::AdaptiveMutex> lock(lists_mutex_);
   groups_.push_back(group);
   return *group;
 }
 
 void Node::DestroyGroup(Group & group) {
-  std::list<Group*>::iterator ii =
-    std::find(groups_.begin(), groups_.end(), &group);
-  if (ii != groups_.end()) {
-    embb::base::Allocation::Delete(*ii);
+  {
+    embb::base::LockGuard<embb::base::AdaptiveMutex> lock(lists_mutex_);
+    std::list<Group*>::iterator ii =
+      std::find(groups_.begin(), groups_.end(), &group);
+    if (ii == groups_.end()) {
+      return;
+    }
     groups_.erase(ii);
   }
+  embb::base::Allocation::Delete(&group);
 }
 
 Queue & Node::CreateQueue(mtapi_uint_t priority, bool ordered) {
   Queue * queue = embb::base::Allocation::New<Queue>(priority, ordered);
+  embb::base::LockGuard<embb::base::AdaptiveMutex> lock(lists_mutex_);
   queues_.push_back(queue);
   return *queue;
 }
 
 void Node::DestroyQueue(Queue & queue) {
-  std::list<Queue*>::iterator ii =
-    std::find(queues_.begin(), queues_.end(), &queue);
-  if (ii != queues_.end()) {
-    embb::base::Allocation::Delete(*ii);
+  {
+    embb::base::LockGuard<embb::base::AdaptiveMutex> lock(lists_mutex_);
+    std::list<Queue*>::iterator ii =
+      std::find(queues_.begin(), queues_.end(), &queue);
+    if (ii == queues_.end()) {
+      return;
+    }
     queues_.erase(ii);
   }
+  embb::base::Allocation::Delete(&queue);
 }
 
 Task Node::Spawn(Action action) {